@@ -1,7 +1,14 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
-#define MAX_LIGHTS 64
+#define MAX_LIGHTS 1024
+#define CLUSTERS_X 16
+#define CLUSTERS_Y 9
+#define CLUSTERS_Z 24
+#define CLUSTERS_COUNT (CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z)
+#define MAX_LIGHT_INDICES (CLUSTERS_COUNT * 64)
+#define ATTENUATION_SCALE 0.1f
+#define MAX_CASCADES 4
 #define PI 3.141592653589793f
 #define EPSILON 0.001f
 
@@ -14,11 +21,10 @@ struct Light
 
 layout(set = 0, binding = 0) uniform UboScene 
 {
-	Light lights[MAX_LIGHTS];
-
 	mat4 projection;
 	mat4 view;
-	mat4 shadowSpace;
+	mat4 shadowSpaces[MAX_CASCADES];
+	vec4 shadowSplits;
 
 	vec4 fogColour;
 	vec3 cameraPosition;
@@ -30,8 +36,10 @@ layout(set = 0, binding = 0) uniform UboScene
 	float shadowBias;
 	float shadowDarkness;
 	int shadowPCF;
+	int shadowCascades;
 
-	int lightsCount;
+	float clusterScale;
+	float clusterBias;
 } scene;
 
 layout(rgba16f, set = 0, binding = 1) uniform writeonly image2D writeColour;
@@ -42,6 +50,21 @@ layout(set = 0, binding = 4) uniform sampler2D samplerNormal;
 layout(set = 0, binding = 5) uniform sampler2D samplerMaterial;
 layout(set = 0, binding = 6) uniform sampler2D samplerShadows;
 
+layout(set = 0, binding = 7) readonly buffer BufferLights
+{
+	Light lights[MAX_LIGHTS];
+} bufferLights;
+
+layout(set = 0, binding = 8) readonly buffer BufferClusters
+{
+	uvec2 clusters[CLUSTERS_COUNT];
+} bufferClusters;
+
+layout(set = 0, binding = 9) readonly buffer BufferIndices
+{
+	uint indices[MAX_LIGHT_INDICES];
+} bufferIndices;
+
 layout(location = 0) in vec2 fragmentUv;
 
 layout(location = 0) out vec4 outColour;
@@ -66,35 +89,54 @@ vec3 decodeWorldPosition(vec2 uv, float depth)
 	return p.xyz / p.w;
 }
 
-float shadow(vec4 shadowCoords)
+float shadow(vec3 worldPosition, float viewDistance)
+{
+	// Picks the first cascade that reaches this fragment.
+	int cascade = 0;
+
+	while (cascade < scene.shadowCascades - 1 && viewDistance > scene.shadowSplits[cascade])
+	{
+		cascade++;
+	}
+
+	vec4 shadowCoords = scene.shadowSpaces[cascade] * vec4(worldPosition, 1.0f);
+
+	if (shadowCoords.x < 0.0f || shadowCoords.x > 1.0f || shadowCoords.y < 0.0f || shadowCoords.y > 1.0f || shadowCoords.z > 1.0f)
+	{
+		return 1.0f;
+	}
+
+	// Each cascade is one cell of a 2x2 atlas, samples are clamped inside the cell.
+	vec2 cell = vec2(cascade % 2, cascade / 2) * 0.5f;
+	vec2 sizeShadows = 2.0f / textureSize(samplerShadows, 0);
+	float totalTextels = (scene.shadowPCF * 2.0f + 1.0f) * (scene.shadowPCF * 2.0f + 1.0f);
+	float total = 0.0f;
+
+	for (int x = -scene.shadowPCF; x <= scene.shadowPCF; x++)
+	{
+		for (int y = -scene.shadowPCF; y <= scene.shadowPCF; y++)
+		{
+			vec2 local = clamp(shadowCoords.xy + vec2(x, y) * sizeShadows, sizeShadows, 1.0f - sizeShadows);
+			float shadowValue = texture(samplerShadows, cell + local * 0.5f).r;
+
+			if (shadowCoords.z > shadowValue + scene.shadowBias)
+			{
+				total += 1.0f;
+			}
+		}
+	}
+
+	total /= totalTextels;
+
+	float fade = clamp((scene.shadowDistance - viewDistance) / scene.shadowTransition, 0.0f, 1.0f);
+	return 1.0f - (total * scene.shadowDarkness * fade);
+}
+
+uint clusterIndex(vec2 uv, float viewDepth)
 {
-    float total = 0.0f;
-	vec2 sizeShadows = 1.0f / textureSize(samplerShadows, 0);
-    float totalTextels = (scene.shadowPCF * 2.0f + 1.0f) * (scene.shadowPCF * 2.0f + 1.0f);
-
-   // if (shadowCoords.x > 0.0f && shadowCoords.x < 1.0f && shadowCoords.y > 0.0f && shadowCoords.y < 1.0f && shadowCoords.z > 0.0f && shadowCoords.z < 1.0f)
-   // {
-        for (int x = -scene.shadowPCF; x <= scene.shadowPCF; x++)
-        {
-            for (int y = -scene.shadowPCF; y <= scene.shadowPCF; y++)
-            {
-                float shadowValue = texture(samplerShadows, shadowCoords.xy + vec2(x, y) * sizeShadows).r;
-
-                if (shadowCoords.z < shadowValue + scene.shadowBias)
-                {
-                    total += scene.shadowDarkness * shadowCoords.w;
-                }
-            }
-        }
-
-        total /= totalTextels;
-   // }
-   // else
-   // {
-   //     total = 0.0f;
-   // }
-
-    return 1.0f - total;
+	uvec2 tile = uvec2(clamp(uv * vec2(CLUSTERS_X, CLUSTERS_Y), vec2(0.0f), vec2(CLUSTERS_X - 1, CLUSTERS_Y - 1)));
+	uint slice = uint(clamp(log(viewDepth) * scene.clusterScale - scene.clusterBias, 0.0f, CLUSTERS_Z - 1));
+	return tile.x + CLUSTERS_X * (tile.y + CLUSTERS_Y * slice);
 }
 
 float attenuation(float radius, float distance)
@@ -131,12 +173,7 @@ void main()
 	// Shadows.
     if (!ignoreLighting && scene.shadowDarkness >= 0.07f)
     {
-        vec4 shadowCoords = scene.shadowSpace * vec4(worldPosition, 1.0f);
-        float distanceAway = length(screenPosition.xyz);
-        distanceAway = distanceAway - ((scene.shadowDistance * 2.0f) - scene.shadowTransition);
-        distanceAway = distanceAway / scene.shadowTransition;
-        shadowCoords.w = clamp(1.0f - distanceAway, 0.0f, 1.0f);
-        outColour *= shadow(shadowCoords);
+        outColour *= shadow(worldPosition, -screenPosition.z);
     }
 
 	// Lighting.
@@ -144,15 +181,17 @@ void main()
 	{
 		vec3 irradiance = vec3(0.0f);
 
-    	for (int i = 0; i < scene.lightsCount; i++)
+		uvec2 cluster = bufferClusters.clusters[clusterIndex(fragmentUv, -screenPosition.z)];
+
+    	for (uint i = 0; i < cluster.y; i++)
     	{
-    		Light light = scene.lights[i];
+    		Light light = bufferLights.lights[bufferIndices.indices[cluster.x + i]];
 
     		vec3 lightDirection = light.position - worldPosition;
     		float distance = length(lightDirection);
     		lightDirection /= distance;
 
-    		float att = attenuation(light.radius, 0.1f * distance);
+    		float att = attenuation(light.radius, ATTENUATION_SCALE * distance);
 
     		vec3 LvD = normalize(lightDirection + viewDirection);
     		float NoH = max(0.0f, dot(normal, LvD));
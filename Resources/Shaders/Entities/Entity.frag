@@ -3,7 +3,29 @@
 
 #define MAX_JOINTS 50
 #define MAX_WEIGHTS 3
+#define MAX_MATERIAL_TEXTURES 128
 
+#ifdef BINDLESS
+struct Material
+{
+	vec4 baseColor;
+	float metallic;
+	float roughness;
+	float ignoreFog;
+	float ignoreLighting;
+	int diffuseTexture;
+	int surfaceTexture;
+	int normalTexture;
+	int padding;
+};
+
+layout(set = 0, binding = 2, std430) readonly buffer BufferMaterials
+{
+	Material materials[];
+} bufferMaterials;
+
+layout(set = 0, binding = 3) uniform sampler2D samplerTextures[MAX_MATERIAL_TEXTURES];
+#else
 layout(set = 0, binding = 1) uniform UboObject
 {
 #ifdef ANIMATED
@@ -27,6 +49,7 @@ layout(set = 0, binding = 3) uniform sampler2D samplerMaterial;
 #ifdef NORMAL_MAPPING
 layout(set = 0, binding = 4) uniform sampler2D samplerNormal;
 #endif
+#endif
 
 layout(location = 0) in vec2 fragmentUv;
 layout(location = 1) in vec3 fragmentNormal;
@@ -35,6 +58,9 @@ layout(location = 2) in vec3 tangentT;
 layout(location = 3) in vec3 tangentN;
 layout(location = 4) in vec3 tangentB;
 #endif
+#ifdef BINDLESS
+layout(location = 5) flat in int fragmentMaterial;
+#endif
 
 layout(location = 0) out vec4 outColour;
 layout(location = 1) out vec2 outNormal;
@@ -48,6 +74,49 @@ vec2 encodeNormal(vec3 normal)
 	return result;
 }
 
+#ifdef BINDLESS
+void main() 
+{
+	// Every instance in a draw shares its texture indices, so indexing the sampler array stays dynamically uniform.
+	Material object = bufferMaterials.materials[fragmentMaterial];
+	vec4 textureColour = object.baseColor;
+	vec3 unitNormal = normalize(fragmentNormal);
+	vec3 material = vec3(object.metallic, object.roughness, 0.0f);
+	float glowing = 0.0f;
+
+	if (object.diffuseTexture >= 0)
+	{
+		textureColour = texture(samplerTextures[object.diffuseTexture], fragmentUv);
+	}
+
+	if (object.surfaceTexture >= 0)
+	{
+		vec4 textureMaterial = texture(samplerTextures[object.surfaceTexture], fragmentUv);
+		material.x *= textureMaterial.r;
+		material.y *= textureMaterial.g;
+
+		if (textureMaterial.b > 0.5f)
+		{
+			glowing = 1.0f;
+		}
+	}
+
+#ifdef NORMAL_MAPPING
+	if (object.normalTexture >= 0)
+	{
+		vec4 textureNormal = texture(samplerTextures[object.normalTexture], fragmentUv);
+		unitNormal = normalize(textureNormal.rgb * 2.0f - vec3(1.0f));
+		unitNormal = normalize(mat3(tangentT, tangentN, tangentB) * unitNormal);
+	}
+#endif
+
+	material.z = (1.0f / 3.0f) * (object.ignoreFog + (2.0f * min(object.ignoreLighting + glowing, 1.0f)));
+
+	outColour = textureColour;
+	outNormal = encodeNormal(unitNormal);
+	outMaterial = vec4(material, 1.0f);
+}
+#else
 void main() 
 {
 	vec4 textureColour = object.baseColor;
@@ -83,3 +152,4 @@ void main()
 	outNormal = encodeNormal(unitNormal);
 	outMaterial = vec4(material, 1.0f);
 }
+#endif
@@ -10,6 +10,18 @@ layout(set = 0, binding = 0) uniform UboScene
 	mat4 view;
 } scene;
 
+#ifdef BINDLESS
+struct Object
+{
+	mat4 transform;
+	int material;
+};
+
+layout(set = 0, binding = 1, std430) readonly buffer BufferObjects
+{
+	Object objects[];
+} bufferObjects;
+#else
 layout(set = 0, binding = 1) uniform UboObject
 {
 #ifdef ANIMATED
@@ -23,6 +35,7 @@ layout(set = 0, binding = 1) uniform UboObject
 	float ignoreFog;
 	float ignoreLighting;
 } object;
+#endif
 
 layout(location = 0) in vec3 vertexPosition;
 layout(location = 1) in vec2 vertexUv;
@@ -42,6 +55,9 @@ layout(location = 2) out vec3 tangentT;
 layout(location = 3) out vec3 tangentN;
 layout(location = 4) out vec3 tangentB;
 #endif
+#ifdef BINDLESS
+layout(location = 5) flat out int fragmentMaterial;
+#endif
 
 out gl_PerVertex 
 {
@@ -50,10 +66,17 @@ out gl_PerVertex
 
 void main() 
 {
+#ifdef BINDLESS
+	mat4 transform = bufferObjects.objects[gl_InstanceIndex].transform;
+	fragmentMaterial = bufferObjects.objects[gl_InstanceIndex].material;
+#else
+	mat4 transform = object.transform;
+#endif
+
 	vec4 totalLocalPos = vec4(vertexPosition, 1.0f);
 	vec4 totalNormal = vec4(vertexNormal, 0.0f);
 
-#ifdef ANIMATED
+#if defined(ANIMATED) && !defined(BINDLESS)
     for (int i = 0; i < MAX_WEIGHTS; i++)
     {
  	    mat4 jointTransform = object.jointTransforms[vertexJointIndices[i]];
@@ -65,15 +88,15 @@ void main()
     }
 #endif
 
-	vec4 worldPosition = object.transform * totalLocalPos;
+	vec4 worldPosition = transform * totalLocalPos;
 
     gl_Position = scene.projection * scene.view * worldPosition;
 
     fragmentUv = vertexUv;
-	fragmentNormal = normalize((object.transform * totalNormal).xyz);
+	fragmentNormal = normalize((transform * totalNormal).xyz);
 
 #ifdef NORMAL_MAPPING
-    mat3 normal_matrix = transpose(inverse(mat3(object.transform)));
+    mat3 normal_matrix = transpose(inverse(mat3(transform)));
     tangentT = normalize(normal_matrix * vertexTangent);
     tangentN = normalize(normal_matrix * vertexNormal);
     tangentB = normalize(cross(tangentT, tangentN));
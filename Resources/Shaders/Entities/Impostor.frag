@@ -0,0 +1,102 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+#define IMPOSTOR_FRAME_SIZE 64.0f
+#define MAX_MATERIAL_TEXTURES 128
+
+struct Material
+{
+	vec4 baseColor;
+	float metallic;
+	float roughness;
+	float ignoreFog;
+	float ignoreLighting;
+	int diffuseTexture;
+	int surfaceTexture;
+	int normalTexture;
+	int padding;
+};
+
+layout(set = 0, binding = 2, std430) readonly buffer BufferMaterials
+{
+	Material materials[];
+} bufferMaterials;
+
+layout(set = 0, binding = 3) uniform sampler2D samplerTextures[MAX_MATERIAL_TEXTURES];
+
+layout(location = 0) in vec2 fragmentUv;
+layout(location = 1) flat in int fragmentMaterial;
+layout(location = 2) flat in int fragmentAtlas;
+layout(location = 3) flat in mat3 fragmentRotation;
+
+layout(location = 0) out vec4 outColour;
+layout(location = 1) out vec2 outNormal;
+layout(location = 2) out vec4 outMaterial;
+
+vec2 encodeNormal(vec3 normal)
+{
+	vec2 result = vec2(0.0f);
+	result.x = (atan(normal.y, normal.x) / 3.14159f) * 0.5f + 0.5f;
+	result.y = normal.z * 0.5f + 0.5f;
+	return result;
+}
+
+vec2 signNotZero(vec2 v)
+{
+	return vec2(v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f);
+}
+
+vec4 sampleMaterial(int index, vec2 uv)
+{
+	// Atlas uvs jump between texels, so their derivatives say nothing, textures are read at the mip that matches a frames resolution.
+	float lod = max(log2(float(textureSize(samplerTextures[index], 0).x) / IMPOSTOR_FRAME_SIZE), 0.0f);
+	return textureLod(samplerTextures[index], uv, lod);
+}
+
+void main()
+{
+	// Atlas texels hold the models uv and octahedral encoded normal, texels the model does not cover have an alpha past the normals range.
+	vec4 texel = texture(samplerTextures[fragmentAtlas], fragmentUv);
+
+	if (texel.a > 1.5f)
+	{
+		discard;
+	}
+
+	vec3 normal = vec3(texel.zw, 1.0f - abs(texel.z) - abs(texel.w));
+
+	if (normal.z < 0.0f)
+	{
+		normal.xy = (1.0f - abs(normal.yx)) * signNotZero(normal.xy);
+	}
+
+	// Every instance in a draw shares its atlas and texture indices, so indexing the sampler array stays dynamically uniform.
+	Material object = bufferMaterials.materials[fragmentMaterial];
+	vec4 textureColour = object.baseColor;
+	vec3 unitNormal = normalize(fragmentRotation * normal);
+	vec3 material = vec3(object.metallic, object.roughness, 0.0f);
+	float glowing = 0.0f;
+
+	if (object.diffuseTexture >= 0)
+	{
+		textureColour = sampleMaterial(object.diffuseTexture, texel.xy);
+	}
+
+	if (object.surfaceTexture >= 0)
+	{
+		vec4 textureMaterial = sampleMaterial(object.surfaceTexture, texel.xy);
+		material.x *= textureMaterial.r;
+		material.y *= textureMaterial.g;
+
+		if (textureMaterial.b > 0.5f)
+		{
+			glowing = 1.0f;
+		}
+	}
+
+	material.z = (1.0f / 3.0f) * (object.ignoreFog + (2.0f * min(object.ignoreLighting + glowing, 1.0f)));
+
+	outColour = textureColour;
+	outNormal = encodeNormal(unitNormal);
+	outMaterial = vec4(material, 1.0f);
+}
@@ -0,0 +1,88 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+#define IMPOSTOR_FRAMES 8.0f
+
+layout(set = 0, binding = 0) uniform UboScene
+{
+	mat4 projection;
+	mat4 view;
+} scene;
+
+struct Impostor
+{
+	mat4 transform;
+	vec4 sphere;
+	int material;
+	int atlas;
+};
+
+layout(set = 0, binding = 1, std430) readonly buffer BufferImpostors
+{
+	Impostor impostors[];
+} bufferImpostors;
+
+layout(location = 0) out vec2 fragmentUv;
+layout(location = 1) flat out int fragmentMaterial;
+layout(location = 2) flat out int fragmentAtlas;
+layout(location = 3) flat out mat3 fragmentRotation;
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+const vec2 CORNERS[6] = vec2[](
+	vec2(-1.0f, -1.0f), vec2(1.0f, -1.0f), vec2(1.0f, 1.0f),
+	vec2(-1.0f, -1.0f), vec2(1.0f, 1.0f), vec2(-1.0f, 1.0f)
+);
+
+vec2 signNotZero(vec2 v)
+{
+	return vec2(v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f);
+}
+
+void main()
+{
+	Impostor impostor = bufferImpostors.impostors[gl_InstanceIndex];
+	mat3 rotation = mat3(impostor.transform);
+
+	// The view matrix only rotates and translates, so the camera position is found with its transpose.
+	vec3 cameraPosition = -transpose(mat3(scene.view)) * scene.view[3].xyz;
+	vec3 centre = (impostor.transform * vec4(impostor.sphere.xyz, 1.0f)).xyz;
+	vec3 viewDirection = normalize(inverse(rotation) * (cameraPosition - centre));
+
+	// Picks the frame nearest the view direction, frames are spread the same way as Impostor::GetFrameDirection.
+	vec2 octahedral = viewDirection.xz / (abs(viewDirection.x) + abs(viewDirection.y) + abs(viewDirection.z));
+
+	if (viewDirection.y < 0.0f)
+	{
+		octahedral = (1.0f - abs(octahedral.yx)) * signNotZero(octahedral);
+	}
+
+	vec2 frame = clamp(round((octahedral * 0.5f + 0.5f) * (IMPOSTOR_FRAMES - 1)), 0.0f, IMPOSTOR_FRAMES - 1);
+	vec2 grid = frame / (IMPOSTOR_FRAMES - 1) * 2.0f - 1.0f;
+	vec3 direction = vec3(grid.x, 1.0f - abs(grid.x) - abs(grid.y), grid.y);
+
+	if (direction.y < 0.0f)
+	{
+		direction.xz = (1.0f - abs(grid.yx)) * signNotZero(grid);
+	}
+
+	direction = normalize(direction);
+
+	// The quad faces the frames direction with the axes the frame was baked with, so it lines up with the atlas.
+	vec3 reference = abs(direction.y) > 0.999f ? vec3(0.0f, 0.0f, 1.0f) : vec3(0.0f, 1.0f, 0.0f);
+	vec3 right = normalize(cross(reference, direction));
+	vec3 up = cross(direction, right);
+
+	vec2 corner = CORNERS[gl_VertexIndex];
+	vec3 localPosition = impostor.sphere.xyz + impostor.sphere.w * (corner.x * right + corner.y * up);
+
+	gl_Position = scene.projection * scene.view * impostor.transform * vec4(localPosition, 1.0f);
+
+	fragmentUv = (frame + vec2(0.5f + 0.5f * corner.x, 0.5f - 0.5f * corner.y)) / IMPOSTOR_FRAMES;
+	fragmentMaterial = impostor.material;
+	fragmentAtlas = impostor.atlas;
+	fragmentRotation = rotation;
+}
@@ -5,5 +5,5 @@ layout(location = 0) out vec4 outShadow;
 
 void main() 
 {
-	outShadow = vec4(1.0f);
+	outShadow = vec4(gl_FragCoord.z);
 }
\ No newline at end of file
@@ -1,11 +1,6 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
-layout(set = 0, binding = 1) uniform UboObject
-{
-	mat4 transform;
-} object;
-
 layout(location = 0) in vec3 fragmentNormal;
 layout(location = 1) in vec2 fragmentUv;
 layout(location = 2) in vec3 fragmentColour;
@@ -5,17 +5,26 @@ layout(set = 0, binding = 0) uniform UboScene
 {
 	mat4 projection;
 	mat4 view;
+	vec4 cameraPosition;
 } scene;
 
-layout(set = 0, binding = 1) uniform UboObject
+struct Node
 {
-	mat4 transform;
-} object;
+	vec4 origin;
+	vec4 morph;
+};
+
+layout(set = 0, binding = 1) readonly buffer BufferNodes
+{
+	Node nodes[];
+} bufferNodes;
+
+layout(set = 0, binding = 2) readonly buffer BufferHeights
+{
+	uint heights[];
+} bufferHeights;
 
-layout(location = 0) in vec3 vertexPosition;
-layout(location = 1) in vec2 vertexUv;
-layout(location = 2) in vec3 vertexNormal;
-layout(location = 3) in vec3 vertexTangent;
+layout(location = 0) in uvec2 vertexGrid;
 
 layout(location = 0) out vec3 fragmentNormal;
 layout(location = 1) out vec2 fragmentUv;
@@ -26,16 +35,74 @@ out gl_PerVertex
 	vec4 gl_Position;
 };
 
+const int TILE_SIZE = 64;
+const int TILE_BORDER = 1;
+const int TILE_ROW = TILE_SIZE + 1 + 2 * TILE_BORDER;
+const int SLOT_SIZE = ((TILE_ROW * TILE_ROW) + 1) & ~1;
+const float HEIGHT_OFFSET = 15.0f;
+const float HEIGHT_AMPLITUDE = 60.0f;
+
+const vec3 BIOME_COLOURS[4] = vec3[](
+	vec3(1.0f, 0.8f, 0.0f), vec3(0.882f, 0.482f, 0.208f),
+	vec3(0.765f, 0.365f, 0.208f), vec3(0.408f, 0.192f, 0.188f)
+);
+const float SPREAD = 0.76f;
+const float HALF_SPREAD = SPREAD / 2.0f;
+const float AMPLITUDE = 20.0f;
+const float PART = 1.0f / 3.0f;
+
+float getHeight(int base, ivec2 grid)
+{
+	// Heights are packed two to a uint, quantized to 16 bits over the terrains height range.
+	grid += TILE_BORDER;
+	int index = base + grid.x + TILE_ROW * grid.y;
+	uint quantized = (bufferHeights.heights[index >> 1] >> ((index & 1) * 16)) & 0xFFFFu;
+	return HEIGHT_OFFSET - HEIGHT_AMPLITUDE + (2.0f * HEIGHT_AMPLITUDE) * (float(quantized) / 65535.0f);
+}
+
+float sampleHeight(int base, vec2 grid)
+{
+	ivec2 cell = clamp(ivec2(floor(grid)), ivec2(-TILE_BORDER), ivec2(TILE_SIZE));
+	vec2 blend = grid - vec2(cell);
+	float height0 = mix(getHeight(base, cell), getHeight(base, cell + ivec2(1, 0)), blend.x);
+	float height1 = mix(getHeight(base, cell + ivec2(0, 1)), getHeight(base, cell + ivec2(1, 1)), blend.x);
+	return mix(height0, height1, blend.y);
+}
+
+vec3 getColour(float height)
+{
+	float value = (height + AMPLITUDE) / (AMPLITUDE * 2.0f);
+	value = clamp((value - HALF_SPREAD) * (1.0f / SPREAD), 0.0f, 0.9999f);
+	int firstBiome = int(floor(value / PART));
+	float blend = (value - (float(firstBiome) * PART)) / PART;
+	return mix(BIOME_COLOURS[firstBiome], BIOME_COLOURS[firstBiome + 1], blend);
+}
+
 void main() 
 {
-	vec4 totalLocalPos = vec4(vertexPosition, 1.0f);
-	vec4 totalNormal = vec4(vertexNormal, 0.0f);
+	Node node = bufferNodes.nodes[gl_InstanceIndex];
+	float spacing = node.origin.z;
+	int base = int(node.origin.w) * SLOT_SIZE;
+
+	// The grid points are counted from the nodes corner.
+	vec2 grid = vec2(vertexGrid);
+	vec3 position = vec3(node.origin.x + grid.x * spacing, getHeight(base, ivec2(grid)), node.origin.y + grid.y * spacing);
+
+	// Odd grid points slide onto the grid of the level above, along the same diagonal the grids triangles are split on.
+	float morph = clamp((distance(position, scene.cameraPosition.xyz) - node.morph.x) / (node.morph.y - node.morph.x), 0.0f, 1.0f);
+	vec2 odd = fract(grid * 0.5f) * 2.0f;
+	grid += vec2(odd.x, -odd.y) * morph;
+
+	position = vec3(node.origin.x + grid.x * spacing, sampleHeight(base, grid), node.origin.y + grid.y * spacing);
 
-	vec4 worldPosition = object.transform * totalLocalPos;
+	float heightL = sampleHeight(base, grid - vec2(1.0f, 0.0f));
+	float heightR = sampleHeight(base, grid + vec2(1.0f, 0.0f));
+	float heightD = sampleHeight(base, grid - vec2(0.0f, 1.0f));
+	float heightU = sampleHeight(base, grid + vec2(0.0f, 1.0f));
 
-	gl_Position = scene.projection * scene.view * worldPosition;
+	gl_Position = scene.projection * scene.view * vec4(position, 1.0f);
 
-	fragmentNormal = normalize((object.transform * totalNormal).xyz);
-	fragmentUv = vertexUv;
-	fragmentColour = vertexTangent;
+	fragmentNormal = normalize(vec3(heightL - heightR, spacing, heightD - heightU));
+	fragmentUv = position.xz / 20.0f;
+	fragmentColour = getColour(position.y);
 }
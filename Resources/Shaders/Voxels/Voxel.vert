@@ -10,12 +10,16 @@ layout(set = 0, binding = 0) uniform UboScene
 layout(set = 0, binding = 1) uniform UboObject
 {
 	mat4 transform;
+	vec4 planet;
 } object;
 
-layout(location = 0) in vec3 vertexPosition;
-layout(location = 1) in vec2 vertexUv;
-layout(location = 2) in vec3 vertexNormal;
-layout(location = 3) in vec3 vertexTangent;
+layout(set = 0, binding = 2) uniform UboBlocks
+{
+	vec4 colours[256];
+} blocks;
+
+// Position 5 bits per axis, face 3 bits, ambient occlusion 2 bits, block 8 bits.
+layout(location = 0) in uint vertexData;
 
 layout(location = 0) out vec3 fragmentNormal;
 layout(location = 1) out vec3 fragmentColour;
@@ -25,15 +29,40 @@ out gl_PerVertex
     vec4 gl_Position;
 };
 
+const vec3 NORMALS[6] = vec3[](
+	vec3(0.0f, 0.0f, -1.0f), vec3(0.0f, 0.0f, 1.0f),
+	vec3(0.0f, 1.0f, 0.0f), vec3(0.0f, -1.0f, 0.0f),
+	vec3(-1.0f, 0.0f, 0.0f), vec3(1.0f, 0.0f, 0.0f)
+);
+
+const float OCCLUSION[4] = float[](0.45f, 0.6f, 0.8f, 1.0f);
+
 void main() 
 {
-	vec4 totalLocalPos = vec4(vertexPosition, 1.0f);
-	vec4 totalNormal = vec4(vertexNormal, 0.0f);
+	vec3 position = vec3(float(vertexData & 31u), float((vertexData >> 5u) & 31u), float((vertexData >> 10u) & 31u));
+	uint face = (vertexData >> 15u) & 7u;
+	uint occlusion = (vertexData >> 18u) & 3u;
+	uint block = (vertexData >> 20u) & 255u;
+
+	vec4 totalLocalPos = vec4(position, 1.0f);
+	vec4 totalNormal = vec4(NORMALS[face], 0.0f);
 
 	vec4 worldPosition = object.transform * totalLocalPos;
+	vec3 worldNormal = normalize((object.transform * totalNormal).xyz);
+
+	// Planet patches are laid flat on a side of the cube, the height above the side is kept while the point is pushed onto the sphere.
+	if (object.planet.w > 0.0f)
+	{
+		vec3 side = normalize(object.transform[1].xyz);
+		vec3 offset = worldPosition.xyz - object.planet.xyz;
+		float height = dot(offset, side) - object.planet.w;
+		vec3 up = normalize(offset - side * height);
+		worldPosition.xyz = object.planet.xyz + up * (object.planet.w + height);
+		worldNormal = normalize(worldNormal + (up - side) * dot(worldNormal, side));
+	}
 
     gl_Position = scene.projection * scene.view * worldPosition;
 
-    fragmentNormal = normalize((object.transform * totalNormal).xyz);
-    fragmentColour = vertexTangent;
+    fragmentNormal = worldNormal;
+    fragmentColour = blocks.colours[block].rgb * OCCLUSION[occlusion];
 }
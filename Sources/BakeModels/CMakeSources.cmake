@@ -0,0 +1,9 @@
+set(BAKE_MODELS_SOURCES_
+        "Main.cpp"
+)
+
+source_group("Source Files" FILES ${BAKE_MODELS_SOURCES_})
+
+set(BAKE_MODELS_SOURCES
+        ${BAKE_MODELS_SOURCES_}
+)
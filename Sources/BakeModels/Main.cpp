@@ -0,0 +1,50 @@
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <Engine/Engine.hpp>
+#include <Helpers/FileSystem.hpp>
+#include <Models/ModelBaked.hpp>
+
+using namespace Flounder;
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+	{
+		printf("Usage: BakeModels <model.obj>...\n");
+		printf("Bakes each OBJ into a %s file beside it, models loaded from the OBJ then load the baked file.\n", ModelBaked::EXTENSION.c_str());
+		return EXIT_FAILURE;
+	}
+
+	// Modules are looked up through the engine, without an updater there are none so models are loaded on this thread.
+	auto engine = new Engine();
+	int exitCode = EXIT_SUCCESS;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string filename = argv[i];
+
+		if (!FileSystem::FileExists(filename))
+		{
+			fprintf(stderr, "File does not exist: '%s'\n", filename.c_str());
+			exitCode = EXIT_FAILURE;
+			continue;
+		}
+
+		try
+		{
+			if (!ModelBaked::Bake(filename))
+			{
+				exitCode = EXIT_FAILURE;
+			}
+		}
+		catch (const std::runtime_error &e)
+		{
+			fprintf(stderr, "%s\n", e.what());
+			exitCode = EXIT_FAILURE;
+		}
+	}
+
+	delete engine;
+	return exitCode;
+}
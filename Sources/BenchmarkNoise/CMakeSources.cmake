@@ -0,0 +1,9 @@
+set(BENCHMARK_NOISE_SOURCES_
+        "Main.cpp"
+)
+
+source_group("Source Files" FILES ${BENCHMARK_NOISE_SOURCES_})
+
+set(BENCHMARK_NOISE_SOURCES
+        ${BENCHMARK_NOISE_SOURCES_}
+)
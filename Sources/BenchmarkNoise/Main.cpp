@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include <Maths/Noise/NoiseFast.hpp>
+
+using namespace Flounder;
+
+struct NoiseCase
+{
+	const char *name;
+	NoiseFast::TypeNoise noiseType;
+	NoiseFast::TypeCellularReturn cellularReturnType;
+};
+
+static double GetTimeMs(const std::chrono::steady_clock::time_point &start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+	// Compares filling a grid per point through GetNoise with filling it in one FillNoiseSet call.
+	const int size = 64;
+	const int repeats = 3;
+	const NoiseCase cases[] = {
+		{"Value", NoiseFast::Value, NoiseFast::CellValue},
+		{"ValueFractal", NoiseFast::ValueFractal, NoiseFast::CellValue},
+		{"Perlin", NoiseFast::Perlin, NoiseFast::CellValue},
+		{"PerlinFractal", NoiseFast::PerlinFractal, NoiseFast::CellValue},
+		{"Simplex", NoiseFast::Simplex, NoiseFast::CellValue},
+		{"SimplexFractal", NoiseFast::SimplexFractal, NoiseFast::CellValue},
+		{"Cellular", NoiseFast::Cellular, NoiseFast::Distance},
+		{"Cellular Distance2Add", NoiseFast::Cellular, NoiseFast::Distance2Add}
+	};
+
+	std::vector<float> scalarSet = std::vector<float>(size * size * size);
+	std::vector<float> batchSet = std::vector<float>(size * size * size);
+
+	printf("%-24s %12s %12s %10s %12s\n", "Noise", "Scalar (ms)", "Batch (ms)", "Speedup", "Max Error");
+
+	for (const auto &noiseCase : cases)
+	{
+		NoiseFast noise = NoiseFast(1337);
+		noise.SetNoiseType(noiseCase.noiseType);
+		noise.SetCellularReturnType(noiseCase.cellularReturnType);
+		noise.SetFrequency(0.02f);
+		noise.SetFractalOctaves(4);
+
+		double scalarTime = 0.0;
+		double batchTime = 0.0;
+
+		for (int r = 0; r < repeats; r++)
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			for (int z = 0; z < size; z++)
+			{
+				for (int y = 0; y < size; y++)
+				{
+					for (int x = 0; x < size; x++)
+					{
+						scalarSet[x + size * (y + size * z)] = noise.GetNoise(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+					}
+				}
+			}
+
+			scalarTime += GetTimeMs(start);
+
+			start = std::chrono::steady_clock::now();
+			noise.FillNoiseSet(batchSet.data(), 0.0f, 0.0f, 0.0f, size, size, size);
+			batchTime += GetTimeMs(start);
+		}
+
+		float maxError = 0.0f;
+
+		for (size_t i = 0; i < batchSet.size(); i++)
+		{
+			maxError = std::max(maxError, std::fabs(batchSet[i] - scalarSet[i]));
+		}
+
+		printf("%-24s %12.2f %12.2f %9.2fx %12g\n", noiseCase.name, scalarTime / repeats, batchTime / repeats, scalarTime / batchTime, maxError);
+	}
+
+	return 0;
+}
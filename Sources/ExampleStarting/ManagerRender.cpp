@@ -8,12 +8,15 @@ namespace Demo
 {
 	RenderpassCreate *RENDERPASS_0_CREATE = new RenderpassCreate
 	{
-		4096, 4096, // width / height
+		8192, 8192, // width / height
 		{
-			Attachment(0, TypeImage, VK_FORMAT_R16_UNORM) // shadows
+			Attachment(0, TypeImage, VK_FORMAT_R16_UNORM, Colour::WHITE, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+				VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_ATTACHMENT_LOAD_OP_LOAD), // shadow atlas
+			Attachment(1, TypeDepth, VK_FORMAT_UNDEFINED, Colour::WHITE, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+				VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_ATTACHMENT_LOAD_OP_LOAD) // depth
 		}, // images
 		{
-			SubpassType(0, {0})
+			SubpassType(0, {0, 1})
 		} // subpasses
 	};
 	RenderpassCreate *RENDERPASS_1_CREATE = new RenderpassCreate
@@ -87,14 +90,17 @@ namespace Demo
 		const auto commandBuffer = Renderer::Get()->GetCommandBuffer();
 		const auto camera = Scenes::Get()->GetCamera();
 
-		// Starts Rendering.
-		VkResult startResult = Renderer::Get()->StartRenderpass(commandBuffer, 0);
+		// Starts Rendering, cached shadow cells are restored before the render pass begins.
+		VkResult startResult = Renderer::Get()->BeginCommands(commandBuffer, 0);
 
 		if (startResult != VK_SUCCESS)
 		{
 			return;
 		}
 
+		m_rendererShadows->RenderPrepass(commandBuffer, *camera);
+		Renderer::Get()->BeginRenderpass(commandBuffer, 0);
+
 		// Subpass 0.
 		m_rendererShadows->Render(commandBuffer, m_infinity, *camera);
 
@@ -107,14 +113,17 @@ namespace Demo
 		const auto commandBuffer = Renderer::Get()->GetCommandBuffer();
 		const auto camera = Scenes::Get()->GetCamera();
 
-		// Starts Rendering.
-		VkResult startResult = Renderer::Get()->StartRenderpass(commandBuffer, 1);
+		// Starts Rendering, entity culling is dispatched before the render pass begins.
+		VkResult startResult = Renderer::Get()->BeginCommands(commandBuffer, 1);
 
 		if (startResult != VK_SUCCESS)
 		{
 			return;
 		}
 
+		m_rendererEntities->RenderPrepass(commandBuffer, *camera);
+		Renderer::Get()->BeginRenderpass(commandBuffer, 1);
+
 		// Subpass 0.
 		m_rendererSkyboxes->Render(commandBuffer, m_infinity, *camera);
 		m_rendererTerrains->Render(commandBuffer, m_infinity, *camera);
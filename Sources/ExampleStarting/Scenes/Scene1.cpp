@@ -10,7 +10,7 @@
 #include <Meshes/Mesh.hpp>
 #include <Models/Shapes/ShapeSphere.hpp>
 #include <Skyboxes/SkyboxRender.hpp>
-#include <Terrains/LodBehaviour.hpp>
+#include <Terrains/TerrainRender.hpp>
 #include <Waters/MeshWater.hpp>
 #include <Waters/WaterRender.hpp>
 #include <Materials/Material.hpp>
@@ -21,6 +21,7 @@
 #include <Voxels/Chunk.hpp>
 #include <Voxels/VoxelRender.hpp>
 #include <Voxels/Planet.hpp>
+#include <Voxels/ChunkManager.hpp>
 #include "ManagerUis.hpp"
 #include "FpsCamera.hpp"
 #include "FpsPlayer.hpp"
@@ -63,29 +64,19 @@ namespace Demo
 		skyboxObject->AddComponent(new SkyboxRender(Cubemap::Resource("Resources/Skyboxes/Stars", ".png")));
 
 		// Terrains.
-		/*const int n = 4;
-
-		for (int j = -n; j <= n; j++)
-		{
-			for (int w = -n; w <= n; w++)
-			{
-				GameObject *terrainObject = new GameObject(Transform(Vector3(
-					static_cast<float>(j) * TerrainRender::SIDE_LENGTH, 0.0f,
-					static_cast<float>(w) * TerrainRender::SIDE_LENGTH)));
-				terrainObject->SetName("Terrain");
-				terrainObject->AddComponent(new Mesh());
-			//	terrainObject->AddComponent(new Material());
-				terrainObject->AddComponent(new Rigidbody());
-				terrainObject->AddComponent(new LodBehaviour());
-				terrainObject->AddComponent(new TerrainRender());
-			//	terrainObject->AddComponent(new ShadowRender());
-			}
-		}*/
+	//	GameObject *terrainObject = new GameObject(Transform());
+	//	terrainObject->SetName("Terrain");
+	//	terrainObject->AddComponent(new TerrainRender());
 
 		// Planets.
-		GameObject *planet = new GameObject(Transform(Vector3()));
-		planet->SetName("Etaran");
-		planet->AddComponent(new Planet(1));
+	//	GameObject *planet = new GameObject(Transform(Vector3()));
+	//	planet->SetName("Etaran");
+	//	planet->AddComponent(new Planet(1));
+
+		// Voxel world.
+		GameObject *world = new GameObject(Transform(Vector3()));
+		world->SetName("World");
+		world->AddComponent(new ChunkManager(6, 4));
 
 		// Waters.
 	//	GameObject *waterObject = new GameObject(Transform(Vector3(), Vector3()));
@@ -38,6 +38,7 @@ set(FLOUNDERENGINE_HEADERS_
         "Guis/Gui.hpp"
         "Guis/RendererGuis.hpp"
         "Guis/UbosGuis.hpp"
+        "Helpers/FileMapped.hpp"
         "Helpers/FileSystem.hpp"
         "Helpers/FormatString.hpp"
         "Helpers/SquareArray.hpp"
@@ -53,6 +54,7 @@ set(FLOUNDERENGINE_HEADERS_
         "Lights/Fog.hpp"
         "Lights/Light.hpp"
         "Materials/Material.hpp"
+        "Materials/MaterialTable.hpp"
         "Maths/Colour.hpp"
         "Maths/Constraint3.hpp"
         "Maths/Delta.hpp"
@@ -92,15 +94,19 @@ set(FLOUNDERENGINE_HEADERS_
         "Meshes/Animations/Skin/SkinLoader.hpp"
         "Meshes/Animations/Skin/VertexSkinData.hpp"
         "Meshes/Mesh.hpp"
-        "Models/IVertex.hpp"
+        "Models/Impostor.hpp"
+        "Models/MeshOptimizer.hpp"
         "Models/Model.hpp"
+        "Models/ModelBaked.hpp"
+        "Models/ModelPool.hpp"
+        "Models/ObjLoader.hpp"
         "Models/Shapes/MeshPattern.hpp"
         "Models/Shapes/MeshSimple.hpp"
         "Models/Shapes/ShapeCube.hpp"
         "Models/Shapes/ShapeRectangle.hpp"
         "Models/Shapes/ShapeSphere.hpp"
-        "Models/VertexModelData.hpp"
         "Models/VertexModel.hpp"
+        "Models/VertexModelQuantized.hpp"
         "Objects/Behaviour.hpp"
         "Objects/Component.hpp"
         "Objects/ComponentRegister.hpp"
@@ -126,6 +132,7 @@ set(FLOUNDERENGINE_HEADERS_
         "Physics/Rigidbody.hpp"
         "Physics/Space/ISpatialStructure.hpp"
         "Physics/Space/StructureBasic.hpp"
+        "Post/Deferred/LightClusters.hpp"
         "Post/Deferred/RendererDeferred.hpp"
         "Post/Deferred/UbosDeferred.hpp"
         "Post/Filters/FilterCrt.hpp"
@@ -147,16 +154,19 @@ set(FLOUNDERENGINE_HEADERS_
         "Prerequisites.hpp"
         "Renderer/Buffers/Buffer.hpp"
         "Renderer/Buffers/IndexBuffer.hpp"
+        "Renderer/Buffers/StorageBuffer.hpp"
         "Renderer/Buffers/UniformBuffer.hpp"
         "Renderer/Buffers/VertexBuffer.hpp"
         "Renderer/IManagerRender.hpp"
         "Renderer/IRenderer.hpp"
+        "Renderer/Pipelines/Compute.hpp"
         "Renderer/Pipelines/Descriptor.hpp"
         "Renderer/Pipelines/DescriptorSet.hpp"
         "Renderer/Pipelines/Pipeline.hpp"
         "Renderer/Pipelines/PipelineCreate.hpp"
         "Renderer/Pipelines/ShaderProgram.hpp"
         "Renderer/Queue/QueueFamily.hpp"
+        "Renderer/Queue/RenderQueue.hpp"
         "Renderer/Renderer.hpp"
         "Renderer/Renderpass/Renderpass.hpp"
         "Renderer/Renderpass/RenderpassCreate.hpp"
@@ -172,7 +182,7 @@ set(FLOUNDERENGINE_HEADERS_
         "Scenes/Scene.hpp"
         "Scenes/Scenes.hpp"
         "Shadows/RendererShadows.hpp"
-        "Shadows/ShadowBox.hpp"
+        "Shadows/ShadowCascade.hpp"
         "Shadows/ShadowRender.hpp"
         "Shadows/Shadows.hpp"
         "Shadows/UbosShadows.hpp"
@@ -183,14 +193,16 @@ set(FLOUNDERENGINE_HEADERS_
         "Sounds/Sound.hpp"
         "Sounds/SoundBuffer.hpp"
         "Tasks/Tasks.hpp"
-        "Terrains/LodBehaviour.hpp"
+        "Tasks/ThreadPool.hpp"
         "Terrains/MeshTerrain.hpp"
         "Terrains/RendererTerrains.hpp"
         "Terrains/TerrainRender.hpp"
         "Terrains/Terrains.hpp"
+        "Terrains/TerrainVertex.hpp"
         "Terrains/UbosTerrains.hpp"
         "Textures/Cubemap.hpp"
         "Textures/Texture.hpp"
+        "Textures/TextureArray.hpp"
         "Uis/InputButton.hpp"
         "Uis/InputDelay.hpp"
         "Uis/InputGrabber.hpp"
@@ -203,10 +215,17 @@ set(FLOUNDERENGINE_HEADERS_
         "Uis/UiStartLogo.hpp"
         "Voxels/Block.hpp"
         "Voxels/Chunk.hpp"
+        "Voxels/ChunkGenerator.hpp"
+        "Voxels/ChunkManager.hpp"
+        "Voxels/ChunkMesher.hpp"
+        "Voxels/ChunkStorage.hpp"
         "Voxels/Planet.hpp"
+        "Voxels/RegionFile.hpp"
         "Voxels/RendererVoxels.hpp"
         "Voxels/UbosVoxels.hpp"
         "Voxels/VoxelRender.hpp"
+        "Voxels/Voxels.hpp"
+        "Voxels/VoxelVertex.hpp"
         "Waters/MeshWater.hpp"
         "Waters/RendererWaters.hpp"
         "Waters/UbosWaters.hpp"
@@ -246,6 +265,7 @@ set(FLOUNDERENGINE_SOURCES_
         "Fonts/Word.cpp"
         "Guis/Gui.cpp"
         "Guis/RendererGuis.cpp"
+        "Helpers/FileMapped.cpp"
         "Helpers/FileSystem.cpp"
         "Helpers/FormatString.cpp"
         "Helpers/SquareArray.cpp"
@@ -259,6 +279,7 @@ set(FLOUNDERENGINE_SOURCES_
         "Lights/Fog.cpp"
         "Lights/Light.cpp"
         "Materials/Material.cpp"
+        "Materials/MaterialTable.cpp"
         "Maths/Colour.cpp"
         "Maths/Constraint3.cpp"
         "Maths/Delta.cpp"
@@ -296,14 +317,19 @@ set(FLOUNDERENGINE_SOURCES_
         "Meshes/Animations/Skin/SkinLoader.cpp"
         "Meshes/Animations/Skin/VertexSkinData.cpp"
         "Meshes/Mesh.cpp"
+        "Models/Impostor.cpp"
+        "Models/MeshOptimizer.cpp"
         "Models/Model.cpp"
+        "Models/ModelBaked.cpp"
+        "Models/ModelPool.cpp"
+        "Models/ObjLoader.cpp"
         "Models/Shapes/MeshPattern.cpp"
         "Models/Shapes/MeshSimple.cpp"
         "Models/Shapes/ShapeCube.cpp"
         "Models/Shapes/ShapeRectangle.cpp"
         "Models/Shapes/ShapeSphere.cpp"
-        "Models/VertexModelData.cpp"
         "Models/VertexModel.cpp"
+        "Models/VertexModelQuantized.cpp"
         "Objects/Behaviour.cpp"
         "Objects/Component.cpp"
         "Objects/ComponentRegister.cpp"
@@ -325,6 +351,7 @@ set(FLOUNDERENGINE_SOURCES_
         "Physics/Ray.cpp"
         "Physics/Rigidbody.cpp"
         "Physics/Space/StructureBasic.cpp"
+        "Post/Deferred/LightClusters.cpp"
         "Post/Deferred/RendererDeferred.cpp"
         "Post/Filters/FilterCrt.cpp"
         "Post/Filters/FilterDarken.cpp"
@@ -344,14 +371,17 @@ set(FLOUNDERENGINE_SOURCES_
         "Post/IPostPipeline.cpp"
         "Renderer/Buffers/Buffer.cpp"
         "Renderer/Buffers/IndexBuffer.cpp"
+        "Renderer/Buffers/StorageBuffer.cpp"
         "Renderer/Buffers/UniformBuffer.cpp"
         "Renderer/Buffers/VertexBuffer.cpp"
         "Renderer/IManagerRender.cpp"
+        "Renderer/Pipelines/Compute.cpp"
         "Renderer/Pipelines/Descriptor.cpp"
         "Renderer/Pipelines/DescriptorSet.cpp"
         "Renderer/Pipelines/Pipeline.cpp"
         "Renderer/Pipelines/ShaderProgram.cpp"
         "Renderer/Queue/QueueFamily.cpp"
+        "Renderer/Queue/RenderQueue.cpp"
         "Renderer/Renderer.cpp"
         "Renderer/Renderpass/Renderpass.cpp"
         "Renderer/RenderStage.cpp"
@@ -363,7 +393,7 @@ set(FLOUNDERENGINE_SOURCES_
         "Scenes/Scene.cpp"
         "Scenes/Scenes.cpp"
         "Shadows/RendererShadows.cpp"
-        "Shadows/ShadowBox.cpp"
+        "Shadows/ShadowCascade.cpp"
         "Shadows/ShadowRender.cpp"
         "Shadows/Shadows.cpp"
         "Skyboxes/CelestialBody.cpp"
@@ -372,13 +402,15 @@ set(FLOUNDERENGINE_SOURCES_
         "Sounds/Sound.cpp"
         "Sounds/SoundBuffer.cpp"
         "Tasks/Tasks.cpp"
-        "Terrains/LodBehaviour.cpp"
+        "Tasks/ThreadPool.cpp"
         "Terrains/MeshTerrain.cpp"
         "Terrains/RendererTerrains.cpp"
         "Terrains/TerrainRender.cpp"
         "Terrains/Terrains.cpp"
+        "Terrains/TerrainVertex.cpp"
         "Textures/Cubemap.cpp"
         "Textures/Texture.cpp"
+        "Textures/TextureArray.cpp"
         "Uis/InputButton.cpp"
         "Uis/InputDelay.cpp"
         "Uis/InputGrabber.cpp"
@@ -391,9 +423,16 @@ set(FLOUNDERENGINE_SOURCES_
         "Uis/UiStartLogo.cpp"
         "Voxels/Block.cpp"
         "Voxels/Chunk.cpp"
+        "Voxels/ChunkGenerator.cpp"
+        "Voxels/ChunkManager.cpp"
+        "Voxels/ChunkMesher.cpp"
+        "Voxels/ChunkStorage.cpp"
         "Voxels/Planet.cpp"
+        "Voxels/RegionFile.cpp"
         "Voxels/RendererVoxels.cpp"
         "Voxels/VoxelRender.cpp"
+        "Voxels/Voxels.cpp"
+        "Voxels/VoxelVertex.cpp"
         "Waters/MeshWater.cpp"
         "Waters/RendererWaters.cpp"
         "Waters/WaterRender.cpp"
@@ -558,6 +558,9 @@ namespace Flounder
 		physicalDeviceFeatures.shaderClipDistance = VK_TRUE;
 		physicalDeviceFeatures.shaderCullDistance = VK_TRUE;
 		physicalDeviceFeatures.fillModeNonSolid = VK_TRUE;
+		physicalDeviceFeatures.shaderSampledImageArrayDynamicIndexing = m_physicalDeviceFeatures.shaderSampledImageArrayDynamicIndexing;
+		physicalDeviceFeatures.multiDrawIndirect = m_physicalDeviceFeatures.multiDrawIndirect;
+		physicalDeviceFeatures.drawIndirectFirstInstance = m_physicalDeviceFeatures.drawIndirectFirstInstance;
 
 		VkDeviceCreateInfo deviceCreateInfo = {};
 		deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
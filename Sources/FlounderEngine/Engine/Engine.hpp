@@ -66,8 +66,8 @@ namespace Flounder
 		/// Gets a module instance by name.
 		/// </summary>
 		/// <param name="name"> The module name to find. </param>
-		/// <returns> The found module. </returns>
-		IModule *GetModule(const std::string &name) const { return m_updater->GetModule(name); }
+		/// <returns> The found module, or nullptr when no updater has been set, such as in command line tools. </returns>
+		IModule *GetModule(const std::string &name) const { return m_updater != nullptr ? m_updater->GetModule(name) : nullptr; }
 
 		/// <summary>
 		/// Gets the added/removed time for the engine (seconds).
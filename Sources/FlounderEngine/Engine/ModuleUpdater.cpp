@@ -12,6 +12,7 @@
 #include "../Shadows/Shadows.hpp"
 #include "../Terrains/Terrains.hpp"
 #include "../Uis/Uis.hpp"
+#include "../Voxels/Voxels.hpp"
 #include "../Waters/Waters.hpp"
 #include "../Worlds/Worlds.hpp"
 
@@ -66,6 +67,7 @@ namespace Flounder
 		ModuleCreate<Terrains>(UpdateNormal, "terrains");
 		ModuleCreate<Shadows>(UpdateNormal, "shadows");
 		ModuleCreate<Waters>(UpdatePre, "waters");
+		ModuleCreate<Voxels>(UpdatePre, "voxels");
 	}
 
 	void ModuleUpdater::Update()
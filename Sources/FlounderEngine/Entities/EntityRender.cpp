@@ -1,5 +1,7 @@
 #include "EntityRender.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include "../Devices/Display.hpp"
 #include "../Meshes/Mesh.hpp"
 #include "../Meshes/Animations/MeshAnimated.hpp"
@@ -15,7 +17,10 @@ namespace Flounder
 		Component(),
 		m_uniformObject(new UniformBuffer(sizeof(UbosEntities::UboObject))),
 		m_descriptorSet(nullptr),
-		m_nullTexture(Texture::Resource("Resources/Undefined.png"))
+		m_nullTexture(Texture::Resource("Resources/Undefined.png")),
+		m_lod(0),
+		m_impostorDistance(0.0f),
+		m_impostor(nullptr)
 	{
 	}
 
@@ -27,6 +32,14 @@ namespace Flounder
 
 	void EntityRender::Update()
 	{
+		// Impostors are baked as soon as the model is known, so entities do not stall a frame when they first move out of range.
+		auto mesh = GetGameObject()->GetComponent<Mesh>();
+
+		if (m_impostorDistance > 0.0f && mesh != nullptr && mesh->GetModel() != nullptr && (m_impostor == nullptr || m_impostor->GetModel() != mesh->GetModel()))
+		{
+			m_impostor = Impostor::Resource(mesh->GetModel());
+		}
+
 		auto material = GetGameObject()->GetComponent<Material>();
 
 		if (material == nullptr)
@@ -71,13 +84,20 @@ namespace Flounder
 
 	void EntityRender::Load(LoadedValue *value)
 	{
+		auto impostorDistance = value->GetChild("ImpostorDistance");
+
+		if (impostorDistance != nullptr)
+		{
+			m_impostorDistance = impostorDistance->Get<float>();
+		}
 	}
 
 	void EntityRender::Write(LoadedValue *value)
 	{
+		value->SetChild<float>("ImpostorDistance", m_impostorDistance);
 	}
 
-	void EntityRender::CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene)
+	void EntityRender::CmdRender(RenderQueue *renderQueue, const Pipeline &pipeline, UniformBuffer *uniformScene, const ICamera &camera)
 	{
 		// Gets required components.
 		auto mesh = GetGameObject()->GetComponent<Mesh>();
@@ -112,8 +132,54 @@ namespace Flounder
 		//	material->GetNormal()->GetTexture() == nullptr ? m_nullTexture : material->GetNormal()->GetTexture()
 		});
 
-		// Draws the object.
-		m_descriptorSet->BindDescriptor(commandBuffer);
-		mesh->GetModel()->CmdRender(commandBuffer);
+		// Queues the object, sorted by its view depth.
+		Vector4 viewPosition = Vector4();
+		Matrix4::Transform(*camera.GetViewMatrix(), Vector4(*GetGameObject()->GetTransform()->GetPosition()), &viewPosition);
+		const float depth = -viewPosition.m_z / camera.GetFarPlane();
+		const bool transparent = material->GetDiffuse()->GetBaseColor()->m_a < 1.0f;
+
+		Matrix4 worldMatrix = Matrix4();
+		GetGameObject()->GetTransform()->GetWorldMatrix(&worldMatrix);
+		const uint32_t lod = SelectLod(camera, worldMatrix);
+
+		renderQueue->Push(&pipeline, m_descriptorSet, mesh->GetModel(), material->GetDiffuse()->GetTexture(), depth, transparent, 1, 0, lod);
+	}
+
+	uint32_t EntityRender::SelectLod(const ICamera &camera, const Matrix4 &worldMatrix)
+	{
+		auto mesh = GetGameObject()->GetComponent<Mesh>();
+
+		if (mesh == nullptr || mesh->GetModel() == nullptr || mesh->GetModel()->GetLods().size() < 2)
+		{
+			m_lod = 0;
+			return m_lod;
+		}
+
+		// The models box is bounded by a world space sphere, at a distance d the view is 2 d / |projection[1][1]| high, the term is negative for Vulkans flipped y.
+		auto aabb = mesh->GetModel()->GetAabb();
+		auto scaling = GetGameObject()->GetTransform()->GetScaling();
+		Vector4 centre = Vector4();
+		Matrix4::Transform(worldMatrix, Vector4(aabb->GetCentreX(), aabb->GetCentreY(), aabb->GetCentreZ(), 1.0f), &centre);
+
+		const float radius = 0.5f * Vector3(aabb->GetWidth(), aabb->GetHeight(), aabb->GetDepth()).Length() *
+			std::max(std::fabs(scaling->m_x), std::max(std::fabs(scaling->m_y), std::fabs(scaling->m_z)));
+		const float distance = std::max(Vector3::GetDistance(Vector3(centre.m_x, centre.m_y, centre.m_z), *camera.GetPosition()), radius);
+		const float screenSize = radius * std::fabs(camera.GetProjectionMatrix()->m_11) / distance;
+
+		m_lod = mesh->GetModel()->SelectLod(screenSize, m_lod);
+		return m_lod;
+	}
+
+	Impostor *EntityRender::SelectImpostor(const ICamera &camera) const
+	{
+		auto mesh = GetGameObject()->GetComponent<Mesh>();
+
+		if (m_impostorDistance <= 0.0f || m_impostor == nullptr || m_impostor->GetAtlas() == nullptr || mesh == nullptr || mesh->GetModel() != m_impostor->GetModel())
+		{
+			return nullptr;
+		}
+
+		const float distance = Vector3::GetDistance(*GetGameObject()->GetTransform()->GetPosition(), *camera.GetPosition());
+		return distance > m_impostorDistance ? m_impostor : nullptr;
 	}
 }
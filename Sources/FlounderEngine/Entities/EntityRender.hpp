@@ -2,10 +2,13 @@
 
 #include <vector>
 #include "../Engine/Platform.hpp"
+#include "../Models/Impostor.hpp"
 #include "../Objects/Component.hpp"
 #include "../Objects/GameObject.hpp"
 #include "../Renderer/Pipelines/Pipeline.hpp"
 #include "../Renderer/Buffers/UniformBuffer.hpp"
+#include "../Renderer/Queue/RenderQueue.hpp"
+#include "../Scenes/ICamera.hpp"
 
 namespace Flounder
 {
@@ -19,6 +22,9 @@ namespace Flounder
 		UniformBuffer *m_uniformObject;
 		DescriptorSet *m_descriptorSet;
 		Texture *m_nullTexture;
+		uint32_t m_lod;
+		float m_impostorDistance;
+		Impostor *m_impostor;
 	public:
 		EntityRender();
 
@@ -30,10 +36,44 @@ namespace Flounder
 
 		void Write(LoadedValue *value) override;
 
-		void CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene);
+		/// <summary>
+		/// Updates the entities descriptors and adds its draw to a render queue.
+		/// </summary>
+		/// <param name="renderQueue"> The queue to add the draw to. </param>
+		/// <param name="pipeline"> The pipeline the entity is drawn with. </param>
+		/// <param name="uniformScene"> The scene uniform buffer. </param>
+		/// <param name="camera"> The camera, used to find the draws depth. </param>
+		void CmdRender(RenderQueue *renderQueue, const Pipeline &pipeline, UniformBuffer *uniformScene, const ICamera &camera);
+
+		/// <summary>
+		/// Selects the level of detail to draw the entities model at, from how much of the screen its bounding sphere covers.
+		/// The level is kept between calls, so the model only changes level once it is clearly past a threshold.
+		/// </summary>
+		/// <param name="camera"> The camera the entity is drawn from. </param>
+		/// <param name="worldMatrix"> The entities world matrix. </param>
+		/// <returns> The level of detail to draw. </returns>
+		uint32_t SelectLod(const ICamera &camera, const Matrix4 &worldMatrix);
+
+		/// <summary>
+		/// Gets the impostor to draw the entity with instead of its model, once it is further from the camera than the impostor distance.
+		/// </summary>
+		/// <param name="camera"> The camera the entity is drawn from. </param>
+		/// <returns> The impostor, or null if the model should be drawn. </returns>
+		Impostor *SelectImpostor(const ICamera &camera) const;
 
 		std::string GetName() const override { return "EntityRender"; };
 
 		UniformBuffer *GetUniformObject() const { return m_uniformObject; }
+
+		uint32_t GetLod() const { return m_lod; }
+
+		float GetImpostorDistance() const { return m_impostorDistance; }
+
+		/// <summary>
+		/// Sets the distance past which the entity is drawn as an impostor, the impostor is baked on the next update.
+		/// Impostors are only drawn by renderers with a material table, other renderers always draw the model.
+		/// </summary>
+		/// <param name="impostorDistance"> The impostor distance, or 0 to always draw the model. </param>
+		void SetImpostorDistance(const float &impostorDistance) { m_impostorDistance = impostorDistance; }
 	};
 }
@@ -1,26 +1,69 @@
 ﻿#include <Devices/Display.hpp>
 #include "RendererEntities.hpp"
 
+#include <cmath>
+#include <map>
+#include <tuple>
 #include "../Renderer/Renderer.hpp"
-#include "../Models/Model.hpp"
+#include "../Meshes/Mesh.hpp"
 #include "../Scenes/Scenes.hpp"
-#include "UbosEntities.hpp"
 #include "EntityRender.hpp"
 
 namespace Flounder
 {
-	RendererEntities::RendererEntities(const GraphicsStage &graphicsStage) :
+	RendererEntities::RendererEntities(const GraphicsStage &graphicsStage, const bool &gpuDriven) :
 		IRenderer(),
 		m_uniformScene(new UniformBuffer(sizeof(UbosEntities::UboScene))),
+		m_materialTable(MaterialTable::IsSupported() ? new MaterialTable() : nullptr),
 		m_pipeline(new Pipeline(graphicsStage, PipelineCreate({"Resources/Shaders/Entities/Entity.vert", "Resources/Shaders/Entities/Entity.frag"},
-			VertexModel::GetBindingDescriptions(), PIPELINE_MRT, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT), { })) // "ANIMATED", "COLOUR_MAPPING", "MATERIAL_MAPPING", "NORMAL_MAPPING"
+			VertexModel::GetBindingDescriptions(), PIPELINE_MRT, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT),
+			m_materialTable != nullptr ? std::vector<std::string>{"BINDLESS"} : std::vector<std::string>{})), // "ANIMATED", "COLOUR_MAPPING", "MATERIAL_MAPPING", "NORMAL_MAPPING"
+		m_renderQueue(new RenderQueue()),
+		m_objectBuffer(m_materialTable != nullptr ? new StorageBuffer(sizeof(UbosEntities::Object) * MAX_OBJECTS) : nullptr),
+		m_descriptorSet(nullptr),
+		m_textureVersion(0),
+		m_objects(std::vector<UbosEntities::Object>()),
+		m_gpuDriven(gpuDriven && m_materialTable != nullptr && Display::Get()->GetPhysicalDeviceFeatures().drawIndirectFirstInstance),
+		m_compute(m_gpuDriven ? new Compute("Resources/Shaders/Entities/Cull.comp") : nullptr),
+		m_modelPool(m_gpuDriven ? new ModelPool() : nullptr),
+		m_uniformCull(m_gpuDriven ? new UniformBuffer(sizeof(UbosEntities::UboCull)) : nullptr),
+		m_drawBuffer(m_gpuDriven ? new StorageBuffer(sizeof(UbosEntities::Draw) * MAX_OBJECTS) : nullptr),
+		m_indirectBuffer(m_gpuDriven ? new StorageBuffer(sizeof(VkDrawIndexedIndirectCommand) * MAX_OBJECTS, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT) : nullptr),
+		m_cullDescriptorSet(nullptr),
+		m_culled(false),
+		m_draws(std::vector<UbosEntities::Draw>()),
+		m_drawModels(std::vector<Model *>()),
+		m_drawLods(std::vector<uint32_t>()),
+		m_impostorPipeline(m_materialTable != nullptr ? new Pipeline(graphicsStage, PipelineCreate({"Resources/Shaders/Entities/Impostor.vert", "Resources/Shaders/Entities/Impostor.frag"},
+			std::vector<VkVertexInputBindingDescription>(), PIPELINE_MRT, VK_POLYGON_MODE_FILL, VK_CULL_MODE_NONE)) : nullptr),
+		m_impostorBuffer(m_materialTable != nullptr ? new StorageBuffer(sizeof(UbosEntities::ImpostorObject) * MAX_OBJECTS) : nullptr),
+		m_impostorDescriptorSet(nullptr),
+		m_impostorTextureVersion(0),
+		m_impostorBatches(std::map<std::tuple<Impostor *, Texture *, Texture *>, std::vector<UbosEntities::ImpostorObject>>()),
+		m_impostorObjects(std::vector<UbosEntities::ImpostorObject>())
 	{
 	}
 
 	RendererEntities::~RendererEntities()
 	{
 		delete m_uniformScene;
+		delete m_materialTable;
 		delete m_pipeline;
+		delete m_renderQueue;
+
+		delete m_objectBuffer;
+		delete m_descriptorSet;
+
+		delete m_cullDescriptorSet;
+		delete m_indirectBuffer;
+		delete m_drawBuffer;
+		delete m_uniformCull;
+		delete m_modelPool;
+		delete m_compute;
+
+		delete m_impostorPipeline;
+		delete m_impostorBuffer;
+		delete m_impostorDescriptorSet;
 	}
 
 	void RendererEntities::Render(const VkCommandBuffer &commandBuffer, const Vector4 &clipPlane, const ICamera &camera)
@@ -30,14 +73,371 @@ namespace Flounder
 		uboScene.view = *camera.GetViewMatrix();
 		m_uniformScene->Update(&uboScene);
 
-		m_pipeline->BindPipeline(commandBuffer);
+		// The indirect draws are only ready when culling was dispatched before the render pass.
+		if (m_culled)
+		{
+			CmdIndirect(commandBuffer);
+		}
+		else if (m_materialTable != nullptr)
+		{
+			QueueBindless(camera);
+		}
+		else
+		{
+			std::vector<EntityRender *> renderList = std::vector<EntityRender *>();
+			Scenes::Get()->GetStructure()->QueryComponents<EntityRender>(&renderList);
+
+			for (auto entityRender : renderList)
+			{
+				entityRender->CmdRender(m_renderQueue, *m_pipeline, m_uniformScene, camera);
+			}
+		}
+
+		if (m_impostorPipeline != nullptr)
+		{
+			CmdImpostors(commandBuffer);
+		}
+
+		m_renderQueue->CmdRender(commandBuffer);
+		m_culled = false;
+	}
+
+	void RendererEntities::RenderPrepass(const VkCommandBuffer &commandBuffer, const ICamera &camera)
+	{
+		if (!m_gpuDriven)
+		{
+			return;
+		}
+
+		QueueIndirect(camera);
+		CmdCull(commandBuffer);
+		m_culled = true;
+	}
+
+	void RendererEntities::QueueBindless(const ICamera &camera)
+	{
+		if (m_descriptorSet == nullptr)
+		{
+			m_descriptorSet = new DescriptorSet(*m_pipeline);
+		}
+
+		std::vector<EntityRender *> renderList = std::vector<EntityRender *>();
+		Scenes::Get()->GetStructure()->QueryComponents<EntityRender>(&renderList);
+
+		m_materialTable->Clear();
+		m_objects.clear();
+		m_impostorBatches.clear();
+
+		// Opaque entities with the same model, level of detail and textures become one instanced draw, transparent entities are drawn alone to keep their order.
+		std::map<std::tuple<Model *, uint32_t, Texture *, Texture *, Texture *>, uint32_t> batchIndices = {};
+		std::vector<Batch> batches = {};
+		Vector4 viewPosition = Vector4();
+
+		for (auto entityRender : renderList)
+		{
+			auto mesh = entityRender->GetGameObject()->GetComponent<Mesh>();
+			auto material = entityRender->GetGameObject()->GetComponent<Material>();
+
+			if (mesh == nullptr || mesh->GetModel() == nullptr || material == nullptr)
+			{
+				continue;
+			}
+
+			UbosEntities::Object object = {};
+			entityRender->GetGameObject()->GetTransform()->GetWorldMatrix(&object.transform);
+			object.material = static_cast<int32_t>(m_materialTable->Add(material));
+
+			if (QueueImpostor(entityRender, material, object, camera))
+			{
+				continue;
+			}
+
+			Matrix4::Transform(*camera.GetViewMatrix(), Vector4(*entityRender->GetGameObject()->GetTransform()->GetPosition()), &viewPosition);
+			const float depth = -viewPosition.m_z / camera.GetFarPlane();
+			const bool transparent = material->GetDiffuse()->GetBaseColor()->m_a < 1.0f;
+			const uint32_t lod = entityRender->SelectLod(camera, object.transform);
+			uint32_t batchIndex = static_cast<uint32_t>(batches.size());
+
+			if (!transparent)
+			{
+				auto key = std::make_tuple(mesh->GetModel(), lod, material->GetDiffuse()->GetTexture(), material->GetSurface()->GetTexture(), material->GetNormal()->GetTexture());
+				batchIndex = batchIndices.emplace(key, batchIndex).first->second;
+			}
+
+			if (batchIndex == batches.size())
+			{
+				batches.push_back({mesh->GetModel(), lod, material->GetDiffuse()->GetTexture(), depth, transparent, {}});
+			}
+
+			Batch &batch = batches.at(batchIndex);
+			batch.depth = std::min(batch.depth, depth);
+			batch.objects.push_back(object);
+		}
+
+		// Each batch owns a contiguous range of objects, found from gl_InstanceIndex in the shader.
+		for (auto &batch : batches)
+		{
+			const uint32_t firstInstance = static_cast<uint32_t>(m_objects.size());
+			const uint32_t instances = std::min(static_cast<uint32_t>(batch.objects.size()), MAX_OBJECTS - firstInstance);
+
+			if (instances == 0)
+			{
+				break;
+			}
+
+			m_objects.insert(m_objects.end(), batch.objects.begin(), batch.objects.begin() + instances);
+			m_renderQueue->Push(m_pipeline, m_descriptorSet, batch.model, batch.texture, batch.depth, batch.transparent, instances, firstInstance, batch.lod);
+		}
+
+		m_materialTable->Update();
+		m_objectBuffer->Update(m_objects.data(), 0, sizeof(UbosEntities::Object) * m_objects.size());
+
+		// New textures in the array are only written when the array has changed.
+		if (m_textureVersion != m_materialTable->GetTextures()->GetVersion())
+		{
+			m_descriptorSet->Invalidate();
+			m_textureVersion = m_materialTable->GetTextures()->GetVersion();
+		}
+
+		m_descriptorSet->Update({
+			m_uniformScene,
+			m_objectBuffer,
+			m_materialTable->GetBuffer(),
+			m_materialTable->GetTextures()
+		});
+	}
+
+	void RendererEntities::QueueIndirect(const ICamera &camera)
+	{
+		if (m_descriptorSet == nullptr)
+		{
+			m_descriptorSet = new DescriptorSet(*m_pipeline);
+			m_cullDescriptorSet = new DescriptorSet(*m_compute);
+		}
 
 		std::vector<EntityRender *> renderList = std::vector<EntityRender *>();
 		Scenes::Get()->GetStructure()->QueryComponents<EntityRender>(&renderList);
 
+		m_materialTable->Clear();
+		m_objects.clear();
+		m_draws.clear();
+		m_drawModels.clear();
+		m_drawLods.clear();
+		m_impostorBatches.clear();
+
+		Vector4 centre = Vector4();
+		Vector4 viewPosition = Vector4();
+
 		for (auto entityRender : renderList)
 		{
-			entityRender->CmdRender(commandBuffer, *m_pipeline, m_uniformScene);
+			auto mesh = entityRender->GetGameObject()->GetComponent<Mesh>();
+			auto material = entityRender->GetGameObject()->GetComponent<Material>();
+
+			if (mesh == nullptr || mesh->GetModel() == nullptr || material == nullptr || m_objects.size() >= MAX_OBJECTS)
+			{
+				continue;
+			}
+
+			UbosEntities::Object object = {};
+			entityRender->GetGameObject()->GetTransform()->GetWorldMatrix(&object.transform);
+			object.material = static_cast<int32_t>(m_materialTable->Add(material));
+
+			if (QueueImpostor(entityRender, material, object, camera))
+			{
+				continue;
+			}
+
+			const uint32_t objectIndex = static_cast<uint32_t>(m_objects.size());
+			const uint32_t lod = entityRender->SelectLod(camera, object.transform);
+			m_objects.push_back(object);
+
+			// Blended entities still need a back to front order, so they stay on the render queue.
+			if (material->GetDiffuse()->GetBaseColor()->m_a < 1.0f || m_modelPool->GetRange(mesh->GetModel()) == nullptr)
+			{
+				Matrix4::Transform(*camera.GetViewMatrix(), Vector4(*entityRender->GetGameObject()->GetTransform()->GetPosition()), &viewPosition);
+				const float depth = -viewPosition.m_z / camera.GetFarPlane();
+				m_renderQueue->Push(m_pipeline, m_descriptorSet, mesh->GetModel(), material->GetDiffuse()->GetTexture(), depth,
+					material->GetDiffuse()->GetBaseColor()->m_a < 1.0f, 1, objectIndex, lod);
+				continue;
+			}
+
+			// The culling shader tests a world space bounding sphere around the models box.
+			auto aabb = mesh->GetModel()->GetAabb();
+			auto scaling = entityRender->GetGameObject()->GetTransform()->GetScaling();
+			Matrix4::Transform(object.transform, Vector4(aabb->GetCentreX(), aabb->GetCentreY(), aabb->GetCentreZ(), 1.0f), &centre);
+
+			UbosEntities::Draw draw = {};
+			draw.sphere = Vector4(centre.m_x, centre.m_y, centre.m_z, 0.5f * Vector3(aabb->GetWidth(), aabb->GetHeight(), aabb->GetDepth()).Length() *
+				std::max(std::fabs(scaling->m_x), std::max(std::fabs(scaling->m_y), std::fabs(scaling->m_z))));
+			draw.object = objectIndex;
+			m_draws.push_back(draw);
+			m_drawModels.push_back(mesh->GetModel());
+			m_drawLods.push_back(lod);
+		}
+
+		// Ranges are only final once the pool has packed any new models.
+		m_modelPool->Update();
+
+		// Levels of detail are ranges of a models indices, so they are offset into the models range.
+		for (uint32_t i = 0; i < m_draws.size(); i++)
+		{
+			ModelPool::Range *range = m_modelPool->GetRange(m_drawModels.at(i));
+			const MeshLod &lod = m_drawModels.at(i)->GetLods().at(m_drawLods.at(i));
+			m_draws.at(i).firstIndex = range->firstIndex + lod.firstIndex;
+			m_draws.at(i).indexCount = lod.indexCount;
+			m_draws.at(i).vertexOffset = range->vertexOffset;
+		}
+
+		UbosEntities::UboCull uboCull = {};
+		float **frustum = camera.GetViewFrustum()->GetFrustum();
+
+		for (int i = 0; i < 6; i++)
+		{
+			uboCull.frustum[i] = Vector4(frustum[i][FrustumA], frustum[i][FrustumB], frustum[i][FrustumC], frustum[i][FrustumD]);
+		}
+
+		uboCull.drawCount = static_cast<uint32_t>(m_draws.size());
+
+		m_uniformCull->Update(&uboCull);
+		m_drawBuffer->Update(m_draws.data(), 0, sizeof(UbosEntities::Draw) * m_draws.size());
+		m_materialTable->Update();
+		m_objectBuffer->Update(m_objects.data(), 0, sizeof(UbosEntities::Object) * m_objects.size());
+
+		if (m_textureVersion != m_materialTable->GetTextures()->GetVersion())
+		{
+			m_descriptorSet->Invalidate();
+			m_textureVersion = m_materialTable->GetTextures()->GetVersion();
+		}
+
+		m_descriptorSet->Update({
+			m_uniformScene,
+			m_objectBuffer,
+			m_materialTable->GetBuffer(),
+			m_materialTable->GetTextures()
+		});
+		m_cullDescriptorSet->Update({
+			m_uniformCull,
+			m_drawBuffer,
+			m_indirectBuffer
+		});
+	}
+
+	void RendererEntities::CmdIndirect(const VkCommandBuffer &commandBuffer)
+	{
+		// Draws every opaque entity from the shared buffers, culled draws have no instances.
+		if (!m_draws.empty())
+		{
+			m_pipeline->BindPipeline(commandBuffer);
+			m_descriptorSet->BindDescriptor(commandBuffer);
+			m_modelPool->CmdBind(commandBuffer);
+
+			if (Display::Get()->GetPhysicalDeviceFeatures().multiDrawIndirect)
+			{
+				vkCmdDrawIndexedIndirect(commandBuffer, m_indirectBuffer->GetBuffer(), 0, static_cast<uint32_t>(m_draws.size()), sizeof(VkDrawIndexedIndirectCommand));
+			}
+			else
+			{
+				for (uint32_t i = 0; i < m_draws.size(); i++)
+				{
+					vkCmdDrawIndexedIndirect(commandBuffer, m_indirectBuffer->GetBuffer(), i * sizeof(VkDrawIndexedIndirectCommand), 1, sizeof(VkDrawIndexedIndirectCommand));
+				}
+			}
+		}
+	}
+
+	void RendererEntities::CmdCull(const VkCommandBuffer &commandBuffer)
+	{
+		// Compute can not run inside the render pass, so culling is recorded into the frame before the render pass begins.
+		m_compute->BindPipeline(commandBuffer);
+		m_cullDescriptorSet->BindDescriptor(commandBuffer);
+		m_compute->CmdDispatch(commandBuffer, static_cast<uint32_t>(m_draws.size()), 64);
+
+		VkMemoryBarrier memoryBarrier = {};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+	}
+
+	bool RendererEntities::QueueImpostor(EntityRender *entityRender, Material *material, const UbosEntities::Object &object, const ICamera &camera)
+	{
+		// Blended entities keep their model, impostors are drawn with the opaque entities.
+		if (m_impostorPipeline == nullptr || material->GetDiffuse()->GetBaseColor()->m_a < 1.0f)
+		{
+			return false;
+		}
+
+		Impostor *impostor = entityRender->SelectImpostor(camera);
+
+		if (impostor == nullptr)
+		{
+			return false;
+		}
+
+		UbosEntities::ImpostorObject impostorObject = {};
+		impostorObject.transform = object.transform;
+		impostorObject.sphere = Vector4(impostor->GetCentre().m_x, impostor->GetCentre().m_y, impostor->GetCentre().m_z, impostor->GetRadius());
+		impostorObject.material = object.material;
+		impostorObject.atlas = static_cast<int32_t>(m_materialTable->GetTextures()->Add(impostor->GetAtlas()));
+
+		// Instances of a draw have to share their atlas and textures, so the sampler array is indexed uniformly.
+		auto key = std::make_tuple(impostor, material->GetDiffuse()->GetTexture(), material->GetSurface()->GetTexture());
+		m_impostorBatches[key].push_back(impostorObject);
+		return true;
+	}
+
+	void RendererEntities::CmdImpostors(const VkCommandBuffer &commandBuffer)
+	{
+		if (m_impostorBatches.empty())
+		{
+			return;
+		}
+
+		if (m_impostorDescriptorSet == nullptr)
+		{
+			m_impostorDescriptorSet = new DescriptorSet(*m_impostorPipeline);
+		}
+
+		m_impostorObjects.clear();
+
+		for (auto &batch : m_impostorBatches)
+		{
+			const size_t instances = std::min(batch.second.size(), MAX_OBJECTS - m_impostorObjects.size());
+			m_impostorObjects.insert(m_impostorObjects.end(), batch.second.begin(), batch.second.begin() + instances);
+		}
+
+		m_impostorBuffer->Update(m_impostorObjects.data(), 0, sizeof(UbosEntities::ImpostorObject) * m_impostorObjects.size());
+
+		if (m_impostorTextureVersion != m_materialTable->GetTextures()->GetVersion())
+		{
+			m_impostorDescriptorSet->Invalidate();
+			m_impostorTextureVersion = m_materialTable->GetTextures()->GetVersion();
+		}
+
+		m_impostorDescriptorSet->Update({
+			m_uniformScene,
+			m_impostorBuffer,
+			m_materialTable->GetBuffer(),
+			m_materialTable->GetTextures()
+		});
+
+		m_impostorPipeline->BindPipeline(commandBuffer);
+		m_impostorDescriptorSet->BindDescriptor(commandBuffer);
+
+		// Each batch is one instanced draw of a quad, its quads are built in the vertex shader so there are no buffers to bind.
+		uint32_t firstInstance = 0;
+
+		for (auto &batch : m_impostorBatches)
+		{
+			const uint32_t instances = std::min(static_cast<uint32_t>(batch.second.size()), static_cast<uint32_t>(m_impostorObjects.size()) - firstInstance);
+
+			if (instances == 0)
+			{
+				break;
+			}
+
+			vkCmdDraw(commandBuffer, 6, instances, 0, firstInstance);
+			firstInstance += instances;
 		}
 	}
 }
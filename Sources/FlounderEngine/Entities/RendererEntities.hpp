@@ -1,22 +1,113 @@
 ﻿#pragma once
 
+#include <map>
+#include <tuple>
+#include "../Materials/MaterialTable.hpp"
+#include "../Models/Impostor.hpp"
+#include "../Models/Model.hpp"
+#include "../Models/ModelPool.hpp"
 #include "../Renderer/IRenderer.hpp"
+#include "../Renderer/Buffers/StorageBuffer.hpp"
 #include "../Renderer/Buffers/UniformBuffer.hpp"
+#include "../Renderer/Pipelines/Compute.hpp"
 #include "../Renderer/Pipelines/Pipeline.hpp"
+#include "../Renderer/Queue/RenderQueue.hpp"
+#include "UbosEntities.hpp"
 
 namespace Flounder
 {
+	class EntityRender;
+
 	class F_EXPORT RendererEntities :
 		public IRenderer
 	{
 	private:
+		struct Batch
+		{
+			Model *model;
+			uint32_t lod;
+			Texture *texture;
+			float depth;
+			bool transparent;
+			std::vector<UbosEntities::Object> objects;
+		};
+
 		UniformBuffer *m_uniformScene;
+		MaterialTable *m_materialTable;
 		Pipeline *m_pipeline;
+		RenderQueue *m_renderQueue;
+
+		StorageBuffer *m_objectBuffer;
+		DescriptorSet *m_descriptorSet;
+		uint32_t m_textureVersion;
+		std::vector<UbosEntities::Object> m_objects;
+
+		bool m_gpuDriven;
+		Compute *m_compute;
+		ModelPool *m_modelPool;
+		UniformBuffer *m_uniformCull;
+		StorageBuffer *m_drawBuffer;
+		StorageBuffer *m_indirectBuffer;
+		DescriptorSet *m_cullDescriptorSet;
+		bool m_culled;
+		std::vector<UbosEntities::Draw> m_draws;
+		std::vector<Model *> m_drawModels;
+		std::vector<uint32_t> m_drawLods;
+
+		Pipeline *m_impostorPipeline;
+		StorageBuffer *m_impostorBuffer;
+		DescriptorSet *m_impostorDescriptorSet;
+		uint32_t m_impostorTextureVersion;
+		std::map<std::tuple<Impostor *, Texture *, Texture *>, std::vector<UbosEntities::ImpostorObject>> m_impostorBatches;
+		std::vector<UbosEntities::ImpostorObject> m_impostorObjects;
 	public:
-		RendererEntities(const GraphicsStage &graphicsStage);
+		/// <summary>
+		/// Creates a new entity renderer.
+		/// </summary>
+		/// <param name="graphicsStage"> The graphics stage the entities are drawn in. </param>
+		/// <param name="gpuDriven"> If opaque entities should be culled by a compute shader and drawn from one indirect draw, this is ignored when the device can not support it. </param>
+		RendererEntities(const GraphicsStage &graphicsStage, const bool &gpuDriven = false);
 
 		~RendererEntities();
 
 		void Render(const VkCommandBuffer &commandBuffer, const Vector4 &clipPlane, const ICamera &camera) override;
+
+		/// <summary>
+		/// Builds the frames indirect draws and records their culling dispatch, when the renderer is gpu driven.
+		/// Frames without a prepass fall back to the bindless draws.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer the render pass will be recorded into. </param>
+		/// <param name="camera"> The camera to be used when rendering. </param>
+		void RenderPrepass(const VkCommandBuffer &commandBuffer, const ICamera &camera) override;
+
+		RenderQueue *GetRenderQueue() const { return m_renderQueue; }
+
+		/// <summary>
+		/// Gets the material table, this is null when the device falls back to a descriptor set per entity.
+		/// </summary>
+		/// <returns> The material table. </returns>
+		MaterialTable *GetMaterialTable() const { return m_materialTable; }
+
+		bool IsGpuDriven() const { return m_gpuDriven; }
+	private:
+		void QueueBindless(const ICamera &camera);
+
+		void QueueIndirect(const ICamera &camera);
+
+		void CmdCull(const VkCommandBuffer &commandBuffer);
+
+		void CmdIndirect(const VkCommandBuffer &commandBuffer);
+
+		/// <summary>
+		/// Queues the entity as an impostor if it is far enough away, impostors are only drawn when there is a material table.
+		/// </summary>
+		/// <param name="entityRender"> The entity. </param>
+		/// <param name="material"> The entities material. </param>
+		/// <param name="object"> The entities object, with its transform and material index. </param>
+		/// <param name="camera"> The camera the entity is drawn from. </param>
+		/// <returns> If the entity is drawn as an impostor instead of its model. </returns>
+		bool QueueImpostor(EntityRender *entityRender, Material *material, const UbosEntities::Object &object, const ICamera &camera);
+
+		void CmdImpostors(const VkCommandBuffer &commandBuffer);
 	};
 }
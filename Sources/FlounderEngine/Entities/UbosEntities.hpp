@@ -12,6 +12,7 @@ namespace Flounder
 	public:
 #define MAX_JOINTS 50
 #define MAX_WEIGHTS 3
+#define MAX_OBJECTS 4096
 
 		struct UboScene
 		{
@@ -31,5 +32,36 @@ namespace Flounder
 			float ignoreFog;
 			float ignoreLighting;
 		};
+
+		struct Object
+		{
+			Matrix4 transform;
+			int32_t material;
+			int32_t padding[3];
+		};
+
+		struct ImpostorObject
+		{
+			Matrix4 transform;
+			Vector4 sphere; // The models bounding sphere in model space.
+			int32_t material;
+			int32_t atlas;
+			int32_t padding[2];
+		};
+
+		struct UboCull
+		{
+			Vector4 frustum[6];
+			uint32_t drawCount;
+		};
+
+		struct Draw
+		{
+			Vector4 sphere;
+			uint32_t firstIndex;
+			uint32_t indexCount;
+			int32_t vertexOffset;
+			uint32_t object;
+		};
 	};
 }
@@ -43,6 +43,7 @@
 #include "Guis/Gui.hpp"
 #include "Guis/RendererGuis.hpp"
 #include "Guis/UbosGuis.hpp"
+#include "Helpers/FileMapped.hpp"
 #include "Helpers/FileSystem.hpp"
 #include "Helpers/FormatString.hpp"
 #include "Helpers/SquareArray.hpp"
@@ -58,6 +59,7 @@
 #include "Lights/Fog.hpp"
 #include "Lights/Light.hpp"
 #include "Materials/Material.hpp"
+#include "Materials/MaterialTable.hpp"
 #include "Maths/Colour.hpp"
 #include "Maths/Constraint3.hpp"
 #include "Maths/Delta.hpp"
@@ -95,15 +97,19 @@
 #include "Meshes/Animations/Skeleton/SkeletonLoader.hpp"
 #include "Meshes/Animations/Skin/SkinLoader.hpp"
 #include "Meshes/Mesh.hpp"
-#include "Models/IVertex.hpp"
+#include "Models/Impostor.hpp"
+#include "Models/MeshOptimizer.hpp"
 #include "Models/Model.hpp"
+#include "Models/ModelBaked.hpp"
+#include "Models/ModelPool.hpp"
+#include "Models/ObjLoader.hpp"
 #include "Models/Shapes/MeshPattern.hpp"
 #include "Models/Shapes/MeshSimple.hpp"
 #include "Models/Shapes/ShapeCube.hpp"
 #include "Models/Shapes/ShapeRectangle.hpp"
 #include "Models/Shapes/ShapeSphere.hpp"
-#include "Models/VertexModelData.hpp"
 #include "Models/VertexModel.hpp"
+#include "Models/VertexModelQuantized.hpp"
 #include "Objects/Behaviour.hpp"
 #include "Objects/Component.hpp"
 #include "Objects/ComponentRegister.hpp"
@@ -129,6 +135,7 @@
 #include "Physics/Rigidbody.hpp"
 #include "Physics/Space/ISpatialStructure.hpp"
 #include "Physics/Space/StructureBasic.hpp"
+#include "Post/Deferred/LightClusters.hpp"
 #include "Post/Deferred/RendererDeferred.hpp"
 #include "Post/Deferred/UbosDeferred.hpp"
 #include "Post/Filters/FilterCrt.hpp"
@@ -150,15 +157,18 @@
 #include "Prerequisites.hpp"
 #include "Renderer/Buffers/Buffer.hpp"
 #include "Renderer/Buffers/IndexBuffer.hpp"
+#include "Renderer/Buffers/StorageBuffer.hpp"
 #include "Renderer/Buffers/UniformBuffer.hpp"
 #include "Renderer/Buffers/VertexBuffer.hpp"
 #include "Renderer/IManagerRender.hpp"
 #include "Renderer/IRenderer.hpp"
+#include "Renderer/Pipelines/Compute.hpp"
 #include "Renderer/Pipelines/Descriptor.hpp"
 #include "Renderer/Pipelines/DescriptorSet.hpp"
 #include "Renderer/Pipelines/Pipeline.hpp"
 #include "Renderer/Pipelines/PipelineCreate.hpp"
 #include "Renderer/Queue/QueueFamily.hpp"
+#include "Renderer/Queue/RenderQueue.hpp"
 #include "Renderer/Renderer.hpp"
 #include "Renderer/Renderpass/Renderpass.hpp"
 #include "Renderer/Renderpass/RenderpassCreate.hpp"
@@ -174,7 +184,7 @@
 #include "Scenes/Scene.hpp"
 #include "Scenes/Scenes.hpp"
 #include "Shadows/RendererShadows.hpp"
-#include "Shadows/ShadowBox.hpp"
+#include "Shadows/ShadowCascade.hpp"
 #include "Shadows/ShadowRender.hpp"
 #include "Shadows/Shadows.hpp"
 #include "Shadows/UbosShadows.hpp"
@@ -185,14 +195,16 @@
 #include "Sounds/Sound.hpp"
 #include "Sounds/SoundBuffer.hpp"
 #include "Tasks/Tasks.hpp"
-#include "Terrains/LodBehaviour.hpp"
+#include "Tasks/ThreadPool.hpp"
 #include "Terrains/MeshTerrain.hpp"
 #include "Terrains/RendererTerrains.hpp"
 #include "Terrains/TerrainRender.hpp"
 #include "Terrains/Terrains.hpp"
+#include "Terrains/TerrainVertex.hpp"
 #include "Terrains/UbosTerrains.hpp"
 #include "Textures/Cubemap.hpp"
 #include "Textures/Texture.hpp"
+#include "Textures/TextureArray.hpp"
 #include "Uis/InputButton.hpp"
 #include "Uis/InputDelay.hpp"
 #include "Uis/InputGrabber.hpp"
@@ -205,10 +217,17 @@
 #include "Uis/UiStartLogo.hpp"
 #include "Voxels/Block.hpp"
 #include "Voxels/Chunk.hpp"
+#include "Voxels/ChunkGenerator.hpp"
+#include "Voxels/ChunkManager.hpp"
+#include "Voxels/ChunkMesher.hpp"
+#include "Voxels/ChunkStorage.hpp"
 #include "Voxels/Planet.hpp"
+#include "Voxels/RegionFile.hpp"
 #include "Voxels/RendererVoxels.hpp"
 #include "Voxels/UbosVoxels.hpp"
 #include "Voxels/VoxelRender.hpp"
+#include "Voxels/Voxels.hpp"
+#include "Voxels/VoxelVertex.hpp"
 #include "Waters/MeshWater.hpp"
 #include "Waters/RendererWaters.hpp"
 #include "Waters/UbosWaters.hpp"
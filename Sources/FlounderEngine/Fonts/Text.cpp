@@ -186,7 +186,7 @@ namespace Flounder
 	{
 		// Creates mesh data.
 		std::vector<Line> lines = CreateStructure(object);
-		std::vector<IVertex*> vertices = CreateQuad(object, lines);
+		std::vector<VertexModel> vertices = CreateQuad(object, lines);
 
 		// Calculates the bounds and normalizes the vertices.
 		Vector2 bounding = Vector2();
@@ -267,9 +267,9 @@ namespace Flounder
 		lines.push_back(currentLine);
 	}
 
-	std::vector<IVertex*> Text::CreateQuad(Text *object, std::vector<Line> lines)
+	std::vector<VertexModel> Text::CreateQuad(Text *object, std::vector<Line> lines)
 	{
-		std::vector<IVertex*> vertices = std::vector<IVertex*>();
+		std::vector<VertexModel> vertices = std::vector<VertexModel>();
 		//	object->m_numberLines = static_cast<int>(lines.size());
 		double cursorX = 0.0;
 		double cursorY = 0.0;
@@ -319,7 +319,7 @@ namespace Flounder
 		return vertices;
 	}
 
-	void Text::AddVerticesForCharacter(const double &cursorX, const double &cursorY, const Character &character, std::vector<IVertex*> &vertices)
+	void Text::AddVerticesForCharacter(const double &cursorX, const double &cursorY, const Character &character, std::vector<VertexModel> &vertices)
 	{
 		const double vertexX = cursorX + character.GetOffsetX();
 		const double vertexY = cursorY + character.GetOffsetY();
@@ -339,22 +339,21 @@ namespace Flounder
 		AddVertex(vertexX, vertexY, textureX, textureY, vertices);
 	}
 
-	void Text::AddVertex(const double &vx, const double &vy, const double &tx, const double &ty, std::vector<IVertex*> &vertices)
+	void Text::AddVertex(const double &vx, const double &vy, const double &tx, const double &ty, std::vector<VertexModel> &vertices)
 	{
-		IVertex *vertex = new VertexModel(Vector3(static_cast<float>(vx), static_cast<float>(vy), 0.0f), Vector2(static_cast<float>(tx), static_cast<float>(ty)));
-		vertices.push_back(vertex);
+		vertices.emplace_back(Vector3(static_cast<float>(vx), static_cast<float>(vy), 0.0f), Vector2(static_cast<float>(tx), static_cast<float>(ty)));
 	}
 
-	void Text::NormalizeQuad(Vector2 *bounding, std::vector<IVertex*> &vertices)
+	void Text::NormalizeQuad(Vector2 *bounding, std::vector<VertexModel> &vertices)
 	{
 		float minX = +INFINITY;
 		float minY = +INFINITY;
 		float maxX = -INFINITY;
 		float maxY = -INFINITY;
 
-		for (auto vertex : vertices)
+		for (const auto &vertex : vertices)
 		{
-			const Vector3 position = vertex->GetPosition();
+			const Vector3 position = vertex.m_position;
 
 			if (position.m_x < minX)
 			{
@@ -381,10 +380,9 @@ namespace Flounder
 		maxX -= minX;
 		maxY -= minY;
 
-		for (auto vertex : vertices)
+		for (auto &vertex : vertices)
 		{
-			Vector3 position = Vector3((vertex->GetPosition().m_x - minX) / maxX, (vertex->GetPosition().m_y - minY) / maxY, 0.0f);
-			vertex->SetPosition(position);
+			vertex.m_position = Vector3((vertex.m_position.m_x - minX) / maxX, (vertex.m_position.m_y - minY) / maxY, 0.0f);
 		}
 	}
 }
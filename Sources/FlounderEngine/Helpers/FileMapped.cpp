@@ -0,0 +1,98 @@
+#include "FileMapped.hpp"
+
+#include "FileSystem.hpp"
+
+#ifdef FLOUNDER_PLATFORM_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Flounder
+{
+	FileMapped::FileMapped(const std::string &filename) :
+		m_data(nullptr),
+		m_size(0),
+		m_mapping(nullptr),
+		m_mapped(false),
+		m_buffer(std::vector<char>())
+	{
+#ifdef FLOUNDER_PLATFORM_WINDOWS
+		HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			LARGE_INTEGER size = {};
+
+			if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+			{
+				HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+				if (mapping != nullptr)
+				{
+					void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+					if (view != nullptr)
+					{
+						m_data = static_cast<const char *>(view);
+						m_size = static_cast<size_t>(size.QuadPart);
+						m_mapping = mapping;
+						m_mapped = true;
+					}
+					else
+					{
+						CloseHandle(mapping);
+					}
+				}
+			}
+
+			CloseHandle(file);
+		}
+#else
+		const int file = open(filename.c_str(), O_RDONLY);
+
+		if (file != -1)
+		{
+			struct stat status = {};
+
+			if (fstat(file, &status) == 0 && status.st_size > 0)
+			{
+				void *view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+				if (view != MAP_FAILED)
+				{
+					m_data = static_cast<const char *>(view);
+					m_size = static_cast<size_t>(status.st_size);
+					m_mapped = true;
+				}
+			}
+
+			close(file);
+		}
+#endif
+
+		// Empty files and files that cannot be mapped are read into a buffer.
+		if (!m_mapped)
+		{
+			m_buffer = FileSystem::ReadBinaryFile<char>(filename);
+			m_data = m_buffer.data();
+			m_size = m_buffer.size();
+		}
+	}
+
+	FileMapped::~FileMapped()
+	{
+		if (m_mapped)
+		{
+#ifdef FLOUNDER_PLATFORM_WINDOWS
+			UnmapViewOfFile(m_data);
+			CloseHandle(static_cast<HANDLE>(m_mapping));
+#else
+			munmap(const_cast<char *>(m_data), m_size);
+#endif
+		}
+	}
+}
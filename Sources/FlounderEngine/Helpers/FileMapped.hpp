@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "../Prerequisites.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// A whole file mapped read only into memory, so large files can be parsed in place without being copied.
+	/// Files that cannot be mapped are read into a buffer instead, either way the data is valid until this is destroyed.
+	/// </summary>
+	class F_EXPORT FileMapped
+	{
+	private:
+		const char *m_data;
+		size_t m_size;
+		void *m_mapping;
+		bool m_mapped;
+		std::vector<char> m_buffer;
+	public:
+		/// <summary>
+		/// Maps a file.
+		/// </summary>
+		/// <param name="filename"> The files path. </param>
+		FileMapped(const std::string &filename);
+
+		~FileMapped();
+
+		FileMapped(const FileMapped &) = delete;
+
+		FileMapped &operator=(const FileMapped &) = delete;
+
+		const char *GetData() const { return m_data; }
+
+		size_t GetSize() const { return m_size; }
+
+		/// <summary>
+		/// Gets if the file was mapped, rather than read into a buffer.
+		/// </summary>
+		/// <returns> If the file is mapped. </returns>
+		bool IsMapped() const { return m_mapped; }
+	};
+}
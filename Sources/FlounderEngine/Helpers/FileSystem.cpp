@@ -3,11 +3,12 @@
 #include <cassert>
 #include <algorithm>
 
+#include <sys/stat.h>
+
 #ifdef FLOUNDER_PLATFORM_WINDOWS
 #include <direct.h>
 #define GetCurrentDir _getcwd
 #else
-#include <sys/stat.h>
 #include <unistd.h>
 #define GetCurrentDir getcwd
 #endif
@@ -115,6 +116,27 @@ namespace Flounder
 		}
 	}
 
+	int64_t FileSystem::GetModifiedTime(const std::string &filepath)
+	{
+#ifdef FLOUNDER_PLATFORM_WINDOWS
+		struct _stat64 status = {};
+
+		if (_stat64(filepath.c_str(), &status) != 0)
+		{
+			return -1;
+		}
+#else
+		struct stat status = {};
+
+		if (stat(filepath.c_str(), &status) != 0)
+		{
+			return -1;
+		}
+#endif
+
+		return static_cast<int64_t>(status.st_mtime);
+	}
+
 	std::string FileSystem::GetWorkingDirectory()
 	{
 		char buff[FILENAME_MAX];
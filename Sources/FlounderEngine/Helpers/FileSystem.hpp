@@ -144,6 +144,13 @@ namespace Flounder
 			}
 		}
 
+		/// <summary>
+		/// Gets when a file was last modified.
+		/// </summary>
+		/// <param name="filepath"> The files path. </param>
+		/// <returns> The modification time in seconds since the epoch, or -1 if the file does not exist. </returns>
+		static int64_t GetModifiedTime(const std::string &filepath);
+
 		/// <summary>
 		/// Gets the current working directory.
 		/// </summary>
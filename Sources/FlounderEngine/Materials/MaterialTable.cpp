@@ -0,0 +1,75 @@
+#include "MaterialTable.hpp"
+
+#include "../Devices/Display.hpp"
+
+namespace Flounder
+{
+	bool MaterialTable::IsSupported()
+	{
+		const auto features = Display::Get()->GetPhysicalDeviceFeatures();
+		const auto limits = Display::Get()->GetPhysicalDeviceProperties().limits;
+
+		return features.shaderSampledImageArrayDynamicIndexing &&
+			limits.maxPerStageDescriptorSamplers >= MAX_MATERIAL_TEXTURES &&
+			limits.maxPerStageDescriptorSampledImages >= MAX_MATERIAL_TEXTURES;
+	}
+
+	MaterialTable::MaterialTable() :
+		m_textures(new TextureArray(MAX_MATERIAL_TEXTURES, Texture::Resource("Resources/Undefined.png"))),
+		m_buffer(new StorageBuffer(sizeof(MaterialData) * MAX_MATERIALS)),
+		m_materials(std::vector<MaterialData>()),
+		m_indices(std::unordered_map<Material *, uint32_t>())
+	{
+		m_materials.reserve(MAX_MATERIALS);
+	}
+
+	MaterialTable::~MaterialTable()
+	{
+		delete m_textures;
+		delete m_buffer;
+	}
+
+	void MaterialTable::Clear()
+	{
+		m_materials.clear();
+		m_indices.clear();
+		m_textures->Update();
+	}
+
+	uint32_t MaterialTable::Add(Material *material)
+	{
+		auto it = m_indices.find(material);
+
+		if (it != m_indices.end())
+		{
+			return it->second;
+		}
+
+		if (m_materials.size() >= MAX_MATERIALS)
+		{
+			return 0;
+		}
+
+		MaterialData data = {};
+		data.baseColor = *material->GetDiffuse()->GetBaseColor();
+		data.metallic = material->GetSurface()->GetMetallic();
+		data.roughness = material->GetSurface()->GetRoughness();
+		data.ignoreFog = static_cast<float>(material->GetSurface()->GetIgnoreFog());
+		data.ignoreLighting = static_cast<float>(material->GetSurface()->GetIgnoreLighting());
+
+		// A negative index tells the shader the map is not used.
+		data.diffuseTexture = material->GetDiffuse()->GetTexture() == nullptr ? -1 : static_cast<int32_t>(m_textures->Add(material->GetDiffuse()->GetTexture()));
+		data.surfaceTexture = material->GetSurface()->GetTexture() == nullptr ? -1 : static_cast<int32_t>(m_textures->Add(material->GetSurface()->GetTexture()));
+		data.normalTexture = material->GetNormal()->GetTexture() == nullptr ? -1 : static_cast<int32_t>(m_textures->Add(material->GetNormal()->GetTexture()));
+
+		const uint32_t index = static_cast<uint32_t>(m_materials.size());
+		m_materials.push_back(data);
+		m_indices.emplace(material, index);
+		return index;
+	}
+
+	void MaterialTable::Update()
+	{
+		m_buffer->Update(m_materials.data(), 0, sizeof(MaterialData) * m_materials.size());
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "../Maths/Vector4.hpp"
+#include "../Renderer/Buffers/StorageBuffer.hpp"
+#include "../Textures/TextureArray.hpp"
+#include "Material.hpp"
+
+namespace Flounder
+{
+#define MAX_MATERIALS 4096
+#define MAX_MATERIAL_TEXTURES 128
+
+	/// <summary>
+	/// A table of material parameters in a storage buffer with the materials textures in one texture array, shaders index it per instance.
+	/// This replaces a descriptor set per object when the device can index sampler arrays from shaders.
+	/// </summary>
+	class F_EXPORT MaterialTable
+	{
+	public:
+		struct MaterialData
+		{
+			Vector4 baseColor;
+			float metallic;
+			float roughness;
+			float ignoreFog;
+			float ignoreLighting;
+			int32_t diffuseTexture;
+			int32_t surfaceTexture;
+			int32_t normalTexture;
+			int32_t padding;
+		};
+	private:
+		TextureArray *m_textures;
+		StorageBuffer *m_buffer;
+
+		std::vector<MaterialData> m_materials;
+		std::unordered_map<Material *, uint32_t> m_indices;
+	public:
+		/// <summary>
+		/// Gets if the device can index a sampler array from a shader, without this the per object descriptor sets have to be used.
+		/// </summary>
+		/// <returns> If material tables are supported. </returns>
+		static bool IsSupported();
+
+		/// <summary>
+		/// Creates a new material table.
+		/// </summary>
+		MaterialTable();
+
+		/// <summary>
+		/// Deconstructor for the material table.
+		/// </summary>
+		~MaterialTable();
+
+		/// <summary>
+		/// Removes every material, this should be called before the frames materials are added.
+		/// Textures that were not used by the last frame are freed from the texture array.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Gets the index of a material in the table, adding it if it is new this frame.
+		/// </summary>
+		/// <param name="material"> The material to add. </param>
+		/// <returns> The materials index, or 0 if the table is full. </returns>
+		uint32_t Add(Material *material);
+
+		/// <summary>
+		/// Uploads the frames materials to the storage buffer.
+		/// </summary>
+		void Update();
+
+		TextureArray *GetTextures() const { return m_textures; }
+
+		StorageBuffer *GetBuffer() const { return m_buffer; }
+	};
+}
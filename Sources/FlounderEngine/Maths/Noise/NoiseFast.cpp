@@ -2,8 +2,24 @@
 
 #include <cassert>
 #include <random>
+#include <vector>
 #include "../Maths.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#include <immintrin.h>
+#define FN_SSE2
+#define FN_AVX2
+
+// AVX2 kernels are compiled for AVX2 per function and only called when the processor has it, so the engine keeps its baseline target
+#if defined(__GNUC__) || defined(__clang__)
+#define FN_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#include <intrin.h>
+#define FN_AVX2_TARGET
+#endif
+#endif
+
 namespace Flounder
 {
 	const float NoiseFast::GRAD_X[] =
@@ -2603,4 +2619,1298 @@ namespace Flounder
 
 		return 27.0f * (n0 + n1 + n2 + n3 + n4);
 	}
+
+	// Batched
+	void NoiseFast::FillNoiseSet(float *noiseSet, const float &xStart, const float &yStart, const int &xSize, const int &ySize, const float &step) const
+	{
+		std::vector<float> xs = std::vector<float>(xSize);
+		std::vector<float> ys = std::vector<float>(xSize);
+
+		for (int x = 0; x < xSize; x++)
+		{
+			xs[x] = xStart + x * step;
+		}
+
+		for (int y = 0; y < ySize; y++)
+		{
+			std::fill(ys.begin(), ys.end(), yStart + y * step);
+			FillNoiseSet(noiseSet + xSize * y, xs.data(), ys.data(), xSize);
+		}
+	}
+
+	void NoiseFast::FillNoiseSet(float *noiseSet, const float &xStart, const float &yStart, const float &zStart, const int &xSize, const int &ySize, const int &zSize, const float &step) const
+	{
+		std::vector<float> xs = std::vector<float>(xSize);
+		std::vector<float> ys = std::vector<float>(xSize);
+		std::vector<float> zs = std::vector<float>(xSize);
+
+		for (int x = 0; x < xSize; x++)
+		{
+			xs[x] = xStart + x * step;
+		}
+
+		for (int z = 0; z < zSize; z++)
+		{
+			std::fill(zs.begin(), zs.end(), zStart + z * step);
+
+			for (int y = 0; y < ySize; y++)
+			{
+				std::fill(ys.begin(), ys.end(), yStart + y * step);
+				FillNoiseSet(noiseSet + xSize * (y + ySize * z), xs.data(), ys.data(), zs.data(), xSize);
+			}
+		}
+	}
+
+	void NoiseFast::FillNoiseSet(float *noiseSet, const float *x, const float *y, const int &count) const
+	{
+		int i = FillNoiseSetBatch(noiseSet, x, y, nullptr, count);
+
+		for (; i < count; i++)
+		{
+			noiseSet[i] = GetNoise(x[i], y[i]);
+		}
+	}
+
+	void NoiseFast::FillNoiseSet(float *noiseSet, const float *x, const float *y, const float *z, const int &count) const
+	{
+		int i = FillNoiseSetBatch(noiseSet, x, y, z, count);
+
+		for (; i < count; i++)
+		{
+			noiseSet[i] = GetNoise(x[i], y[i], z[i]);
+		}
+	}
+
+	bool NoiseFast::HasNoiseSetKernel() const
+	{
+#ifdef FN_SSE2
+		switch (m_noiseType)
+		{
+		case Value:
+		case ValueFractal:
+		case Perlin:
+		case PerlinFractal:
+		case Simplex:
+		case SimplexFractal:
+			return true;
+		case Cellular:
+			// Noise lookups sample another generator at every point, so they stay on the scalar path.
+			return m_cellularReturnType != NoiseLookup;
+		default:
+			return false;
+		}
+#else
+		return false;
+#endif
+	}
+
+#ifdef FN_SSE2
+	// The kernels below follow the scalar Single* functions operation for operation, so batches match GetNoise(...)
+	// They are not members so the header does not need the vector types, the generator state they read is copied into a NoiseKernel
+	struct NoiseKernel
+	{
+		const unsigned char *perm;
+		const unsigned char *perm12;
+		const float *gradX;
+		const float *gradY;
+		const float *gradZ;
+		const float *valLut;
+		const float *cellX;
+		const float *cellY;
+		const float *cellZ;
+		float f2;
+		float g2;
+		float f3;
+		float g3;
+		int seed;
+		int noiseType;
+		int interp;
+		float frequency;
+		int octaves;
+		float lacunarity;
+		float gain;
+		int fractalType;
+		float fractalBounding;
+		int cellularFunction;
+		int cellularReturnType;
+		int cellularIndex0;
+		int cellularIndex1;
+		float cellularJitter;
+	};
+
+	static inline void HashLanes(const NoiseKernel &kernel, const unsigned char *lut, const unsigned char &offset, const int32_t *x, const int32_t *y, const int32_t *z, const int &lanes, int32_t *hashes)
+	{
+		// The permutation tables are bytes, so they are read per lane the same way as Index2d12, Index2d256, Index3d12 and Index3d256.
+		for (int l = 0; l < lanes; l++)
+		{
+			int32_t hash = offset;
+
+			if (z != nullptr)
+			{
+				hash = kernel.perm[(z[l] & 0xff) + hash];
+			}
+
+			hash = kernel.perm[(y[l] & 0xff) + hash];
+			hashes[l] = lut[(x[l] & 0xff) + hash];
+		}
+	}
+
+	static inline void HashLanes(const unsigned char *lut, const int32_t *x, const int32_t *seeds, const int &lanes, int32_t *hashes)
+	{
+		// Finishes a hash from inner lookups that were shared between corners.
+		for (int l = 0; l < lanes; l++)
+		{
+			hashes[l] = lut[(x[l] & 0xff) + seeds[l]];
+		}
+	}
+
+	static inline __m128i FloorSse2(const __m128 &f)
+	{
+		// Like FastFloor, negative whole numbers are also stepped down.
+		return _mm_add_epi32(_mm_cvttps_epi32(f), _mm_castps_si128(_mm_cmplt_ps(f, _mm_setzero_ps())));
+	}
+
+	static inline __m128 SelectSse2(const __m128 &mask, const __m128 &a, const __m128 &b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	static inline __m128i SelectSse2(const __m128i &mask, const __m128i &a, const __m128i &b)
+	{
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+	}
+
+	static inline __m128i RoundSse2(const __m128 &f)
+	{
+		// Like FastRound, halves are rounded away from zero.
+		return _mm_cvttps_epi32(_mm_add_ps(f, SelectSse2(_mm_cmpge_ps(f, _mm_setzero_ps()), _mm_set1_ps(0.5f), _mm_set1_ps(-0.5f))));
+	}
+
+	static inline __m128 AbsSse2(const __m128 &f)
+	{
+		return _mm_and_ps(f, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+	}
+
+	static inline __m128 LerpSse2(const __m128 &a, const __m128 &b, const __m128 &t)
+	{
+		return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+	}
+
+	static inline __m128 InterpSse2(const int &interp, const __m128 &t)
+	{
+		switch (interp)
+		{
+		case NoiseFast::Hermite:
+			return _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_set1_ps(2.0f), t)));
+		case NoiseFast::Quintic:
+			return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))), _mm_set1_ps(10.0f)));
+		default:
+			return t;
+		}
+	}
+
+	static inline void StoreLanes(int32_t *lanes, const __m128i &value)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), value);
+	}
+
+	static inline __m128 GatherSse2(const float *table, const int32_t *indices)
+	{
+		// SSE2 has no gather, the table is read per lane.
+		return _mm_setr_ps(table[indices[0]], table[indices[1]], table[indices[2]], table[indices[3]]);
+	}
+
+	static inline __m128 GradSse2(const NoiseKernel &kernel, const int32_t *hashes, const __m128 &xd, const __m128 &yd, const __m128 *zd)
+	{
+		__m128 gradient = _mm_add_ps(_mm_mul_ps(xd, GatherSse2(kernel.gradX, hashes)), _mm_mul_ps(yd, GatherSse2(kernel.gradY, hashes)));
+
+		if (zd != nullptr)
+		{
+			gradient = _mm_add_ps(gradient, _mm_mul_ps(*zd, GatherSse2(kernel.gradZ, hashes)));
+		}
+
+		return gradient;
+	}
+
+	static inline __m128 FalloffSse2(const __m128 &radius, const __m128 &x, const __m128 &y, const __m128 *z)
+	{
+		__m128 t = _mm_sub_ps(_mm_sub_ps(radius, _mm_mul_ps(x, x)), _mm_mul_ps(y, y));
+
+		if (z != nullptr)
+		{
+			t = _mm_sub_ps(t, _mm_mul_ps(*z, *z));
+		}
+
+		return t;
+	}
+
+	static inline __m128 CornerSse2(const __m128 &t, const __m128 &gradient)
+	{
+		const __m128 t2 = _mm_mul_ps(t, t);
+		return _mm_andnot_ps(_mm_cmplt_ps(t, _mm_setzero_ps()), _mm_mul_ps(_mm_mul_ps(t2, t2), gradient));
+	}
+
+	static __m128 LatticeSse2(const NoiseKernel &kernel, const bool &perlin, const unsigned char &offset, const __m128 &x, const __m128 &y)
+	{
+		// Value and Perlin noise share the lattice, Perlin weights gradients where Value reads a value per corner.
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128i x0 = FloorSse2(x);
+		const __m128i y0 = FloorSse2(y);
+
+		const __m128 xd0 = _mm_sub_ps(x, _mm_cvtepi32_ps(x0));
+		const __m128 yd0 = _mm_sub_ps(y, _mm_cvtepi32_ps(y0));
+		const __m128 xd1 = _mm_sub_ps(xd0, _mm_set1_ps(1.0f));
+		const __m128 yd1 = _mm_sub_ps(yd0, _mm_set1_ps(1.0f));
+		const __m128 xs = InterpSse2(kernel.interp, xd0);
+		const __m128 ys = InterpSse2(kernel.interp, yd0);
+
+		int32_t lx0[4], lx1[4], ly0[4], ly1[4];
+		int32_t hash00[4], hash10[4], hash01[4], hash11[4];
+		StoreLanes(lx0, x0);
+		StoreLanes(lx1, _mm_add_epi32(x0, one));
+		StoreLanes(ly0, y0);
+		StoreLanes(ly1, _mm_add_epi32(y0, one));
+
+		const unsigned char *lut = perlin ? kernel.perm12 : kernel.perm;
+		HashLanes(kernel, lut, offset, lx0, ly0, nullptr, 4, hash00);
+		HashLanes(kernel, lut, offset, lx1, ly0, nullptr, 4, hash10);
+		HashLanes(kernel, lut, offset, lx0, ly1, nullptr, 4, hash01);
+		HashLanes(kernel, lut, offset, lx1, ly1, nullptr, 4, hash11);
+
+		if (!perlin)
+		{
+			const __m128 xf0 = LerpSse2(GatherSse2(kernel.valLut, hash00), GatherSse2(kernel.valLut, hash10), xs);
+			const __m128 xf1 = LerpSse2(GatherSse2(kernel.valLut, hash01), GatherSse2(kernel.valLut, hash11), xs);
+			return LerpSse2(xf0, xf1, ys);
+		}
+
+		const __m128 xf0 = LerpSse2(GradSse2(kernel, hash00, xd0, yd0, nullptr), GradSse2(kernel, hash10, xd1, yd0, nullptr), xs);
+		const __m128 xf1 = LerpSse2(GradSse2(kernel, hash01, xd0, yd1, nullptr), GradSse2(kernel, hash11, xd1, yd1, nullptr), xs);
+		return LerpSse2(xf0, xf1, ys);
+	}
+
+	static __m128 LatticeSse2(const NoiseKernel &kernel, const bool &perlin, const unsigned char &offset, const __m128 &x, const __m128 &y, const __m128 &z)
+	{
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128i x0 = FloorSse2(x);
+		const __m128i y0 = FloorSse2(y);
+		const __m128i z0 = FloorSse2(z);
+
+		const __m128 xd0 = _mm_sub_ps(x, _mm_cvtepi32_ps(x0));
+		const __m128 yd0 = _mm_sub_ps(y, _mm_cvtepi32_ps(y0));
+		const __m128 zd0 = _mm_sub_ps(z, _mm_cvtepi32_ps(z0));
+		const __m128 xd1 = _mm_sub_ps(xd0, _mm_set1_ps(1.0f));
+		const __m128 yd1 = _mm_sub_ps(yd0, _mm_set1_ps(1.0f));
+		const __m128 zd1 = _mm_sub_ps(zd0, _mm_set1_ps(1.0f));
+		const __m128 xs = InterpSse2(kernel.interp, xd0);
+		const __m128 ys = InterpSse2(kernel.interp, yd0);
+		const __m128 zs = InterpSse2(kernel.interp, zd0);
+
+		int32_t lx0[4], lx1[4], ly0[4], ly1[4], lz0[4], lz1[4];
+		int32_t yz00[4], yz10[4], yz01[4], yz11[4];
+		int32_t hash[8][4];
+		StoreLanes(lx0, x0);
+		StoreLanes(lx1, _mm_add_epi32(x0, one));
+		StoreLanes(ly0, y0);
+		StoreLanes(ly1, _mm_add_epi32(y0, one));
+		StoreLanes(lz0, z0);
+		StoreLanes(lz1, _mm_add_epi32(z0, one));
+
+		// Corners that share a y and z also share the inner permutation lookups, so they are hashed once per lane.
+		HashLanes(kernel, kernel.perm, offset, ly0, lz0, nullptr, 4, yz00);
+		HashLanes(kernel, kernel.perm, offset, ly1, lz0, nullptr, 4, yz10);
+		HashLanes(kernel, kernel.perm, offset, ly0, lz1, nullptr, 4, yz01);
+		HashLanes(kernel, kernel.perm, offset, ly1, lz1, nullptr, 4, yz11);
+
+		const unsigned char *lut = perlin ? kernel.perm12 : kernel.perm;
+		HashLanes(lut, lx0, yz00, 4, hash[0]);
+		HashLanes(lut, lx1, yz00, 4, hash[1]);
+		HashLanes(lut, lx0, yz10, 4, hash[2]);
+		HashLanes(lut, lx1, yz10, 4, hash[3]);
+		HashLanes(lut, lx0, yz01, 4, hash[4]);
+		HashLanes(lut, lx1, yz01, 4, hash[5]);
+		HashLanes(lut, lx0, yz11, 4, hash[6]);
+		HashLanes(lut, lx1, yz11, 4, hash[7]);
+
+		__m128 xf00, xf10, xf01, xf11;
+
+		if (perlin)
+		{
+			xf00 = LerpSse2(GradSse2(kernel, hash[0], xd0, yd0, &zd0), GradSse2(kernel, hash[1], xd1, yd0, &zd0), xs);
+			xf10 = LerpSse2(GradSse2(kernel, hash[2], xd0, yd1, &zd0), GradSse2(kernel, hash[3], xd1, yd1, &zd0), xs);
+			xf01 = LerpSse2(GradSse2(kernel, hash[4], xd0, yd0, &zd1), GradSse2(kernel, hash[5], xd1, yd0, &zd1), xs);
+			xf11 = LerpSse2(GradSse2(kernel, hash[6], xd0, yd1, &zd1), GradSse2(kernel, hash[7], xd1, yd1, &zd1), xs);
+		}
+		else
+		{
+			xf00 = LerpSse2(GatherSse2(kernel.valLut, hash[0]), GatherSse2(kernel.valLut, hash[1]), xs);
+			xf10 = LerpSse2(GatherSse2(kernel.valLut, hash[2]), GatherSse2(kernel.valLut, hash[3]), xs);
+			xf01 = LerpSse2(GatherSse2(kernel.valLut, hash[4]), GatherSse2(kernel.valLut, hash[5]), xs);
+			xf11 = LerpSse2(GatherSse2(kernel.valLut, hash[6]), GatherSse2(kernel.valLut, hash[7]), xs);
+		}
+
+		const __m128 yf0 = LerpSse2(xf00, xf10, ys);
+		const __m128 yf1 = LerpSse2(xf01, xf11, ys);
+		return LerpSse2(yf0, yf1, zs);
+	}
+
+	static __m128 SimplexSse2(const NoiseKernel &kernel, const unsigned char &offset, const __m128 &x, const __m128 &y)
+	{
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 radius = _mm_set1_ps(0.5f);
+		__m128 t = _mm_mul_ps(_mm_add_ps(x, y), _mm_set1_ps(kernel.f2));
+		const __m128i i = FloorSse2(_mm_add_ps(x, t));
+		const __m128i j = FloorSse2(_mm_add_ps(y, t));
+
+		t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, j)), _mm_set1_ps(kernel.g2));
+		const __m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+		const __m128 y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+
+		// The lower or upper triangle of the simplex, depending on which axis the point is further along.
+		const __m128 lower = _mm_cmpgt_ps(x0, y0);
+		const __m128i i1 = _mm_and_si128(_mm_castps_si128(lower), _mm_set1_epi32(1));
+		const __m128i j1 = _mm_andnot_si128(_mm_castps_si128(lower), _mm_set1_epi32(1));
+
+		const __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_cvtepi32_ps(i1)), _mm_set1_ps(kernel.g2));
+		const __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_cvtepi32_ps(j1)), _mm_set1_ps(kernel.g2));
+		const __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, one), _mm_set1_ps(2.0f * kernel.g2));
+		const __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, one), _mm_set1_ps(2.0f * kernel.g2));
+
+		int32_t li[3][4], lj[3][4], hash[3][4];
+		StoreLanes(li[0], i);
+		StoreLanes(li[1], _mm_add_epi32(i, i1));
+		StoreLanes(li[2], _mm_add_epi32(i, _mm_set1_epi32(1)));
+		StoreLanes(lj[0], j);
+		StoreLanes(lj[1], _mm_add_epi32(j, j1));
+		StoreLanes(lj[2], _mm_add_epi32(j, _mm_set1_epi32(1)));
+
+		for (int c = 0; c < 3; c++)
+		{
+			HashLanes(kernel, kernel.perm12, offset, li[c], lj[c], nullptr, 4, hash[c]);
+		}
+
+		const __m128 n0 = CornerSse2(FalloffSse2(radius, x0, y0, nullptr), GradSse2(kernel, hash[0], x0, y0, nullptr));
+		const __m128 n1 = CornerSse2(FalloffSse2(radius, x1, y1, nullptr), GradSse2(kernel, hash[1], x1, y1, nullptr));
+		const __m128 n2 = CornerSse2(FalloffSse2(radius, x2, y2, nullptr), GradSse2(kernel, hash[2], x2, y2, nullptr));
+		return _mm_mul_ps(_mm_set1_ps(70.0f), _mm_add_ps(_mm_add_ps(n0, n1), n2));
+	}
+
+	static __m128 SimplexSse2(const NoiseKernel &kernel, const unsigned char &offset, const __m128 &x, const __m128 &y, const __m128 &z)
+	{
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128i oneInt = _mm_set1_epi32(1);
+		const __m128 radius = _mm_set1_ps(0.6f);
+		const __m128 g3 = _mm_set1_ps(kernel.g3);
+		__m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(x, y), z), _mm_set1_ps(kernel.f3));
+		const __m128i i = FloorSse2(_mm_add_ps(x, t));
+		const __m128i j = FloorSse2(_mm_add_ps(y, t));
+		const __m128i k = FloorSse2(_mm_add_ps(z, t));
+
+		t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_add_epi32(i, j), k)), g3);
+		const __m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+		const __m128 y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+		const __m128 z0 = _mm_sub_ps(z, _mm_sub_ps(_mm_cvtepi32_ps(k), t));
+
+		// The branches of the scalar simplex selection, written as masks.
+		const __m128i xy = _mm_castps_si128(_mm_cmpge_ps(x0, y0));
+		const __m128i yz = _mm_castps_si128(_mm_cmpge_ps(y0, z0));
+		const __m128i xz = _mm_castps_si128(_mm_cmpge_ps(x0, z0));
+		const __m128i i1 = _mm_and_si128(_mm_and_si128(xy, xz), oneInt);
+		const __m128i j1 = _mm_and_si128(_mm_andnot_si128(xy, yz), oneInt);
+		const __m128i k1 = _mm_andnot_si128(_mm_or_si128(xz, yz), oneInt);
+		const __m128i i2 = _mm_and_si128(_mm_or_si128(xy, xz), oneInt);
+		const __m128i j2 = _mm_and_si128(_mm_or_si128(_mm_xor_si128(xy, _mm_set1_epi32(-1)), yz), oneInt);
+		const __m128i k2 = _mm_andnot_si128(_mm_and_si128(xz, yz), oneInt);
+
+		const __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_cvtepi32_ps(i1)), g3);
+		const __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_cvtepi32_ps(j1)), g3);
+		const __m128 z1 = _mm_add_ps(_mm_sub_ps(z0, _mm_cvtepi32_ps(k1)), g3);
+		const __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, _mm_cvtepi32_ps(i2)), _mm_set1_ps(2.0f * kernel.g3));
+		const __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, _mm_cvtepi32_ps(j2)), _mm_set1_ps(2.0f * kernel.g3));
+		const __m128 z2 = _mm_add_ps(_mm_sub_ps(z0, _mm_cvtepi32_ps(k2)), _mm_set1_ps(2.0f * kernel.g3));
+		const __m128 x3 = _mm_add_ps(_mm_sub_ps(x0, one), _mm_set1_ps(3.0f * kernel.g3));
+		const __m128 y3 = _mm_add_ps(_mm_sub_ps(y0, one), _mm_set1_ps(3.0f * kernel.g3));
+		const __m128 z3 = _mm_add_ps(_mm_sub_ps(z0, one), _mm_set1_ps(3.0f * kernel.g3));
+
+		int32_t li[4][4], lj[4][4], lk[4][4], hash[4][4];
+		StoreLanes(li[0], i);
+		StoreLanes(li[1], _mm_add_epi32(i, i1));
+		StoreLanes(li[2], _mm_add_epi32(i, i2));
+		StoreLanes(li[3], _mm_add_epi32(i, oneInt));
+		StoreLanes(lj[0], j);
+		StoreLanes(lj[1], _mm_add_epi32(j, j1));
+		StoreLanes(lj[2], _mm_add_epi32(j, j2));
+		StoreLanes(lj[3], _mm_add_epi32(j, oneInt));
+		StoreLanes(lk[0], k);
+		StoreLanes(lk[1], _mm_add_epi32(k, k1));
+		StoreLanes(lk[2], _mm_add_epi32(k, k2));
+		StoreLanes(lk[3], _mm_add_epi32(k, oneInt));
+
+		for (int c = 0; c < 4; c++)
+		{
+			HashLanes(kernel, kernel.perm12, offset, li[c], lj[c], lk[c], 4, hash[c]);
+		}
+
+		const __m128 n0 = CornerSse2(FalloffSse2(radius, x0, y0, &z0), GradSse2(kernel, hash[0], x0, y0, &z0));
+		const __m128 n1 = CornerSse2(FalloffSse2(radius, x1, y1, &z1), GradSse2(kernel, hash[1], x1, y1, &z1));
+		const __m128 n2 = CornerSse2(FalloffSse2(radius, x2, y2, &z2), GradSse2(kernel, hash[2], x2, y2, &z2));
+		const __m128 n3 = CornerSse2(FalloffSse2(radius, x3, y3, &z3), GradSse2(kernel, hash[3], x3, y3, &z3));
+		return _mm_mul_ps(_mm_set1_ps(32.0f), _mm_add_ps(_mm_add_ps(_mm_add_ps(n0, n1), n2), n3));
+	}
+
+	static __m128 SingleSse2(const NoiseKernel &kernel, const unsigned char &offset, const __m128 &x, const __m128 &y, const __m128 *z)
+	{
+		switch (kernel.noiseType)
+		{
+		case NoiseFast::Value:
+		case NoiseFast::ValueFractal:
+			return z != nullptr ? LatticeSse2(kernel, false, offset, x, y, *z) : LatticeSse2(kernel, false, offset, x, y);
+		case NoiseFast::Perlin:
+		case NoiseFast::PerlinFractal:
+			return z != nullptr ? LatticeSse2(kernel, true, offset, x, y, *z) : LatticeSse2(kernel, true, offset, x, y);
+		default:
+			return z != nullptr ? SimplexSse2(kernel, offset, x, y, *z) : SimplexSse2(kernel, offset, x, y);
+		}
+	}
+
+	static __m128 OctaveSse2(const NoiseKernel &kernel, const __m128 &noise)
+	{
+		switch (kernel.fractalType)
+		{
+		case NoiseFast::Billow:
+			return _mm_sub_ps(_mm_mul_ps(AbsSse2(noise), _mm_set1_ps(2.0f)), _mm_set1_ps(1.0f));
+		case NoiseFast::RigidMulti:
+			return _mm_sub_ps(_mm_set1_ps(1.0f), AbsSse2(noise));
+		default:
+			return noise;
+		}
+	}
+
+	static __m128 FractalSse2(const NoiseKernel &kernel, __m128 x, __m128 y, const __m128 *z)
+	{
+		// Octaves are summed in the same order as the scalar fractals.
+		const __m128 lacunarity = _mm_set1_ps(kernel.lacunarity);
+		__m128 zs = z != nullptr ? *z : _mm_setzero_ps();
+		__m128 sum = OctaveSse2(kernel, SingleSse2(kernel, kernel.perm[0], x, y, z != nullptr ? &zs : nullptr));
+		float amp = 1.0f;
+
+		for (int i = 1; i < kernel.octaves; i++)
+		{
+			x = _mm_mul_ps(x, lacunarity);
+			y = _mm_mul_ps(y, lacunarity);
+			zs = _mm_mul_ps(zs, lacunarity);
+			amp *= kernel.gain;
+
+			const __m128 value = _mm_mul_ps(OctaveSse2(kernel, SingleSse2(kernel, kernel.perm[i], x, y, z != nullptr ? &zs : nullptr)), _mm_set1_ps(amp));
+			sum = kernel.fractalType == NoiseFast::RigidMulti ? _mm_sub_ps(sum, value) : _mm_add_ps(sum, value);
+		}
+
+		if (kernel.fractalType != NoiseFast::RigidMulti)
+		{
+			sum = _mm_mul_ps(sum, _mm_set1_ps(kernel.fractalBounding));
+		}
+
+		return sum;
+	}
+
+	static inline __m128 CellDistanceSse2(const int &function, const __m128 &vecX, const __m128 &vecY, const __m128 *vecZ)
+	{
+		__m128 manhattan = _mm_add_ps(AbsSse2(vecX), AbsSse2(vecY));
+		__m128 euclidean = _mm_add_ps(_mm_mul_ps(vecX, vecX), _mm_mul_ps(vecY, vecY));
+
+		if (vecZ != nullptr)
+		{
+			manhattan = _mm_add_ps(manhattan, AbsSse2(*vecZ));
+			euclidean = _mm_add_ps(euclidean, _mm_mul_ps(*vecZ, *vecZ));
+		}
+
+		switch (function)
+		{
+		case NoiseFast::Manhattan:
+			return manhattan;
+		case NoiseFast::Natural:
+			return _mm_add_ps(manhattan, euclidean);
+		default:
+			return euclidean;
+		}
+	}
+
+	static inline __m128 CellValueSse2(const int &seed, const int32_t *x, const int32_t *y, const int32_t *z)
+	{
+		// The hash of ValueCoord2d and ValueCoord3d, SSE2 has no 32 bit multiply so it is found per lane with the same wrapping.
+		alignas(16) float values[4];
+
+		for (int l = 0; l < 4; l++)
+		{
+			uint32_t n = static_cast<uint32_t>(seed);
+			n ^= static_cast<uint32_t>(X_PRIME) * static_cast<uint32_t>(x[l]);
+			n ^= static_cast<uint32_t>(Y_PRIME) * static_cast<uint32_t>(y[l]);
+
+			if (z != nullptr)
+			{
+				n ^= static_cast<uint32_t>(Z_PRIME) * static_cast<uint32_t>(z[l]);
+			}
+
+			values[l] = static_cast<float>(static_cast<int32_t>(n * n * n * 60493u)) / 2147483648.0f;
+		}
+
+		return _mm_load_ps(values);
+	}
+
+	static __m128 CellularSse2(const NoiseKernel &kernel, const __m128 &x, const __m128 &y, const __m128 *z)
+	{
+		// Distance returns keep the closest cell, the Distance2 returns keep the closest few distances.
+		const bool closest = kernel.cellularReturnType == NoiseFast::CellValue || kernel.cellularReturnType == NoiseFast::Distance;
+		const int range = z != nullptr ? 1 : 0;
+		const __m128 jitter = _mm_set1_ps(kernel.cellularJitter);
+		const __m128i xr = RoundSse2(x);
+		const __m128i yr = RoundSse2(y);
+		const __m128i zr = z != nullptr ? RoundSse2(*z) : _mm_setzero_si128();
+
+		__m128 distance[FN_CELLULAR_INDEX_MAX + 1];
+		__m128i cellX = _mm_setzero_si128();
+		__m128i cellY = _mm_setzero_si128();
+		__m128i cellZ = _mm_setzero_si128();
+
+		for (int i = 0; i <= FN_CELLULAR_INDEX_MAX; i++)
+		{
+			distance[i] = _mm_set1_ps(999999.0f);
+		}
+
+		int32_t lx[4], ly[3][4], lz[3][4], yzHashes[3][3][4], hashes[4];
+		const int32_t seeds[4] = {};
+
+		// The inner permutation lookups only depend on y and z, so they are shared by the three columns of cells.
+		for (int o = 0; o < 3; o++)
+		{
+			StoreLanes(ly[o], _mm_add_epi32(yr, _mm_set1_epi32(o - 1)));
+			StoreLanes(lz[o], _mm_add_epi32(zr, _mm_set1_epi32(o - 1)));
+		}
+
+		for (int yo = 0; yo < 3; yo++)
+		{
+			for (int zo = 0; zo < 1 + 2 * range; zo++)
+			{
+				if (z != nullptr)
+				{
+					HashLanes(kernel, kernel.perm, 0, ly[yo], lz[zo], nullptr, 4, yzHashes[yo][zo]);
+				}
+				else
+				{
+					HashLanes(kernel.perm, ly[yo], seeds, 4, yzHashes[yo][zo]);
+				}
+			}
+		}
+
+		// Cells are visited in the same order as the scalar loops, so ties pick the same cell.
+		for (int xo = -1; xo <= 1; xo++)
+		{
+			const __m128i xi = _mm_add_epi32(xr, _mm_set1_epi32(xo));
+			const __m128 xd = _mm_sub_ps(_mm_cvtepi32_ps(xi), x);
+			StoreLanes(lx, xi);
+
+			for (int yo = -1; yo <= 1; yo++)
+			{
+				const __m128i yi = _mm_add_epi32(yr, _mm_set1_epi32(yo));
+				const __m128 yd = _mm_sub_ps(_mm_cvtepi32_ps(yi), y);
+
+				for (int zo = -range; zo <= range; zo++)
+				{
+					const __m128i zi = _mm_add_epi32(zr, _mm_set1_epi32(zo));
+					HashLanes(kernel.perm, lx, yzHashes[yo + 1][zo + range], 4, hashes);
+
+					const __m128 vecX = _mm_add_ps(xd, _mm_mul_ps(GatherSse2(kernel.cellX, hashes), jitter));
+					const __m128 vecY = _mm_add_ps(yd, _mm_mul_ps(GatherSse2(kernel.cellY, hashes), jitter));
+					__m128 vecZ = _mm_setzero_ps();
+
+					if (z != nullptr)
+					{
+						vecZ = _mm_add_ps(_mm_sub_ps(_mm_cvtepi32_ps(zi), *z), _mm_mul_ps(GatherSse2(kernel.cellZ, hashes), jitter));
+					}
+
+					const __m128 newDistance = CellDistanceSse2(kernel.cellularFunction, vecX, vecY, z != nullptr ? &vecZ : nullptr);
+
+					if (closest)
+					{
+						const __m128 closer = _mm_cmplt_ps(newDistance, distance[0]);
+						distance[0] = SelectSse2(closer, newDistance, distance[0]);
+						cellX = SelectSse2(_mm_castps_si128(closer), xi, cellX);
+						cellY = SelectSse2(_mm_castps_si128(closer), yi, cellY);
+						cellZ = SelectSse2(_mm_castps_si128(closer), zi, cellZ);
+						continue;
+					}
+
+					for (int i = kernel.cellularIndex1; i > 0; i--)
+					{
+						distance[i] = _mm_max_ps(_mm_min_ps(distance[i], newDistance), distance[i - 1]);
+					}
+
+					distance[0] = _mm_min_ps(distance[0], newDistance);
+				}
+			}
+		}
+
+		const __m128 &distance0 = distance[kernel.cellularIndex0];
+		const __m128 &distance1 = distance[kernel.cellularIndex1];
+
+		switch (kernel.cellularReturnType)
+		{
+		case NoiseFast::CellValue:
+			StoreLanes(lx, cellX);
+			StoreLanes(ly[0], cellY);
+			StoreLanes(lz[0], cellZ);
+			return CellValueSse2(kernel.seed, lx, ly[0], z != nullptr ? lz[0] : nullptr);
+		case NoiseFast::Distance:
+			return distance[0];
+		case NoiseFast::Distance2:
+			return distance1;
+		case NoiseFast::Distance2Add:
+			return _mm_add_ps(distance1, distance0);
+		case NoiseFast::Distance2Sub:
+			return _mm_sub_ps(distance1, distance0);
+		case NoiseFast::Distance2Mul:
+			return _mm_mul_ps(distance1, distance0);
+		case NoiseFast::Distance2Div:
+			return _mm_div_ps(distance0, distance1);
+		default:
+			return _mm_setzero_ps();
+		}
+	}
+
+	static int FillNoiseSetSse2(const NoiseKernel &kernel, float *noiseSet, const float *x, const float *y, const float *z, const int &count)
+	{
+		const __m128 frequency = _mm_set1_ps(kernel.frequency);
+		int i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 xs = _mm_mul_ps(_mm_loadu_ps(x + i), frequency);
+			const __m128 ys = _mm_mul_ps(_mm_loadu_ps(y + i), frequency);
+			const __m128 zs = z != nullptr ? _mm_mul_ps(_mm_loadu_ps(z + i), frequency) : _mm_setzero_ps();
+			const __m128 *zp = z != nullptr ? &zs : nullptr;
+
+			switch (kernel.noiseType)
+			{
+			case NoiseFast::Value:
+			case NoiseFast::Perlin:
+			case NoiseFast::Simplex:
+				_mm_storeu_ps(noiseSet + i, SingleSse2(kernel, 0, xs, ys, zp));
+				break;
+			case NoiseFast::Cellular:
+				_mm_storeu_ps(noiseSet + i, CellularSse2(kernel, xs, ys, zp));
+				break;
+			default:
+				_mm_storeu_ps(noiseSet + i, FractalSse2(kernel, xs, ys, zp));
+				break;
+			}
+		}
+
+		return i;
+	}
+#endif
+
+#ifdef FN_AVX2
+	// The AVX2 kernels are the SSE2 kernels eight lanes wide.
+	static bool HasAvx2()
+	{
+#ifdef _MSC_VER
+		// AVX2 needs the processor flag, and the operating system saving the ymm registers.
+		int info[4];
+		__cpuid(info, 0);
+
+		if (info[0] < 7)
+		{
+			return false;
+		}
+
+		__cpuid(info, 1);
+
+		if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+		{
+			return false;
+		}
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+	}
+
+	FN_AVX2_TARGET static inline __m256i FloorAvx2(const __m256 &f)
+	{
+		return _mm256_add_epi32(_mm256_cvttps_epi32(f), _mm256_castps_si256(_mm256_cmp_ps(f, _mm256_setzero_ps(), _CMP_LT_OQ)));
+	}
+
+	FN_AVX2_TARGET static inline __m256i RoundAvx2(const __m256 &f)
+	{
+		const __m256 half = _mm256_blendv_ps(_mm256_set1_ps(-0.5f), _mm256_set1_ps(0.5f), _mm256_cmp_ps(f, _mm256_setzero_ps(), _CMP_GE_OQ));
+		return _mm256_cvttps_epi32(_mm256_add_ps(f, half));
+	}
+
+	FN_AVX2_TARGET static inline __m256 AbsAvx2(const __m256 &f)
+	{
+		return _mm256_and_ps(f, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)));
+	}
+
+	FN_AVX2_TARGET static inline __m256 LerpAvx2(const __m256 &a, const __m256 &b, const __m256 &t)
+	{
+		return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+	}
+
+	FN_AVX2_TARGET static inline __m256 InterpAvx2(const int &interp, const __m256 &t)
+	{
+		switch (interp)
+		{
+		case NoiseFast::Hermite:
+			return _mm256_mul_ps(_mm256_mul_ps(t, t), _mm256_sub_ps(_mm256_set1_ps(3.0f), _mm256_mul_ps(_mm256_set1_ps(2.0f), t)));
+		case NoiseFast::Quintic:
+			return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t),
+				_mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))), _mm256_set1_ps(10.0f)));
+		default:
+			return t;
+		}
+	}
+
+	FN_AVX2_TARGET static inline void StoreLanes(int32_t *lanes, const __m256i &value)
+	{
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), value);
+	}
+
+	FN_AVX2_TARGET static inline __m256 GatherAvx2(const float *table, const int32_t *indices)
+	{
+		// Gather instructions are slower than reading the lanes one by one on many processors, the tables are small enough to stay cached.
+		return _mm256_setr_ps(table[indices[0]], table[indices[1]], table[indices[2]], table[indices[3]],
+			table[indices[4]], table[indices[5]], table[indices[6]], table[indices[7]]);
+	}
+
+	FN_AVX2_TARGET static inline __m256 GradAvx2(const NoiseKernel &kernel, const int32_t *hashes, const __m256 &xd, const __m256 &yd, const __m256 *zd)
+	{
+		__m256 gradient = _mm256_add_ps(_mm256_mul_ps(xd, GatherAvx2(kernel.gradX, hashes)), _mm256_mul_ps(yd, GatherAvx2(kernel.gradY, hashes)));
+
+		if (zd != nullptr)
+		{
+			gradient = _mm256_add_ps(gradient, _mm256_mul_ps(*zd, GatherAvx2(kernel.gradZ, hashes)));
+		}
+
+		return gradient;
+	}
+
+	FN_AVX2_TARGET static inline __m256 FalloffAvx2(const __m256 &radius, const __m256 &x, const __m256 &y, const __m256 *z)
+	{
+		__m256 t = _mm256_sub_ps(_mm256_sub_ps(radius, _mm256_mul_ps(x, x)), _mm256_mul_ps(y, y));
+
+		if (z != nullptr)
+		{
+			t = _mm256_sub_ps(t, _mm256_mul_ps(*z, *z));
+		}
+
+		return t;
+	}
+
+	FN_AVX2_TARGET static inline __m256 CornerAvx2(const __m256 &t, const __m256 &gradient)
+	{
+		const __m256 t2 = _mm256_mul_ps(t, t);
+		return _mm256_andnot_ps(_mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_mul_ps(_mm256_mul_ps(t2, t2), gradient));
+	}
+
+	FN_AVX2_TARGET static __m256 LatticeAvx2(const NoiseKernel &kernel, const bool &perlin, const unsigned char &offset, const __m256 &x, const __m256 &y)
+	{
+		const __m256i one = _mm256_set1_epi32(1);
+		const __m256i x0 = FloorAvx2(x);
+		const __m256i y0 = FloorAvx2(y);
+
+		const __m256 xd0 = _mm256_sub_ps(x, _mm256_cvtepi32_ps(x0));
+		const __m256 yd0 = _mm256_sub_ps(y, _mm256_cvtepi32_ps(y0));
+		const __m256 xd1 = _mm256_sub_ps(xd0, _mm256_set1_ps(1.0f));
+		const __m256 yd1 = _mm256_sub_ps(yd0, _mm256_set1_ps(1.0f));
+		const __m256 xs = InterpAvx2(kernel.interp, xd0);
+		const __m256 ys = InterpAvx2(kernel.interp, yd0);
+
+		int32_t lx0[8], lx1[8], ly0[8], ly1[8];
+		int32_t hash00[8], hash10[8], hash01[8], hash11[8];
+		StoreLanes(lx0, x0);
+		StoreLanes(lx1, _mm256_add_epi32(x0, one));
+		StoreLanes(ly0, y0);
+		StoreLanes(ly1, _mm256_add_epi32(y0, one));
+
+		const unsigned char *lut = perlin ? kernel.perm12 : kernel.perm;
+		HashLanes(kernel, lut, offset, lx0, ly0, nullptr, 8, hash00);
+		HashLanes(kernel, lut, offset, lx1, ly0, nullptr, 8, hash10);
+		HashLanes(kernel, lut, offset, lx0, ly1, nullptr, 8, hash01);
+		HashLanes(kernel, lut, offset, lx1, ly1, nullptr, 8, hash11);
+
+		if (!perlin)
+		{
+			const __m256 xf0 = LerpAvx2(GatherAvx2(kernel.valLut, hash00), GatherAvx2(kernel.valLut, hash10), xs);
+			const __m256 xf1 = LerpAvx2(GatherAvx2(kernel.valLut, hash01), GatherAvx2(kernel.valLut, hash11), xs);
+			return LerpAvx2(xf0, xf1, ys);
+		}
+
+		const __m256 xf0 = LerpAvx2(GradAvx2(kernel, hash00, xd0, yd0, nullptr), GradAvx2(kernel, hash10, xd1, yd0, nullptr), xs);
+		const __m256 xf1 = LerpAvx2(GradAvx2(kernel, hash01, xd0, yd1, nullptr), GradAvx2(kernel, hash11, xd1, yd1, nullptr), xs);
+		return LerpAvx2(xf0, xf1, ys);
+	}
+
+	FN_AVX2_TARGET static __m256 LatticeAvx2(const NoiseKernel &kernel, const bool &perlin, const unsigned char &offset, const __m256 &x, const __m256 &y, const __m256 &z)
+	{
+		const __m256i one = _mm256_set1_epi32(1);
+		const __m256i x0 = FloorAvx2(x);
+		const __m256i y0 = FloorAvx2(y);
+		const __m256i z0 = FloorAvx2(z);
+
+		const __m256 xd0 = _mm256_sub_ps(x, _mm256_cvtepi32_ps(x0));
+		const __m256 yd0 = _mm256_sub_ps(y, _mm256_cvtepi32_ps(y0));
+		const __m256 zd0 = _mm256_sub_ps(z, _mm256_cvtepi32_ps(z0));
+		const __m256 xd1 = _mm256_sub_ps(xd0, _mm256_set1_ps(1.0f));
+		const __m256 yd1 = _mm256_sub_ps(yd0, _mm256_set1_ps(1.0f));
+		const __m256 zd1 = _mm256_sub_ps(zd0, _mm256_set1_ps(1.0f));
+		const __m256 xs = InterpAvx2(kernel.interp, xd0);
+		const __m256 ys = InterpAvx2(kernel.interp, yd0);
+		const __m256 zs = InterpAvx2(kernel.interp, zd0);
+
+		int32_t lx0[8], lx1[8], ly0[8], ly1[8], lz0[8], lz1[8];
+		int32_t yz00[8], yz10[8], yz01[8], yz11[8];
+		int32_t hash[8][8];
+		StoreLanes(lx0, x0);
+		StoreLanes(lx1, _mm256_add_epi32(x0, one));
+		StoreLanes(ly0, y0);
+		StoreLanes(ly1, _mm256_add_epi32(y0, one));
+		StoreLanes(lz0, z0);
+		StoreLanes(lz1, _mm256_add_epi32(z0, one));
+
+		HashLanes(kernel, kernel.perm, offset, ly0, lz0, nullptr, 8, yz00);
+		HashLanes(kernel, kernel.perm, offset, ly1, lz0, nullptr, 8, yz10);
+		HashLanes(kernel, kernel.perm, offset, ly0, lz1, nullptr, 8, yz01);
+		HashLanes(kernel, kernel.perm, offset, ly1, lz1, nullptr, 8, yz11);
+
+		const unsigned char *lut = perlin ? kernel.perm12 : kernel.perm;
+		HashLanes(lut, lx0, yz00, 8, hash[0]);
+		HashLanes(lut, lx1, yz00, 8, hash[1]);
+		HashLanes(lut, lx0, yz10, 8, hash[2]);
+		HashLanes(lut, lx1, yz10, 8, hash[3]);
+		HashLanes(lut, lx0, yz01, 8, hash[4]);
+		HashLanes(lut, lx1, yz01, 8, hash[5]);
+		HashLanes(lut, lx0, yz11, 8, hash[6]);
+		HashLanes(lut, lx1, yz11, 8, hash[7]);
+
+		__m256 xf00, xf10, xf01, xf11;
+
+		if (perlin)
+		{
+			xf00 = LerpAvx2(GradAvx2(kernel, hash[0], xd0, yd0, &zd0), GradAvx2(kernel, hash[1], xd1, yd0, &zd0), xs);
+			xf10 = LerpAvx2(GradAvx2(kernel, hash[2], xd0, yd1, &zd0), GradAvx2(kernel, hash[3], xd1, yd1, &zd0), xs);
+			xf01 = LerpAvx2(GradAvx2(kernel, hash[4], xd0, yd0, &zd1), GradAvx2(kernel, hash[5], xd1, yd0, &zd1), xs);
+			xf11 = LerpAvx2(GradAvx2(kernel, hash[6], xd0, yd1, &zd1), GradAvx2(kernel, hash[7], xd1, yd1, &zd1), xs);
+		}
+		else
+		{
+			xf00 = LerpAvx2(GatherAvx2(kernel.valLut, hash[0]), GatherAvx2(kernel.valLut, hash[1]), xs);
+			xf10 = LerpAvx2(GatherAvx2(kernel.valLut, hash[2]), GatherAvx2(kernel.valLut, hash[3]), xs);
+			xf01 = LerpAvx2(GatherAvx2(kernel.valLut, hash[4]), GatherAvx2(kernel.valLut, hash[5]), xs);
+			xf11 = LerpAvx2(GatherAvx2(kernel.valLut, hash[6]), GatherAvx2(kernel.valLut, hash[7]), xs);
+		}
+
+		const __m256 yf0 = LerpAvx2(xf00, xf10, ys);
+		const __m256 yf1 = LerpAvx2(xf01, xf11, ys);
+		return LerpAvx2(yf0, yf1, zs);
+	}
+
+	FN_AVX2_TARGET static __m256 SimplexAvx2(const NoiseKernel &kernel, const unsigned char &offset, const __m256 &x, const __m256 &y)
+	{
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 radius = _mm256_set1_ps(0.5f);
+		__m256 t = _mm256_mul_ps(_mm256_add_ps(x, y), _mm256_set1_ps(kernel.f2));
+		const __m256i i = FloorAvx2(_mm256_add_ps(x, t));
+		const __m256i j = FloorAvx2(_mm256_add_ps(y, t));
+
+		t = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(i, j)), _mm256_set1_ps(kernel.g2));
+		const __m256 x0 = _mm256_sub_ps(x, _mm256_sub_ps(_mm256_cvtepi32_ps(i), t));
+		const __m256 y0 = _mm256_sub_ps(y, _mm256_sub_ps(_mm256_cvtepi32_ps(j), t));
+
+		const __m256i lower = _mm256_castps_si256(_mm256_cmp_ps(x0, y0, _CMP_GT_OQ));
+		const __m256i i1 = _mm256_and_si256(lower, _mm256_set1_epi32(1));
+		const __m256i j1 = _mm256_andnot_si256(lower, _mm256_set1_epi32(1));
+
+		const __m256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_cvtepi32_ps(i1)), _mm256_set1_ps(kernel.g2));
+		const __m256 y1 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_cvtepi32_ps(j1)), _mm256_set1_ps(kernel.g2));
+		const __m256 x2 = _mm256_add_ps(_mm256_sub_ps(x0, one), _mm256_set1_ps(2.0f * kernel.g2));
+		const __m256 y2 = _mm256_add_ps(_mm256_sub_ps(y0, one), _mm256_set1_ps(2.0f * kernel.g2));
+
+		int32_t li[3][8], lj[3][8], hash[3][8];
+		StoreLanes(li[0], i);
+		StoreLanes(li[1], _mm256_add_epi32(i, i1));
+		StoreLanes(li[2], _mm256_add_epi32(i, _mm256_set1_epi32(1)));
+		StoreLanes(lj[0], j);
+		StoreLanes(lj[1], _mm256_add_epi32(j, j1));
+		StoreLanes(lj[2], _mm256_add_epi32(j, _mm256_set1_epi32(1)));
+
+		for (int c = 0; c < 3; c++)
+		{
+			HashLanes(kernel, kernel.perm12, offset, li[c], lj[c], nullptr, 8, hash[c]);
+		}
+
+		const __m256 n0 = CornerAvx2(FalloffAvx2(radius, x0, y0, nullptr), GradAvx2(kernel, hash[0], x0, y0, nullptr));
+		const __m256 n1 = CornerAvx2(FalloffAvx2(radius, x1, y1, nullptr), GradAvx2(kernel, hash[1], x1, y1, nullptr));
+		const __m256 n2 = CornerAvx2(FalloffAvx2(radius, x2, y2, nullptr), GradAvx2(kernel, hash[2], x2, y2, nullptr));
+		return _mm256_mul_ps(_mm256_set1_ps(70.0f), _mm256_add_ps(_mm256_add_ps(n0, n1), n2));
+	}
+
+	FN_AVX2_TARGET static __m256 SimplexAvx2(const NoiseKernel &kernel, const unsigned char &offset, const __m256 &x, const __m256 &y, const __m256 &z)
+	{
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256i oneInt = _mm256_set1_epi32(1);
+		const __m256 radius = _mm256_set1_ps(0.6f);
+		const __m256 g3 = _mm256_set1_ps(kernel.g3);
+		__m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(x, y), z), _mm256_set1_ps(kernel.f3));
+		const __m256i i = FloorAvx2(_mm256_add_ps(x, t));
+		const __m256i j = FloorAvx2(_mm256_add_ps(y, t));
+		const __m256i k = FloorAvx2(_mm256_add_ps(z, t));
+
+		t = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_add_epi32(i, j), k)), g3);
+		const __m256 x0 = _mm256_sub_ps(x, _mm256_sub_ps(_mm256_cvtepi32_ps(i), t));
+		const __m256 y0 = _mm256_sub_ps(y, _mm256_sub_ps(_mm256_cvtepi32_ps(j), t));
+		const __m256 z0 = _mm256_sub_ps(z, _mm256_sub_ps(_mm256_cvtepi32_ps(k), t));
+
+		const __m256i xy = _mm256_castps_si256(_mm256_cmp_ps(x0, y0, _CMP_GE_OQ));
+		const __m256i yz = _mm256_castps_si256(_mm256_cmp_ps(y0, z0, _CMP_GE_OQ));
+		const __m256i xz = _mm256_castps_si256(_mm256_cmp_ps(x0, z0, _CMP_GE_OQ));
+		const __m256i i1 = _mm256_and_si256(_mm256_and_si256(xy, xz), oneInt);
+		const __m256i j1 = _mm256_and_si256(_mm256_andnot_si256(xy, yz), oneInt);
+		const __m256i k1 = _mm256_andnot_si256(_mm256_or_si256(xz, yz), oneInt);
+		const __m256i i2 = _mm256_and_si256(_mm256_or_si256(xy, xz), oneInt);
+		const __m256i j2 = _mm256_and_si256(_mm256_or_si256(_mm256_xor_si256(xy, _mm256_set1_epi32(-1)), yz), oneInt);
+		const __m256i k2 = _mm256_andnot_si256(_mm256_and_si256(xz, yz), oneInt);
+
+		const __m256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_cvtepi32_ps(i1)), g3);
+		const __m256 y1 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_cvtepi32_ps(j1)), g3);
+		const __m256 z1 = _mm256_add_ps(_mm256_sub_ps(z0, _mm256_cvtepi32_ps(k1)), g3);
+		const __m256 x2 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_cvtepi32_ps(i2)), _mm256_set1_ps(2.0f * kernel.g3));
+		const __m256 y2 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_cvtepi32_ps(j2)), _mm256_set1_ps(2.0f * kernel.g3));
+		const __m256 z2 = _mm256_add_ps(_mm256_sub_ps(z0, _mm256_cvtepi32_ps(k2)), _mm256_set1_ps(2.0f * kernel.g3));
+		const __m256 x3 = _mm256_add_ps(_mm256_sub_ps(x0, one), _mm256_set1_ps(3.0f * kernel.g3));
+		const __m256 y3 = _mm256_add_ps(_mm256_sub_ps(y0, one), _mm256_set1_ps(3.0f * kernel.g3));
+		const __m256 z3 = _mm256_add_ps(_mm256_sub_ps(z0, one), _mm256_set1_ps(3.0f * kernel.g3));
+
+		int32_t li[4][8], lj[4][8], lk[4][8], hash[4][8];
+		StoreLanes(li[0], i);
+		StoreLanes(li[1], _mm256_add_epi32(i, i1));
+		StoreLanes(li[2], _mm256_add_epi32(i, i2));
+		StoreLanes(li[3], _mm256_add_epi32(i, oneInt));
+		StoreLanes(lj[0], j);
+		StoreLanes(lj[1], _mm256_add_epi32(j, j1));
+		StoreLanes(lj[2], _mm256_add_epi32(j, j2));
+		StoreLanes(lj[3], _mm256_add_epi32(j, oneInt));
+		StoreLanes(lk[0], k);
+		StoreLanes(lk[1], _mm256_add_epi32(k, k1));
+		StoreLanes(lk[2], _mm256_add_epi32(k, k2));
+		StoreLanes(lk[3], _mm256_add_epi32(k, oneInt));
+
+		for (int c = 0; c < 4; c++)
+		{
+			HashLanes(kernel, kernel.perm12, offset, li[c], lj[c], lk[c], 8, hash[c]);
+		}
+
+		const __m256 n0 = CornerAvx2(FalloffAvx2(radius, x0, y0, &z0), GradAvx2(kernel, hash[0], x0, y0, &z0));
+		const __m256 n1 = CornerAvx2(FalloffAvx2(radius, x1, y1, &z1), GradAvx2(kernel, hash[1], x1, y1, &z1));
+		const __m256 n2 = CornerAvx2(FalloffAvx2(radius, x2, y2, &z2), GradAvx2(kernel, hash[2], x2, y2, &z2));
+		const __m256 n3 = CornerAvx2(FalloffAvx2(radius, x3, y3, &z3), GradAvx2(kernel, hash[3], x3, y3, &z3));
+		return _mm256_mul_ps(_mm256_set1_ps(32.0f), _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(n0, n1), n2), n3));
+	}
+
+	FN_AVX2_TARGET static __m256 SingleAvx2(const NoiseKernel &kernel, const unsigned char &offset, const __m256 &x, const __m256 &y, const __m256 *z)
+	{
+		switch (kernel.noiseType)
+		{
+		case NoiseFast::Value:
+		case NoiseFast::ValueFractal:
+			return z != nullptr ? LatticeAvx2(kernel, false, offset, x, y, *z) : LatticeAvx2(kernel, false, offset, x, y);
+		case NoiseFast::Perlin:
+		case NoiseFast::PerlinFractal:
+			return z != nullptr ? LatticeAvx2(kernel, true, offset, x, y, *z) : LatticeAvx2(kernel, true, offset, x, y);
+		default:
+			return z != nullptr ? SimplexAvx2(kernel, offset, x, y, *z) : SimplexAvx2(kernel, offset, x, y);
+		}
+	}
+
+	FN_AVX2_TARGET static __m256 OctaveAvx2(const NoiseKernel &kernel, const __m256 &noise)
+	{
+		switch (kernel.fractalType)
+		{
+		case NoiseFast::Billow:
+			return _mm256_sub_ps(_mm256_mul_ps(AbsAvx2(noise), _mm256_set1_ps(2.0f)), _mm256_set1_ps(1.0f));
+		case NoiseFast::RigidMulti:
+			return _mm256_sub_ps(_mm256_set1_ps(1.0f), AbsAvx2(noise));
+		default:
+			return noise;
+		}
+	}
+
+	FN_AVX2_TARGET static __m256 FractalAvx2(const NoiseKernel &kernel, __m256 x, __m256 y, const __m256 *z)
+	{
+		const __m256 lacunarity = _mm256_set1_ps(kernel.lacunarity);
+		__m256 zs = z != nullptr ? *z : _mm256_setzero_ps();
+		__m256 sum = OctaveAvx2(kernel, SingleAvx2(kernel, kernel.perm[0], x, y, z != nullptr ? &zs : nullptr));
+		float amp = 1.0f;
+
+		for (int i = 1; i < kernel.octaves; i++)
+		{
+			x = _mm256_mul_ps(x, lacunarity);
+			y = _mm256_mul_ps(y, lacunarity);
+			zs = _mm256_mul_ps(zs, lacunarity);
+			amp *= kernel.gain;
+
+			const __m256 value = _mm256_mul_ps(OctaveAvx2(kernel, SingleAvx2(kernel, kernel.perm[i], x, y, z != nullptr ? &zs : nullptr)), _mm256_set1_ps(amp));
+			sum = kernel.fractalType == NoiseFast::RigidMulti ? _mm256_sub_ps(sum, value) : _mm256_add_ps(sum, value);
+		}
+
+		if (kernel.fractalType != NoiseFast::RigidMulti)
+		{
+			sum = _mm256_mul_ps(sum, _mm256_set1_ps(kernel.fractalBounding));
+		}
+
+		return sum;
+	}
+
+	FN_AVX2_TARGET static inline __m256 CellDistanceAvx2(const int &function, const __m256 &vecX, const __m256 &vecY, const __m256 *vecZ)
+	{
+		__m256 manhattan = _mm256_add_ps(AbsAvx2(vecX), AbsAvx2(vecY));
+		__m256 euclidean = _mm256_add_ps(_mm256_mul_ps(vecX, vecX), _mm256_mul_ps(vecY, vecY));
+
+		if (vecZ != nullptr)
+		{
+			manhattan = _mm256_add_ps(manhattan, AbsAvx2(*vecZ));
+			euclidean = _mm256_add_ps(euclidean, _mm256_mul_ps(*vecZ, *vecZ));
+		}
+
+		switch (function)
+		{
+		case NoiseFast::Manhattan:
+			return manhattan;
+		case NoiseFast::Natural:
+			return _mm256_add_ps(manhattan, euclidean);
+		default:
+			return euclidean;
+		}
+	}
+
+	FN_AVX2_TARGET static inline __m256 CellValueAvx2(const int &seed, const __m256i &x, const __m256i &y, const __m256i *z)
+	{
+		// The hash of ValueCoord2d and ValueCoord3d, the multiplies wrap the same way.
+		__m256i n = _mm256_set1_epi32(seed);
+		n = _mm256_xor_si256(n, _mm256_mullo_epi32(_mm256_set1_epi32(X_PRIME), x));
+		n = _mm256_xor_si256(n, _mm256_mullo_epi32(_mm256_set1_epi32(Y_PRIME), y));
+
+		if (z != nullptr)
+		{
+			n = _mm256_xor_si256(n, _mm256_mullo_epi32(_mm256_set1_epi32(Z_PRIME), *z));
+		}
+
+		n = _mm256_mullo_epi32(_mm256_mullo_epi32(_mm256_mullo_epi32(n, n), n), _mm256_set1_epi32(60493));
+		return _mm256_div_ps(_mm256_cvtepi32_ps(n), _mm256_set1_ps(2147483648.0f));
+	}
+
+	FN_AVX2_TARGET static __m256 CellularAvx2(const NoiseKernel &kernel, const __m256 &x, const __m256 &y, const __m256 *z)
+	{
+		const bool closest = kernel.cellularReturnType == NoiseFast::CellValue || kernel.cellularReturnType == NoiseFast::Distance;
+		const int range = z != nullptr ? 1 : 0;
+		const __m256 jitter = _mm256_set1_ps(kernel.cellularJitter);
+		const __m256i xr = RoundAvx2(x);
+		const __m256i yr = RoundAvx2(y);
+		const __m256i zr = z != nullptr ? RoundAvx2(*z) : _mm256_setzero_si256();
+
+		__m256 distance[FN_CELLULAR_INDEX_MAX + 1];
+		__m256i cellX = _mm256_setzero_si256();
+		__m256i cellY = _mm256_setzero_si256();
+		__m256i cellZ = _mm256_setzero_si256();
+
+		for (int i = 0; i <= FN_CELLULAR_INDEX_MAX; i++)
+		{
+			distance[i] = _mm256_set1_ps(999999.0f);
+		}
+
+		int32_t lx[8], ly[3][8], lz[3][8], yzHashes[3][3][8], hashes[8];
+		const int32_t seeds[8] = {};
+
+		// The inner permutation lookups only depend on y and z, so they are shared by the three columns of cells.
+		for (int o = 0; o < 3; o++)
+		{
+			StoreLanes(ly[o], _mm256_add_epi32(yr, _mm256_set1_epi32(o - 1)));
+			StoreLanes(lz[o], _mm256_add_epi32(zr, _mm256_set1_epi32(o - 1)));
+		}
+
+		for (int yo = 0; yo < 3; yo++)
+		{
+			for (int zo = 0; zo < 1 + 2 * range; zo++)
+			{
+				if (z != nullptr)
+				{
+					HashLanes(kernel, kernel.perm, 0, ly[yo], lz[zo], nullptr, 8, yzHashes[yo][zo]);
+				}
+				else
+				{
+					HashLanes(kernel.perm, ly[yo], seeds, 8, yzHashes[yo][zo]);
+				}
+			}
+		}
+
+		for (int xo = -1; xo <= 1; xo++)
+		{
+			const __m256i xi = _mm256_add_epi32(xr, _mm256_set1_epi32(xo));
+			const __m256 xd = _mm256_sub_ps(_mm256_cvtepi32_ps(xi), x);
+			StoreLanes(lx, xi);
+
+			for (int yo = -1; yo <= 1; yo++)
+			{
+				const __m256i yi = _mm256_add_epi32(yr, _mm256_set1_epi32(yo));
+				const __m256 yd = _mm256_sub_ps(_mm256_cvtepi32_ps(yi), y);
+
+				for (int zo = -range; zo <= range; zo++)
+				{
+					const __m256i zi = _mm256_add_epi32(zr, _mm256_set1_epi32(zo));
+					HashLanes(kernel.perm, lx, yzHashes[yo + 1][zo + range], 8, hashes);
+
+					const __m256 vecX = _mm256_add_ps(xd, _mm256_mul_ps(GatherAvx2(kernel.cellX, hashes), jitter));
+					const __m256 vecY = _mm256_add_ps(yd, _mm256_mul_ps(GatherAvx2(kernel.cellY, hashes), jitter));
+					__m256 vecZ = _mm256_setzero_ps();
+
+					if (z != nullptr)
+					{
+						vecZ = _mm256_add_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(zi), *z), _mm256_mul_ps(GatherAvx2(kernel.cellZ, hashes), jitter));
+					}
+
+					const __m256 newDistance = CellDistanceAvx2(kernel.cellularFunction, vecX, vecY, z != nullptr ? &vecZ : nullptr);
+
+					if (closest)
+					{
+						const __m256 closer = _mm256_cmp_ps(newDistance, distance[0], _CMP_LT_OQ);
+						distance[0] = _mm256_blendv_ps(distance[0], newDistance, closer);
+						cellX = _mm256_blendv_epi8(cellX, xi, _mm256_castps_si256(closer));
+						cellY = _mm256_blendv_epi8(cellY, yi, _mm256_castps_si256(closer));
+						cellZ = _mm256_blendv_epi8(cellZ, zi, _mm256_castps_si256(closer));
+						continue;
+					}
+
+					for (int i = kernel.cellularIndex1; i > 0; i--)
+					{
+						distance[i] = _mm256_max_ps(_mm256_min_ps(distance[i], newDistance), distance[i - 1]);
+					}
+
+					distance[0] = _mm256_min_ps(distance[0], newDistance);
+				}
+			}
+		}
+
+		const __m256 &distance0 = distance[kernel.cellularIndex0];
+		const __m256 &distance1 = distance[kernel.cellularIndex1];
+
+		switch (kernel.cellularReturnType)
+		{
+		case NoiseFast::CellValue:
+			return CellValueAvx2(kernel.seed, cellX, cellY, z != nullptr ? &cellZ : nullptr);
+		case NoiseFast::Distance:
+			return distance[0];
+		case NoiseFast::Distance2:
+			return distance1;
+		case NoiseFast::Distance2Add:
+			return _mm256_add_ps(distance1, distance0);
+		case NoiseFast::Distance2Sub:
+			return _mm256_sub_ps(distance1, distance0);
+		case NoiseFast::Distance2Mul:
+			return _mm256_mul_ps(distance1, distance0);
+		case NoiseFast::Distance2Div:
+			return _mm256_div_ps(distance0, distance1);
+		default:
+			return _mm256_setzero_ps();
+		}
+	}
+
+	FN_AVX2_TARGET static int FillNoiseSetAvx2(const NoiseKernel &kernel, float *noiseSet, const float *x, const float *y, const float *z, const int &count)
+	{
+		const __m256 frequency = _mm256_set1_ps(kernel.frequency);
+		int i = 0;
+
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 xs = _mm256_mul_ps(_mm256_loadu_ps(x + i), frequency);
+			const __m256 ys = _mm256_mul_ps(_mm256_loadu_ps(y + i), frequency);
+			const __m256 zs = z != nullptr ? _mm256_mul_ps(_mm256_loadu_ps(z + i), frequency) : _mm256_setzero_ps();
+			const __m256 *zp = z != nullptr ? &zs : nullptr;
+
+			switch (kernel.noiseType)
+			{
+			case NoiseFast::Value:
+			case NoiseFast::Perlin:
+			case NoiseFast::Simplex:
+				_mm256_storeu_ps(noiseSet + i, SingleAvx2(kernel, 0, xs, ys, zp));
+				break;
+			case NoiseFast::Cellular:
+				_mm256_storeu_ps(noiseSet + i, CellularAvx2(kernel, xs, ys, zp));
+				break;
+			default:
+				_mm256_storeu_ps(noiseSet + i, FractalAvx2(kernel, xs, ys, zp));
+				break;
+			}
+		}
+
+		return i;
+	}
+#endif
+
+	int NoiseFast::FillNoiseSetBatch(float *noiseSet, const float *x, const float *y, const float *z, const int &count) const
+	{
+#ifdef FN_SSE2
+		if (!HasNoiseSetKernel())
+		{
+			return 0;
+		}
+
+		const bool is3d = z != nullptr;
+		NoiseKernel kernel = {};
+		kernel.perm = m_perm;
+		kernel.perm12 = m_perm12;
+		kernel.gradX = GRAD_X;
+		kernel.gradY = GRAD_Y;
+		kernel.gradZ = GRAD_Z;
+		kernel.valLut = VAL_LUT;
+		kernel.cellX = is3d ? CELL_3D_X : CELL_2D_X;
+		kernel.cellY = is3d ? CELL_3D_Y : CELL_2D_Y;
+		kernel.cellZ = CELL_3D_Z;
+		kernel.f2 = F2;
+		kernel.g2 = G2;
+		kernel.f3 = F3;
+		kernel.g3 = G3;
+		kernel.seed = m_seed;
+		kernel.noiseType = m_noiseType;
+		kernel.interp = m_interp;
+		kernel.frequency = m_frequency;
+		kernel.octaves = m_octaves;
+		kernel.lacunarity = m_lacunarity;
+		kernel.gain = m_gain;
+		kernel.fractalType = m_fractalType;
+		kernel.fractalBounding = m_fractalBounding;
+		kernel.cellularFunction = m_cellularDistanceFunction;
+		kernel.cellularReturnType = m_cellularReturnType;
+		kernel.cellularIndex0 = m_cellularDistanceIndex0;
+		kernel.cellularIndex1 = m_cellularDistanceIndex1;
+		kernel.cellularJitter = m_cellularJitter;
+
+		int filled = 0;
+
+#ifdef FN_AVX2
+		// Detected once, AVX2 fills eight points at a time and SSE2 fills what is left.
+		static const bool hasAvx2 = HasAvx2();
+
+		if (hasAvx2)
+		{
+			filled = FillNoiseSetAvx2(kernel, noiseSet, x, y, z, count);
+		}
+#endif
+
+		return filled + FillNoiseSetSse2(kernel, noiseSet + filled, x + filled, y + filled, is3d ? z + filled : nullptr, count - filled);
+#else
+		return 0;
+#endif
+	}
 }
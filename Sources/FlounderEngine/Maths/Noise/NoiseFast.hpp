@@ -290,9 +290,32 @@ namespace Flounder
 
 		float GetWhiteNoiseInt(int x, int y, int z, int w) const;
 
+		//Batched
+		// Fills a grid of 2D noise, the noise at (xStart + x * step, yStart + y * step) is written to noiseSet[x + xSize * y]
+		// Value, Perlin and Simplex noise, their fractals, and Cellular noise are evaluated 8 points at a time with AVX2 or 4 with SSE2,
+		// AVX2 is picked at runtime when the processor has it. Other noise types and cellular noise lookups are evaluated one point
+		// at a time, the same as GetNoise(...)
+		void FillNoiseSet(float *noiseSet, const float &xStart, const float &yStart, const int &xSize, const int &ySize, const float &step = 1.0f) const;
+
+		// Fills a grid of 3D noise, the noise at (xStart + x * step, yStart + y * step, zStart + z * step) is written to
+		// noiseSet[x + xSize * (y + ySize * z)]
+		void FillNoiseSet(float *noiseSet, const float &xStart, const float &yStart, const float &zStart, const int &xSize, const int &ySize, const int &zSize, const float &step = 1.0f) const;
+
+		// Fills noiseSet[i] with the 2D noise at (x[i], y[i])
+		void FillNoiseSet(float *noiseSet, const float *x, const float *y, const int &count) const;
+
+		// Fills noiseSet[i] with the 3D noise at (x[i], y[i], z[i])
+		void FillNoiseSet(float *noiseSet, const float *x, const float *y, const float *z, const int &count) const;
+
 	private:
 		void CalculateFractalBounding();
 
+		// Batched helpers, z is nullptr for 2D noise
+		bool HasNoiseSetKernel() const;
+
+		// Fills as many points as the vector kernels can and returns how many were filled, the rest are left to GetNoise(...)
+		int FillNoiseSetBatch(float *noiseSet, const float *x, const float *y, const float *z, const int &count) const;
+
 		// Helpers
 		static int FastFloor(const float &f);
 
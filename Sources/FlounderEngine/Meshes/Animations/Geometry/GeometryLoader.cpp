@@ -10,7 +10,7 @@ namespace Flounder
 		m_positionsList(std::vector<VertexAnimatedData *>()),
 		m_uvsList(std::vector<Vector2>()),
 		m_normalsList(std::vector<Vector3>()),
-		m_vertices(std::vector<IVertex *>()),
+		m_vertices(std::vector<VertexAnimated>()),
 		m_indices(std::vector<uint32_t>())
 	{
 		LoadVertices();
@@ -18,6 +18,7 @@ namespace Flounder
 		LoadNormals();
 		AssembleVertices();
 		RemoveUnusedVertices();
+		m_vertices.reserve(m_positionsList.size());
 
 		for (auto current : m_positionsList)
 		{
@@ -30,9 +31,7 @@ namespace Flounder
 			//  const Vector3 jointIds = Vector3(skin->GetJointIds()[0], skin->GetJointIds()[1], skin->GetJointIds()[2]);
 			//	const Vector3 weights = Vector3(skin->GetWeights()[0], skin->GetWeights()[1], skin->GetWeights()[2]);
 
-			VertexAnimated *vertex = new VertexAnimated(position, textures, normal, tangent); // , jointIds, weights
-
-			m_vertices.push_back(vertex);
+			m_vertices.emplace_back(position, textures, normal, tangent); // , jointIds, weights
 
 			delete current;
 		}
@@ -3,7 +3,6 @@
 namespace Flounder
 {
 	VertexAnimated::VertexAnimated(const Vector3 &position, const Vector2 &uv, const Vector3 &normal, const Vector3 &tangent, const Vector3 &jointId, const Vector3 &vertexWeight) :
-		IVertex(),
 		m_position(position),
 		m_uv(uv),
 		m_normal(normal),
@@ -14,7 +13,6 @@ namespace Flounder
 	}
 
 	VertexAnimated::VertexAnimated(const VertexAnimated &source) :
-		IVertex(),
 		m_position(source.m_position),
 		m_uv(source.m_uv),
 		m_normal(source.m_normal),
@@ -28,22 +26,6 @@ namespace Flounder
 	{
 	}
 
-	void *VertexAnimated::GetData(std::vector<IVertex *> &vertices)
-	{
-		size_t dataSize = GetSize() * vertices.size();
-		void *data = new void*[dataSize];
-
-		std::vector<VertexAnimated> thisVector = std::vector<VertexAnimated>();
-
-		for (auto vertex : vertices)
-		{
-			thisVector.push_back(*((VertexAnimated*) vertex));
-		}
-
-		memcpy(data, thisVector.data(), dataSize);
-		return data;
-	}
-
 	std::vector<VkVertexInputBindingDescription> VertexAnimated::GetBindingDescriptions(const VkVertexInputRate &inputRate)
 	{
 		std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
@@ -4,12 +4,13 @@
 #include "../../../Maths/Vector2.hpp"
 #include "../../../Maths/Vector3.hpp"
 #include "../../../Engine/Platform.hpp"
-#include "../../../Models/IVertex.hpp"
 
 namespace Flounder
 {
-	class F_EXPORT VertexAnimated :
-		public IVertex
+	/// <summary>
+	/// A vertex laid out as it is in the vertex buffer, models copy arrays of them into their buffers as they are.
+	/// </summary>
+	class F_EXPORT VertexAnimated
 	{
 	public:
 		Vector3 m_position;
@@ -25,14 +26,6 @@ namespace Flounder
 
 		~VertexAnimated();
 
-		Vector3 GetPosition() const override { return m_position; };
-
-		void SetPosition(const Vector3 &position) override { m_position = position; };
-
-		size_t GetSize() const override { return sizeof(VertexAnimated); }
-
-		void *GetData(std::vector<IVertex *> &vertices) override;
-
 		static std::vector<VkVertexInputBindingDescription> GetBindingDescriptions(const VkVertexInputRate &inputRate = VK_VERTEX_INPUT_RATE_VERTEX);
 
 		static std::vector<VkVertexInputAttributeDescription> GetAttributeDescriptions(const int &usedCount = 5);
@@ -71,9 +71,7 @@ namespace Flounder
 		SkeletonLoader *skeletonLoader = new SkeletonLoader(file->GetParent()->GetChild("COLLADA")->GetChild("library_visual_scenes"),
 			skinLoader->GetJointOrder());
 		GeometryLoader *geometryLoader = new GeometryLoader(file->GetParent()->GetChild("COLLADA")->GetChild("library_geometries"), skinLoader->GetVerticesSkinData());
-		auto vertices = geometryLoader->GetVertices();
-		auto indices = geometryLoader->GetIndices();
-		m_model = new Model(vertices, indices);
+		m_model = new Model(geometryLoader->GetVertices(), geometryLoader->GetIndices());
 		m_headJoint = CreateJoints(skeletonLoader->GetHeadJoint());
 	//	delete skinLoader;
 	//	delete skeletonLoader;
@@ -0,0 +1,261 @@
+#include "Impostor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "../Devices/Display.hpp"
+#include "../Tasks/Tasks.hpp"
+#include "VertexModelQuantized.hpp"
+
+namespace Flounder
+{
+	const uint32_t Impostor::FRAMES = 8;
+	const uint32_t Impostor::FRAME_SIZE = 64;
+	const float Impostor::EMPTY = 2.0f;
+
+	static void ReadBuffer(const Buffer &buffer, void *destination)
+	{
+		// Model buffers are host visible, so they are read back through a mapping instead of keeping a second copy of every model.
+		const auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		void *data;
+		vkMapMemory(logicalDevice, buffer.GetBufferMemory(), 0, buffer.GetSize(), 0, &data);
+		memcpy(destination, data, static_cast<size_t>(buffer.GetSize()));
+		vkUnmapMemory(logicalDevice, buffer.GetBufferMemory());
+	}
+
+	static float SignNotZero(const float &value)
+	{
+		return value >= 0.0f ? 1.0f : -1.0f;
+	}
+
+	Impostor::Impostor(Model *model) :
+		IResource(),
+		m_filename(GetName(model)),
+		m_model(model),
+		m_atlas(nullptr),
+		m_centre(Vector3(model->GetAabb()->GetCentreX(), model->GetAabb()->GetCentreY(), model->GetAabb()->GetCentreZ())),
+		m_radius(0.5f * Vector3(model->GetAabb()->GetWidth(), model->GetAabb()->GetHeight(), model->GetAabb()->GetDepth()).Length())
+	{
+#if FLOUNDER_VERBOSE
+		const auto debugStart = Engine::Get()->GetTimeMs();
+#endif
+
+		VertexBuffer *vertexBuffer = model->GetVertexBuffer();
+		IndexBuffer *indexBuffer = model->GetIndexBuffer();
+
+		if (vertexBuffer == nullptr || vertexBuffer->GetVertexCount() == 0 || vertexBuffer->GetSize() != sizeof(VertexModel) * vertexBuffer->GetVertexCount() ||
+			model->GetLods().empty() || m_radius <= 0.0f)
+		{
+			fprintf(stderr, "Impostor can not be baked for model '%s', it has no VertexModel vertices\n", model->GetFilename().c_str());
+			return;
+		}
+
+		std::vector<VertexModel> vertices = std::vector<VertexModel>(vertexBuffer->GetVertexCount());
+		std::vector<uint32_t> indices = std::vector<uint32_t>();
+		ReadBuffer(*vertexBuffer, vertices.data());
+
+		// Only the full level of detail is baked, the simplified levels follow it in the index buffer.
+		if (indexBuffer == nullptr)
+		{
+			for (uint32_t i = 0; i < vertexBuffer->GetVertexCount(); i++)
+			{
+				indices.push_back(i);
+			}
+		}
+		else
+		{
+			const MeshLod &lod = model->GetLods().at(0);
+			std::vector<uint8_t> indexData = std::vector<uint8_t>(static_cast<size_t>(indexBuffer->GetSize()));
+			ReadBuffer(*indexBuffer, indexData.data());
+
+			for (uint32_t i = lod.firstIndex; i < lod.firstIndex + lod.indexCount; i++)
+			{
+				indices.push_back(indexBuffer->GetIndexType() == VK_INDEX_TYPE_UINT16 ? reinterpret_cast<const uint16_t *>(indexData.data())[i] :
+					reinterpret_cast<const uint32_t *>(indexData.data())[i]);
+			}
+		}
+
+		const uint32_t size = FRAMES * FRAME_SIZE;
+		std::vector<uint16_t> texels = Bake(vertices, indices, m_centre, m_radius);
+		m_atlas = new Texture(size, size, texels.data(), VK_FORMAT_R16G16B16A16_SFLOAT, 4 * sizeof(uint16_t), true);
+
+#if FLOUNDER_VERBOSE
+		const auto debugEnd = Engine::Get()->GetTimeMs();
+		printf("Impostor '%s' baked in %fms\n", m_filename.c_str(), debugEnd - debugStart);
+#endif
+	}
+
+	Impostor::~Impostor()
+	{
+		delete m_atlas;
+	}
+
+	std::vector<uint16_t> Impostor::Bake(const std::vector<VertexModel> &vertices, const std::vector<uint32_t> &indices, const Vector3 &centre, const float &radius)
+	{
+		const uint32_t size = FRAMES * FRAME_SIZE;
+		const uint16_t empty = VertexModelQuantized::QuantizeHalf(EMPTY);
+		std::vector<uint16_t> texels = std::vector<uint16_t>(4 * size * size);
+
+		for (uint32_t i = 0; i < size * size; i++)
+		{
+			texels[4 * i + 3] = empty;
+		}
+
+		// Frames write to their own texels, so they are baked in parallel when there is a thread pool.
+		if (Tasks::Get() == nullptr)
+		{
+			for (uint32_t frame = 0; frame < FRAMES * FRAMES; frame++)
+			{
+				BakeFrame(vertices, indices, centre, radius, frame % FRAMES, frame / FRAMES, &texels);
+			}
+
+			return texels;
+		}
+
+		Tasks::Get()->GetThreadPool()->ParallelFor(FRAMES * FRAMES, [&](unsigned int start, unsigned int end)
+		{
+			for (unsigned int frame = start; frame < end; frame++)
+			{
+				BakeFrame(vertices, indices, centre, radius, frame % FRAMES, frame / FRAMES, &texels);
+			}
+		});
+
+		return texels;
+	}
+
+	Vector3 Impostor::GetFrameDirection(const uint32_t &frameX, const uint32_t &frameY)
+	{
+		// Frames sit on the corners of the grid, so the poles and the horizon are views of their own.
+		const float x = 2.0f * static_cast<float>(frameX) / static_cast<float>(FRAMES - 1) - 1.0f;
+		const float z = 2.0f * static_cast<float>(frameY) / static_cast<float>(FRAMES - 1) - 1.0f;
+		Vector3 direction = Vector3(x, 1.0f - std::fabs(x) - std::fabs(z), z);
+
+		// The lower half of the sphere is folded out over the corners of the grid.
+		if (direction.m_y < 0.0f)
+		{
+			direction.m_x = (1.0f - std::fabs(z)) * SignNotZero(x);
+			direction.m_z = (1.0f - std::fabs(x)) * SignNotZero(z);
+		}
+
+		direction.Normalize();
+		return direction;
+	}
+
+	std::string Impostor::GetName(Model *model)
+	{
+		// Models made at runtime have no file name, their address keeps them apart.
+		if (model->GetFilename().empty())
+		{
+			return "Impostor:" + std::to_string(reinterpret_cast<uintptr_t>(model));
+		}
+
+		return "Impostor:" + model->GetFilename();
+	}
+
+	void Impostor::BakeFrame(const std::vector<VertexModel> &vertices, const std::vector<uint32_t> &indices, const Vector3 &centre, const float &radius,
+		const uint32_t &frameX, const uint32_t &frameY, std::vector<uint16_t> *texels)
+	{
+		// The frame looks down its direction with the same axes Impostor.vert builds the quad from.
+		const Vector3 direction = GetFrameDirection(frameX, frameY);
+		const Vector3 reference = std::fabs(direction.m_y) > 0.999f ? Vector3(0.0f, 0.0f, 1.0f) : Vector3(0.0f, 1.0f, 0.0f);
+		Vector3 right = Vector3();
+		Vector3 up = Vector3();
+		Vector3::Cross(reference, direction, &right);
+		right.Normalize();
+		Vector3::Cross(direction, right, &up);
+
+		// Vertices are projected orthographically, the bounding sphere fills the frame and rows run from the top down.
+		const float halfSize = 0.5f * static_cast<float>(FRAME_SIZE);
+		const float scale = halfSize / radius;
+		std::vector<float> projected = std::vector<float>(3 * vertices.size());
+
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			const Vector3 &position = vertices[i].m_position;
+			const Vector3 offset = Vector3(position.m_x - centre.m_x, position.m_y - centre.m_y, position.m_z - centre.m_z);
+			projected[3 * i] = halfSize + Vector3::Dot(offset, right) * scale;
+			projected[3 * i + 1] = halfSize - Vector3::Dot(offset, up) * scale;
+			projected[3 * i + 2] = Vector3::Dot(offset, direction);
+		}
+
+		const int frameSize = static_cast<int>(FRAME_SIZE);
+		const uint32_t rowSize = FRAMES * FRAME_SIZE;
+		std::vector<float> depths = std::vector<float>(FRAME_SIZE * FRAME_SIZE, std::numeric_limits<float>::lowest());
+
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const float *a = &projected[3 * indices[i]];
+			const float *b = &projected[3 * indices[i + 1]];
+			const float *c = &projected[3 * indices[i + 2]];
+			const float area = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+
+			if (std::fabs(area) < 1e-8f)
+			{
+				continue;
+			}
+
+			const int minX = std::max(static_cast<int>(std::floor(std::min(a[0], std::min(b[0], c[0])))), 0);
+			const int minY = std::max(static_cast<int>(std::floor(std::min(a[1], std::min(b[1], c[1])))), 0);
+			const int maxX = std::min(static_cast<int>(std::ceil(std::max(a[0], std::max(b[0], c[0])))), frameSize - 1);
+			const int maxY = std::min(static_cast<int>(std::ceil(std::max(a[1], std::max(b[1], c[1])))), frameSize - 1);
+
+			const VertexModel &vertexA = vertices[indices[i]];
+			const VertexModel &vertexB = vertices[indices[i + 1]];
+			const VertexModel &vertexC = vertices[indices[i + 2]];
+
+			for (int y = minY; y <= maxY; y++)
+			{
+				for (int x = minX; x <= maxX; x++)
+				{
+					// Triangles are not culled by their winding, the nearest surface is kept by the depth test.
+					const float pixelX = static_cast<float>(x) + 0.5f;
+					const float pixelY = static_cast<float>(y) + 0.5f;
+					const float weightA = ((b[0] - pixelX) * (c[1] - pixelY) - (b[1] - pixelY) * (c[0] - pixelX)) / area;
+					const float weightB = ((c[0] - pixelX) * (a[1] - pixelY) - (c[1] - pixelY) * (a[0] - pixelX)) / area;
+					const float weightC = 1.0f - weightA - weightB;
+
+					if (weightA < 0.0f || weightB < 0.0f || weightC < 0.0f)
+					{
+						continue;
+					}
+
+					const float depth = weightA * a[2] + weightB * b[2] + weightC * c[2];
+					float &nearest = depths[x + frameSize * y];
+
+					if (depth <= nearest)
+					{
+						continue;
+					}
+
+					nearest = depth;
+
+					const float u = weightA * vertexA.m_uv.m_x + weightB * vertexB.m_uv.m_x + weightC * vertexC.m_uv.m_x;
+					const float v = weightA * vertexA.m_uv.m_y + weightB * vertexB.m_uv.m_y + weightC * vertexC.m_uv.m_y;
+					const float normalX = weightA * vertexA.m_normal.m_x + weightB * vertexB.m_normal.m_x + weightC * vertexC.m_normal.m_x;
+					const float normalY = weightA * vertexA.m_normal.m_y + weightB * vertexB.m_normal.m_y + weightC * vertexC.m_normal.m_y;
+					const float normalZ = weightA * vertexA.m_normal.m_z + weightB * vertexB.m_normal.m_z + weightC * vertexC.m_normal.m_z;
+					const float length = std::fabs(normalX) + std::fabs(normalY) + std::fabs(normalZ);
+
+					// Normals are octahedral encoded around z, Impostor.frag decodes them back into model space.
+					float encodedX = length > 0.0f ? normalX / length : 0.0f;
+					float encodedY = length > 0.0f ? normalY / length : 0.0f;
+
+					if (normalZ < 0.0f)
+					{
+						const float foldedX = (1.0f - std::fabs(encodedY)) * SignNotZero(encodedX);
+						encodedY = (1.0f - std::fabs(encodedX)) * SignNotZero(encodedY);
+						encodedX = foldedX;
+					}
+
+					uint16_t *texel = &(*texels)[4 * ((frameX * FRAME_SIZE + x) + rowSize * (frameY * FRAME_SIZE + y))];
+					texel[0] = VertexModelQuantized::QuantizeHalf(u);
+					texel[1] = VertexModelQuantized::QuantizeHalf(v);
+					texel[2] = VertexModelQuantized::QuantizeHalf(encodedX);
+					texel[3] = VertexModelQuantized::QuantizeHalf(encodedY);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "../Maths/Vector3.hpp"
+#include "../Resources/Resources.hpp"
+#include "../Textures/Texture.hpp"
+#include "Model.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// A billboard stand in for a model seen from far away, baked once at load time into an atlas of views.
+	/// The views look at the models bounding sphere from directions spread over the sphere by an octahedral mapping, a grid of FRAMES by FRAMES frames.
+	/// Every atlas texel holds the models uv and octahedral encoded model space normal where it was seen, so one atlas is shared by every material the model is drawn with.
+	/// Texels the model does not cover have their alpha set to EMPTY.
+	/// </summary>
+	class F_EXPORT Impostor :
+		public IResource
+	{
+	private:
+		std::string m_filename;
+		Model *m_model;
+		Texture *m_atlas;
+		Vector3 m_centre;
+		float m_radius;
+	public:
+		static const uint32_t FRAMES;
+		static const uint32_t FRAME_SIZE;
+		static const float EMPTY;
+
+		static Impostor *Resource(Model *model)
+		{
+			IResource *resource = Resources::Get()->Get(GetName(model));
+
+			if (resource != nullptr)
+			{
+				return dynamic_cast<Impostor *>(resource);
+			}
+
+			Impostor *result = new Impostor(model);
+			Resources::Get()->Add(dynamic_cast<IResource *>(result));
+			return result;
+		}
+
+		/// <summary>
+		/// Creates a new impostor, baking the atlas from the models full level of detail.
+		/// Only models with <seealso cref="VertexModel"/> vertices can be baked, other models get no atlas.
+		/// </summary>
+		/// <param name="model"> The model to bake. </param>
+		Impostor(Model *model);
+
+		/// <summary>
+		/// Deconstructor for the impostor.
+		/// </summary>
+		~Impostor();
+
+		std::string GetFilename() override { return m_filename; }
+
+		Model *GetModel() const { return m_model; }
+
+		/// <summary>
+		/// Gets the atlas of views, this is null when the model could not be baked.
+		/// </summary>
+		/// <returns> The atlas. </returns>
+		Texture *GetAtlas() const { return m_atlas; }
+
+		Vector3 GetCentre() const { return m_centre; }
+
+		float GetRadius() const { return m_radius; }
+
+		/// <summary>
+		/// Rasterizes every view of a mesh into atlas texels, four half floats per texel.
+		/// </summary>
+		/// <param name="vertices"> The mesh vertices. </param>
+		/// <param name="indices"> The mesh triangle list. </param>
+		/// <param name="centre"> The centre of the meshes bounding sphere. </param>
+		/// <param name="radius"> The radius of the meshes bounding sphere. </param>
+		/// <returns> The atlas texels, FRAMES * FRAME_SIZE texels wide and high. </returns>
+		static std::vector<uint16_t> Bake(const std::vector<VertexModel> &vertices, const std::vector<uint32_t> &indices, const Vector3 &centre, const float &radius);
+
+		/// <summary>
+		/// Gets the direction a frame sees the model from, pointing from the model towards the viewer.
+		/// Impostor.vert maps view directions to frames the same way.
+		/// </summary>
+		/// <param name="frameX"> The frames column in the atlas. </param>
+		/// <param name="frameY"> The frames row in the atlas. </param>
+		/// <returns> The unit view direction. </returns>
+		static Vector3 GetFrameDirection(const uint32_t &frameX, const uint32_t &frameY);
+
+		static std::string GetName(Model *model);
+	private:
+		static void BakeFrame(const std::vector<VertexModel> &vertices, const std::vector<uint32_t> &indices, const Vector3 &centre, const float &radius,
+			const uint32_t &frameX, const uint32_t &frameY, std::vector<uint16_t> *texels);
+	};
+}
@@ -0,0 +1,765 @@
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <unordered_map>
+#include "../Tasks/Tasks.hpp"
+
+namespace Flounder
+{
+	const uint32_t MeshOptimizer::CACHE_SIZE = 16;
+	const float MeshOptimizer::OVERDRAW_THRESHOLD = 1.05f;
+	const uint32_t MeshOptimizer::MAX_LODS = 5;
+	const float MeshOptimizer::LOD_MAX_ERROR = 0.1f;
+	const float MeshOptimizer::LOD_SCREEN_ERROR = 0.001f;
+
+	static const size_t LOD_MIN_INDICES = 3 * 32;
+	static const float LOD_MIN_REDUCTION = 0.9f;
+	static const size_t LOD_PARALLEL_INDICES = 3 * 16384;
+
+	static const uint32_t FORSYTH_CACHE_SIZE = 32;
+	static const float FORSYTH_DECAY_POWER = 1.5f;
+	static const float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+	static const float FORSYTH_VALENCE_SCALE = 2.0f;
+	static const float FORSYTH_VALENCE_POWER = -0.5f;
+
+	static const uint32_t FORSYTH_MAX_VALENCE = 32;
+
+	/// <summary>
+	/// The sum of squared distances to a set of planes, as a symmetric 4x4 matrix.
+	/// </summary>
+	struct Quadric
+	{
+		double a00, a01, a02, a11, a12, a22;
+		double b0, b1, b2;
+		double c;
+	};
+
+	static void AddPlane(Quadric *quadric, const double normal[3], const double &distance, const double &weight)
+	{
+		quadric->a00 += weight * normal[0] * normal[0];
+		quadric->a01 += weight * normal[0] * normal[1];
+		quadric->a02 += weight * normal[0] * normal[2];
+		quadric->a11 += weight * normal[1] * normal[1];
+		quadric->a12 += weight * normal[1] * normal[2];
+		quadric->a22 += weight * normal[2] * normal[2];
+		quadric->b0 += weight * normal[0] * distance;
+		quadric->b1 += weight * normal[1] * distance;
+		quadric->b2 += weight * normal[2] * distance;
+		quadric->c += weight * distance * distance;
+	}
+
+	static void AddQuadric(Quadric *quadric, const Quadric &other)
+	{
+		quadric->a00 += other.a00;
+		quadric->a01 += other.a01;
+		quadric->a02 += other.a02;
+		quadric->a11 += other.a11;
+		quadric->a12 += other.a12;
+		quadric->a22 += other.a22;
+		quadric->b0 += other.b0;
+		quadric->b1 += other.b1;
+		quadric->b2 += other.b2;
+		quadric->c += other.c;
+	}
+
+	static double GetQuadricError(const Quadric &a, const Quadric &b, const float *point)
+	{
+		// Evaluates (a + b) at the point, p'Ap + 2b'p + c, the sum of weighted squared distances to every plane.
+		const double x = point[0];
+		const double y = point[1];
+		const double z = point[2];
+		const double axx = (a.a00 + b.a00) * x * x + (a.a11 + b.a11) * y * y + (a.a22 + b.a22) * z * z;
+		const double axy = 2.0 * ((a.a01 + b.a01) * x * y + (a.a02 + b.a02) * x * z + (a.a12 + b.a12) * y * z);
+		const double bx = 2.0 * ((a.b0 + b.b0) * x + (a.b1 + b.b1) * y + (a.b2 + b.b2) * z);
+		return std::max(axx + axy + bx + a.c + b.c, 0.0);
+	}
+
+	static void GetNormal(const float *p0, const float *p1, const float *p2, double normal[3])
+	{
+		const double e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+		const double e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+		normal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+		normal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+		normal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+	}
+
+	static float GetVertexScore(const int32_t &cachePosition, const uint32_t &remaining)
+	{
+		// Scores are looked up from tables, working them out for each vertex each step dominates the optimisation.
+		static const std::vector<float> cacheScores = []()
+		{
+			// The last triangles vertices get a fixed score, so the next triangle does not just reuse two of them.
+			std::vector<float> scores = std::vector<float>(FORSYTH_CACHE_SIZE, FORSYTH_LAST_TRIANGLE_SCORE);
+			const float scale = 1.0f / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+
+			for (uint32_t i = 3; i < FORSYTH_CACHE_SIZE; i++)
+			{
+				scores[i] = std::pow(1.0f - static_cast<float>(i - 3) * scale, FORSYTH_DECAY_POWER);
+			}
+
+			return scores;
+		}();
+		static const std::vector<float> valenceScores = []()
+		{
+			// Vertices with few triangles left are finished off first, so they do not have to be shaded again later.
+			std::vector<float> scores = std::vector<float>(FORSYTH_MAX_VALENCE, 0.0f);
+
+			for (uint32_t i = 1; i < FORSYTH_MAX_VALENCE; i++)
+			{
+				scores[i] = FORSYTH_VALENCE_SCALE * std::pow(static_cast<float>(i), FORSYTH_VALENCE_POWER);
+			}
+
+			return scores;
+		}();
+
+		// Vertices with no triangles left are never chosen.
+		if (remaining == 0)
+		{
+			return -1.0f;
+		}
+
+		const float cacheScore = cachePosition >= 0 ? cacheScores[cachePosition] : 0.0f;
+		const float valenceScore = remaining < FORSYTH_MAX_VALENCE ? valenceScores[remaining] :
+			FORSYTH_VALENCE_SCALE * std::pow(static_cast<float>(remaining), FORSYTH_VALENCE_POWER);
+		return cacheScore + valenceScore;
+	}
+
+	void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t> &indices, const size_t &vertexCount)
+	{
+		const size_t triangleCount = indices.size() / 3;
+
+		if (triangleCount == 0)
+		{
+			return;
+		}
+
+		// The triangles of each vertex are packed into one array, a vertex keeps its triangles left to draw at the front of its range.
+		std::vector<uint32_t> adjacencyOffsets = std::vector<uint32_t>(vertexCount + 1, 0);
+		std::vector<uint32_t> adjacency = std::vector<uint32_t>(indices.size());
+		std::vector<uint32_t> remaining = std::vector<uint32_t>(vertexCount, 0);
+
+		for (auto index : indices)
+		{
+			adjacencyOffsets[index + 1]++;
+		}
+
+		for (size_t i = 0; i < vertexCount; i++)
+		{
+			adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+		}
+
+		for (uint32_t triangle = 0; triangle < triangleCount; triangle++)
+		{
+			for (size_t i = 0; i < 3; i++)
+			{
+				const uint32_t vertex = indices[3 * triangle + i];
+				adjacency[adjacencyOffsets[vertex] + remaining[vertex]++] = triangle;
+			}
+		}
+
+		std::vector<int32_t> cachePositions = std::vector<int32_t>(vertexCount, -1);
+		std::vector<float> vertexScores = std::vector<float>(vertexCount);
+		std::vector<float> triangleScores = std::vector<float>(triangleCount, 0.0f);
+		std::vector<bool> emitted = std::vector<bool>(triangleCount, false);
+
+		for (size_t i = 0; i < vertexCount; i++)
+		{
+			vertexScores[i] = GetVertexScore(-1, remaining[i]);
+		}
+
+		int64_t best = 0;
+
+		for (size_t triangle = 0; triangle < triangleCount; triangle++)
+		{
+			for (size_t i = 0; i < 3; i++)
+			{
+				triangleScores[triangle] += vertexScores[indices[3 * triangle + i]];
+			}
+
+			if (triangleScores[triangle] > triangleScores[best])
+			{
+				best = static_cast<int64_t>(triangle);
+			}
+		}
+
+		std::vector<uint32_t> cache = std::vector<uint32_t>();
+		std::vector<uint32_t> newCache = std::vector<uint32_t>();
+		std::vector<uint32_t> result = std::vector<uint32_t>();
+		cache.reserve(FORSYTH_CACHE_SIZE + 3);
+		newCache.reserve(FORSYTH_CACHE_SIZE + 3);
+		result.reserve(indices.size());
+		size_t cursor = 0;
+
+		while (result.size() < 3 * triangleCount)
+		{
+			// When no cached vertex has triangles left, carries on from the next triangle not drawn yet.
+			if (best < 0)
+			{
+				while (emitted[cursor])
+				{
+					cursor++;
+				}
+
+				best = static_cast<int64_t>(cursor);
+			}
+
+			const uint32_t triangle = static_cast<uint32_t>(best);
+			const uint32_t *corners = &indices[3 * triangle];
+			emitted[triangle] = true;
+			newCache.clear();
+
+			for (size_t i = 0; i < 3; i++)
+			{
+				const uint32_t vertex = corners[i];
+				result.push_back(vertex);
+
+				uint32_t *triangles = &adjacency[adjacencyOffsets[vertex]];
+				uint32_t *last = triangles + remaining[vertex] - 1;
+				*std::find(triangles, last, triangle) = *last;
+				remaining[vertex]--;
+
+				if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+				{
+					newCache.push_back(vertex);
+				}
+			}
+
+			for (auto vertex : cache)
+			{
+				if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2])
+				{
+					newCache.push_back(vertex);
+				}
+			}
+
+			// Rescores every vertex that moved in the cache or fell out of it, along with the triangles they are in.
+			for (size_t i = 0; i < newCache.size(); i++)
+			{
+				const uint32_t vertex = newCache[i];
+				cachePositions[vertex] = i < FORSYTH_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+				const float score = GetVertexScore(cachePositions[vertex], remaining[vertex]);
+				const float delta = score - vertexScores[vertex];
+				vertexScores[vertex] = score;
+
+				for (uint32_t j = adjacencyOffsets[vertex]; j < adjacencyOffsets[vertex] + remaining[vertex]; j++)
+				{
+					triangleScores[adjacency[j]] += delta;
+				}
+			}
+
+			newCache.resize(std::min(newCache.size(), static_cast<size_t>(FORSYTH_CACHE_SIZE)));
+			cache.swap(newCache);
+
+			// The next triangle is the best one touching the cache.
+			best = -1;
+			float bestScore = -1.0f;
+
+			for (auto vertex : cache)
+			{
+				for (uint32_t j = adjacencyOffsets[vertex]; j < adjacencyOffsets[vertex] + remaining[vertex]; j++)
+				{
+					if (triangleScores[adjacency[j]] > bestScore)
+					{
+						best = adjacency[j];
+						bestScore = triangleScores[adjacency[j]];
+					}
+				}
+			}
+		}
+
+		indices.swap(result);
+	}
+
+	void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t> &indices, const std::vector<Vector3> &positions, const float &threshold)
+	{
+		const size_t triangleCount = indices.size() / 3;
+
+		if (triangleCount < 2)
+		{
+			return;
+		}
+
+		// Clusters start at triangles that miss the cache on every vertex, moving them does not make the cache any colder.
+		std::vector<size_t> clusters = std::vector<size_t>();
+		std::vector<uint32_t> timestamps = std::vector<uint32_t>(positions.size(), 0);
+		uint32_t timestamp = CACHE_SIZE + 1;
+
+		for (size_t triangle = 0; triangle < triangleCount; triangle++)
+		{
+			uint32_t misses = 0;
+
+			for (size_t i = 0; i < 3; i++)
+			{
+				const uint32_t vertex = indices[3 * triangle + i];
+
+				if (timestamp - timestamps[vertex] > CACHE_SIZE)
+				{
+					timestamps[vertex] = timestamp++;
+					misses++;
+				}
+			}
+
+			if (misses == 3)
+			{
+				clusters.push_back(triangle);
+			}
+		}
+
+		if (clusters.size() < 2)
+		{
+			return;
+		}
+
+		clusters.push_back(triangleCount);
+
+		// Each cluster is sorted by how far its area weighted centre lies along its average normal, from the middle of the mesh.
+		std::vector<float> centres = std::vector<float>(3 * (clusters.size() - 1), 0.0f);
+		std::vector<float> normals = std::vector<float>(3 * (clusters.size() - 1), 0.0f);
+		float meshCentre[3] = {0.0f, 0.0f, 0.0f};
+		float meshArea = 0.0f;
+
+		for (size_t cluster = 0; cluster + 1 < clusters.size(); cluster++)
+		{
+			float *centre = &centres[3 * cluster];
+			float *normal = &normals[3 * cluster];
+			float clusterArea = 0.0f;
+
+			for (size_t triangle = clusters[cluster]; triangle < clusters[cluster + 1]; triangle++)
+			{
+				const Vector3 &p0 = positions[indices[3 * triangle + 0]];
+				const Vector3 &p1 = positions[indices[3 * triangle + 1]];
+				const Vector3 &p2 = positions[indices[3 * triangle + 2]];
+				const float e1[3] = {p1.m_x - p0.m_x, p1.m_y - p0.m_y, p1.m_z - p0.m_z};
+				const float e2[3] = {p2.m_x - p0.m_x, p2.m_y - p0.m_y, p2.m_z - p0.m_z};
+				const float cross[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+				const float area = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+
+				centre[0] += area * (p0.m_x + p1.m_x + p2.m_x) / 3.0f;
+				centre[1] += area * (p0.m_y + p1.m_y + p2.m_y) / 3.0f;
+				centre[2] += area * (p0.m_z + p1.m_z + p2.m_z) / 3.0f;
+				normal[0] += cross[0];
+				normal[1] += cross[1];
+				normal[2] += cross[2];
+				clusterArea += area;
+			}
+
+			for (size_t i = 0; i < 3; i++)
+			{
+				meshCentre[i] += centre[i];
+				centre[i] = clusterArea > 0.0f ? centre[i] / clusterArea : 0.0f;
+			}
+
+			meshArea += clusterArea;
+		}
+
+		if (meshArea > 0.0f)
+		{
+			for (size_t i = 0; i < 3; i++)
+			{
+				meshCentre[i] /= meshArea;
+			}
+		}
+
+		std::vector<float> keys = std::vector<float>(clusters.size() - 1);
+		std::vector<size_t> order = std::vector<size_t>(clusters.size() - 1);
+
+		for (size_t cluster = 0; cluster < keys.size(); cluster++)
+		{
+			const float *centre = &centres[3 * cluster];
+			const float *normal = &normals[3 * cluster];
+			const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+			const float dot = (centre[0] - meshCentre[0]) * normal[0] + (centre[1] - meshCentre[1]) * normal[1] + (centre[2] - meshCentre[2]) * normal[2];
+			keys[cluster] = length > 0.0f ? dot / length : 0.0f;
+			order[cluster] = cluster;
+		}
+
+		std::stable_sort(order.begin(), order.end(), [&keys](const size_t &a, const size_t &b)
+		{
+			return keys[a] > keys[b];
+		});
+
+		std::vector<uint32_t> result = std::vector<uint32_t>();
+		result.reserve(indices.size());
+
+		for (auto cluster : order)
+		{
+			result.insert(result.end(), indices.begin() + 3 * clusters[cluster], indices.begin() + 3 * clusters[cluster + 1]);
+		}
+
+		if (GetStats(result, positions.size()).acmr <= threshold * GetStats(indices, positions.size()).acmr)
+		{
+			indices.swap(result);
+		}
+	}
+
+	std::vector<uint32_t> MeshOptimizer::Simplify(const std::vector<uint32_t> &indices, const std::vector<Vector3> &positions, const size_t &targetIndexCount,
+		const float &maxError, float *error)
+	{
+		const size_t vertexCount = positions.size();
+		std::vector<uint32_t> result = indices;
+		*error = 0.0f;
+
+		if (indices.size() <= targetIndexCount || vertexCount == 0)
+		{
+			return result;
+		}
+
+		// Positions are scaled into a unit box, so errors are relative to the size of the mesh.
+		float minExtents[3] = {positions[0].m_x, positions[0].m_y, positions[0].m_z};
+		float maxExtents[3] = {positions[0].m_x, positions[0].m_y, positions[0].m_z};
+
+		for (auto &position : positions)
+		{
+			minExtents[0] = std::min(minExtents[0], position.m_x);
+			minExtents[1] = std::min(minExtents[1], position.m_y);
+			minExtents[2] = std::min(minExtents[2], position.m_z);
+			maxExtents[0] = std::max(maxExtents[0], position.m_x);
+			maxExtents[1] = std::max(maxExtents[1], position.m_y);
+			maxExtents[2] = std::max(maxExtents[2], position.m_z);
+		}
+
+		const float extent = std::max(maxExtents[0] - minExtents[0], std::max(maxExtents[1] - minExtents[1], maxExtents[2] - minExtents[2]));
+		const float scale = extent > 0.0f ? 1.0f / extent : 1.0f;
+		std::vector<float> points = std::vector<float>(3 * vertexCount);
+
+		for (size_t i = 0; i < vertexCount; i++)
+		{
+			points[3 * i + 0] = (positions[i].m_x - minExtents[0]) * scale;
+			points[3 * i + 1] = (positions[i].m_y - minExtents[1]) * scale;
+			points[3 * i + 2] = (positions[i].m_z - minExtents[2]) * scale;
+		}
+
+		// Edges with a triangle on only one side are borders, or seams where vertices are split for their UVs or normals.
+		std::unordered_map<uint64_t, uint32_t> edges = std::unordered_map<uint64_t, uint32_t>();
+		edges.reserve(indices.size());
+
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			for (size_t j = 0; j < 3; j++)
+			{
+				const uint64_t a = std::min(indices[i + j], indices[i + (j + 1) % 3]);
+				const uint64_t b = std::max(indices[i + j], indices[i + (j + 1) % 3]);
+				edges[(a << 32) | b]++;
+			}
+		}
+
+		std::vector<bool> locked = std::vector<bool>(vertexCount, false);
+
+		for (auto &edge : edges)
+		{
+			if (edge.second != 2)
+			{
+				locked[edge.first >> 32] = true;
+				locked[edge.first & 0xffffffff] = true;
+			}
+		}
+
+		// Each vertex starts with the planes of its triangles, weighted by their area.
+		std::vector<Quadric> quadrics = std::vector<Quadric>(vertexCount, Quadric{});
+
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			double normal[3];
+			const float *p0 = &points[3 * indices[i]];
+			GetNormal(p0, &points[3 * indices[i + 1]], &points[3 * indices[i + 2]], normal);
+			const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+			if (length <= 0.0)
+			{
+				continue;
+			}
+
+			normal[0] /= length;
+			normal[1] /= length;
+			normal[2] /= length;
+			const double distance = -(normal[0] * p0[0] + normal[1] * p0[1] + normal[2] * p0[2]);
+
+			for (size_t j = 0; j < 3; j++)
+			{
+				AddPlane(&quadrics[indices[i + j]], normal, distance, 0.5 * length);
+			}
+		}
+
+		struct Collapse
+		{
+			uint32_t from;
+			uint32_t to;
+			double cost;
+		};
+
+		const double maxCost = static_cast<double>(maxError) * static_cast<double>(maxError);
+		std::vector<Collapse> collapses = std::vector<Collapse>();
+		std::vector<uint32_t> adjacencyOffsets = std::vector<uint32_t>(vertexCount + 1);
+		std::vector<uint32_t> adjacency = std::vector<uint32_t>();
+		std::vector<bool> touched = std::vector<bool>(vertexCount);
+		std::vector<uint32_t> remap = std::vector<uint32_t>(vertexCount);
+		double worstCost = 0.0;
+
+		while (result.size() > targetIndexCount)
+		{
+			// Every edge is costed collapsing onto whichever end moves the surface least, each edge is seen from one side.
+			collapses.clear();
+
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				for (size_t j = 0; j < 3; j++)
+				{
+					const uint32_t a = result[i + j];
+					const uint32_t b = result[i + (j + 1) % 3];
+
+					if (a > b)
+					{
+						continue;
+					}
+
+					const double costAb = locked[a] ? std::numeric_limits<double>::max() : GetQuadricError(quadrics[a], quadrics[b], &points[3 * b]);
+					const double costBa = locked[b] ? std::numeric_limits<double>::max() : GetQuadricError(quadrics[a], quadrics[b], &points[3 * a]);
+
+					if (std::min(costAb, costBa) <= maxCost)
+					{
+						collapses.push_back(costAb <= costBa ? Collapse{a, b, costAb} : Collapse{b, a, costBa});
+					}
+				}
+			}
+
+			if (collapses.empty())
+			{
+				break;
+			}
+
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse &a, const Collapse &b)
+			{
+				return a.cost < b.cost;
+			});
+
+			// Triangles around each vertex, to check collapses do not flip any of them.
+			std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+
+			for (auto index : result)
+			{
+				adjacencyOffsets[index + 1]++;
+			}
+
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+			}
+
+			adjacency.resize(result.size());
+			std::vector<uint32_t> fill = std::vector<uint32_t>(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+			for (size_t i = 0; i < result.size(); i++)
+			{
+				adjacency[fill[result[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+
+			// A pass collapses the cheapest edges, a collapse removes about two triangles.
+			// Vertices around a collapse are left alone for the rest of the pass, so every flip check sees the mesh as it will be.
+			std::fill(touched.begin(), touched.end(), false);
+
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				remap[i] = static_cast<uint32_t>(i);
+			}
+
+			const size_t collapseGoal = (result.size() - targetIndexCount) / 6 + 1;
+			size_t collapsed = 0;
+
+			for (auto &collapse : collapses)
+			{
+				if (touched[collapse.from] || touched[collapse.to])
+				{
+					continue;
+				}
+
+				bool flips = false;
+
+				for (uint32_t j = adjacencyOffsets[collapse.from]; j < adjacencyOffsets[collapse.from + 1] && !flips; j++)
+				{
+					const uint32_t *triangle = &result[3 * adjacency[j]];
+
+					if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+					{
+						continue;
+					}
+
+					const float *corners[3];
+					double before[3];
+					double after[3];
+
+					for (size_t k = 0; k < 3; k++)
+					{
+						corners[k] = &points[3 * triangle[k]];
+					}
+
+					GetNormal(corners[0], corners[1], corners[2], before);
+
+					for (size_t k = 0; k < 3; k++)
+					{
+						corners[k] = &points[3 * (triangle[k] == collapse.from ? collapse.to : triangle[k])];
+					}
+
+					GetNormal(corners[0], corners[1], corners[2], after);
+					flips = before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0;
+				}
+
+				if (flips)
+				{
+					continue;
+				}
+
+				for (uint32_t j = adjacencyOffsets[collapse.from]; j < adjacencyOffsets[collapse.from + 1]; j++)
+				{
+					for (size_t k = 0; k < 3; k++)
+					{
+						touched[result[3 * adjacency[j] + k]] = true;
+					}
+				}
+
+				remap[collapse.from] = collapse.to;
+				AddQuadric(&quadrics[collapse.to], quadrics[collapse.from]);
+				worstCost = std::max(worstCost, collapse.cost);
+
+				if (++collapsed >= collapseGoal)
+				{
+					break;
+				}
+			}
+
+			if (collapsed == 0)
+			{
+				break;
+			}
+
+			// Triangles that lost a corner to a collapse are removed.
+			size_t write = 0;
+
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				const uint32_t a = remap[result[i]];
+				const uint32_t b = remap[result[i + 1]];
+				const uint32_t c = remap[result[i + 2]];
+
+				if (a != b && b != c && c != a)
+				{
+					result[write++] = a;
+					result[write++] = b;
+					result[write++] = c;
+				}
+			}
+
+			result.resize(write);
+		}
+
+		*error = static_cast<float>(std::sqrt(worstCost));
+		return result;
+	}
+
+	std::vector<MeshLod> MeshOptimizer::GenerateLods(const std::vector<Vector3> &positions, std::vector<uint32_t> &indices)
+	{
+		std::vector<MeshLod> lods = std::vector<MeshLod>();
+		lods.push_back({0, static_cast<uint32_t>(indices.size()), 0.0f, std::numeric_limits<float>::infinity()});
+
+		const size_t levelCount = MAX_LODS - 1;
+		std::vector<std::vector<uint32_t>> levels = std::vector<std::vector<uint32_t>>(levelCount);
+		std::vector<float> errors = std::vector<float>(levelCount, 0.0f);
+
+		auto simplify = [&](const size_t &level)
+		{
+			const size_t target = 3 * ((indices.size() / 3) >> (level + 1));
+			levels[level] = Simplify(indices, positions, std::max(target, LOD_MIN_INDICES), LOD_MAX_ERROR, &errors[level]);
+			OptimizeVertexCache(levels[level], positions.size());
+		};
+
+		if (indices.size() >= LOD_PARALLEL_INDICES && Tasks::Get() != nullptr)
+		{
+			std::vector<std::future<void>> jobs = std::vector<std::future<void>>();
+
+			for (size_t level = 0; level < levelCount; level++)
+			{
+				jobs.push_back(Tasks::Get()->GetThreadPool()->Enqueue([&simplify, level]()
+				{
+					simplify(level);
+				}));
+			}
+
+			for (auto &job : jobs)
+			{
+				job.wait();
+			}
+		}
+		else
+		{
+			for (size_t level = 0; level < levelCount; level++)
+			{
+				simplify(level);
+			}
+		}
+
+		// Levels are kept while they are noticeably smaller than the last, a level with no error can replace the full mesh anywhere.
+		for (size_t level = 0; level < levelCount; level++)
+		{
+			const MeshLod &previous = lods.back();
+
+			if (levels[level].size() < LOD_MIN_INDICES || static_cast<float>(levels[level].size()) > LOD_MIN_REDUCTION * static_cast<float>(previous.indexCount))
+			{
+				break;
+			}
+
+			MeshLod lod = {};
+			lod.firstIndex = static_cast<uint32_t>(indices.size());
+			lod.indexCount = static_cast<uint32_t>(levels[level].size());
+			lod.error = std::max(errors[level], previous.error);
+			lod.screenSize = lod.error > 0.0f ? LOD_SCREEN_ERROR / lod.error : std::numeric_limits<float>::infinity();
+			indices.insert(indices.end(), levels[level].begin(), levels[level].end());
+			lods.push_back(lod);
+		}
+
+		return lods;
+	}
+
+	MeshOptimizer::Stats MeshOptimizer::GetStats(const std::vector<uint32_t> &indices, const size_t &vertexCount)
+	{
+		// A vertex is in the cache while fewer than the cache size vertices have missed since it was last loaded.
+		std::vector<uint32_t> timestamps = std::vector<uint32_t>(vertexCount, 0);
+		uint32_t timestamp = CACHE_SIZE + 1;
+		uint32_t misses = 0;
+
+		for (auto index : indices)
+		{
+			if (timestamp - timestamps[index] > CACHE_SIZE)
+			{
+				timestamps[index] = timestamp++;
+				misses++;
+			}
+		}
+
+		Stats stats = {};
+		stats.acmr = indices.size() < 3 ? 0.0f : static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+		stats.atvr = vertexCount == 0 ? 0.0f : static_cast<float>(misses) / static_cast<float>(vertexCount);
+		return stats;
+	}
+
+	std::vector<uint32_t> MeshOptimizer::RemapVertexFetch(std::vector<uint32_t> &indices, const size_t &vertexCount)
+	{
+		std::vector<uint32_t> remap = std::vector<uint32_t>(vertexCount, std::numeric_limits<uint32_t>::max());
+		std::vector<uint32_t> order = std::vector<uint32_t>();
+		order.reserve(vertexCount);
+
+		for (auto &index : indices)
+		{
+			if (remap[index] == std::numeric_limits<uint32_t>::max())
+			{
+				remap[index] = static_cast<uint32_t>(order.size());
+				order.push_back(index);
+			}
+
+			index = remap[index];
+		}
+
+		return order;
+	}
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <vector>
+#include "../Maths/Vector3.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// A level of detail of a mesh, a range of its indices drawn over the same vertices as the full mesh.
+	/// </summary>
+	struct MeshLod
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		float error; // The largest distance the surface moved, relative to the size of the mesh.
+		float screenSize; // The level is drawn once the mesh covers less than this fraction of the screen height.
+	};
+
+	/// <summary>
+	/// Reorders the triangles and vertices of indexed meshes so the GPU shades and fetches fewer vertices.
+	/// Triangles are first ordered for the post transform vertex cache, then clusters of them are sorted so outer facing
+	/// clusters are drawn first to reduce overdraw, then vertices are ordered by first use so fetches are sequential.
+	/// None of the passes change how the mesh looks. Levels of detail are simplified with quadric error metrics.
+	/// </summary>
+	class F_EXPORT MeshOptimizer
+	{
+	public:
+		/// <summary>
+		/// How well a mesh uses a simulated FIFO vertex cache.
+		/// </summary>
+		struct Stats
+		{
+			float acmr; // Average cache miss ratio, vertices shaded per triangle, 0.5 is ideal for large meshes and 3 is the worst.
+			float atvr; // Average transformed vertex ratio, vertices shaded per vertex, 1 is ideal.
+		};
+
+		static const uint32_t CACHE_SIZE;
+		static const float OVERDRAW_THRESHOLD;
+		static const uint32_t MAX_LODS;
+		static const float LOD_MAX_ERROR;
+		static const float LOD_SCREEN_ERROR;
+
+		/// <summary>
+		/// Runs every pass over a mesh, vertices no triangle uses are removed.
+		/// </summary>
+		/// <param name="vertices"> The mesh vertices, any vertex type with a m_position. </param>
+		/// <param name="indices"> The mesh triangle indices. </param>
+		template<typename T>
+		static void Optimize(std::vector<T> &vertices, std::vector<uint32_t> &indices)
+		{
+			OptimizeVertexCache(indices, vertices.size());
+			OptimizeOverdraw(indices, vertices, OVERDRAW_THRESHOLD);
+			OptimizeVertexFetch(vertices, indices);
+		}
+
+		/// <summary>
+		/// Reorders triangles so vertices are reused while they are still in the post transform cache.
+		/// Uses Tom Forsyth's linear speed vertex cache optimisation, which does not depend on the exact cache size.
+		/// </summary>
+		/// <param name="indices"> The triangle indices to reorder. </param>
+		/// <param name="vertexCount"> The number of vertices. </param>
+		static void OptimizeVertexCache(std::vector<uint32_t> &indices, const size_t &vertexCount);
+
+		/// <summary>
+		/// Reorders clusters of triangles so those facing out from the middle of the mesh are drawn first.
+		/// Clusters start where the cache is cold anyway, the order is kept if it would miss the cache more than the threshold allows.
+		/// </summary>
+		/// <param name="indices"> The triangle indices, already ordered for the vertex cache. </param>
+		/// <param name="vertices"> The mesh vertices, any vertex type with a m_position. </param>
+		/// <param name="threshold"> How much the cache miss ratio may grow by, 1.05 allows 5% more misses. </param>
+		template<typename T>
+		static void OptimizeOverdraw(std::vector<uint32_t> &indices, const std::vector<T> &vertices, const float &threshold)
+		{
+			std::vector<Vector3> positions = std::vector<Vector3>();
+			positions.reserve(vertices.size());
+
+			for (auto &vertex : vertices)
+			{
+				positions.push_back(vertex.m_position);
+			}
+
+			OptimizeOverdraw(indices, positions, threshold);
+		}
+
+		static void OptimizeOverdraw(std::vector<uint32_t> &indices, const std::vector<Vector3> &positions, const float &threshold);
+
+		/// <summary>
+		/// Reorders vertices into the order the triangles first use them, vertices no triangle uses are removed.
+		/// </summary>
+		/// <param name="vertices"> The vertices to reorder. </param>
+		/// <param name="indices"> The triangle indices, remapped to the new order. </param>
+		template<typename T>
+		static void OptimizeVertexFetch(std::vector<T> &vertices, std::vector<uint32_t> &indices)
+		{
+			const std::vector<uint32_t> order = RemapVertexFetch(indices, vertices.size());
+			std::vector<T> result = std::vector<T>();
+			result.reserve(order.size());
+
+			for (auto vertex : order)
+			{
+				result.push_back(vertices[vertex]);
+			}
+
+			vertices.swap(result);
+		}
+
+		/// <summary>
+		/// Simplifies a mesh with quadric error metrics, collapsing edges onto one of their vertices so no vertices are added or moved.
+		/// Vertices on borders and on UV or normal seams are never collapsed, so the mesh keeps its outline and its mapping.
+		/// </summary>
+		/// <param name="indices"> The triangle indices. </param>
+		/// <param name="positions"> The vertex positions. </param>
+		/// <param name="targetIndexCount"> The number of indices to simplify down to. </param>
+		/// <param name="maxError"> The largest distance the surface may move, relative to the size of the mesh. </param>
+		/// <param name="error"> Set to the largest distance the surface moved, relative to the size of the mesh. </param>
+		/// <returns> The simplified triangle indices, there are more than the target when the error limit is reached first. </returns>
+		static std::vector<uint32_t> Simplify(const std::vector<uint32_t> &indices, const std::vector<Vector3> &positions, const size_t &targetIndexCount,
+			const float &maxError, float *error);
+
+		/// <summary>
+		/// Builds a chain of levels of detail, each simplified from the full mesh to half the triangles of the level before.
+		/// Levels are simplified in parallel on worker threads for large meshes, the chain ends once a level stops getting smaller.
+		/// </summary>
+		/// <param name="vertices"> The mesh vertices, any vertex type with a m_position. </param>
+		/// <param name="indices"> The triangle indices, every coarser level is appended to them. </param>
+		/// <returns> The levels of detail, the first is the full mesh. </returns>
+		template<typename T>
+		static std::vector<MeshLod> GenerateLods(const std::vector<T> &vertices, std::vector<uint32_t> &indices)
+		{
+			std::vector<Vector3> positions = std::vector<Vector3>();
+			positions.reserve(vertices.size());
+
+			for (auto &vertex : vertices)
+			{
+				positions.push_back(vertex.m_position);
+			}
+
+			return GenerateLods(positions, indices);
+		}
+
+		static std::vector<MeshLod> GenerateLods(const std::vector<Vector3> &positions, std::vector<uint32_t> &indices);
+
+		/// <summary>
+		/// Gets how well a mesh uses a FIFO vertex cache of <seealso cref="#CACHE_SIZE"/> vertices.
+		/// </summary>
+		/// <param name="indices"> The triangle indices. </param>
+		/// <param name="vertexCount"> The number of vertices. </param>
+		/// <returns> The cache stats. </returns>
+		static Stats GetStats(const std::vector<uint32_t> &indices, const size_t &vertexCount);
+	private:
+		static std::vector<uint32_t> RemapVertexFetch(std::vector<uint32_t> &indices, const size_t &vertexCount);
+	};
+}
@@ -2,17 +2,23 @@
 
 #include <cassert>
 #include "Helpers/FileSystem.hpp"
+#include "ModelBaked.hpp"
+#include "ModelPool.hpp"
+#include "ObjLoader.hpp"
 
 namespace Flounder
 {
 	static const std::string FALLBACK_PATH = "Resources/Undefined.obj";
 
+	const float Model::LOD_HYSTERESIS = 0.15f;
+
 	Model::Model() :
 		IResource(),
 		m_filename(""),
 		m_vertexBuffer(nullptr),
 		m_indexBuffer(nullptr),
-		m_aabb(new ColliderAabb())
+		m_aabb(new ColliderAabb()),
+		m_lods(std::vector<MeshLod>())
 	{
 	}
 
@@ -21,75 +27,36 @@ namespace Flounder
 		m_filename(filename),
 		m_vertexBuffer(nullptr),
 		m_indexBuffer(nullptr),
-		m_aabb(new ColliderAabb())
+		m_aabb(new ColliderAabb()),
+		m_lods(std::vector<MeshLod>())
 	{
-		std::vector<IVertex*> vertices = std::vector<IVertex*>();
-		std::vector<uint32_t> indices = std::vector<uint32_t>();
-
-		LoadFromFile(filename, &vertices, &indices);
-
-		if (!vertices.empty())
-		{
-			void *verticesData = vertices[0]->GetData(vertices);
-			m_vertexBuffer = new VertexBuffer(vertices[0]->GetSize(), vertices.size(), verticesData);
-			free(verticesData);
-		}
-
-		if (!indices.empty())
-		{
-			m_indexBuffer = new IndexBuffer(VK_INDEX_TYPE_UINT32, sizeof(indices[0]), indices.size(), indices.data());
-		}
-
-		m_aabb->Set(CalculateAabb(vertices));
-
-		for (auto vertex : vertices)
-		{
-			delete vertex;
-		}
+		LoadFromFile(filename);
 	}
 
-	Model::Model(std::vector<IVertex*> &vertices, std::vector<uint32_t> &indices, const std::string &name) :
+	Model::Model(const void *vertices, const uint64_t &vertexSize, const size_t &vertexCount, const ColliderAabb &aabb, const std::string &name) :
 		IResource(),
 		m_filename(name),
-		m_vertexBuffer(nullptr),
+		m_vertexBuffer(new VertexBuffer(vertexSize, vertexCount, const_cast<void *>(vertices))),
 		m_indexBuffer(nullptr),
-		m_aabb(new ColliderAabb())
+		m_aabb(new ColliderAabb(aabb)),
+		m_lods(std::vector<MeshLod>())
 	{
-		void *verticesData = vertices[0]->GetData(vertices);
-		m_vertexBuffer = new VertexBuffer(vertices[0]->GetSize(), vertices.size(), verticesData);
-		free(verticesData);
-
-		m_indexBuffer = new IndexBuffer(VK_INDEX_TYPE_UINT32, sizeof(indices[0]), indices.size(), indices.data());
-
-		m_aabb->Set(CalculateAabb(vertices));
-
-		for (auto vertex : vertices)
-		{
-			delete vertex;
-		}
 	}
 
-	Model::Model(std::vector<IVertex*> &vertices, const std::string &name) :
+	Model::Model(const void *vertices, const uint64_t &vertexSize, const size_t &vertexCount, const std::vector<uint32_t> &indices, const ColliderAabb &aabb, const std::string &name) :
 		IResource(),
 		m_filename(name),
 		m_vertexBuffer(nullptr),
 		m_indexBuffer(nullptr),
-		m_aabb(new ColliderAabb())
+		m_aabb(new ColliderAabb()),
+		m_lods(std::vector<MeshLod>())
 	{
-		void *verticesData = vertices[0]->GetData(vertices);
-		m_vertexBuffer = new VertexBuffer(vertices[0]->GetSize(), vertices.size(), verticesData);
-		free(verticesData);
-
-		m_aabb->Set(CalculateAabb(vertices));
-
-		for (auto vertex : vertices)
-		{
-			delete vertex;
-		}
+		SetData(vertices, vertexSize, vertexCount, indices.data(), sizeof(uint32_t), indices.size(), aabb, name);
 	}
 
 	Model::~Model()
 	{
+		ModelPool::RemoveFromPools(this);
 		delete m_indexBuffer;
 		delete m_vertexBuffer;
 		delete m_aabb;
@@ -97,20 +64,35 @@ namespace Flounder
 
 	void Model::CmdRender(const VkCommandBuffer &commandBuffer, const unsigned int &instances)
 	{
-		if (m_vertexBuffer != nullptr && m_indexBuffer != nullptr)
+		CmdBind(commandBuffer);
+		CmdDraw(commandBuffer, instances);
+	}
+
+	void Model::CmdBind(const VkCommandBuffer &commandBuffer)
+	{
+		if (m_vertexBuffer != nullptr)
 		{
 			VkBuffer vertexBuffers[] = {m_vertexBuffer->GetBuffer()};
 			VkDeviceSize offsets[] = {0};
 			vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+		}
+
+		if (m_vertexBuffer != nullptr && m_indexBuffer != nullptr)
+		{
 			vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer->GetBuffer(), 0, m_indexBuffer->GetIndexType());
-			vkCmdDrawIndexed(commandBuffer, m_indexBuffer->GetIndexCount(), instances, 0, 0, 0);
+		}
+	}
+
+	void Model::CmdDraw(const VkCommandBuffer &commandBuffer, const unsigned int &instances, const unsigned int &firstInstance, const uint32_t &lod)
+	{
+		if (m_vertexBuffer != nullptr && m_indexBuffer != nullptr)
+		{
+			const MeshLod &level = m_lods.at(std::min(lod, static_cast<uint32_t>(m_lods.size() - 1)));
+			vkCmdDrawIndexed(commandBuffer, level.indexCount, instances, level.firstIndex, 0, firstInstance);
 		}
 		else if (m_vertexBuffer != nullptr && m_indexBuffer == nullptr)
 		{
-			VkBuffer vertexBuffers[] = {m_vertexBuffer->GetBuffer()};
-			VkDeviceSize offsets[] = {0};
-			vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-			vkCmdDraw(commandBuffer, m_vertexBuffer->GetVertexCount(), instances, 0, 0);
+			vkCmdDraw(commandBuffer, m_vertexBuffer->GetVertexCount(), instances, 0, firstInstance);
 		}
 		//	else
 		//	{
@@ -118,41 +100,76 @@ namespace Flounder
 		//	}
 	}
 
-	void Model::Set(std::vector<IVertex *> &vertices, std::vector<uint32_t> &indices, const std::string &name)
+	uint32_t Model::SelectLod(const float &screenSize, const uint32_t &current) const
+	{
+		uint32_t lod = 0;
+
+		// Coarser levels are taken while the model is below their screen size, the threshold moves away from the current level.
+		while (lod + 1 < m_lods.size())
+		{
+			const float hysteresis = lod + 1 <= current ? 1.0f + LOD_HYSTERESIS : 1.0f - LOD_HYSTERESIS;
+
+			if (screenSize > m_lods[lod + 1].screenSize * hysteresis)
+			{
+				break;
+			}
+
+			lod++;
+		}
+
+		return lod;
+	}
+
+	void Model::SetLods(const std::vector<MeshLod> &lods)
+	{
+		m_lods = lods;
+	}
+
+	void Model::SetData(const void *vertices, const uint64_t &vertexSize, const size_t &vertexCount, const void *indices, const uint64_t &indexSize, const size_t &indexCount, const ColliderAabb &aabb, const std::string &name)
 	{
 		m_filename = name;
+		ModelPool::RemoveFromPools(this);
 		delete m_vertexBuffer;
 		delete m_indexBuffer;
+		m_vertexBuffer = nullptr;
+		m_indexBuffer = nullptr;
 
-		if (!vertices.empty())
+		if (vertexCount != 0)
 		{
-			void *verticesData = vertices[0]->GetData(vertices);
-			m_vertexBuffer = new VertexBuffer(vertices[0]->GetSize(), vertices.size(), verticesData);
-			free(verticesData);
+			m_vertexBuffer = new VertexBuffer(vertexSize, vertexCount, const_cast<void *>(vertices));
 		}
 
-		if (!indices.empty())
+		if (indexCount != 0)
 		{
-			m_indexBuffer = new IndexBuffer(VK_INDEX_TYPE_UINT32, sizeof(indices[0]), indices.size(), indices.data());
+			// Indices are narrowed to 16 bits whenever every vertex can be reached with them, halving index fetches.
+			if (indexSize == sizeof(uint32_t) && vertexCount <= 65536)
+			{
+				const uint32_t *source = static_cast<const uint32_t *>(indices);
+				std::vector<uint16_t> indices16 = std::vector<uint16_t>(source, source + indexCount);
+				m_indexBuffer = new IndexBuffer(VK_INDEX_TYPE_UINT16, sizeof(uint16_t), indexCount, indices16.data());
+			}
+			else
+			{
+				const VkIndexType indexType = indexSize == sizeof(uint16_t) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+				m_indexBuffer = new IndexBuffer(indexType, indexSize, indexCount, const_cast<void *>(indices));
+			}
 		}
 
-		m_aabb->Set(CalculateAabb(vertices));
+		m_aabb->Set(aabb);
+		m_lods.clear();
 
-		for (auto vertex : vertices)
+		if (indexCount != 0)
 		{
-			delete vertex;
+			m_lods.push_back({0, static_cast<uint32_t>(indexCount), 0.0f, std::numeric_limits<float>::infinity()});
 		}
 	}
 
-	void Model::LoadFromFile(const std::string &filename, std::vector<IVertex*> *vertices, std::vector<uint32_t> *indices)
+	void Model::LoadFromFile(const std::string &filename)
 	{
 #if FLOUNDER_VERBOSE
 		const auto debugStart = Engine::Get()->GetTimeMs();
 #endif
 
-		delete m_indexBuffer;
-		delete m_vertexBuffer;
-
 		if (!FileSystem::FileExists(m_filename))
 		{
 			fprintf(stderr, "File does not exist: '%s'\n", m_filename.c_str());
@@ -160,219 +177,56 @@ namespace Flounder
 			return;
 		}
 
-		const std::string fileLoaded = FileSystem::ReadTextFile(m_filename);
-		std::vector<std::string> lines = FormatString::Split(fileLoaded, "\n");
+		// Baked files are used while they are at least as new as the OBJ, a missing baked file has no modified time.
+		const std::string bakedFilename = ModelBaked::GetBakedFilename(filename);
 
-		std::vector<uint32_t> indicesList = std::vector<uint32_t>();
-		std::vector<VertexModelData *> verticesList = std::vector<VertexModelData *>();
-		std::vector<Vector2> uvsList = std::vector<Vector2>();
-		std::vector<Vector3> normalsList = std::vector<Vector3>();
-
-		for (const auto &line : lines)
+		if (FileSystem::FindExt(filename) == ModelBaked::EXTENSION)
 		{
-			std::vector<std::string> split = FormatString::Split(line, " ", true);
-
-			if (!split.empty())
+			if (!LoadFromBaked(filename, filename))
 			{
-				const std::string prefix = split[0];
-
-				if (prefix == "#")
-				{
-					continue;
-				}
-				else if (prefix == "v")
-				{
-					const Vector3 vertex = Vector3(std::stof(split[1]), std::stof(split[2]), std::stof(split[3]));
-					VertexModelData *newVertex = new VertexModelData(static_cast<int>(verticesList.size()), vertex);
-					verticesList.push_back(newVertex);
-				}
-				else if (prefix == "vt")
-				{
-					const Vector2 uv = Vector2(std::stof(split[1]), 1.0f - std::stof(split[2]));
-					uvsList.push_back(uv);
-				}
-				else if (prefix == "vn")
-				{
-					const Vector3 normal = Vector3(std::stof(split[1]), std::stof(split[2]), std::stof(split[3]));
-					normalsList.push_back(normal);
-				}
-				else if (prefix == "f")
-				{
-					// The split length of 3 faced + 1 for the f prefix.
-					if (split.size() != 4 || FormatString::Contains(line, "//"))
-					{
-						fprintf(stderr, "Error reading the OBJ '%s', it does not appear to be UV mapped! The model will not be loaded.\n", m_filename.c_str());
-						throw std::runtime_error("Model loading error.");
-					}
-
-					std::vector<std::string> vertex1 = FormatString::Split(split[1], "/");
-					std::vector<std::string> vertex2 = FormatString::Split(split[2], "/");
-					std::vector<std::string> vertex3 = FormatString::Split(split[3], "/");
-
-					VertexModelData *v0 = ProcessDataVertex(Vector3(std::stof(vertex1[0]), std::stof(vertex1[1]), std::stof(vertex1[2])), &verticesList, &indicesList);
-					VertexModelData *v1 = ProcessDataVertex(Vector3(std::stof(vertex2[0]), std::stof(vertex2[1]), std::stof(vertex2[2])), &verticesList, &indicesList);
-					VertexModelData *v2 = ProcessDataVertex(Vector3(std::stof(vertex3[0]), std::stof(vertex3[1]), std::stof(vertex3[2])), &verticesList, &indicesList);
-					CalculateTangents(v0, v1, v2, &uvsList);
-				}
-				else if (prefix == "o")
-				{
-				}
-				else if (prefix == "s")
-				{
-				}
-				else
-				{
-					fprintf(stderr, "OBJ '%s' unknown line: '%s'\n", m_filename.c_str(), line.c_str());
-				}
+				fprintf(stderr, "Baked model is invalid or has a different vertex layout: '%s'\n", filename.c_str());
+				m_filename = FALLBACK_PATH;
+				return;
 			}
 		}
-
-		// Averages out vertex tangents, and disabled non set vertices,
-		for (auto current : verticesList)
+		else if (FileSystem::GetModifiedTime(bakedFilename) < FileSystem::GetModifiedTime(filename) || !LoadFromBaked(bakedFilename, filename))
 		{
-			current->AverageTangents();
-
-			if (!current->IsSet())
-			{
-				current->SetUvIndex(0);
-				current->SetNormalIndex(0);
-			}
-		}
-
-		indices->swap(indicesList);
-
-		// Turns the loaded data into a format that can be used by OpenGL.
-		for (auto current : verticesList)
-		{
-			const Vector3 position = current->GetPosition();
-			const Vector2 textures = uvsList[current->GetUvIndex()];
-			const Vector3 normal = normalsList[current->GetNormalIndex()];
-			const Vector3 tangent = current->GetAverageTangent();
-
-			vertices->push_back(new VertexModel(position, textures, normal, tangent));
-
-			delete current;
+			ObjLoader loader = ObjLoader(filename);
+			Set(loader.GetVertices(), loader.GetIndices(), filename);
+			SetLods(loader.GetLods());
 		}
 
 #if FLOUNDER_VERBOSE
 		const auto debugEnd = Engine::Get()->GetTimeMs();
 		printf("Obj '%s' loaded in %fms\n", m_filename.c_str(), debugEnd - debugStart);
 #endif
-
-		m_filename = filename;
 	}
 
-	VertexModelData *Model::ProcessDataVertex(const Vector3 &vertex, std::vector<VertexModelData *> *vertices, std::vector<uint32_t> *indices)
+	bool Model::LoadFromBaked(const std::string &filename, const std::string &name)
 	{
-		const int index = static_cast<int>(vertex.m_x) - 1;
-		const int textureIndex = static_cast<int>(vertex.m_y) - 1;
-		const int normalIndex = static_cast<int>(vertex.m_z) - 1;
-		VertexModelData *currentVertex = (*vertices)[index];
+		ModelBaked baked = ModelBaked(filename);
 
-		if (!currentVertex->IsSet())
+		if (!baked.IsValid() || !baked.HasLayout(sizeof(VertexModel), VertexModel::GetAttributeDescriptions()))
 		{
-			currentVertex->SetUvIndex(textureIndex);
-			currentVertex->SetNormalIndex(normalIndex);
-			indices->push_back(index);
-			return currentVertex;
+			return false;
 		}
 
-		return DealWithAlreadyProcessedDataVertex(currentVertex, textureIndex, normalIndex, indices, vertices);
-	}
+		// The mapping is copied straight into the buffers, nothing is parsed or converted on the way.
+		SetData(baked.GetVertices(), baked.GetVertexSize(), baked.GetVertexCount(), baked.GetIndices(), baked.GetIndexSize(), baked.GetIndexCount(), baked.GetAabb(), name);
 
-	VertexModelData *Model::DealWithAlreadyProcessedDataVertex(VertexModelData *previousVertex, const int &newTextureIndex, const int &newNormalIndex, std::vector<uint32_t> *indices, std::vector<VertexModelData *> *vertices)
-	{
-		if (previousVertex->HasSameTextureAndNormal(newTextureIndex, newNormalIndex))
-		{
-			indices->push_back(previousVertex->GetIndex());
-			return previousVertex;
-		}
-
-		VertexModelData *anotherVertex = previousVertex->GetDuplicateVertex();
+		// Files baked without levels of detail draw the whole index buffer.
+		std::vector<MeshLod> lods = std::vector<MeshLod>();
 
-		if (anotherVertex != nullptr)
+		for (auto &lod : baked.GetLods())
 		{
-			return DealWithAlreadyProcessedDataVertex(anotherVertex, newTextureIndex, newNormalIndex, indices, vertices);
+			lods.push_back({lod.firstIndex, lod.indexCount, lod.error, lod.screenSize});
 		}
 
-		VertexModelData *duplicateVertex = new VertexModelData(static_cast<uint32_t>(vertices->size()), previousVertex->GetPosition());
-		duplicateVertex->SetUvIndex(newTextureIndex);
-		duplicateVertex->SetNormalIndex(newNormalIndex);
-		previousVertex->SetDuplicateVertex(duplicateVertex);
-		vertices->push_back(duplicateVertex);
-		indices->push_back(duplicateVertex->GetIndex());
-		return duplicateVertex;
-	}
-
-	void Model::CalculateTangents(VertexModelData *v0, VertexModelData *v1, VertexModelData *v2, std::vector<Vector2> *uvs)
-	{
-		const Vector2 uv0 = (*uvs)[v0->GetUvIndex()];
-		const Vector2 uv1 = (*uvs)[v1->GetUvIndex()];
-		const Vector2 uv2 = (*uvs)[v2->GetUvIndex()];
-
-		Vector2 *deltaUv1 = Vector2::Subtract(uv1, uv0, nullptr);
-		Vector2 *deltaUv2 = Vector2::Subtract(uv2, uv0, nullptr);
-		const float r = 1.0f / (deltaUv1->m_x * deltaUv2->m_y - deltaUv1->m_y * deltaUv2->m_x);
-
-		Vector3 *deltaPos1 = Vector3::Subtract(v1->GetPosition(), v0->GetPosition(), nullptr);
-		Vector3 *deltaPos2 = Vector3::Subtract(v2->GetPosition(), v0->GetPosition(), nullptr);
-		deltaPos1->Scale(deltaUv2->m_y);
-		deltaPos2->Scale(deltaUv1->m_y);
-
-		Vector3 *tangent = Vector3::Subtract(*deltaPos1, *deltaPos2, nullptr);
-		tangent->Scale(r);
-
-		v0->AddTangent(tangent);
-		v1->AddTangent(tangent);
-		v2->AddTangent(tangent);
-
-		delete deltaPos1;
-		delete deltaPos2;
-		delete deltaUv1;
-		delete deltaUv2;
-	}
-
-	ColliderAabb Model::CalculateAabb(const std::vector<IVertex*> &vertices)
-	{
-		float minX = +std::numeric_limits<float>::infinity();
-		float minY = +std::numeric_limits<float>::infinity();
-		float minZ = +std::numeric_limits<float>::infinity();
-		float maxX = -std::numeric_limits<float>::infinity();
-		float maxY = -std::numeric_limits<float>::infinity();
-		float maxZ = -std::numeric_limits<float>::infinity();
-
-		for (auto vertex : vertices)
+		if (!lods.empty())
 		{
-			const Vector3 position = vertex->GetPosition();
-
-			if (position.m_x < minX)
-			{
-				minX = position.m_x;
-			}
-			else if (position.m_x > maxX)
-			{
-				maxX = position.m_x;
-			}
-
-			if (position.m_y < minY)
-			{
-				minY = position.m_y;
-			}
-			else if (position.m_y > maxY)
-			{
-				maxY = position.m_y;
-			}
-
-			if (position.m_z < minZ)
-			{
-				minZ = position.m_z;
-			}
-			else if (position.m_z > maxZ)
-			{
-				maxZ = position.m_z;
-			}
+			SetLods(lods);
 		}
 
-		return ColliderAabb(Vector3(minX, minY, minZ), Vector3(maxX, maxY, maxZ));
+		return true;
 	}
 }
@@ -1,14 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "../Maths/Vector2.hpp"
 #include "../Physics/ColliderAabb.hpp"
 #include "../Resources/Resources.hpp"
 #include "../Renderer/Buffers/VertexBuffer.hpp"
 #include "../Renderer/Buffers/IndexBuffer.hpp"
+#include "MeshOptimizer.hpp"
 #include "VertexModel.hpp"
-#include "VertexModelData.hpp"
 
 namespace Flounder
 {
@@ -25,8 +28,11 @@ namespace Flounder
 		IndexBuffer *m_indexBuffer;
 
 		ColliderAabb *m_aabb;
+		std::vector<MeshLod> m_lods;
 
 	public:
+		static const float LOD_HYSTERESIS;
+
 		static Model *Resource(const std::string &filename)
 		{
 			IResource *resource = Resources::Get()->Get(filename);
@@ -52,20 +58,70 @@ namespace Flounder
 		/// <param name="filename"> The file name. </param>
 		Model(const std::string &filename);
 
+		/// <summary>
+		/// Creates a new model from a contiguous array of vertices, the vertices are copied into the vertex buffer as they are.
+		/// </summary>
+		/// <param name="vertices"> The model vertices, any standard layout vertex type with a m_position. </param>
+		/// <param name="vertexCount"> The number of vertices. </param>
+		/// <param name="indices"> The model indices, or nullptr. </param>
+		/// <param name="indexCount"> The number of indices. </param>
+		/// <param name="name"> The model name. </param>
+		template<typename T>
+		Model(const T *vertices, const size_t &vertexCount, const uint32_t *indices, const size_t &indexCount, const std::string &name = "") :
+			IResource(),
+			m_filename(name),
+			m_vertexBuffer(nullptr),
+			m_indexBuffer(nullptr),
+			m_aabb(new ColliderAabb()),
+			m_lods(std::vector<MeshLod>())
+		{
+			Set(vertices, vertexCount, indices, indexCount, name);
+		}
+
 		/// <summary>
 		/// Creates a new model.
 		/// </summary>
 		/// <param name="vertices"> The model vertices. </param>
 		/// <param name="indices"> The model indices. </param>
 		/// <param name="name"> The model name. </param>
-		Model(std::vector<IVertex*> &vertices, std::vector<uint32_t> &indices, const std::string &name = "");
+		template<typename T>
+		Model(const std::vector<T> &vertices, const std::vector<uint32_t> &indices, const std::string &name = "") :
+			Model(vertices.data(), vertices.size(), indices.data(), indices.size(), name)
+		{
+		}
 
 		/// <summary>
 		/// Creates a new model without indices.
 		/// </summary>
 		/// <param name="vertices"> The model vertices. </param>
 		/// <param name="name"> The model name. </param>
-		Model(std::vector<IVertex*> &vertices, const std::string &name = "");
+		template<typename T>
+		Model(const std::vector<T> &vertices, const std::string &name = "") :
+			Model(vertices.data(), vertices.size(), nullptr, 0, name)
+		{
+		}
+
+		/// <summary>
+		/// Creates a new model from vertices already packed in their buffer layout, without indices.
+		/// Used by vertex formats that are drawn with a shared index buffer, such as voxel quads.
+		/// </summary>
+		/// <param name="vertices"> The packed vertex data. </param>
+		/// <param name="vertexSize"> The size of one vertex, in bytes. </param>
+		/// <param name="vertexCount"> The number of vertices. </param>
+		/// <param name="aabb"> The bounds of the vertices. </param>
+		/// <param name="name"> The model name. </param>
+		Model(const void *vertices, const uint64_t &vertexSize, const size_t &vertexCount, const ColliderAabb &aabb, const std::string &name = "");
+
+		/// <summary>
+		/// Creates a new model from indexed vertices already packed in their buffer layout, such as quantized vertices.
+		/// </summary>
+		/// <param name="vertices"> The packed vertex data. </param>
+		/// <param name="vertexSize"> The size of one vertex, in bytes. </param>
+		/// <param name="vertexCount"> The number of vertices. </param>
+		/// <param name="indices"> The model indices. </param>
+		/// <param name="aabb"> The bounds of the vertices. </param>
+		/// <param name="name"> The model name. </param>
+		Model(const void *vertices, const uint64_t &vertexSize, const size_t &vertexCount, const std::vector<uint32_t> &indices, const ColliderAabb &aabb, const std::string &name = "");
 
 		/// <summary>
 		/// Deconstructor for the model.
@@ -74,6 +130,30 @@ namespace Flounder
 
 		void CmdRender(const VkCommandBuffer &commandBuffer, const unsigned int &instances = 1);
 
+		/// <summary>
+		/// Binds the models vertex and index buffers, so several draws of this model can share one bind.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		void CmdBind(const VkCommandBuffer &commandBuffer);
+
+		/// <summary>
+		/// Draws the model, the buffers must already be bound with <seealso cref="#CmdBind()"/>.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="instances"> The number of instances to draw. </param>
+		/// <param name="firstInstance"> The first instance index, shaders see it in gl_InstanceIndex. </param>
+		/// <param name="lod"> The level of detail to draw. </param>
+		void CmdDraw(const VkCommandBuffer &commandBuffer, const unsigned int &instances = 1, const unsigned int &firstInstance = 0, const uint32_t &lod = 0);
+
+		/// <summary>
+		/// Selects the level of detail to draw the model at, from how much of the screen it covers.
+		/// A level is only left once the size is past its threshold by <seealso cref="#LOD_HYSTERESIS"/>, so models near a threshold do not flicker between levels.
+		/// </summary>
+		/// <param name="screenSize"> The models bounding sphere diameter, as a fraction of the screen height. </param>
+		/// <param name="current"> The level the model was drawn at last. </param>
+		/// <returns> The level of detail to draw. </returns>
+		uint32_t SelectLod(const float &screenSize, const uint32_t &current) const;
+
 		std::string GetFilename() override { return m_filename; }
 
 		ColliderAabb *GetAabb() const { return m_aabb; }
@@ -82,21 +162,87 @@ namespace Flounder
 
 		IndexBuffer *GetIndexBuffer() const { return m_indexBuffer; }
 
-	protected:
-		void Set(std::vector<IVertex *> &vertices, std::vector<uint32_t> &indices, const std::string &name = "");
+		/// <summary>
+		/// Gets the models levels of detail, ranges of the index buffer. The first level is the full model.
+		/// </summary>
+		/// <returns> The levels of detail. </returns>
+		const std::vector<MeshLod> &GetLods() const { return m_lods; }
 
-	private:
 		/// <summary>
-		/// Loads the model object from a OBJ file.
+		/// Gets the bounds of a contiguous array of vertices.
+		/// </summary>
+		/// <param name="vertices"> The vertices, any vertex type with a m_position. </param>
+		/// <param name="vertexCount"> The number of vertices. </param>
+		/// <returns> The bounds of the vertex positions. </returns>
+		template<typename T>
+		static ColliderAabb CalculateAabb(const T *vertices, const size_t &vertexCount)
+		{
+			if (vertexCount == 0)
+			{
+				return ColliderAabb();
+			}
+
+			Vector3 minExtents = Vector3(+std::numeric_limits<float>::infinity(), +std::numeric_limits<float>::infinity(), +std::numeric_limits<float>::infinity());
+			Vector3 maxExtents = Vector3(-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity());
+
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				const Vector3 &position = vertices[i].m_position;
+				minExtents.m_x = std::min(minExtents.m_x, position.m_x);
+				minExtents.m_y = std::min(minExtents.m_y, position.m_y);
+				minExtents.m_z = std::min(minExtents.m_z, position.m_z);
+				maxExtents.m_x = std::max(maxExtents.m_x, position.m_x);
+				maxExtents.m_y = std::max(maxExtents.m_y, position.m_y);
+				maxExtents.m_z = std::max(maxExtents.m_z, position.m_z);
+			}
+
+			return ColliderAabb(minExtents, maxExtents);
+		}
+
+	protected:
+		/// <summary>
+		/// Replaces the models buffers with a contiguous array of vertices, the vertex stride is the size of the vertex type.
 		/// </summary>
-		void LoadFromFile(const std::string &filename, std::vector<IVertex*> *vertices, std::vector<uint32_t> *indices);
+		/// <param name="vertices"> The model vertices, any standard layout vertex type with a m_position. </param>
+		/// <param name="vertexCount"> The number of vertices. </param>
+		/// <param name="indices"> The model indices, or nullptr. </param>
+		/// <param name="indexCount"> The number of indices. </param>
+		/// <param name="name"> The model name. </param>
+		template<typename T>
+		void Set(const T *vertices, const size_t &vertexCount, const uint32_t *indices, const size_t &indexCount, const std::string &name = "")
+		{
+			static_assert(std::is_standard_layout<T>::value, "Vertices are copied into the vertex buffer as raw bytes, they must have a standard layout.");
+			SetData(vertices, sizeof(T), vertexCount, indices, sizeof(uint32_t), indexCount, CalculateAabb(vertices, vertexCount), name);
+		}
 
-		VertexModelData *ProcessDataVertex(const Vector3 &vertex, std::vector<VertexModelData *> *vertices, std::vector<uint32_t> *indices);
+		template<typename T>
+		void Set(const std::vector<T> &vertices, const std::vector<uint32_t> &indices, const std::string &name = "")
+		{
+			Set(vertices.data(), vertices.size(), indices.data(), indices.size(), name);
+		}
 
-		VertexModelData *DealWithAlreadyProcessedDataVertex(VertexModelData *previousVertex, const int &newTextureIndex, const int &newNormalIndex, std::vector<uint32_t> *indices, std::vector<VertexModelData *> *vertices);
+		/// <summary>
+		/// Sets the models levels of detail, the index buffer has to already hold every level.
+		/// </summary>
+		/// <param name="lods"> The levels of detail, the first is the full model. </param>
+		void SetLods(const std::vector<MeshLod> &lods);
 
-		void CalculateTangents(VertexModelData *v0, VertexModelData *v1, VertexModelData *v2, std::vector<Vector2> *uvs);
+	private:
+		void SetData(const void *vertices, const uint64_t &vertexSize, const size_t &vertexCount, const void *indices, const uint64_t &indexSize, const size_t &indexCount, const ColliderAabb &aabb, const std::string &name);
 
-		static ColliderAabb CalculateAabb(const std::vector<IVertex*> &vertices);
+		/// <summary>
+		/// Loads the model object from a OBJ file, or a baked model file.
+		/// A OBJ with a baked file beside it that is at least as new loads the baked file instead.
+		/// </summary>
+		/// <param name="filename"> The file name. </param>
+		void LoadFromFile(const std::string &filename);
+
+		/// <summary>
+		/// Loads the model object from a baked model file, the buffers are filled straight from the files mapping.
+		/// </summary>
+		/// <param name="filename"> The baked file name. </param>
+		/// <param name="name"> The model name. </param>
+		/// <returns> If the file is a baked model with the vertex layout of this model. </returns>
+		bool LoadFromBaked(const std::string &filename, const std::string &name);
 	};
 }
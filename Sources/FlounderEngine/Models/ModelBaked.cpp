@@ -0,0 +1,273 @@
+#include "ModelBaked.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include "../Helpers/FileSystem.hpp"
+#include "MeshOptimizer.hpp"
+#include "Model.hpp"
+#include "ObjLoader.hpp"
+
+namespace Flounder
+{
+	static const char BAKED_MAGIC[4] = {'F', 'M', 'S', 'H'};
+	static const uint32_t BAKED_VERSION = 1;
+	static const uint64_t BAKED_ALIGNMENT = 16;
+
+	const std::string ModelBaked::EXTENSION = "fmesh";
+
+	static uint64_t AlignOffset(const uint64_t &offset)
+	{
+		return (offset + BAKED_ALIGNMENT - 1) & ~(BAKED_ALIGNMENT - 1);
+	}
+
+	static bool SectionInFile(const uint64_t &offset, const uint64_t &count, const uint64_t &elementSize, const uint64_t &fileSize)
+	{
+		// Written so a corrupt count cannot overflow past the end of the file.
+		return offset % BAKED_ALIGNMENT == 0 && offset <= fileSize && count <= (fileSize - offset) / elementSize;
+	}
+
+	static bool WritePadded(FILE *file, const void *data, const uint64_t &size, uint64_t *position)
+	{
+		static const char padding[BAKED_ALIGNMENT] = {};
+		const uint64_t padded = AlignOffset(*position + size) - *position - size;
+
+		if (size != 0 && fwrite(data, 1, size, file) != size)
+		{
+			return false;
+		}
+
+		if (padded != 0 && fwrite(padding, 1, padded, file) != padded)
+		{
+			return false;
+		}
+
+		*position += size + padded;
+		return true;
+	}
+
+	ModelBaked::ModelBaked(const std::string &filename) :
+		m_file(new FileMapped(filename)),
+		m_header(nullptr)
+	{
+		if (m_file->GetSize() < sizeof(BakedHeader))
+		{
+			return;
+		}
+
+		const BakedHeader *header = reinterpret_cast<const BakedHeader *>(m_file->GetData());
+		const uint64_t fileSize = m_file->GetSize();
+
+		if (memcmp(header->magic, BAKED_MAGIC, sizeof(BAKED_MAGIC)) != 0 || header->version != BAKED_VERSION || header->fileSize != fileSize ||
+			header->vertexSize == 0 || (header->indexSize != sizeof(uint16_t) && header->indexSize != sizeof(uint32_t)))
+		{
+			return;
+		}
+
+		if (!SectionInFile(header->attributesOffset, header->attributeCount, sizeof(BakedAttribute), fileSize) ||
+			!SectionInFile(header->lodsOffset, header->lodCount, sizeof(BakedLod), fileSize) ||
+			!SectionInFile(header->meshletsOffset, header->meshletCount, sizeof(BakedMeshlet), fileSize) ||
+			!SectionInFile(header->verticesOffset, header->vertexCount, header->vertexSize, fileSize) ||
+			!SectionInFile(header->indicesOffset, header->indexCount, header->indexSize, fileSize))
+		{
+			return;
+		}
+
+		// Levels of detail and meshlets are drawn straight from the index buffer, so they have to stay inside it.
+		const BakedLod *lods = reinterpret_cast<const BakedLod *>(m_file->GetData() + header->lodsOffset);
+
+		for (uint32_t i = 0; i < header->lodCount; i++)
+		{
+			if (lods[i].firstIndex > header->indexCount || lods[i].indexCount > header->indexCount - lods[i].firstIndex)
+			{
+				return;
+			}
+		}
+
+		const BakedMeshlet *meshlets = reinterpret_cast<const BakedMeshlet *>(m_file->GetData() + header->meshletsOffset);
+
+		for (uint32_t i = 0; i < header->meshletCount; i++)
+		{
+			if (meshlets[i].firstIndex > header->indexCount || meshlets[i].indexCount > header->indexCount - meshlets[i].firstIndex)
+			{
+				return;
+			}
+		}
+
+		// The indices are uploaded without being read again, one past the last vertex would have the GPU read outside the vertex buffer.
+		const char *indices = m_file->GetData() + header->indicesOffset;
+		uint32_t maxIndex = 0;
+
+		for (uint64_t i = 0; i < header->indexCount; i++)
+		{
+			maxIndex = std::max(maxIndex, header->indexSize == sizeof(uint16_t) ? static_cast<uint32_t>(reinterpret_cast<const uint16_t *>(indices)[i]) :
+				reinterpret_cast<const uint32_t *>(indices)[i]);
+		}
+
+		if (header->indexCount != 0 && maxIndex >= header->vertexCount)
+		{
+			return;
+		}
+
+		m_header = header;
+	}
+
+	ModelBaked::~ModelBaked()
+	{
+		delete m_file;
+	}
+
+	bool ModelBaked::HasLayout(const uint32_t &vertexSize, const std::vector<VkVertexInputAttributeDescription> &attributes) const
+	{
+		if (m_header->vertexSize != vertexSize || m_header->attributeCount != attributes.size())
+		{
+			return false;
+		}
+
+		const BakedAttribute *baked = reinterpret_cast<const BakedAttribute *>(m_file->GetData() + m_header->attributesOffset);
+
+		for (size_t i = 0; i < attributes.size(); i++)
+		{
+			if (baked[i].location != attributes[i].location || baked[i].format != static_cast<uint32_t>(attributes[i].format) ||
+				baked[i].offset != attributes[i].offset)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	const void *ModelBaked::GetVertices() const
+	{
+		return m_file->GetData() + m_header->verticesOffset;
+	}
+
+	const void *ModelBaked::GetIndices() const
+	{
+		return m_file->GetData() + m_header->indicesOffset;
+	}
+
+	ColliderAabb ModelBaked::GetAabb() const
+	{
+		const Vector3 minExtents = Vector3(m_header->aabbMin[0], m_header->aabbMin[1], m_header->aabbMin[2]);
+		const Vector3 maxExtents = Vector3(m_header->aabbMax[0], m_header->aabbMax[1], m_header->aabbMax[2]);
+		return ColliderAabb(minExtents, maxExtents);
+	}
+
+	std::vector<BakedLod> ModelBaked::GetLods() const
+	{
+		const BakedLod *lods = reinterpret_cast<const BakedLod *>(m_file->GetData() + m_header->lodsOffset);
+		return std::vector<BakedLod>(lods, lods + m_header->lodCount);
+	}
+
+	std::vector<BakedMeshlet> ModelBaked::GetMeshlets() const
+	{
+		const BakedMeshlet *meshlets = reinterpret_cast<const BakedMeshlet *>(m_file->GetData() + m_header->meshletsOffset);
+		return std::vector<BakedMeshlet>(meshlets, meshlets + m_header->meshletCount);
+	}
+
+	bool ModelBaked::Write(const std::string &filename, const void *vertices, const uint32_t &vertexSize, const size_t &vertexCount,
+		const std::vector<VkVertexInputAttributeDescription> &attributes, const std::vector<uint32_t> &indices, const ColliderAabb &aabb,
+		const std::vector<BakedLod> &lods, const std::vector<BakedMeshlet> &meshlets)
+	{
+		// Every index fits in 16 bits once there are no more vertices than a 16 bit index can reach.
+		const bool shortIndices = vertexCount <= 65536;
+		std::vector<uint16_t> indices16 = std::vector<uint16_t>();
+
+		if (shortIndices)
+		{
+			indices16.assign(indices.begin(), indices.end());
+		}
+
+		std::vector<BakedAttribute> bakedAttributes = std::vector<BakedAttribute>();
+
+		for (auto &attribute : attributes)
+		{
+			bakedAttributes.push_back({attribute.location, static_cast<uint32_t>(attribute.format), attribute.offset, 0});
+		}
+
+		BakedHeader header = {};
+		memcpy(header.magic, BAKED_MAGIC, sizeof(BAKED_MAGIC));
+		header.version = BAKED_VERSION;
+		header.vertexSize = vertexSize;
+		header.indexSize = shortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+		header.vertexCount = vertexCount;
+		header.indexCount = indices.size();
+		header.aabbMin[0] = aabb.GetMinExtents()->m_x;
+		header.aabbMin[1] = aabb.GetMinExtents()->m_y;
+		header.aabbMin[2] = aabb.GetMinExtents()->m_z;
+		header.aabbMax[0] = aabb.GetMaxExtents()->m_x;
+		header.aabbMax[1] = aabb.GetMaxExtents()->m_y;
+		header.aabbMax[2] = aabb.GetMaxExtents()->m_z;
+		header.attributeCount = static_cast<uint32_t>(bakedAttributes.size());
+		header.lodCount = static_cast<uint32_t>(lods.size());
+		header.meshletCount = static_cast<uint32_t>(meshlets.size());
+
+		// The small tables come first, so reading the header and tables only touches the first pages of the file.
+		const uint64_t vertexBytes = static_cast<uint64_t>(vertexSize) * vertexCount;
+		const uint64_t indexBytes = static_cast<uint64_t>(header.indexSize) * indices.size();
+		header.attributesOffset = AlignOffset(sizeof(BakedHeader));
+		header.lodsOffset = AlignOffset(header.attributesOffset + sizeof(BakedAttribute) * bakedAttributes.size());
+		header.meshletsOffset = AlignOffset(header.lodsOffset + sizeof(BakedLod) * lods.size());
+		header.verticesOffset = AlignOffset(header.meshletsOffset + sizeof(BakedMeshlet) * meshlets.size());
+		header.indicesOffset = AlignOffset(header.verticesOffset + vertexBytes);
+		header.fileSize = AlignOffset(header.indicesOffset + indexBytes);
+
+		FILE *file = fopen(filename.c_str(), "wb");
+
+		if (file == nullptr)
+		{
+			fprintf(stderr, "File could not be opened: '%s'\n", filename.c_str());
+			return false;
+		}
+
+		uint64_t position = 0;
+		bool written = WritePadded(file, &header, sizeof(BakedHeader), &position) &&
+			WritePadded(file, bakedAttributes.data(), sizeof(BakedAttribute) * bakedAttributes.size(), &position) &&
+			WritePadded(file, lods.data(), sizeof(BakedLod) * lods.size(), &position) &&
+			WritePadded(file, meshlets.data(), sizeof(BakedMeshlet) * meshlets.size(), &position) &&
+			WritePadded(file, vertices, vertexBytes, &position) &&
+			WritePadded(file, shortIndices ? static_cast<const void *>(indices16.data()) : indices.data(), indexBytes, &position);
+		written = fclose(file) == 0 && written;
+
+		if (!written)
+		{
+			fprintf(stderr, "Could not write to file: '%s'\n", filename.c_str());
+			FileSystem::DeleteFile(filename);
+		}
+
+		return written;
+	}
+
+	bool ModelBaked::Bake(const std::string &filename, const std::string &bakedFilename)
+	{
+		ObjLoader loader = ObjLoader(filename);
+		const std::vector<VertexModel> &vertices = loader.GetVertices();
+		const std::vector<uint32_t> &indices = loader.GetIndices();
+		const MeshOptimizer::Stats stats = MeshOptimizer::GetStats(std::vector<uint32_t>(indices.begin(), indices.begin() + loader.GetLods()[0].indexCount), vertices.size());
+		printf("Baking '%s', %zu vertices, %u triangles, %zu levels of detail, ACMR %.3f, ATVR %.3f\n", filename.c_str(), vertices.size(),
+			loader.GetLods()[0].indexCount / 3, loader.GetLods().size(), stats.acmr, stats.atvr);
+		std::vector<BakedLod> lods = std::vector<BakedLod>();
+
+		for (auto &lod : loader.GetLods())
+		{
+			lods.push_back({lod.firstIndex, lod.indexCount, lod.screenSize, lod.error});
+		}
+
+		return Write(bakedFilename.empty() ? GetBakedFilename(filename) : bakedFilename, vertices.data(), sizeof(VertexModel), vertices.size(),
+			VertexModel::GetAttributeDescriptions(), loader.GetIndices(), Model::CalculateAabb(vertices.data(), vertices.size()), lods);
+	}
+
+	std::string ModelBaked::GetBakedFilename(const std::string &filename)
+	{
+		const size_t extension = filename.find_last_of('.');
+		const size_t folder = filename.find_last_of("/\\");
+
+		if (extension == std::string::npos || (folder != std::string::npos && extension < folder))
+		{
+			return filename + "." + EXTENSION;
+		}
+
+		return filename.substr(0, extension + 1) + EXTENSION;
+	}
+}
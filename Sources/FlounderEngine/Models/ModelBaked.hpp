@@ -0,0 +1,159 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "../Engine/Platform.hpp"
+#include "../Helpers/FileMapped.hpp"
+#include "../Physics/ColliderAabb.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// How one vertex attribute is laid out, the same as a VkVertexInputAttributeDescription on binding 0.
+	/// </summary>
+	struct BakedAttribute
+	{
+		uint32_t location;
+		uint32_t format;
+		uint32_t offset;
+		uint32_t padding;
+	};
+
+	/// <summary>
+	/// A level of detail, a range of the index data drawn once the model covers less of the screen than its screen size.
+	/// </summary>
+	struct BakedLod
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		float screenSize;
+		float error;
+	};
+
+	/// <summary>
+	/// A small cluster of triangles in the index data, with a bounding sphere so it can be culled on its own.
+	/// </summary>
+	struct BakedMeshlet
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		float center[3];
+		float radius;
+	};
+
+	/// <summary>
+	/// The table at the start of every baked model file. Section offsets are from the start of the file and 16 byte aligned.
+	/// </summary>
+	struct BakedHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t vertexSize;
+		uint32_t indexSize;
+		uint64_t vertexCount;
+		uint64_t indexCount;
+		float aabbMin[3];
+		uint32_t attributeCount;
+		float aabbMax[3];
+		uint32_t lodCount;
+		uint32_t meshletCount;
+		uint32_t padding[3];
+		uint64_t attributesOffset;
+		uint64_t lodsOffset;
+		uint64_t meshletsOffset;
+		uint64_t verticesOffset;
+		uint64_t indicesOffset;
+		uint64_t fileSize;
+	};
+
+	/// <summary>
+	/// A model baked into a binary file that is memory mapped and uploaded straight from the mapping.
+	/// The file holds the vertex layout, vertex and index data in their buffer layout, the bounds, and optional levels of
+	/// detail and meshlets. Indices are 16 bit when every vertex can be reached with them.
+	/// </summary>
+	class F_EXPORT ModelBaked
+	{
+	private:
+		FileMapped *m_file;
+		const BakedHeader *m_header;
+	public:
+		static const std::string EXTENSION;
+
+		/// <summary>
+		/// Maps a baked model file, the file is checked before any of its data is used.
+		/// </summary>
+		/// <param name="filename"> The baked model file. </param>
+		ModelBaked(const std::string &filename);
+
+		~ModelBaked();
+
+		ModelBaked(const ModelBaked &) = delete;
+
+		ModelBaked &operator=(const ModelBaked &) = delete;
+
+		/// <summary>
+		/// Gets if the file is a baked model of this version, with every section inside the file and every index inside the vertices.
+		/// </summary>
+		/// <returns> If the file can be used. </returns>
+		bool IsValid() const { return m_header != nullptr; }
+
+		/// <summary>
+		/// Gets if the vertices are laid out the way a pipeline expects.
+		/// </summary>
+		/// <param name="vertexSize"> The expected vertex stride. </param>
+		/// <param name="attributes"> The expected vertex attributes. </param>
+		/// <returns> If the layouts match. </returns>
+		bool HasLayout(const uint32_t &vertexSize, const std::vector<VkVertexInputAttributeDescription> &attributes) const;
+
+		const void *GetVertices() const;
+
+		uint32_t GetVertexSize() const { return m_header->vertexSize; }
+
+		size_t GetVertexCount() const { return static_cast<size_t>(m_header->vertexCount); }
+
+		const void *GetIndices() const;
+
+		uint32_t GetIndexSize() const { return m_header->indexSize; }
+
+		size_t GetIndexCount() const { return static_cast<size_t>(m_header->indexCount); }
+
+		ColliderAabb GetAabb() const;
+
+		std::vector<BakedLod> GetLods() const;
+
+		std::vector<BakedMeshlet> GetMeshlets() const;
+
+		/// <summary>
+		/// Writes a baked model file.
+		/// </summary>
+		/// <param name="filename"> The file to write. </param>
+		/// <param name="vertices"> The vertex data, in its buffer layout. </param>
+		/// <param name="vertexSize"> The size of one vertex, in bytes. </param>
+		/// <param name="vertexCount"> The number of vertices. </param>
+		/// <param name="attributes"> The vertex attributes. </param>
+		/// <param name="indices"> The indices. </param>
+		/// <param name="aabb"> The bounds of the vertices. </param>
+		/// <param name="lods"> The levels of detail, ranges of the indices. </param>
+		/// <param name="meshlets"> The meshlets, ranges of the indices. </param>
+		/// <returns> If the file was written. </returns>
+		static bool Write(const std::string &filename, const void *vertices, const uint32_t &vertexSize, const size_t &vertexCount,
+			const std::vector<VkVertexInputAttributeDescription> &attributes, const std::vector<uint32_t> &indices, const ColliderAabb &aabb,
+			const std::vector<BakedLod> &lods = std::vector<BakedLod>(), const std::vector<BakedMeshlet> &meshlets = std::vector<BakedMeshlet>());
+
+		/// <summary>
+		/// Converts a OBJ model into a baked model file, models loaded from the OBJ then load the baked file while it is up to date.
+		/// The BakeModels tool runs this on the files it is given, it is not called while the engine is running.
+		/// </summary>
+		/// <param name="filename"> The OBJ file. </param>
+		/// <param name="bakedFilename"> The file to write, or empty to write it beside the OBJ. </param>
+		/// <returns> If the file was written. </returns>
+		static bool Bake(const std::string &filename, const std::string &bakedFilename = "");
+
+		/// <summary>
+		/// Gets the baked file a model is baked to, the models path with the baked extension.
+		/// </summary>
+		/// <param name="filename"> The models file. </param>
+		/// <returns> The baked file. </returns>
+		static std::string GetBakedFilename(const std::string &filename);
+	};
+}
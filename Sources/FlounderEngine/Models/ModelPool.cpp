@@ -0,0 +1,156 @@
+#include "ModelPool.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include "../Devices/Display.hpp"
+
+namespace Flounder
+{
+	std::vector<ModelPool *> ModelPool::POOLS = std::vector<ModelPool *>();
+
+	ModelPool::ModelPool() :
+		m_models(std::vector<Model *>()),
+		m_ranges(std::unordered_map<Model *, Range>()),
+		m_vertexSize(0),
+		m_vertexBuffer(nullptr),
+		m_indexBuffer(nullptr),
+		m_dirty(false)
+	{
+		POOLS.push_back(this);
+	}
+
+	ModelPool::~ModelPool()
+	{
+		POOLS.erase(std::remove(POOLS.begin(), POOLS.end(), this), POOLS.end());
+		delete m_vertexBuffer;
+		delete m_indexBuffer;
+	}
+
+	ModelPool::Range *ModelPool::GetRange(Model *model)
+	{
+		auto it = m_ranges.find(model);
+
+		if (it != m_ranges.end())
+		{
+			return &it->second;
+		}
+
+		if (model->GetVertexBuffer() == nullptr || model->GetIndexBuffer() == nullptr || model->GetVertexBuffer()->GetVertexCount() == 0)
+		{
+			return nullptr;
+		}
+
+		const VkDeviceSize vertexSize = model->GetVertexBuffer()->GetSize() / model->GetVertexBuffer()->GetVertexCount();
+
+		if (m_vertexSize != 0 && m_vertexSize != vertexSize)
+		{
+			return nullptr;
+		}
+
+		m_vertexSize = vertexSize;
+		m_models.push_back(model);
+		m_dirty = true;
+
+		// The range is filled in when the buffers are rebuilt.
+		return &m_ranges.emplace(model, Range{0, model->GetIndexBuffer()->GetIndexCount(), 0}).first->second;
+	}
+
+	void ModelPool::Remove(Model *model)
+	{
+		if (m_ranges.erase(model) == 0)
+		{
+			return;
+		}
+
+		m_models.erase(std::remove(m_models.begin(), m_models.end(), model), m_models.end());
+		m_dirty = true;
+
+		// An empty pool can take models of any vertex size again.
+		if (m_models.empty())
+		{
+			m_vertexSize = 0;
+		}
+	}
+
+	void ModelPool::RemoveFromPools(Model *model)
+	{
+		for (auto pool : POOLS)
+		{
+			pool->Remove(model);
+		}
+	}
+
+	void ModelPool::Update()
+	{
+		if (!m_dirty)
+		{
+			return;
+		}
+
+		if (m_models.empty())
+		{
+			delete m_vertexBuffer;
+			delete m_indexBuffer;
+			m_vertexBuffer = nullptr;
+			m_indexBuffer = nullptr;
+			m_dirty = false;
+			return;
+		}
+
+		const auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		std::vector<uint8_t> vertices = std::vector<uint8_t>();
+		std::vector<uint32_t> indices = std::vector<uint32_t>();
+		uint32_t vertexCount = 0;
+		void *data;
+
+		// Model buffers are host visible, so they are read back and packed on the CPU.
+		for (auto model : m_models)
+		{
+			Range &range = m_ranges.at(model);
+			range.firstIndex = static_cast<uint32_t>(indices.size());
+			range.vertexOffset = static_cast<int32_t>(vertexCount);
+
+			VertexBuffer *vertexBuffer = model->GetVertexBuffer();
+			vkMapMemory(logicalDevice, vertexBuffer->GetBufferMemory(), 0, vertexBuffer->GetSize(), 0, &data);
+			vertices.insert(vertices.end(), static_cast<uint8_t *>(data), static_cast<uint8_t *>(data) + vertexBuffer->GetSize());
+			vkUnmapMemory(logicalDevice, vertexBuffer->GetBufferMemory());
+
+			IndexBuffer *indexBuffer = model->GetIndexBuffer();
+			vkMapMemory(logicalDevice, indexBuffer->GetBufferMemory(), 0, indexBuffer->GetSize(), 0, &data);
+
+			// Models with 16 bit indices are widened, the pool can hold more vertices than 16 bits reach.
+			if (indexBuffer->GetIndexType() == VK_INDEX_TYPE_UINT16)
+			{
+				indices.insert(indices.end(), static_cast<uint16_t *>(data), static_cast<uint16_t *>(data) + indexBuffer->GetIndexCount());
+			}
+			else
+			{
+				indices.insert(indices.end(), static_cast<uint32_t *>(data), static_cast<uint32_t *>(data) + indexBuffer->GetIndexCount());
+			}
+
+			vkUnmapMemory(logicalDevice, indexBuffer->GetBufferMemory());
+
+			vertexCount += vertexBuffer->GetVertexCount();
+		}
+
+		delete m_vertexBuffer;
+		delete m_indexBuffer;
+		m_vertexBuffer = new VertexBuffer(m_vertexSize, vertexCount, vertices.data());
+		m_indexBuffer = new IndexBuffer(VK_INDEX_TYPE_UINT32, sizeof(uint32_t), indices.size(), indices.data());
+		m_dirty = false;
+	}
+
+	void ModelPool::CmdBind(const VkCommandBuffer &commandBuffer)
+	{
+		if (m_vertexBuffer == nullptr || m_indexBuffer == nullptr)
+		{
+			return;
+		}
+
+		VkBuffer vertexBuffers[] = {m_vertexBuffer->GetBuffer()};
+		VkDeviceSize offsets[] = {0};
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+		vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer->GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "Model.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// Packs the vertices and indices of many models into one vertex and index buffer, so they can all be drawn from a single bind.
+	/// Models are found by their draw range, the shared buffers are rebuilt when a model is added or removed.
+	/// </summary>
+	class F_EXPORT ModelPool
+	{
+	public:
+		struct Range
+		{
+			uint32_t firstIndex;
+			uint32_t indexCount;
+			int32_t vertexOffset;
+		};
+	private:
+		std::vector<Model *> m_models;
+		std::unordered_map<Model *, Range> m_ranges;
+		VkDeviceSize m_vertexSize;
+
+		VertexBuffer *m_vertexBuffer;
+		IndexBuffer *m_indexBuffer;
+		bool m_dirty;
+
+		static std::vector<ModelPool *> POOLS;
+	public:
+		/// <summary>
+		/// Creates a new model pool.
+		/// </summary>
+		ModelPool();
+
+		/// <summary>
+		/// Deconstructor for the model pool.
+		/// </summary>
+		~ModelPool();
+
+		/// <summary>
+		/// Gets the draw range of a model in the shared buffers, adding it to the pool if it is new.
+		/// </summary>
+		/// <param name="model"> The model to find. </param>
+		/// <returns> The models range, or null if the model can not be pooled (no indices or a different vertex size). </returns>
+		Range *GetRange(Model *model);
+
+		/// <summary>
+		/// Removes a model from the pool, it will be packed again if its range is asked for.
+		/// </summary>
+		/// <param name="model"> The model to remove. </param>
+		void Remove(Model *model);
+
+		/// <summary>
+		/// Removes a model from every pool, called when a models buffers are replaced or deleted.
+		/// </summary>
+		/// <param name="model"> The model to remove. </param>
+		static void RemoveFromPools(Model *model);
+
+		/// <summary>
+		/// Rebuilds the shared buffers if models were added or removed since the last update.
+		/// </summary>
+		void Update();
+
+		/// <summary>
+		/// Binds the shared vertex and index buffers.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		void CmdBind(const VkCommandBuffer &commandBuffer);
+
+		uint32_t GetModelCount() const { return static_cast<uint32_t>(m_models.size()); }
+	};
+}
@@ -0,0 +1,391 @@
+#include "ObjLoader.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include "../Helpers/FileMapped.hpp"
+#include "../Tasks/Tasks.hpp"
+#include "MeshOptimizer.hpp"
+
+namespace Flounder
+{
+	const size_t ObjLoader::CHUNK_SIZE = 1 << 20;
+
+	struct ObjCorner
+	{
+		int32_t position;
+		int32_t uv;
+		int32_t normal;
+
+		bool operator==(const ObjCorner &other) const
+		{
+			return position == other.position && uv == other.uv && normal == other.normal;
+		}
+	};
+
+	struct ObjCornerHash
+	{
+		size_t operator()(const ObjCorner &corner) const
+		{
+			return (static_cast<size_t>(corner.position) * 73856093) ^ (static_cast<size_t>(corner.uv) * 19349663) ^ (static_cast<size_t>(corner.normal) * 83492791);
+		}
+	};
+
+	static const char *SkipSpaces(const char *c, const char *end)
+	{
+		while (c < end && (*c == ' ' || *c == '\t' || *c == '\r'))
+		{
+			c++;
+		}
+
+		return c;
+	}
+
+	static const char *ParseFloat(const char *c, const char *end, float *value)
+	{
+		c = SkipSpaces(c, end);
+
+		if (c < end && *c == '+')
+		{
+			c++;
+		}
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+		const auto result = std::from_chars(c, end, *value);
+		return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+		// Standard libraries without floating point from_chars parse a copy, the mapped file is not null terminated.
+		char buffer[64];
+		size_t length = 0;
+
+		while (c + length < end && length < sizeof(buffer) - 1 && c[length] != ' ' && c[length] != '\t' && c[length] != '\r' && c[length] != '\n')
+		{
+			buffer[length] = c[length];
+			length++;
+		}
+
+		buffer[length] = '\0';
+		char *parsed = nullptr;
+		*value = std::strtof(buffer, &parsed);
+		return parsed != buffer ? c + (parsed - buffer) : nullptr;
+#endif
+	}
+
+	static const char *ParseIndex(const char *c, const char *end, int32_t *value)
+	{
+		const auto result = std::from_chars(c, end, *value);
+		return result.ec == std::errc() ? result.ptr : nullptr;
+	}
+
+	ObjLoader::ObjLoader(const std::string &filename) :
+		m_filename(filename),
+		m_vertices(std::vector<VertexModel>()),
+		m_indices(std::vector<uint32_t>()),
+		m_lods(std::vector<MeshLod>())
+	{
+		FileMapped file = FileMapped(filename);
+		const char *data = file.GetData();
+		const size_t size = file.GetSize();
+
+		// Large files are split into a chunk per worker, each chunk starts at the beginning of a line.
+		size_t chunkCount = 1;
+
+		if (size >= 2 * CHUNK_SIZE && Tasks::Get() != nullptr)
+		{
+			chunkCount = std::min(size / CHUNK_SIZE, static_cast<size_t>(Tasks::Get()->GetThreadPool()->GetThreadCount() + 1));
+		}
+
+		std::vector<const char *> bounds = std::vector<const char *>(chunkCount + 1);
+		bounds[0] = data;
+		bounds[chunkCount] = data + size;
+
+		for (size_t i = 1; i < chunkCount; i++)
+		{
+			const char *start = std::max(data + (size * i) / chunkCount, bounds[i - 1]);
+			const char *newline = static_cast<const char *>(memchr(start, '\n', static_cast<size_t>(data + size - start)));
+			bounds[i] = newline != nullptr ? newline + 1 : data + size;
+		}
+
+		std::vector<Chunk> chunks = std::vector<Chunk>(chunkCount);
+
+		if (chunkCount == 1)
+		{
+			ParseChunk(bounds[0], bounds[1], &chunks[0]);
+		}
+		else
+		{
+			Tasks::Get()->GetThreadPool()->ParallelFor(static_cast<unsigned int>(chunkCount), [&](unsigned int start, unsigned int end)
+			{
+				for (unsigned int i = start; i < end; i++)
+				{
+					ParseChunk(bounds[i], bounds[i + 1], &chunks[i]);
+				}
+			});
+		}
+
+		for (const auto &chunk : chunks)
+		{
+			if (!chunk.error.empty())
+			{
+				fprintf(stderr, "Error reading the OBJ '%s', %s The model will not be loaded.\n", m_filename.c_str(), chunk.error.c_str());
+				throw std::runtime_error("Model loading error.");
+			}
+		}
+
+		Assemble(chunks);
+
+#if FLOUNDER_VERBOSE
+		const MeshOptimizer::Stats before = MeshOptimizer::GetStats(m_indices, m_vertices.size());
+#endif
+
+		// Triangles and vertices are reordered for the GPU, OBJ exporters rarely write them in a cache friendly order.
+		MeshOptimizer::Optimize(m_vertices, m_indices);
+
+#if FLOUNDER_VERBOSE
+		const MeshOptimizer::Stats after = MeshOptimizer::GetStats(m_indices, m_vertices.size());
+		printf("Obj '%s' optimized, ACMR %.3f to %.3f, ATVR %.3f to %.3f\n", m_filename.c_str(), before.acmr, after.acmr, before.atvr, after.atvr);
+#endif
+
+		m_lods = MeshOptimizer::GenerateLods(m_vertices, m_indices);
+	}
+
+	ObjLoader::~ObjLoader()
+	{
+	}
+
+	void ObjLoader::ParseChunk(const char *start, const char *end, Chunk *chunk) const
+	{
+		const char *c = start;
+
+		while (c < end && chunk->error.empty())
+		{
+			const char *lineEnd = static_cast<const char *>(memchr(c, '\n', static_cast<size_t>(end - c)));
+
+			if (lineEnd == nullptr)
+			{
+				lineEnd = end;
+			}
+
+			c = SkipSpaces(c, lineEnd);
+			const char *prefix = c;
+
+			while (c < lineEnd && *c != ' ' && *c != '\t' && *c != '\r')
+			{
+				c++;
+			}
+
+			const std::string type = std::string(prefix, c);
+
+			if (type.empty() || type[0] == '#' || type == "o" || type == "s")
+			{
+			}
+			else if (type == "v" || type == "vn")
+			{
+				float values[3];
+
+				for (auto &value : values)
+				{
+					c = c != nullptr ? ParseFloat(c, lineEnd, &value) : nullptr;
+				}
+
+				if (c == nullptr)
+				{
+					chunk->error = "a vertex could not be read!";
+					break;
+				}
+
+				std::vector<float> &list = type == "v" ? chunk->positions : chunk->normals;
+				list.insert(list.end(), values, values + 3);
+			}
+			else if (type == "vt")
+			{
+				float values[2];
+
+				for (auto &value : values)
+				{
+					c = c != nullptr ? ParseFloat(c, lineEnd, &value) : nullptr;
+				}
+
+				if (c == nullptr)
+				{
+					chunk->error = "a uv could not be read!";
+					break;
+				}
+
+				chunk->uvs.push_back(values[0]);
+				chunk->uvs.push_back(1.0f - values[1]);
+			}
+			else if (type == "f")
+			{
+				// Every face must be a triangle, with a position, uv and normal index at each corner.
+				int32_t values[9];
+				int corners = 0;
+
+				while ((c = SkipSpaces(c, lineEnd)) < lineEnd)
+				{
+					if (corners == 3)
+					{
+						corners++;
+						break;
+					}
+
+					for (int i = 0; i < 3 && c != nullptr; i++)
+					{
+						if (i > 0)
+						{
+							c = c < lineEnd && *c == '/' ? c + 1 : nullptr;
+						}
+
+						c = c != nullptr ? ParseIndex(c, lineEnd, &values[3 * corners + i]) : nullptr;
+					}
+
+					if (c == nullptr || (c < lineEnd && *c != ' ' && *c != '\t' && *c != '\r'))
+					{
+						corners = -1;
+						break;
+					}
+
+					corners++;
+				}
+
+				if (corners != 3)
+				{
+					chunk->error = "it does not appear to be triangulated and UV mapped!";
+					break;
+				}
+
+				for (auto value : values)
+				{
+					chunk->corners.push_back(value - 1);
+				}
+			}
+			else
+			{
+				const char *lineLast = lineEnd;
+
+				while (lineLast > prefix && (lineLast[-1] == ' ' || lineLast[-1] == '\t' || lineLast[-1] == '\r'))
+				{
+					lineLast--;
+				}
+
+				const std::string line = std::string(prefix, lineLast);
+				fprintf(stderr, "OBJ '%s' unknown line: '%s'\n", m_filename.c_str(), line.c_str());
+			}
+
+			c = lineEnd + 1;
+		}
+	}
+
+	void ObjLoader::Assemble(const std::vector<Chunk> &chunks)
+	{
+		std::vector<float> positions = std::vector<float>();
+		std::vector<float> uvs = std::vector<float>();
+		std::vector<float> normals = std::vector<float>();
+		std::vector<int32_t> corners = std::vector<int32_t>();
+
+		for (const auto &chunk : chunks)
+		{
+			positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+			uvs.insert(uvs.end(), chunk.uvs.begin(), chunk.uvs.end());
+			normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+			corners.insert(corners.end(), chunk.corners.begin(), chunk.corners.end());
+		}
+
+		// A position becomes a vertex with the uv and normal of its first corner, unused positions take the first uv and normal.
+		const int32_t positionCount = static_cast<int32_t>(positions.size() / 3);
+		const int32_t uvCount = static_cast<int32_t>(uvs.size() / 2);
+		const int32_t normalCount = static_cast<int32_t>(normals.size() / 3);
+		std::vector<ObjCorner> vertices = std::vector<ObjCorner>(static_cast<size_t>(positionCount), ObjCorner{-1, -1, -1});
+		std::unordered_map<ObjCorner, uint32_t, ObjCornerHash> duplicates = std::unordered_map<ObjCorner, uint32_t, ObjCornerHash>();
+		m_indices.reserve(corners.size() / 3);
+
+		for (size_t i = 0; i < corners.size(); i += 3)
+		{
+			const ObjCorner corner = {corners[i], corners[i + 1], corners[i + 2]};
+
+			if (corner.position < 0 || corner.position >= positionCount || corner.uv < 0 || corner.uv >= uvCount || corner.normal < 0 || corner.normal >= normalCount)
+			{
+				fprintf(stderr, "Error reading the OBJ '%s', a face index is out of range! The model will not be loaded.\n", m_filename.c_str());
+				throw std::runtime_error("Model loading error.");
+			}
+
+			ObjCorner &first = vertices[corner.position];
+
+			if (first.position == -1)
+			{
+				first = corner;
+				m_indices.push_back(static_cast<uint32_t>(corner.position));
+			}
+			else if (first == corner)
+			{
+				m_indices.push_back(static_cast<uint32_t>(corner.position));
+			}
+			else
+			{
+				auto it = duplicates.find(corner);
+
+				if (it == duplicates.end())
+				{
+					it = duplicates.emplace(corner, static_cast<uint32_t>(vertices.size())).first;
+					vertices.push_back(corner);
+				}
+
+				m_indices.push_back(it->second);
+			}
+		}
+
+		// Tangents from each face are summed onto its vertices, then normalized.
+		std::vector<float> tangents = std::vector<float>(3 * vertices.size());
+
+		for (size_t i = 0; i < m_indices.size(); i += 3)
+		{
+			const ObjCorner &v0 = vertices[m_indices[i]];
+			const ObjCorner &v1 = vertices[m_indices[i + 1]];
+			const ObjCorner &v2 = vertices[m_indices[i + 2]];
+
+			const float deltaUv1X = uvs[2 * v1.uv] - uvs[2 * v0.uv];
+			const float deltaUv1Y = uvs[2 * v1.uv + 1] - uvs[2 * v0.uv + 1];
+			const float deltaUv2X = uvs[2 * v2.uv] - uvs[2 * v0.uv];
+			const float deltaUv2Y = uvs[2 * v2.uv + 1] - uvs[2 * v0.uv + 1];
+			const float r = 1.0f / (deltaUv1X * deltaUv2Y - deltaUv1Y * deltaUv2X);
+
+			for (int k = 0; k < 3; k++)
+			{
+				const float deltaPos1 = (positions[3 * v1.position + k] - positions[3 * v0.position + k]) * deltaUv2Y;
+				const float deltaPos2 = (positions[3 * v2.position + k] - positions[3 * v0.position + k]) * deltaUv1Y;
+				const float tangent = (deltaPos1 - deltaPos2) * r;
+				tangents[3 * m_indices[i] + k] += tangent;
+				tangents[3 * m_indices[i + 1] + k] += tangent;
+				tangents[3 * m_indices[i + 2] + k] += tangent;
+			}
+		}
+
+		m_vertices.reserve(vertices.size());
+
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			const ObjCorner &vertex = vertices[i];
+			const size_t position = 3 * (vertex.position != -1 ? vertex.position : i);
+			const size_t uv = 2 * (vertex.uv != -1 ? vertex.uv : 0);
+			const size_t normal = 3 * (vertex.normal != -1 ? vertex.normal : 0);
+			float *tangent = &tangents[3 * i];
+			const float length = std::sqrt(tangent[0] * tangent[0] + tangent[1] * tangent[1] + tangent[2] * tangent[2]);
+
+			if (length > 0.0f)
+			{
+				tangent[0] /= length;
+				tangent[1] /= length;
+				tangent[2] /= length;
+			}
+
+			m_vertices.emplace_back(
+				Vector3(positions[position], positions[position + 1], positions[position + 2]),
+				uv < uvs.size() ? Vector2(uvs[uv], uvs[uv + 1]) : Vector2(),
+				normal < normals.size() ? Vector3(normals[normal], normals[normal + 1], normals[normal + 2]) : Vector3(),
+				Vector3(tangent[0], tangent[1], tangent[2])
+			);
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "MeshOptimizer.hpp"
+#include "VertexModel.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// A loader for triangulated and UV mapped OBJ models.
+	/// The file is memory mapped and parsed in one pass, large files are split into chunks of whole lines that are parsed
+	/// on worker threads. Corners are then joined in file order, a corner that reuses a position with a different uv or
+	/// normal becomes a new vertex after all of the positions, found again through a hash of its position, uv and normal.
+	/// The mesh is then optimized for the vertex cache, overdraw and vertex fetch with <seealso cref="MeshOptimizer"/>,
+	/// and a chain of simplified levels of detail is built from it.
+	/// </summary>
+	class F_EXPORT ObjLoader
+	{
+	private:
+		struct Chunk
+		{
+			std::vector<float> positions;
+			std::vector<float> uvs;
+			std::vector<float> normals;
+			std::vector<int32_t> corners;
+			std::string error;
+		};
+
+		std::string m_filename;
+
+		std::vector<VertexModel> m_vertices;
+		std::vector<uint32_t> m_indices;
+		std::vector<MeshLod> m_lods;
+	public:
+		static const size_t CHUNK_SIZE;
+
+		/// <summary>
+		/// Loads a OBJ file, throws if the model is not triangulated or not UV mapped.
+		/// </summary>
+		/// <param name="filename"> The file name. </param>
+		ObjLoader(const std::string &filename);
+
+		~ObjLoader();
+
+		const std::vector<VertexModel> &GetVertices() const { return m_vertices; }
+
+		const std::vector<uint32_t> &GetIndices() const { return m_indices; }
+
+		/// <summary>
+		/// Gets the models levels of detail, every level after the first is a range of indices appended after the full model.
+		/// </summary>
+		/// <returns> The levels of detail. </returns>
+		const std::vector<MeshLod> &GetLods() const { return m_lods; }
+	private:
+		void ParseChunk(const char *start, const char *end, Chunk *chunk) const;
+
+		void Assemble(const std::vector<Chunk> &chunks);
+	};
+}
@@ -15,8 +15,10 @@ namespace Flounder
 
 	void MeshSimple::GenerateMesh()
 	{
-		std::vector<IVertex*> vertices = std::vector<IVertex*>();
+		std::vector<VertexModel> vertices = std::vector<VertexModel>();
 		std::vector<uint32_t> indices = std::vector<uint32_t>();
+		vertices.reserve(m_vertexCount * m_vertexCount);
+		indices.reserve(6 * (m_vertexCount - 1) * (m_vertexCount - 1));
 
 		// Creates and stores vertices.
 		for (int col = 0; col < m_vertexCount; col++)
@@ -34,7 +36,7 @@ namespace Flounder
 				);
 				const Vector3 normal = GetNormal(position);
 				const Vector3 tangent = GetColour(position, normal);
-				vertices.push_back(new VertexModel(position, uv, normal, tangent));
+				vertices.emplace_back(position, uv, normal, tangent);
 			}
 		}
 
@@ -5,11 +5,11 @@ namespace Flounder
 	ShapeRectangle::ShapeRectangle(const float &min, const float &max) :
 		Model()
 	{
-		std::vector<IVertex*> vertices = {
-			new VertexModel(Vector3(min, min, 0.0f), Vector2(0.0f, 0.0f)),
-			new VertexModel(Vector3(max, min, 0.0f), Vector2(1.0f, 0.0f)),
-			new VertexModel(Vector3(max, max, 0.0f), Vector2(1.0f, 1.0f)),
-			new VertexModel(Vector3(min, max, 0.0f), Vector2(0.0f, 1.0f)),
+		std::vector<VertexModel> vertices = {
+			VertexModel(Vector3(min, min, 0.0f), Vector2(0.0f, 0.0f)),
+			VertexModel(Vector3(max, min, 0.0f), Vector2(1.0f, 0.0f)),
+			VertexModel(Vector3(max, max, 0.0f), Vector2(1.0f, 1.0f)),
+			VertexModel(Vector3(min, max, 0.0f), Vector2(0.0f, 1.0f)),
 		};
 		std::vector<uint32_t> indices = {
 			0, 3, 2, 2, 1, 0
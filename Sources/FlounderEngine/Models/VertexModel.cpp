@@ -3,7 +3,6 @@
 namespace Flounder
 {
 	VertexModel::VertexModel(const Vector3 &position, const Vector2 &uv, const Vector3 &normal, const Vector3 &tangent) :
-		IVertex(),
 		m_position(position),
 		m_uv(uv),
 		m_normal(normal),
@@ -12,7 +11,6 @@ namespace Flounder
 	}
 
 	VertexModel::VertexModel(const VertexModel &source) :
-		IVertex(),
 		m_position(source.m_position),
 		m_uv(source.m_uv),
 		m_normal(source.m_normal),
@@ -24,22 +22,6 @@ namespace Flounder
 	{
 	}
 
-	void *VertexModel::GetData(std::vector<IVertex *> &vertices)
-	{
-		size_t dataSize = GetSize() * vertices.size();
-		void *data = new void*[dataSize];
-
-		std::vector<VertexModel> thisVector = std::vector<VertexModel>();
-
-		for (auto vertex : vertices)
-		{
-			thisVector.push_back(*((VertexModel*) vertex));
-		}
-
-		memcpy(data, thisVector.data(), dataSize);
-		return data;
-	}
-
 	std::vector<VkVertexInputBindingDescription> VertexModel::GetBindingDescriptions(const VkVertexInputRate &inputRate)
 	{
 		std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
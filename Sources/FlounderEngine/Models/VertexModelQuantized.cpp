@@ -0,0 +1,117 @@
+#include "VertexModelQuantized.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Flounder
+{
+	VertexModelQuantized::VertexModelQuantized(const VertexModel &source) :
+		m_position{QuantizeHalf(source.m_position.m_x), QuantizeHalf(source.m_position.m_y), QuantizeHalf(source.m_position.m_z), QuantizeHalf(1.0f)},
+		m_uv{QuantizeHalf(source.m_uv.m_x), QuantizeHalf(source.m_uv.m_y)},
+		m_normal{QuantizeSnorm(source.m_normal.m_x), QuantizeSnorm(source.m_normal.m_y), QuantizeSnorm(source.m_normal.m_z), 0},
+		m_tangent{QuantizeSnorm(source.m_tangent.m_x), QuantizeSnorm(source.m_tangent.m_y), QuantizeSnorm(source.m_tangent.m_z), 0}
+	{
+	}
+
+	VertexModelQuantized::VertexModelQuantized(const VertexModelQuantized &source) :
+		m_position{source.m_position[0], source.m_position[1], source.m_position[2], source.m_position[3]},
+		m_uv{source.m_uv[0], source.m_uv[1]},
+		m_normal{source.m_normal[0], source.m_normal[1], source.m_normal[2], source.m_normal[3]},
+		m_tangent{source.m_tangent[0], source.m_tangent[1], source.m_tangent[2], source.m_tangent[3]}
+	{
+	}
+
+	VertexModelQuantized::~VertexModelQuantized()
+	{
+	}
+
+	std::vector<VkVertexInputBindingDescription> VertexModelQuantized::GetBindingDescriptions(const VkVertexInputRate &inputRate)
+	{
+		std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
+
+		// The vertex input description.
+		bindingDescriptions[0].binding = 0;
+		bindingDescriptions[0].stride = sizeof(VertexModelQuantized);
+		bindingDescriptions[0].inputRate = inputRate;
+
+		return bindingDescriptions;
+	}
+
+	std::vector<VkVertexInputAttributeDescription> VertexModelQuantized::GetAttributeDescriptions(const int &usedCount)
+	{
+		std::vector<VkVertexInputAttributeDescription> attributeDescriptions(usedCount + 1);
+
+		// Position attribute.
+		if (usedCount >= 0)
+		{
+			attributeDescriptions[0].binding = 0;
+			attributeDescriptions[0].location = 0;
+			attributeDescriptions[0].format = VK_FORMAT_R16G16B16A16_SFLOAT;
+			attributeDescriptions[0].offset = offsetof(VertexModelQuantized, m_position);
+		}
+
+		// UV attribute.
+		if (usedCount >= 1)
+		{
+			attributeDescriptions[1].binding = 0;
+			attributeDescriptions[1].location = 1;
+			attributeDescriptions[1].format = VK_FORMAT_R16G16_SFLOAT;
+			attributeDescriptions[1].offset = offsetof(VertexModelQuantized, m_uv);
+		}
+
+		// Normal attribute.
+		if (usedCount >= 2)
+		{
+			attributeDescriptions[2].binding = 0;
+			attributeDescriptions[2].location = 2;
+			attributeDescriptions[2].format = VK_FORMAT_R8G8B8A8_SNORM;
+			attributeDescriptions[2].offset = offsetof(VertexModelQuantized, m_normal);
+		}
+
+		// Tangent attribute.
+		if (usedCount >= 3)
+		{
+			attributeDescriptions[3].binding = 0;
+			attributeDescriptions[3].location = 3;
+			attributeDescriptions[3].format = VK_FORMAT_R8G8B8A8_SNORM;
+			attributeDescriptions[3].offset = offsetof(VertexModelQuantized, m_tangent);
+		}
+
+		return attributeDescriptions;
+	}
+
+	uint16_t VertexModelQuantized::QuantizeHalf(const float &value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+		const uint32_t magnitude = bits & 0x7fffffff;
+
+		// NaN stays NaN, anything past the largest half rounds to infinity.
+		if (magnitude > 0x7f800000)
+		{
+			return sign | 0x7e00;
+		}
+
+		if (magnitude >= 0x47800000)
+		{
+			return sign | 0x7c00;
+		}
+
+		// Below the smallest normal half the value is a multiple of 2^-24, which the float can round exactly.
+		if (magnitude < 0x38800000)
+		{
+			return sign | static_cast<uint16_t>(std::lrint(std::fabs(value) * 16777216.0f));
+		}
+
+		// Rebiases the exponent and rounds the mantissa to nearest even, a carry into the exponent is still correct.
+		const uint32_t rounded = magnitude + 0x0fff + ((magnitude >> 13) & 1);
+		return sign | static_cast<uint16_t>((rounded - 0x38000000) >> 13);
+	}
+
+	int8_t VertexModelQuantized::QuantizeSnorm(const float &value)
+	{
+		return static_cast<int8_t>(std::lround(127.0f * std::min(std::max(value, -1.0f), 1.0f)));
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include "../Engine/Platform.hpp"
+#include "VertexModel.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// A model vertex quantized to 20 bytes, from the 44 of a <seealso cref="VertexModel"/>.
+	/// Positions and UVs are half floats, normals and tangents are signed normalized bytes. The formats are read as floats,
+	/// so shaders written for <seealso cref="VertexModel"/> work unchanged once the pipeline uses these attribute descriptions.
+	/// Half float positions keep about three significant digits, so they suit models built around their own origin.
+	/// </summary>
+	class F_EXPORT VertexModelQuantized
+	{
+	public:
+		uint16_t m_position[4];
+		uint16_t m_uv[2];
+		int8_t m_normal[4];
+		int8_t m_tangent[4];
+
+		VertexModelQuantized(const VertexModel &source = VertexModel());
+
+		VertexModelQuantized(const VertexModelQuantized &source);
+
+		~VertexModelQuantized();
+
+		static std::vector<VkVertexInputBindingDescription> GetBindingDescriptions(const VkVertexInputRate &inputRate = VK_VERTEX_INPUT_RATE_VERTEX);
+
+		static std::vector<VkVertexInputAttributeDescription> GetAttributeDescriptions(const int &usedCount = 3);
+
+		/// <summary>
+		/// Rounds a float to the nearest half float.
+		/// </summary>
+		/// <param name="value"> The value. </param>
+		/// <returns> The half float bits. </returns>
+		static uint16_t QuantizeHalf(const float &value);
+
+		/// <summary>
+		/// Rounds a value in -1 to 1 to the nearest signed normalized byte.
+		/// </summary>
+		/// <param name="value"> The value, clamped to -1 to 1. </param>
+		/// <returns> The signed normalized byte. </returns>
+		static int8_t QuantizeSnorm(const float &value);
+	};
+}
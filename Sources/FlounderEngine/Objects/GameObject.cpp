@@ -126,6 +126,7 @@ namespace Flounder
 
 		structure->Add(this);
 		m_structure = structure;
+		m_removed = false;
 	}
 
 	void GameObject::StructureRemove()
@@ -0,0 +1,188 @@
+#include "LightClusters.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "../../Tasks/Tasks.hpp"
+
+namespace Flounder
+{
+	LightClusters::LightClusters() :
+		m_projection(Matrix4()),
+		m_near(0.0f),
+		m_far(0.0f),
+		m_bounds(std::vector<ClusterBounds>(CLUSTERS_COUNT)),
+		m_viewLights(std::vector<ViewLight>()),
+		m_clusterLights(std::vector<std::vector<uint32_t>>(CLUSTERS_COUNT)),
+		m_clusters(std::vector<UbosDeferred::Cluster>(CLUSTERS_COUNT)),
+		m_indices(std::vector<uint32_t>())
+	{
+		m_indices.reserve(MAX_LIGHT_INDICES);
+	}
+
+	LightClusters::~LightClusters()
+	{
+	}
+
+	void LightClusters::Update(const ICamera &camera, const std::vector<UbosDeferred::Light> &lights)
+	{
+		if (m_near != camera.GetNearPlane() || m_far != camera.GetFarPlane() || m_projection != *camera.GetProjectionMatrix())
+		{
+			UpdateBounds(camera);
+		}
+
+		// Moves the lights into view space, clusters are built around the camera.
+		m_viewLights.clear();
+		Vector4 viewPosition = Vector4();
+
+		for (auto &light : lights)
+		{
+			Matrix4::Transform(*camera.GetViewMatrix(), Vector4(light.position), &viewPosition);
+
+			ViewLight viewLight = {};
+			viewLight.position = Vector3(viewPosition.m_x, viewPosition.m_y, viewPosition.m_z);
+			viewLight.radius = light.radius / ATTENUATION_SCALE;
+			m_viewLights.push_back(viewLight);
+		}
+
+		// Each worker owns a range of depth slices, so no two threads write the same cluster.
+		Tasks::Get()->GetThreadPool()->ParallelFor(CLUSTERS_Z, [this](unsigned int start, unsigned int end)
+		{
+			UpdateSlices(start, end);
+		});
+
+		// Packs the cluster lists into one index list.
+		m_indices.clear();
+
+		for (unsigned int i = 0; i < CLUSTERS_COUNT; i++)
+		{
+			auto &clusterLights = m_clusterLights.at(i);
+			const uint32_t count = std::min(static_cast<uint32_t>(clusterLights.size()), static_cast<uint32_t>(MAX_LIGHT_INDICES - m_indices.size()));
+
+			m_clusters.at(i).offset = static_cast<uint32_t>(m_indices.size());
+			m_clusters.at(i).count = count;
+			m_indices.insert(m_indices.end(), clusterLights.begin(), clusterLights.begin() + count);
+		}
+	}
+
+	float LightClusters::GetScale() const
+	{
+		return static_cast<float>(CLUSTERS_Z) / std::log(m_far / m_near);
+	}
+
+	float LightClusters::GetBias() const
+	{
+		return static_cast<float>(CLUSTERS_Z) * std::log(m_near) / std::log(m_far / m_near);
+	}
+
+	void LightClusters::UpdateBounds(const ICamera &camera)
+	{
+		m_projection = *camera.GetProjectionMatrix();
+		m_near = camera.GetNearPlane();
+		m_far = camera.GetFarPlane();
+
+		Matrix4 inverseProjection = Matrix4();
+		Matrix4::Invert(m_projection, &inverseProjection);
+
+		// Finds the view ray through each tile corner, scaled so its depth is one.
+		std::vector<Vector3> corners = std::vector<Vector3>((CLUSTERS_X + 1) * (CLUSTERS_Y + 1));
+		Vector4 corner = Vector4();
+
+		for (unsigned int y = 0; y <= CLUSTERS_Y; y++)
+		{
+			for (unsigned int x = 0; x <= CLUSTERS_X; x++)
+			{
+				const float ndcX = 2.0f * static_cast<float>(x) / static_cast<float>(CLUSTERS_X) - 1.0f;
+				const float ndcY = 2.0f * static_cast<float>(y) / static_cast<float>(CLUSTERS_Y) - 1.0f;
+				Matrix4::Transform(inverseProjection, Vector4(ndcX, ndcY, 1.0f, 1.0f), &corner);
+
+				const float depth = -corner.m_z / corner.m_w;
+				corners.at(x + (CLUSTERS_X + 1) * y) = Vector3(corner.m_x / corner.m_w / depth, corner.m_y / corner.m_w / depth, -1.0f);
+			}
+		}
+
+		for (unsigned int z = 0; z < CLUSTERS_Z; z++)
+		{
+			const float sliceNear = m_near * std::pow(m_far / m_near, static_cast<float>(z) / static_cast<float>(CLUSTERS_Z));
+			const float sliceFar = m_near * std::pow(m_far / m_near, static_cast<float>(z + 1) / static_cast<float>(CLUSTERS_Z));
+
+			for (unsigned int y = 0; y < CLUSTERS_Y; y++)
+			{
+				for (unsigned int x = 0; x < CLUSTERS_X; x++)
+				{
+					ClusterBounds &bounds = m_bounds.at(x + CLUSTERS_X * (y + CLUSTERS_Y * z));
+					bounds.min = Vector3(+INFINITY, +INFINITY, -sliceFar);
+					bounds.max = Vector3(-INFINITY, -INFINITY, -sliceNear);
+
+					for (unsigned int i = 0; i < 4; i++)
+					{
+						const Vector3 &ray = corners.at((x + (i & 1)) + (CLUSTERS_X + 1) * (y + (i >> 1)));
+
+						for (float depth : {sliceNear, sliceFar})
+						{
+							bounds.min.m_x = std::min(bounds.min.m_x, ray.m_x * depth);
+							bounds.min.m_y = std::min(bounds.min.m_y, ray.m_y * depth);
+							bounds.max.m_x = std::max(bounds.max.m_x, ray.m_x * depth);
+							bounds.max.m_y = std::max(bounds.max.m_y, ray.m_y * depth);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void LightClusters::UpdateSlices(const unsigned int &start, const unsigned int &end)
+	{
+		const unsigned int sliceSize = CLUSTERS_X * CLUSTERS_Y;
+
+		for (unsigned int i = start * sliceSize; i < end * sliceSize; i++)
+		{
+			m_clusterLights.at(i).clear();
+		}
+
+		for (uint32_t l = 0; l < m_viewLights.size(); l++)
+		{
+			const ViewLight &light = m_viewLights.at(l);
+
+			for (unsigned int z = start; z < end; z++)
+			{
+				const unsigned int sliceStart = z * sliceSize;
+
+				// Skips slices the light can not reach before testing the tiles.
+				if (light.radius >= 0.0f && (light.position.m_z - light.radius > m_bounds.at(sliceStart).max.m_z ||
+					light.position.m_z + light.radius < m_bounds.at(sliceStart).min.m_z))
+				{
+					continue;
+				}
+
+				for (unsigned int i = sliceStart; i < sliceStart + sliceSize; i++)
+				{
+					if (light.radius < 0.0f || SphereInBounds(light, m_bounds.at(i)))
+					{
+						m_clusterLights.at(i).push_back(l);
+					}
+				}
+			}
+		}
+	}
+
+	bool LightClusters::SphereInBounds(const ViewLight &light, const ClusterBounds &bounds)
+	{
+		float distanceSquared = 0.0f;
+
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			const float value = light.position.m_elements[i];
+
+			if (value < bounds.min.m_elements[i])
+			{
+				distanceSquared += (bounds.min.m_elements[i] - value) * (bounds.min.m_elements[i] - value);
+			}
+			else if (value > bounds.max.m_elements[i])
+			{
+				distanceSquared += (value - bounds.max.m_elements[i]) * (value - bounds.max.m_elements[i]);
+			}
+		}
+
+		return distanceSquared <= light.radius * light.radius;
+	}
+}
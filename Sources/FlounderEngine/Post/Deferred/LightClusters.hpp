@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include "../../Scenes/ICamera.hpp"
+#include "UbosDeferred.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// Assigns lights to a grid of view space clusters (froxels), so the deferred pass only shades the lights that reach each pixel.
+	/// The grid is split into screen tiles on x/y and exponential depth slices on z, each slice is built on a worker thread.
+	/// </summary>
+	class F_EXPORT LightClusters
+	{
+	private:
+		struct ClusterBounds
+		{
+			Vector3 min;
+			Vector3 max;
+		};
+
+		struct ViewLight
+		{
+			Vector3 position;
+			float radius;
+		};
+
+		Matrix4 m_projection;
+		float m_near;
+		float m_far;
+
+		std::vector<ClusterBounds> m_bounds;
+		std::vector<ViewLight> m_viewLights;
+		std::vector<std::vector<uint32_t>> m_clusterLights;
+
+		std::vector<UbosDeferred::Cluster> m_clusters;
+		std::vector<uint32_t> m_indices;
+	public:
+		LightClusters();
+
+		~LightClusters();
+
+		/// <summary>
+		/// Rebuilds the cluster grid for this frame.
+		/// </summary>
+		/// <param name="camera"> The camera the grid is built for. </param>
+		/// <param name="lights"> The world space lights, a negative radius reaches every cluster. </param>
+		void Update(const ICamera &camera, const std::vector<UbosDeferred::Light> &lights);
+
+		/// <summary>
+		/// Gets the scale used to find a depth slice from the log of a view depth.
+		/// </summary>
+		/// <returns> The depth slice scale. </returns>
+		float GetScale() const;
+
+		/// <summary>
+		/// Gets the bias used to find a depth slice from the log of a view depth.
+		/// </summary>
+		/// <returns> The depth slice bias. </returns>
+		float GetBias() const;
+
+		std::vector<UbosDeferred::Cluster> *GetClusters() { return &m_clusters; }
+
+		std::vector<uint32_t> *GetIndices() { return &m_indices; }
+	private:
+		void UpdateBounds(const ICamera &camera);
+
+		void UpdateSlices(const unsigned int &start, const unsigned int &end);
+
+		static bool SphereInBounds(const ViewLight &light, const ClusterBounds &bounds);
+	};
+}
@@ -14,7 +14,12 @@ namespace Flounder
 	RendererDeferred::RendererDeferred(const GraphicsStage &graphicsStage) :
 		IRenderer(),
 		m_uniformScene(new UniformBuffer(sizeof(UbosDeferred::UboScene))),
+		m_storageLights(new StorageBuffer(sizeof(UbosDeferred::Light) * MAX_LIGHTS)),
+		m_storageClusters(new StorageBuffer(sizeof(UbosDeferred::Cluster) * CLUSTERS_COUNT)),
+		m_storageIndices(new StorageBuffer(sizeof(uint32_t) * MAX_LIGHT_INDICES)),
 		m_descriptorSet(nullptr),
+		m_lightClusters(new LightClusters()),
+		m_sceneLights(std::vector<UbosDeferred::Light>()),
 		m_pipeline(new Pipeline(graphicsStage, PipelineCreate({ "Resources/Shaders/Deferred/Deferred.vert", "Resources/Shaders/Deferred/Deferred.frag" },
 			VertexModel::GetBindingDescriptions(), PIPELINE_POLYGON_NO_DEPTH, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT), { })),
 		m_model(ShapeRectangle::Resource(-1.0f, 1.0f))
@@ -24,7 +29,11 @@ namespace Flounder
 	RendererDeferred::~RendererDeferred()
 	{
 		delete m_uniformScene;
+		delete m_storageLights;
+		delete m_storageClusters;
+		delete m_storageIndices;
 		delete m_descriptorSet;
+		delete m_lightClusters;
 		delete m_pipeline;
 		delete m_model;
 	}
@@ -44,57 +53,60 @@ namespace Flounder
 			m_pipeline->GetTexture(2),
 			m_pipeline->GetTexture(3),
 			m_pipeline->GetTexture(4),
-			m_pipeline->GetTexture(0, 0)
+			m_pipeline->GetTexture(0, 0),
+			m_storageLights,
+			m_storageClusters,
+			m_storageIndices
 		});
 
-		// Updates uniforms.
-		std::vector<UbosDeferred::Light> sceneLights = {};
+		// Updates lights.
+		std::vector<Light *> lights = std::vector<Light *>();
+		Scenes::Get()->GetStructure()->QueryComponents<Light>(&lights);
+		m_sceneLights.clear();
 
-		for (auto entity : *Scenes::Get()->GetStructure()->GetAll())
+		for (auto light : lights)
 		{
-			auto light = entity->GetComponent<Light>();
+			const float radius = light->GetRadius();
+
+			if (light->GetColour()->LengthSquared() == 0.0f)
+			{
+				continue;
+			}
 
-			if (light != nullptr)
+			if (radius >= 0.0f && !camera.GetViewFrustum()->SphereInFrustum(*light->GetPosition(), radius / ATTENUATION_SCALE))
 			{
-			//	auto position = *light->GetPosition();
-			//	float radius = light->GetRadius();
-
-			//	if (radius >= 0.0f && !camera.GetViewFrustum()->SphereInFrustum(position, radius))
-			//	{
-			//		continue;
-			//	}
-
-				if (light->GetColour()->LengthSquared() == 0.0f)
-				{
-					continue;
-				}
-
-				UbosDeferred::Light lightObject = {};
-				lightObject.colour = *light->GetColour();
-				lightObject.position = *light->GetPosition();
-				lightObject.radius = light->GetRadius();
-				sceneLights.push_back(lightObject);
+				continue;
 			}
 
-			if (sceneLights.size() >= MAX_LIGHTS)
+			UbosDeferred::Light lightObject = {};
+			lightObject.colour = *light->GetColour();
+			lightObject.position = *light->GetPosition();
+			lightObject.radius = radius;
+			m_sceneLights.push_back(lightObject);
+
+			if (m_sceneLights.size() >= MAX_LIGHTS)
 			{
 				break;
 			}
 		}
 
-	//	printf("Rendered Lights: %i\n", sceneLights.size());
+		m_lightClusters->Update(camera, m_sceneLights);
+
+		m_storageLights->Update(m_sceneLights.data(), 0, sizeof(UbosDeferred::Light) * m_sceneLights.size());
+		m_storageClusters->Update(m_lightClusters->GetClusters()->data());
+		m_storageIndices->Update(m_lightClusters->GetIndices()->data(), 0, sizeof(uint32_t) * m_lightClusters->GetIndices()->size());
 
+		// Updates uniforms.
 		UbosDeferred::UboScene uboScene = {};
+		uboScene.projection = *camera.GetProjectionMatrix();
+		uboScene.view = *camera.GetViewMatrix();
 
-		for (unsigned int i = 0; i < sceneLights.size(); i++)
+		for (uint32_t i = 0; i < Shadows::Get()->GetCascadeCount(); i++)
 		{
-			uboScene.lights[i] = sceneLights.at(i);
+			uboScene.shadowSpaces[i] = *Shadows::Get()->GetCascade(i)->GetToShadowMapSpaceMatrix();
+			uboScene.shadowSplits.m_elements[i] = Shadows::Get()->GetCascadeSplit(i);
 		}
 
-		uboScene.projection = *camera.GetProjectionMatrix();
-		uboScene.view = *camera.GetViewMatrix();
-		uboScene.shadowSpace = *Shadows::Get()->GetShadowBox()->GetToShadowMapSpaceMatrix();
-
 		uboScene.fogColour = *Worlds::Get()->GetFog()->m_colour;
 		uboScene.cameraPosition = *Scenes::Get()->GetCamera()->GetPosition();
 		uboScene.fogDensity = Worlds::Get()->GetFog()->m_density;
@@ -105,8 +117,10 @@ namespace Flounder
 		uboScene.shadowBias = Shadows::Get()->GetShadowBias();
 		uboScene.shadowDarkness = Shadows::Get()->GetShadowDarkness();
 		uboScene.shadowPCF = Shadows::Get()->GetShadowPcf();
+		uboScene.shadowCascades = static_cast<int>(Shadows::Get()->GetCascadeCount());
 
-		uboScene.lightsCount = static_cast<int>(sceneLights.size());
+		uboScene.clusterScale = m_lightClusters->GetScale();
+		uboScene.clusterBias = m_lightClusters->GetBias();
 		m_uniformScene->Update(&uboScene);
 
 		// Draws the object.
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "../../Renderer/IRenderer.hpp"
+#include "../../Renderer/Buffers/StorageBuffer.hpp"
 #include "../../Renderer/Buffers/UniformBuffer.hpp"
 #include "../../Renderer/Pipelines/Pipeline.hpp"
 #include "../../Models/Model.hpp"
+#include "LightClusters.hpp"
 
 namespace Flounder
 {
@@ -12,8 +14,14 @@ namespace Flounder
 	{
 	private:
 		UniformBuffer *m_uniformScene;
+		StorageBuffer *m_storageLights;
+		StorageBuffer *m_storageClusters;
+		StorageBuffer *m_storageIndices;
 		DescriptorSet *m_descriptorSet;
 
+		LightClusters *m_lightClusters;
+		std::vector<UbosDeferred::Light> m_sceneLights;
+
 		Pipeline *m_pipeline;
 		Model *m_model;
 	public:
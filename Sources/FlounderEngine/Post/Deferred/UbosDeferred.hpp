@@ -3,13 +3,20 @@
 #include "../../Maths/Colour.hpp"
 #include "../../Maths/Vector3.hpp"
 #include "../../Maths/Matrix4.hpp"
+#include "../../Shadows/ShadowCascade.hpp"
 
 namespace Flounder
 {
 	class F_EXPORT UbosDeferred
 	{
 	public:
-#define MAX_LIGHTS 64
+#define MAX_LIGHTS 1024
+#define CLUSTERS_X 16
+#define CLUSTERS_Y 9
+#define CLUSTERS_Z 24
+#define CLUSTERS_COUNT (CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z)
+#define MAX_LIGHT_INDICES (CLUSTERS_COUNT * 64)
+#define ATTENUATION_SCALE 0.1f
 
 		struct Light
 		{
@@ -18,13 +25,18 @@ namespace Flounder
 			float radius;
 		};
 
-		struct UboScene
+		struct Cluster
 		{
-			Light lights[MAX_LIGHTS];
+			uint32_t offset;
+			uint32_t count;
+		};
 
+		struct UboScene
+		{
 			Matrix4 projection;
 			Matrix4 view;
-			Matrix4 shadowSpace;
+			Matrix4 shadowSpaces[MAX_CASCADES];
+			Vector4 shadowSplits;
 
 			Colour fogColour;
 			Vector3 cameraPosition;
@@ -36,8 +48,10 @@ namespace Flounder
 			float shadowBias;
 			float shadowDarkness;
 			int shadowPCF;
+			int shadowCascades;
 
-			int lightsCount;
+			float clusterScale;
+			float clusterBias;
 		};
 	};
 }
@@ -0,0 +1,72 @@
+﻿#include "StorageBuffer.hpp"
+
+#include <cstring>
+#include "../../Devices/Display.hpp"
+
+namespace Flounder
+{
+	StorageBuffer::StorageBuffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage) :
+		Buffer(size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | usage, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT),
+		Descriptor(),
+		m_bufferInfo({})
+	{
+		m_bufferInfo.buffer = m_buffer;
+		m_bufferInfo.offset = 0;
+		m_bufferInfo.range = m_size;
+	}
+
+	StorageBuffer::~StorageBuffer()
+	{
+	}
+
+	void StorageBuffer::Update(void *newData)
+	{
+		Update(newData, 0, m_size);
+	}
+
+	void StorageBuffer::Update(void *newData, const VkDeviceSize &offset, const VkDeviceSize &size)
+	{
+		const auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		if (size == 0)
+		{
+			return;
+		}
+
+		// Copies the data to the buffer.
+		void *data;
+		vkMapMemory(logicalDevice, m_bufferMemory, offset, size, 0, &data);
+		memcpy(data, newData, static_cast<size_t>(size));
+		vkUnmapMemory(logicalDevice, m_bufferMemory);
+	}
+
+	DescriptorType StorageBuffer::CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage)
+	{
+		VkDescriptorSetLayoutBinding descriptorSetLayoutBinding = {};
+		descriptorSetLayoutBinding.binding = binding;
+		descriptorSetLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorSetLayoutBinding.descriptorCount = 1;
+		descriptorSetLayoutBinding.pImmutableSamplers = nullptr;
+		descriptorSetLayoutBinding.stageFlags = stage;
+
+		VkDescriptorPoolSize descriptorPoolSize = {};
+		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorPoolSize.descriptorCount = 1;
+
+		return DescriptorType(binding, stage, descriptorSetLayoutBinding, descriptorPoolSize);
+	}
+
+	VkWriteDescriptorSet StorageBuffer::GetWriteDescriptor(const uint32_t &binding, const DescriptorSet &descriptorSet) const
+	{
+		VkWriteDescriptorSet descriptorWrite = {};
+		descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrite.dstSet = descriptorSet.GetDescriptorSet();
+		descriptorWrite.dstBinding = binding;
+		descriptorWrite.dstArrayElement = 0;
+		descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorWrite.descriptorCount = 1;
+		descriptorWrite.pBufferInfo = &m_bufferInfo;
+
+		return descriptorWrite;
+	}
+}
@@ -0,0 +1,28 @@
+﻿#pragma once
+
+#include "Buffer.hpp"
+#include "../Pipelines/Descriptor.hpp"
+#include "../Pipelines/PipelineCreate.hpp"
+
+namespace Flounder
+{
+	class F_EXPORT StorageBuffer :
+		public Buffer,
+		public Descriptor
+	{
+	private:
+		VkDescriptorBufferInfo m_bufferInfo;
+	public:
+		StorageBuffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage = 0);
+
+		~StorageBuffer();
+
+		void Update(void *newData);
+
+		void Update(void *newData, const VkDeviceSize &offset, const VkDeviceSize &size);
+
+		static DescriptorType CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage);
+
+		VkWriteDescriptorSet GetWriteDescriptor(const uint32_t &binding, const DescriptorSet &descriptorSet) const override;
+	};
+}
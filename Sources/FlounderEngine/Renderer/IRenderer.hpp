@@ -31,5 +31,14 @@ namespace Flounder
 		/// <param name="clipPlane"> The current clip plane. </param>
 		/// <param name="camera"> The camera to be used when rendering. </param>
 		virtual void Render(const VkCommandBuffer &commandBuffer, const Vector4 &clipPlane, const ICamera &camera) = 0;
+
+		/// <summary>
+		/// Called before the renderers render pass begins, to record work that can not be inside a render pass such as compute dispatches.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer the render pass will be recorded into. </param>
+		/// <param name="camera"> The camera to be used when rendering. </param>
+		virtual void RenderPrepass(const VkCommandBuffer &commandBuffer, const ICamera &camera)
+		{
+		}
 	};
 }
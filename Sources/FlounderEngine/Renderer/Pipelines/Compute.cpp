@@ -0,0 +1,147 @@
+#include "Compute.hpp"
+
+#include "../../Devices/Display.hpp"
+#include "../Renderer.hpp"
+
+namespace Flounder
+{
+	Compute::Compute(const std::string &shader, const std::vector<std::string> &defines) :
+		m_shader(shader),
+		m_defines(defines),
+		m_shaderProgram(new ShaderProgram()),
+		m_module(VK_NULL_HANDLE),
+		m_stage({}),
+		m_descriptorSetLayout(VK_NULL_HANDLE),
+		m_descriptorPool(VK_NULL_HANDLE),
+		m_pipeline(VK_NULL_HANDLE),
+		m_pipelineLayout(VK_NULL_HANDLE)
+	{
+#if FLOUNDER_VERBOSE
+		const auto debugStart = Engine::Get()->GetTimeMs();
+#endif
+
+		CreateShaderProgram();
+		CreateDescriptorLayout();
+		CreateDescriptorPool();
+		CreatePipelineLayout();
+		CreatePipelineCompute();
+
+#if FLOUNDER_VERBOSE
+		const auto debugEnd = Engine::Get()->GetTimeMs();
+		printf("Compute '%s' created in %fms\n", m_shader.c_str(), debugEnd - debugStart);
+#endif
+	}
+
+	Compute::~Compute()
+	{
+		const auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		vkDestroyShaderModule(logicalDevice, m_module, nullptr);
+
+		delete m_shaderProgram;
+		vkDestroyDescriptorSetLayout(logicalDevice, m_descriptorSetLayout, nullptr);
+		vkDestroyDescriptorPool(logicalDevice, m_descriptorPool, nullptr);
+		vkDestroyPipeline(logicalDevice, m_pipeline, nullptr);
+		vkDestroyPipelineLayout(logicalDevice, m_pipelineLayout, nullptr);
+	}
+
+	void Compute::BindPipeline(const VkCommandBuffer &commandBuffer) const
+	{
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+	}
+
+	void Compute::CmdDispatch(const VkCommandBuffer &commandBuffer, const uint32_t &invocations, const uint32_t &groupSize) const
+	{
+		const uint32_t groupCount = (invocations + groupSize - 1) / groupSize;
+
+		if (groupCount == 0)
+		{
+			return;
+		}
+
+		vkCmdDispatch(commandBuffer, groupCount, 1, 1);
+	}
+
+	void Compute::CreateShaderProgram()
+	{
+		m_module = m_shaderProgram->CreateShaderModule(m_shader, m_defines);
+
+		m_stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		m_stage.stage = ShaderProgram::GetShaderStage(m_shader);
+		m_stage.module = m_module;
+		m_stage.pName = "main";
+
+		m_shaderProgram->ProcessShader();
+	}
+
+	void Compute::CreateDescriptorLayout()
+	{
+		const auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		std::vector<VkDescriptorSetLayoutBinding> bindings = std::vector<VkDescriptorSetLayoutBinding>();
+
+		for (auto type : *m_shaderProgram->m_descriptors)
+		{
+			bindings.push_back(type.m_descriptorSetLayoutBinding);
+		}
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo = {};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+		descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+		vkDeviceWaitIdle(logicalDevice);
+		Platform::ErrorVk(vkCreateDescriptorSetLayout(logicalDevice, &descriptorSetLayoutCreateInfo, nullptr, &m_descriptorSetLayout));
+	}
+
+	void Compute::CreateDescriptorPool()
+	{
+		const auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		std::vector<VkDescriptorPoolSize> poolSizes = std::vector<VkDescriptorPoolSize>();
+
+		for (auto type : *m_shaderProgram->m_descriptors)
+		{
+			poolSizes.push_back(type.m_descriptorPoolSize);
+		}
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+		descriptorPoolCreateInfo.pPoolSizes = poolSizes.data();
+		descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+		descriptorPoolCreateInfo.maxSets = 16;
+
+		vkDeviceWaitIdle(logicalDevice);
+		Platform::ErrorVk(vkCreateDescriptorPool(logicalDevice, &descriptorPoolCreateInfo, nullptr, &m_descriptorPool));
+	}
+
+	void Compute::CreatePipelineLayout()
+	{
+		const auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = {};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.setLayoutCount = 1;
+		pipelineLayoutCreateInfo.pSetLayouts = &m_descriptorSetLayout;
+
+		vkDeviceWaitIdle(logicalDevice);
+		Platform::ErrorVk(vkCreatePipelineLayout(logicalDevice, &pipelineLayoutCreateInfo, nullptr, &m_pipelineLayout));
+	}
+
+	void Compute::CreatePipelineCompute()
+	{
+		const auto logicalDevice = Display::Get()->GetLogicalDevice();
+		const auto pipelineCache = Renderer::Get()->GetPipelineCache();
+
+		VkComputePipelineCreateInfo pipelineCreateInfo = {};
+		pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		pipelineCreateInfo.stage = m_stage;
+		pipelineCreateInfo.layout = m_pipelineLayout;
+		pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+		pipelineCreateInfo.basePipelineIndex = -1;
+
+		// Create the compute pipeline.
+		Platform::ErrorVk(vkCreateComputePipelines(logicalDevice, pipelineCache, 1, &pipelineCreateInfo, nullptr, &m_pipeline));
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <GlslangToSpv.h>
+#include "../../Engine/Platform.hpp"
+#include "ShaderProgram.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// Class that represents a Vulkan compute pipeline.
+	/// </summary>
+	class F_EXPORT Compute
+	{
+	private:
+		std::string m_shader;
+		std::vector<std::string> m_defines;
+		ShaderProgram *m_shaderProgram;
+
+		VkShaderModule m_module;
+		VkPipelineShaderStageCreateInfo m_stage;
+
+		VkDescriptorSetLayout m_descriptorSetLayout;
+		VkDescriptorPool m_descriptorPool;
+
+		VkPipeline m_pipeline;
+		VkPipelineLayout m_pipelineLayout;
+	public:
+		/// <summary>
+		/// Creates a new compute pipeline.
+		/// </summary>
+		/// <param name="shader"> The compute shader file. </param>
+		/// <param name="defines"> A list of names that will be added a #define. </param>
+		Compute(const std::string &shader, const std::vector<std::string> &defines = std::vector<std::string>());
+
+		/// <summary>
+		/// Deconstructor for the compute pipeline.
+		/// </summary>
+		~Compute();
+
+		void BindPipeline(const VkCommandBuffer &commandBuffer) const;
+
+		/// <summary>
+		/// Records a dispatch with enough work groups to cover a number of invocations.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="invocations"> The number of invocations needed. </param>
+		/// <param name="groupSize"> The local size declared in the shader. </param>
+		void CmdDispatch(const VkCommandBuffer &commandBuffer, const uint32_t &invocations, const uint32_t &groupSize) const;
+
+		std::string GetShader() const { return m_shader; }
+
+		VkDescriptorSetLayout GetDescriptorSetLayout() const { return m_descriptorSetLayout; }
+
+		VkDescriptorPool GetDescriptorPool() const { return m_descriptorPool; }
+
+		VkPipeline GetPipeline() const { return m_pipeline; }
+
+		VkPipelineLayout GetPipelineLayout() const { return m_pipelineLayout; }
+	private:
+		void CreateShaderProgram();
+
+		void CreateDescriptorLayout();
+
+		void CreateDescriptorPool();
+
+		void CreatePipelineLayout();
+
+		void CreatePipelineCompute();
+	};
+}
@@ -1,6 +1,7 @@
 #include "DescriptorSet.hpp"
 
 #include "../../Devices/Display.hpp"
+#include "Compute.hpp"
 #include "Descriptor.hpp"
 #include "Pipeline.hpp"
 
@@ -8,6 +9,7 @@ namespace Flounder
 {
 	DescriptorSet::DescriptorSet(const Pipeline &pipeline) :
 		m_pipelineLayout(pipeline.GetPipelineLayout()),
+		m_pipelineBindPoint(VK_PIPELINE_BIND_POINT_GRAPHICS),
 		m_descriptorPool(pipeline.GetDescriptorPool()),
 		m_descriptorSet(VK_NULL_HANDLE),
 		m_descriptors(std::vector<Descriptor*>())
@@ -27,6 +29,28 @@ namespace Flounder
 		Platform::ErrorVk(vkAllocateDescriptorSets(logicalDevice, &descriptorSetAllocateInfo, &m_descriptorSet));
 	}
 
+	DescriptorSet::DescriptorSet(const Compute &compute) :
+		m_pipelineLayout(compute.GetPipelineLayout()),
+		m_pipelineBindPoint(VK_PIPELINE_BIND_POINT_COMPUTE),
+		m_descriptorPool(compute.GetDescriptorPool()),
+		m_descriptorSet(VK_NULL_HANDLE),
+		m_descriptors(std::vector<Descriptor*>())
+	{
+		const auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		VkDescriptorSetLayout layouts[1] = {compute.GetDescriptorSetLayout()};
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = {};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = 1;
+		descriptorSetAllocateInfo.pSetLayouts = layouts;
+
+		vkDeviceWaitIdle(logicalDevice);
+		Platform::ErrorVk(vkAllocateDescriptorSets(logicalDevice, &descriptorSetAllocateInfo, &m_descriptorSet));
+	}
+
 	DescriptorSet::~DescriptorSet()
 	{
 		const auto logicalDevice = Display::Get()->GetLogicalDevice();
@@ -63,6 +87,6 @@ namespace Flounder
 	void DescriptorSet::BindDescriptor(const VkCommandBuffer &commandBuffer)
 	{
 		VkDescriptorSet descriptors[1] = {m_descriptorSet};
-		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, descriptors, 0, nullptr);
+		vkCmdBindDescriptorSets(commandBuffer, m_pipelineBindPoint, m_pipelineLayout, 0, 1, descriptors, 0, nullptr);
 	}
 }
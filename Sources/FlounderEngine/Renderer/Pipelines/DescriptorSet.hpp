@@ -7,12 +7,14 @@
 namespace Flounder
 {
 	class Pipeline;
+	class Compute;
 	class Descriptor;
 
 	class F_EXPORT DescriptorSet
 	{
 	private:
 		VkPipelineLayout m_pipelineLayout;
+		VkPipelineBindPoint m_pipelineBindPoint;
 		VkDescriptorPool m_descriptorPool;
 		VkDescriptorSet m_descriptorSet;
 
@@ -20,10 +22,14 @@ namespace Flounder
 	public:
 		DescriptorSet(const Pipeline &pipeline);
 
+		DescriptorSet(const Compute &compute);
+
 		~DescriptorSet();
 
 		void Update(const std::vector<Descriptor*> &descriptors);
 
+		void Invalidate() { m_descriptors.clear(); }
+
 		void BindDescriptor(const VkCommandBuffer &commandBuffer);
 
 		VkDescriptorSet GetDescriptorSet() const { return m_descriptorSet; }
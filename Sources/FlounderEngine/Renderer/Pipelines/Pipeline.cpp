@@ -100,66 +100,13 @@ namespace Flounder
 
 	void Pipeline::CreateShaderProgram()
 	{
-		const auto logicalDevice = Display::Get()->GetLogicalDevice();
-
-		std::string defineBlock = "\n";
-
-		for (const auto &define : m_defines)
-		{
-			defineBlock += "#define " + define + "\n";
-		}
-
 		for (auto &type : m_pipelineCreateInfo.m_shaderStages)
 		{
-			auto shaderCode = ShaderProgram::InsertDefineBlock(FileSystem::ReadTextFile(type), defineBlock);
-
-			VkShaderStageFlagBits stageFlag = ShaderProgram::GetShaderStage(type);
-			EShLanguage language = ShaderProgram::GetEshLanguage(stageFlag);
-
-			// Starts converting GLSL to SPIR-V.
-			glslang::TShader shader = glslang::TShader(language);
-			glslang::TProgram program;
-			const char *shaderStrings[1];
-			TBuiltInResource resources = ShaderProgram::GetResources();
-
-			// Enable SPIR-V and Vulkan rules when parsing GLSL.
-			EShMessages messages = (EShMessages) (EShMsgSpvRules | EShMsgVulkanRules);
-
-			shaderStrings[0] = shaderCode.c_str();
-			shader.setStrings(shaderStrings, 1);
-
-			if (!shader.parse(&resources, 100, false, messages))
-			{
-				printf("%s\n", shader.getInfoLog());
-				printf("%s\n", shader.getInfoDebugLog());
-				fprintf(stderr, "SPRIV shader compile failed!\n");
-			}
-
-			program.addShader(&shader);
-
-			if (!program.link(messages) || !program.mapIO())
-			{
-				fprintf(stderr, "Error while linking shader program.\n");
-			}
-
-			program.buildReflection();
-			//	program.dumpReflection();
-			m_shaderProgram->LoadProgram(program, stageFlag);
-
-			std::vector<uint32_t> spirv = std::vector<uint32_t>();
-			glslang::GlslangToSpv(*program.getIntermediate(language), spirv);
-
-			VkShaderModuleCreateInfo shaderModuleCreateInfo = {};
-			shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-			shaderModuleCreateInfo.codeSize = spirv.size() * sizeof(uint32_t);
-			shaderModuleCreateInfo.pCode = spirv.data();
-
-			VkShaderModule shaderModule = VK_NULL_HANDLE;
-			Platform::ErrorVk(vkCreateShaderModule(logicalDevice, &shaderModuleCreateInfo, nullptr, &shaderModule));
+			VkShaderModule shaderModule = m_shaderProgram->CreateShaderModule(type, m_defines);
 
 			VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo = {};
 			pipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-			pipelineShaderStageCreateInfo.stage = stageFlag;
+			pipelineShaderStageCreateInfo.stage = ShaderProgram::GetShaderStage(type);
 			pipelineShaderStageCreateInfo.module = shaderModule;
 			pipelineShaderStageCreateInfo.pName = "main";
 
@@ -302,12 +249,16 @@ namespace Flounder
 		const auto pipelineCache = Renderer::Get()->GetPipelineCache();
 		const auto renderStage = Renderer::Get()->GetRenderStage(m_graphicsStage.renderpass);
 
+		// Packed vertex formats give their own attributes, the reflected ones assume tightly packed float attributes.
+		const std::vector<VkVertexInputAttributeDescription> &attributeDescriptions = m_pipelineCreateInfo.m_vertexAttributeDescriptions.empty() ?
+			*m_shaderProgram->m_attributeDescriptions : m_pipelineCreateInfo.m_vertexAttributeDescriptions;
+
 		VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo = {};
 		vertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 		vertexInputStateCreateInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(m_pipelineCreateInfo.m_vertexBindingDescriptions.size());
 		vertexInputStateCreateInfo.pVertexBindingDescriptions = m_pipelineCreateInfo.m_vertexBindingDescriptions.data();
-		vertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(m_shaderProgram->m_attributeDescriptions->size());
-		vertexInputStateCreateInfo.pVertexAttributeDescriptions = m_shaderProgram->m_attributeDescriptions->data();
+		vertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+		vertexInputStateCreateInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
 		VkGraphicsPipelineCreateInfo pipelineCreateInfo = {};
 		pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -48,13 +48,18 @@ namespace Flounder
 		VkPolygonMode m_polygonMode;
 		VkCullModeFlags m_cullModeFlags;
 
+		// When empty the attributes are reflected from the vertex shader.
+		std::vector<VkVertexInputAttributeDescription> m_vertexAttributeDescriptions;
+
 		PipelineCreate(const std::vector<std::string> &shaderStages, const std::vector<VkVertexInputBindingDescription> &vertexBindingDescriptions,
-					   const PipelineModeFlags &pipelineModeFlags = PIPELINE_POLYGON, const VkPolygonMode &polygonMode = VK_POLYGON_MODE_FILL, const VkCullModeFlags &cullModeFlags = VK_CULL_MODE_BACK_BIT) :
+					   const PipelineModeFlags &pipelineModeFlags = PIPELINE_POLYGON, const VkPolygonMode &polygonMode = VK_POLYGON_MODE_FILL, const VkCullModeFlags &cullModeFlags = VK_CULL_MODE_BACK_BIT,
+					   const std::vector<VkVertexInputAttributeDescription> &vertexAttributeDescriptions = {}) :
 			m_shaderStages(shaderStages),
 			m_vertexBindingDescriptions(vertexBindingDescriptions),
 			m_pipelineModeFlags(pipelineModeFlags),
 			m_polygonMode(polygonMode),
-			m_cullModeFlags(cullModeFlags)
+			m_cullModeFlags(cullModeFlags),
+			m_vertexAttributeDescriptions(vertexAttributeDescriptions)
 		{
 		}
 	};
@@ -1,5 +1,7 @@
 #include "ShaderProgram.hpp"
 
+#include "../../Devices/Display.hpp"
+#include "../../Helpers/FileSystem.hpp"
 #include "../../Helpers/FormatString.hpp"
 #include "../../Maths/Vector2.hpp"
 #include "../../Maths/Vector3.hpp"
@@ -9,6 +11,7 @@
 #include "../../Maths/Matrix4.hpp"
 #include "../../Textures/Texture.hpp"
 #include "../../Textures/Cubemap.hpp"
+#include "../Buffers/StorageBuffer.hpp"
 #include "../Buffers/UniformBuffer.hpp"
 
 namespace Flounder
@@ -65,6 +68,65 @@ namespace Flounder
 		}
 	}
 
+	VkShaderModule ShaderProgram::CreateShaderModule(const std::string &filename, const std::vector<std::string> &defines)
+	{
+		const auto logicalDevice = Display::Get()->GetLogicalDevice();
+
+		std::string defineBlock = "\n";
+
+		for (const auto &define : defines)
+		{
+			defineBlock += "#define " + define + "\n";
+		}
+
+		auto shaderCode = InsertDefineBlock(FileSystem::ReadTextFile(filename), defineBlock);
+
+		VkShaderStageFlagBits stageFlag = GetShaderStage(filename);
+		EShLanguage language = GetEshLanguage(stageFlag);
+
+		// Starts converting GLSL to SPIR-V.
+		glslang::TShader shader = glslang::TShader(language);
+		glslang::TProgram program;
+		const char *shaderStrings[1];
+		TBuiltInResource resources = GetResources();
+
+		// Enable SPIR-V and Vulkan rules when parsing GLSL.
+		EShMessages messages = (EShMessages) (EShMsgSpvRules | EShMsgVulkanRules);
+
+		shaderStrings[0] = shaderCode.c_str();
+		shader.setStrings(shaderStrings, 1);
+
+		if (!shader.parse(&resources, 100, false, messages))
+		{
+			printf("%s\n", shader.getInfoLog());
+			printf("%s\n", shader.getInfoDebugLog());
+			fprintf(stderr, "SPRIV shader compile failed!\n");
+		}
+
+		program.addShader(&shader);
+
+		if (!program.link(messages) || !program.mapIO())
+		{
+			fprintf(stderr, "Error while linking shader program.\n");
+		}
+
+		program.buildReflection();
+		//	program.dumpReflection();
+		LoadProgram(program, stageFlag);
+
+		std::vector<uint32_t> spirv = std::vector<uint32_t>();
+		glslang::GlslangToSpv(*program.getIntermediate(language), spirv);
+
+		VkShaderModuleCreateInfo shaderModuleCreateInfo = {};
+		shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		shaderModuleCreateInfo.codeSize = spirv.size() * sizeof(uint32_t);
+		shaderModuleCreateInfo.pCode = spirv.data();
+
+		VkShaderModule shaderModule = VK_NULL_HANDLE;
+		Platform::ErrorVk(vkCreateShaderModule(logicalDevice, &shaderModuleCreateInfo, nullptr, &shaderModule));
+		return shaderModule;
+	}
+
 	void ShaderProgram::LoadUniform(const glslang::TProgram &program, const VkShaderStageFlagBits &stageFlag, const int &i)
 	{
 		if (program.getUniformBinding(i) == -1)
@@ -77,7 +139,7 @@ namespace Flounder
 				{
 					if (uniformBlock->m_name == splitName.at(0))
 					{
-						uniformBlock->AddUniform(new Uniform(splitName.at(1), program.getUniformBinding(i), program.getUniformBufferOffset(i), program.getUniformType(i), stageFlag));
+						uniformBlock->AddUniform(new Uniform(splitName.at(1), program.getUniformBinding(i), program.getUniformBufferOffset(i), program.getUniformType(i), program.getUniformArraySize(i), stageFlag));
 						return;
 					}
 				}
@@ -93,7 +155,7 @@ namespace Flounder
 			}
 		}
 
-		m_uniforms->push_back(new Uniform(program.getUniformName(i), program.getUniformBinding(i), program.getUniformBufferOffset(i), program.getUniformType(i), stageFlag));
+		m_uniforms->push_back(new Uniform(program.getUniformName(i), program.getUniformBinding(i), program.getUniformBufferOffset(i), program.getUniformType(i), program.getUniformArraySize(i), stageFlag));
 	}
 
 	void ShaderProgram::LoadUniformBlock(const glslang::TProgram &program, const VkShaderStageFlagBits &stageFlag, const int &i)
@@ -107,7 +169,7 @@ namespace Flounder
 			}
 		}
 
-		m_uniformBlocks->push_back(new UniformBlock(program.getUniformBlockName(i), (program.getNumLiveUniformBlocks() - 1) - program.getUniformBlockIndex(i), program.getUniformBlockSize(i), stageFlag));
+		m_uniformBlocks->push_back(new UniformBlock(program.getUniformBlockName(i), program.getUniformBlockBinding(i), program.getUniformBlockSize(i), stageFlag));
 	}
 
 	void ShaderProgram::LoadVertexAttribute(const glslang::TProgram &program, const VkShaderStageFlagBits &stageFlag, const int &i)
@@ -138,6 +200,13 @@ namespace Flounder
 		// Process to descriptors.
 		for (auto uniformBlock : *m_uniformBlocks)
 		{
+			// Shader storage blocks are named with a 'Buffer' prefix, uniform blocks with 'Ubo'.
+			if (FormatString::StartsWith(uniformBlock->m_name, "Buffer"))
+			{
+				m_descriptors->push_back(StorageBuffer::CreateDescriptor(uniformBlock->m_index, uniformBlock->m_stageFlags));
+				continue;
+			}
+
 			m_descriptors->push_back(UniformBuffer::CreateDescriptor(uniformBlock->m_index, uniformBlock->m_stageFlags));
 		}
 
@@ -147,7 +216,7 @@ namespace Flounder
 			{
 			case TypeSampler2D:
 			case TypeWrite2D:
-				m_descriptors->push_back(Texture::CreateDescriptor(uniform->m_binding, uniform->m_stageFlags));
+				m_descriptors->push_back(Texture::CreateDescriptor(uniform->m_binding, uniform->m_stageFlags, std::max(uniform->m_arraySize, 1)));
 				break;
 			case TypeSampler3D:
 			case TypeWrite3D:
@@ -34,13 +34,15 @@ namespace Flounder
 		int m_binding;
 		int m_offset;
 		BasicTypes m_type;
+		int m_arraySize;
 		VkShaderStageFlagBits m_stageFlags;
 
-		Uniform(const std::string &name, const int &binding, const int &offset, const int &type, const VkShaderStageFlagBits &stageFlags) :
+		Uniform(const std::string &name, const int &binding, const int &offset, const int &type, const int &arraySize, const VkShaderStageFlagBits &stageFlags) :
 			m_name(name),
 			m_binding(binding),
 			m_offset(offset),
 			m_type((BasicTypes)type),
+			m_arraySize(arraySize),
 			m_stageFlags(stageFlags)
 		{
 		}
@@ -62,7 +64,7 @@ namespace Flounder
 		std::string ToString() const
 		{
 			std::stringstream result;
-			result << "Uniform(name '" << m_name << "', binding " << m_binding << ", offset " << m_offset << ", type " << m_type << ")";
+			result << "Uniform(name '" << m_name << "', binding " << m_binding << ", offset " << m_offset << ", type " << m_type << ", array size " << m_arraySize << ")";
 			return result.str();
 		}
 	};
@@ -153,6 +155,14 @@ namespace Flounder
 
 		void LoadProgram(const glslang::TProgram &program, const VkShaderStageFlagBits &stageFlag);
 
+		/// <summary>
+		/// Compiles a GLSL shader file to SPIR-V, loads its reflection into this program and creates its shader module.
+		/// </summary>
+		/// <param name="filename"> The shader file, its extension picks the stage. </param>
+		/// <param name="defines"> A list of names that will be added a #define. </param>
+		/// <returns> The shader module, owned by the caller. </returns>
+		VkShaderModule CreateShaderModule(const std::string &filename, const std::vector<std::string> &defines);
+
 	private:
 		void LoadUniform(const glslang::TProgram &program, const VkShaderStageFlagBits &stageFlag, const int &i);
 
@@ -0,0 +1,178 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include "../../Models/Model.hpp"
+#include "../Pipelines/DescriptorSet.hpp"
+#include "../Pipelines/Pipeline.hpp"
+
+namespace Flounder
+{
+	const uint32_t PIPELINE_BITS = 10;
+	const uint32_t MATERIAL_BITS = 14;
+	const uint32_t MODEL_BITS = 15;
+	const uint32_t DEPTH_BITS = 24;
+	const uint32_t MAX_IDS = 1 << 16;
+
+	RenderQueue::RenderQueue() :
+		m_packets(std::vector<DrawPacket>()),
+		m_items(std::vector<SortItem>()),
+		m_swap(std::vector<SortItem>()),
+		m_ids(std::unordered_map<const void *, uint32_t>()),
+		m_stats({})
+	{
+	}
+
+	RenderQueue::~RenderQueue()
+	{
+	}
+
+	void RenderQueue::Push(const Pipeline *pipeline, DescriptorSet *descriptorSet, Model *model, const void *material, const float &depth,
+		const bool &transparent, const uint32_t &instances, const uint32_t &firstInstance, const uint32_t &lod)
+	{
+		const uint64_t pipelineId = GetId(pipeline, PIPELINE_BITS);
+		const uint64_t materialId = GetId(material, MATERIAL_BITS);
+		const uint64_t modelId = GetId(model, MODEL_BITS);
+		const uint64_t depthMax = (1 << DEPTH_BITS) - 1;
+		const uint64_t depthId = static_cast<uint64_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>(depthMax));
+		uint64_t key;
+
+		if (!transparent)
+		{
+			// [0][pipeline][material][model][depth], state changes first, then front to back.
+			key = pipelineId << (MATERIAL_BITS + MODEL_BITS + DEPTH_BITS);
+			key |= materialId << (MODEL_BITS + DEPTH_BITS);
+			key |= modelId << DEPTH_BITS;
+			key |= depthId;
+		}
+		else
+		{
+			// [1][inverted depth][pipeline][material][model], blending order has to win over state.
+			key = static_cast<uint64_t>(1) << 63;
+			key |= (depthMax - depthId) << (PIPELINE_BITS + MATERIAL_BITS + MODEL_BITS);
+			key |= pipelineId << (MATERIAL_BITS + MODEL_BITS);
+			key |= materialId << MODEL_BITS;
+			key |= modelId;
+		}
+
+		DrawPacket packet = {};
+		packet.key = key;
+		packet.pipeline = pipeline;
+		packet.descriptorSet = descriptorSet;
+		packet.model = model;
+		packet.instances = instances;
+		packet.firstInstance = firstInstance;
+		packet.lod = lod;
+		m_packets.push_back(packet);
+	}
+
+	void RenderQueue::CmdRender(const VkCommandBuffer &commandBuffer)
+	{
+		m_stats = {};
+		Sort();
+
+		const Pipeline *boundPipeline = nullptr;
+		VkDescriptorSet boundDescriptor = VK_NULL_HANDLE;
+		Model *boundModel = nullptr;
+
+		for (auto &item : m_items)
+		{
+			DrawPacket &packet = m_packets.at(item.index);
+
+			if (packet.pipeline != boundPipeline)
+			{
+				packet.pipeline->BindPipeline(commandBuffer);
+				boundPipeline = packet.pipeline;
+				boundDescriptor = VK_NULL_HANDLE;
+				m_stats.pipelineBinds++;
+			}
+
+			if (packet.descriptorSet != nullptr && packet.descriptorSet->GetDescriptorSet() != boundDescriptor)
+			{
+				packet.descriptorSet->BindDescriptor(commandBuffer);
+				boundDescriptor = packet.descriptorSet->GetDescriptorSet();
+				m_stats.descriptorBinds++;
+			}
+
+			if (packet.model != boundModel)
+			{
+				packet.model->CmdBind(commandBuffer);
+				boundModel = packet.model;
+				m_stats.bufferBinds++;
+			}
+
+			packet.model->CmdDraw(commandBuffer, packet.instances, packet.firstInstance, packet.lod);
+			m_stats.draws++;
+		}
+
+		m_packets.clear();
+		m_items.clear();
+	}
+
+	uint32_t RenderQueue::GetId(const void *object, const uint32_t &bits)
+	{
+		auto it = m_ids.find(object);
+
+		if (it == m_ids.end())
+		{
+			// Ids only group draws, so a full table is reset instead of tracking destroyed objects.
+			if (m_ids.size() >= MAX_IDS)
+			{
+				m_ids.clear();
+			}
+
+			it = m_ids.emplace(object, static_cast<uint32_t>(m_ids.size())).first;
+		}
+
+		return it->second & ((1 << bits) - 1);
+	}
+
+	void RenderQueue::Sort()
+	{
+		const uint32_t count = static_cast<uint32_t>(m_packets.size());
+		m_items.resize(count);
+		m_swap.resize(count);
+
+		if (count == 0)
+		{
+			return;
+		}
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			m_items.at(i) = {m_packets.at(i).key, i};
+		}
+
+		// Least significant digit radix sort, one byte per pass, stable so equal keys keep their submit order.
+		for (uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			uint32_t histogram[256] = {};
+
+			for (auto &item : m_items)
+			{
+				histogram[(item.key >> shift) & 0xFF]++;
+			}
+
+			// Every key shares this byte, so the pass would not move anything.
+			if (histogram[(m_items.front().key >> shift) & 0xFF] == count)
+			{
+				continue;
+			}
+
+			uint32_t offset = 0;
+
+			for (uint32_t &bucket : histogram)
+			{
+				const uint32_t size = bucket;
+				bucket = offset;
+				offset += size;
+			}
+
+			for (auto &item : m_items)
+			{
+				m_swap.at(histogram[(item.key >> shift) & 0xFF]++) = item;
+			}
+
+			std::swap(m_items, m_swap);
+		}
+	}
+}
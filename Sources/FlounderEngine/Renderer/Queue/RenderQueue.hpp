@@ -0,0 +1,107 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "../../Engine/Platform.hpp"
+
+namespace Flounder
+{
+	class Pipeline;
+	class DescriptorSet;
+	class Model;
+
+	/// <summary>
+	/// A single draw recorded into a render queue.
+	/// </summary>
+	struct DrawPacket
+	{
+		uint64_t key;
+		const Pipeline *pipeline;
+		DescriptorSet *descriptorSet;
+		Model *model;
+		uint32_t instances;
+		uint32_t firstInstance;
+		uint32_t lod;
+	};
+
+	/// <summary>
+	/// Bind and draw counters for the last flushed frame.
+	/// </summary>
+	struct RenderQueueStats
+	{
+		uint32_t draws;
+		uint32_t pipelineBinds;
+		uint32_t descriptorBinds;
+		uint32_t bufferBinds;
+	};
+
+	/// <summary>
+	/// Collects draw packets over a frame, radix sorts them by a 64 bit key, then records them while skipping redundant binds.
+	/// Opaque keys sort by pipeline, material, model, then front to back depth.
+	/// Transparent keys sort after all opaque draws and back to front by depth, state is only grouped within equal depths.
+	/// </summary>
+	class F_EXPORT RenderQueue
+	{
+	private:
+		struct SortItem
+		{
+			uint64_t key;
+			uint32_t index;
+		};
+
+		std::vector<DrawPacket> m_packets;
+		std::vector<SortItem> m_items;
+		std::vector<SortItem> m_swap;
+
+		std::unordered_map<const void *, uint32_t> m_ids;
+
+		RenderQueueStats m_stats;
+	public:
+		/// <summary>
+		/// Creates a new render queue.
+		/// </summary>
+		RenderQueue();
+
+		/// <summary>
+		/// Deconstructor for the render queue.
+		/// </summary>
+		~RenderQueue();
+
+		/// <summary>
+		/// Adds a draw to the queue.
+		/// </summary>
+		/// <param name="pipeline"> The pipeline to draw with. </param>
+		/// <param name="descriptorSet"> The descriptor set to bind for the draw. </param>
+		/// <param name="model"> The model to draw. </param>
+		/// <param name="material"> A pointer identifying the material state, used only to group draws. </param>
+		/// <param name="depth"> The draws view depth, scaled into [0, 1]. </param>
+		/// <param name="transparent"> If the draw is blended and has to be drawn back to front. </param>
+		/// <param name="instances"> The number of instances to draw. </param>
+		/// <param name="firstInstance"> The first instance index, used to look up per instance data. </param>
+		/// <param name="lod"> The models level of detail to draw. </param>
+		void Push(const Pipeline *pipeline, DescriptorSet *descriptorSet, Model *model, const void *material, const float &depth,
+			const bool &transparent = false, const uint32_t &instances = 1, const uint32_t &firstInstance = 0, const uint32_t &lod = 0);
+
+		/// <summary>
+		/// Sorts and records every queued draw, then empties the queue.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		void CmdRender(const VkCommandBuffer &commandBuffer);
+
+		/// <summary>
+		/// Gets the number of draws waiting in the queue.
+		/// </summary>
+		/// <returns> The queued draw count. </returns>
+		uint32_t GetSize() const { return static_cast<uint32_t>(m_packets.size()); }
+
+		/// <summary>
+		/// Gets the counters from the last time the queue was rendered.
+		/// </summary>
+		/// <returns> The queues stats. </returns>
+		RenderQueueStats GetStats() const { return m_stats; }
+	private:
+		uint32_t GetId(const void *object, const uint32_t &bits);
+
+		void Sort();
+	};
+}
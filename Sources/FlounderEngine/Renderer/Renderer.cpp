@@ -73,6 +73,19 @@ namespace Flounder
 	}
 
 	VkResult Renderer::StartRenderpass(const VkCommandBuffer &commandBuffer, const unsigned int &i)
+	{
+		const VkResult result = BeginCommands(commandBuffer, i);
+
+		if (result != VK_SUCCESS)
+		{
+			return result;
+		}
+
+		BeginRenderpass(commandBuffer, i);
+		return VK_SUCCESS;
+	}
+
+	VkResult Renderer::BeginCommands(const VkCommandBuffer &commandBuffer, const unsigned int &i)
 	{
 		const auto renderStage = GetRenderStage(i);
 
@@ -112,6 +125,12 @@ namespace Flounder
 		commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
 		Platform::ErrorVk(vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo));
+		return VK_SUCCESS;
+	}
+
+	void Renderer::BeginRenderpass(const VkCommandBuffer &commandBuffer, const unsigned int &i)
+	{
+		const auto renderStage = GetRenderStage(i);
 
 		VkRect2D renderArea = {};
 		renderArea.offset.x = 0;
@@ -144,8 +163,6 @@ namespace Flounder
 		scissor.extent.width = renderStage->GetWidth();
 		scissor.extent.height = renderStage->GetHeight();
 		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
-
-		return VK_SUCCESS;
 	}
 
 	void Renderer::EndRenderpass(const VkCommandBuffer &commandBuffer, const unsigned int &i)
@@ -59,6 +59,22 @@ namespace Flounder
 		/// <returns> VK_SUCCESS on success. </returns>
 		VkResult StartRenderpass(const VkCommandBuffer &commandBuffer, const unsigned int &i);
 
+		/// <summary>
+		/// Starts recording the command buffer for a renderpass without beginning the renderpass, so work that can not be inside a renderpass
+		/// such as compute dispatches can be recorded first. <seealso cref="#BeginRenderpass()"/> has to be called afterwards.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to use. </param>
+		/// <param name="i"> The index of the render pass being rendered. </param>
+		/// <returns> VK_SUCCESS on success. </returns>
+		VkResult BeginCommands(const VkCommandBuffer &commandBuffer, const unsigned int &i);
+
+		/// <summary>
+		/// Begins a renderpass in a command buffer started with <seealso cref="#BeginCommands()"/>.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to use. </param>
+		/// <param name="i"> The index of the render pass being rendered. </param>
+		void BeginRenderpass(const VkCommandBuffer &commandBuffer, const unsigned int &i);
+
 		/// <summary>
 		/// Ends the renderpass.
 		/// </summary>
@@ -18,7 +18,7 @@ namespace Flounder
 		{
 			VkAttachmentDescription attachment = {};
 			attachment.samples = VK_SAMPLE_COUNT_1_BIT;
-			attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+			attachment.loadOp = image.m_loadOp;
 			attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 			attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 			attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
@@ -40,6 +40,12 @@ namespace Flounder
 				break;
 			}
 
+			// Loaded attachments keep their contents from the last pass.
+			if (image.m_loadOp == VK_ATTACHMENT_LOAD_OP_LOAD)
+			{
+				attachment.initialLayout = attachment.finalLayout;
+			}
+
 			attachments.push_back(attachment);
 		}
 
@@ -23,15 +23,18 @@ namespace Flounder
 		Colour m_clearColour;
 		VkImageLayout m_layout;
 		VkImageUsageFlags m_usage;
+		VkAttachmentLoadOp m_loadOp;
 
 		Attachment(const unsigned int &binding, const AttachmentType &type, const VkFormat &format = VK_FORMAT_R8G8B8A8_UNORM, const Colour &clearColour = Colour::BLACK,
-				   const VkImageLayout &layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, const VkImageUsageFlags &usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) :
+				   const VkImageLayout &layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, const VkImageUsageFlags &usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+				   const VkAttachmentLoadOp &loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR) :
 			m_binding(binding),
 			m_type(type),
 			m_format(format),
 			m_clearColour(clearColour),
 			m_layout(layout),
-			m_usage(usage)
+			m_usage(usage),
+			m_loadOp(loadOp)
 		{
 		}
 	};
@@ -2,41 +2,288 @@
 
 #include "../Devices/Display.hpp"
 #include "../Meshes/Mesh.hpp"
+#include "../Renderer/Renderer.hpp"
 #include "../Scenes/Scenes.hpp"
 #include "ShadowRender.hpp"
 #include "UbosShadows.hpp"
 
 namespace Flounder
 {
+	static void CmdImageBarrier(const VkCommandBuffer &commandBuffer, const VkImage &image, const VkImageAspectFlags &aspectMask, const VkImageLayout &oldLayout, const VkImageLayout &newLayout)
+	{
+		VkImageMemoryBarrier imageMemoryBarrier = {};
+		imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		imageMemoryBarrier.srcAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+		imageMemoryBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+		imageMemoryBarrier.oldLayout = oldLayout;
+		imageMemoryBarrier.newLayout = newLayout;
+		imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		imageMemoryBarrier.image = image;
+		imageMemoryBarrier.subresourceRange.aspectMask = aspectMask;
+		imageMemoryBarrier.subresourceRange.baseMipLevel = 0;
+		imageMemoryBarrier.subresourceRange.levelCount = 1;
+		imageMemoryBarrier.subresourceRange.baseArrayLayer = 0;
+		imageMemoryBarrier.subresourceRange.layerCount = 1;
+
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+	}
+
 	RendererShadows::RendererShadows(const GraphicsStage &graphicsStage) :
 		IRenderer(),
-		m_uniformScene(new UniformBuffer(sizeof(UbosShadows::UboScene))),
+		m_uniformScenes(std::vector<UniformBuffer *>()),
 		m_pipeline(new Pipeline(graphicsStage, PipelineCreate({"Resources/Shaders/Shadows/Shadow.vert", "Resources/Shaders/Shadows/Shadow.frag"},
-			VertexModel::GetBindingDescriptions(), PIPELINE_POLYGON_NO_DEPTH, VK_POLYGON_MODE_FILL, VK_CULL_MODE_FRONT_BIT), { }))
+			VertexModel::GetBindingDescriptions(), PIPELINE_POLYGON, VK_POLYGON_MODE_FILL, VK_CULL_MODE_FRONT_BIT), { })),
+		m_caches(std::vector<CascadeCache>()),
+		m_depthImage(VK_NULL_HANDLE)
 	{
+		for (uint32_t i = 0; i < MAX_CASCADES; i++)
+		{
+			m_uniformScenes.push_back(new UniformBuffer(sizeof(UbosShadows::UboScene)));
+			m_caches.push_back({nullptr, nullptr, 0});
+		}
 	}
 
 	RendererShadows::~RendererShadows()
 	{
-		delete m_uniformScene;
+		for (auto uniformScene : m_uniformScenes)
+		{
+			delete uniformScene;
+		}
+
+		for (auto &cache : m_caches)
+		{
+			delete cache.colour;
+			delete cache.depth;
+		}
+
 		delete m_pipeline;
 	}
 
-	void RendererShadows::Render(const VkCommandBuffer &commandBuffer, const Vector4 &clipPlane, const ICamera &camera)
+	void RendererShadows::RenderPrepass(const VkCommandBuffer &commandBuffer, const ICamera &camera)
 	{
-		UbosShadows::UboScene uboScene = {};
-		uboScene.projectionView = *Shadows::Get()->GetShadowBox()->GetProjectionViewMatrix();
-		uboScene.cameraPosition = *Scenes::Get()->GetCamera()->GetPosition();
-		m_uniformScene->Update(&uboScene);
+		// The atlas depth is loaded so restored cells keep their depth, a new depth image has to leave its undefined layout first.
+		const VkImage depthImage = m_pipeline->GetDepthStencil()->GetImage();
+
+		if (depthImage != m_depthImage)
+		{
+			CmdImageBarrier(commandBuffer, depthImage, VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT,
+				VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+			m_depthImage = depthImage;
+		}
+
+		for (uint32_t i = 0; i < Shadows::Get()->GetCascadeCount(); i++)
+		{
+			ShadowCascade *cascade = Shadows::Get()->GetCascade(i);
+
+			if (!cascade->IsCached())
+			{
+				continue;
+			}
+
+			// A clean cached cell gets its static casters back, the dynamic casters drawn last frame are overwritten.
+			if (!cascade->IsDirty())
+			{
+				CopyCache(commandBuffer, i, false);
+				continue;
+			}
 
+			CascadeCache &cache = m_caches.at(i);
+
+			if (cache.resolution != cascade->GetResolution())
+			{
+				delete cache.colour;
+				delete cache.depth;
+				cache.colour = new Texture(cascade->GetResolution(), cascade->GetResolution(), VK_FORMAT_R16_UNORM, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+				cache.depth = new DepthStencil({cascade->GetResolution(), cascade->GetResolution(), 1});
+				cache.resolution = cascade->GetResolution();
+			}
+		}
+	}
+
+	void RendererShadows::Render(const VkCommandBuffer &commandBuffer, const Vector4 &clipPlane, const ICamera &camera)
+	{
 		m_pipeline->BindPipeline(commandBuffer);
 
 		std::vector<ShadowRender *> renderList = std::vector<ShadowRender *>();
 		Scenes::Get()->GetStructure()->QueryComponents<ShadowRender>(&renderList);
 
+		bool cachesDirty = false;
+
+		for (uint32_t i = 0; i < Shadows::Get()->GetCascadeCount(); i++)
+		{
+			ShadowCascade *cascade = Shadows::Get()->GetCascade(i);
+
+			// Updates uniforms.
+			UbosShadows::UboScene uboScene = {};
+			uboScene.projectionView = *cascade->GetProjectionViewMatrix();
+			uboScene.cameraPosition = *Scenes::Get()->GetCamera()->GetPosition();
+			m_uniformScenes.at(i)->Update(&uboScene);
+
+			// A clean cached cell was restored before the pass, only the dynamic casters are drawn over it.
+			if (!cascade->IsDirty())
+			{
+				RenderCasters(commandBuffer, renderList, i, false, true);
+				continue;
+			}
+
+			// Clears the cascades cell in the atlas.
+			VkClearAttachment clearAttachments[2] = {};
+			clearAttachments[0].aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			clearAttachments[0].colorAttachment = 0;
+			clearAttachments[0].clearValue.color = {{1.0f, 1.0f, 1.0f, 1.0f}};
+			clearAttachments[1].aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+			clearAttachments[1].clearValue.depthStencil = {1.0f, 0};
+
+			VkClearRect clearRect = {};
+			clearRect.rect.offset.x = static_cast<int32_t>(cascade->GetOffsetX());
+			clearRect.rect.offset.y = static_cast<int32_t>(cascade->GetOffsetY());
+			clearRect.rect.extent.width = cascade->GetResolution();
+			clearRect.rect.extent.height = cascade->GetResolution();
+			clearRect.baseArrayLayer = 0;
+			clearRect.layerCount = 1;
+			vkCmdClearAttachments(commandBuffer, 2, clearAttachments, 1, &clearRect);
+
+			// A dirty cached cell is kept with only its static casters, the dynamic casters are drawn once it is copied.
+			RenderCasters(commandBuffer, renderList, i, true, !cascade->IsCached());
+			cachesDirty = cachesDirty || cascade->IsCached();
+		}
+
+		if (cachesDirty)
+		{
+			// Copies can not be recorded inside a render pass, it is ended to keep the static cells and started again, both attachments are loaded.
+			vkCmdEndRenderPass(commandBuffer);
+
+			for (uint32_t i = 0; i < Shadows::Get()->GetCascadeCount(); i++)
+			{
+				ShadowCascade *cascade = Shadows::Get()->GetCascade(i);
+
+				if (cascade->IsCached() && cascade->IsDirty())
+				{
+					CopyCache(commandBuffer, i, true);
+				}
+			}
+
+			Renderer::Get()->BeginRenderpass(commandBuffer, m_pipeline->GetGraphicsStage().renderpass);
+			m_pipeline->BindPipeline(commandBuffer);
+
+			for (uint32_t i = 0; i < Shadows::Get()->GetCascadeCount(); i++)
+			{
+				ShadowCascade *cascade = Shadows::Get()->GetCascade(i);
+
+				if (cascade->IsCached() && cascade->IsDirty())
+				{
+					RenderCasters(commandBuffer, renderList, i, false, true);
+				}
+			}
+		}
+
+		for (uint32_t i = 0; i < Shadows::Get()->GetCascadeCount(); i++)
+		{
+			Shadows::Get()->GetCascade(i)->SetRendered();
+		}
+	}
+
+	void RendererShadows::RenderCasters(const VkCommandBuffer &commandBuffer, const std::vector<ShadowRender *> &renderList, const uint32_t &i, const bool &drawStatic, const bool &drawDynamic)
+	{
+		ShadowCascade *cascade = Shadows::Get()->GetCascade(i);
+
+		// Limits rendering to the cascades cell in the atlas.
+		VkRect2D region = {};
+		region.offset.x = static_cast<int32_t>(cascade->GetOffsetX());
+		region.offset.y = static_cast<int32_t>(cascade->GetOffsetY());
+		region.extent.width = cascade->GetResolution();
+		region.extent.height = cascade->GetResolution();
+
+		VkViewport viewport = {};
+		viewport.x = static_cast<float>(region.offset.x);
+		viewport.y = static_cast<float>(region.offset.y);
+		viewport.width = static_cast<float>(region.extent.width);
+		viewport.height = static_cast<float>(region.extent.height);
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+		vkCmdSetScissor(commandBuffer, 0, 1, &region);
+
+		// Draws the casters inside this cascade.
 		for (auto shadowRender : renderList)
 		{
-			shadowRender->CmdRender(commandBuffer, *m_pipeline, m_uniformScene);
+			if (shadowRender->IsStatic() ? !drawStatic : !drawDynamic)
+			{
+				continue;
+			}
+
+			if (!cascade->IsInBox(*shadowRender->GetCentre(), shadowRender->GetRadius()))
+			{
+				continue;
+			}
+
+			shadowRender->CmdRender(commandBuffer, *m_pipeline, m_uniformScenes.at(i), i);
 		}
 	}
+
+	void RendererShadows::CopyCache(const VkCommandBuffer &commandBuffer, const uint32_t &i, const bool &save)
+	{
+		ShadowCascade *cascade = Shadows::Get()->GetCascade(i);
+		const CascadeCache &cache = m_caches.at(i);
+		const VkImage atlasColour = m_pipeline->GetTexture(0)->GetImage();
+		const VkImage atlasDepth = m_pipeline->GetDepthStencil()->GetImage();
+		const VkImageAspectFlags depthAspect = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+		const VkImageLayout atlasLayout = save ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+		CmdImageBarrier(commandBuffer, atlasColour, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, atlasLayout);
+		CmdImageBarrier(commandBuffer, atlasDepth, depthAspect, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, atlasLayout);
+
+		// The cache is wholly overwritten when saved, afterwards it stays a copy source.
+		if (save)
+		{
+			CmdImageBarrier(commandBuffer, cache.colour->GetImage(), VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+			CmdImageBarrier(commandBuffer, cache.depth->GetImage(), depthAspect, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+		}
+
+		const VkOffset3D cellOffset = {static_cast<int32_t>(cascade->GetOffsetX()), static_cast<int32_t>(cascade->GetOffsetY()), 0};
+		const VkOffset3D cacheOffset = {0, 0, 0};
+
+		VkImageCopy imageCopy = {};
+		imageCopy.srcSubresource.mipLevel = 0;
+		imageCopy.srcSubresource.baseArrayLayer = 0;
+		imageCopy.srcSubresource.layerCount = 1;
+		imageCopy.srcOffset = save ? cellOffset : cacheOffset;
+		imageCopy.dstSubresource = imageCopy.srcSubresource;
+		imageCopy.dstOffset = save ? cacheOffset : cellOffset;
+		imageCopy.extent = {cascade->GetResolution(), cascade->GetResolution(), 1};
+
+		imageCopy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		imageCopy.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+
+		if (save)
+		{
+			vkCmdCopyImage(commandBuffer, atlasColour, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, cache.colour->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageCopy);
+		}
+		else
+		{
+			vkCmdCopyImage(commandBuffer, cache.colour->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, atlasColour, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageCopy);
+		}
+
+		imageCopy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+		imageCopy.dstSubresource.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+		if (save)
+		{
+			vkCmdCopyImage(commandBuffer, atlasDepth, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, cache.depth->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageCopy);
+		}
+		else
+		{
+			vkCmdCopyImage(commandBuffer, cache.depth->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, atlasDepth, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageCopy);
+		}
+
+		if (save)
+		{
+			CmdImageBarrier(commandBuffer, cache.colour->GetImage(), VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+			CmdImageBarrier(commandBuffer, cache.depth->GetImage(), depthAspect, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+		}
+
+		CmdImageBarrier(commandBuffer, atlasColour, VK_IMAGE_ASPECT_COLOR_BIT, atlasLayout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		CmdImageBarrier(commandBuffer, atlasDepth, depthAspect, atlasLayout, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+	}
 }
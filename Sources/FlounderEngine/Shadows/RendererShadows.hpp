@@ -1,23 +1,44 @@
 #pragma once
 
 #include "../Renderer/IRenderer.hpp"
+#include "../Renderer/Swapchain/DepthStencil.hpp"
 #include "../Terrains/Terrains.hpp"
 #include "../Models/Model.hpp"
 #include "Shadows.hpp"
 
 namespace Flounder
 {
+	class ShadowRender;
+
 	class F_EXPORT RendererShadows :
 		public IRenderer
 	{
 	private:
-		UniformBuffer *m_uniformScene;
+		/// <summary>
+		/// A copy of a cached cascades atlas cell holding only its static casters.
+		/// </summary>
+		struct CascadeCache
+		{
+			Texture *colour;
+			DepthStencil *depth;
+			uint32_t resolution;
+		};
+
+		std::vector<UniformBuffer *> m_uniformScenes;
 		Pipeline *m_pipeline;
+		std::vector<CascadeCache> m_caches;
+		VkImage m_depthImage;
 	public:
 		RendererShadows(const GraphicsStage &graphicsStage);
 
 		~RendererShadows();
 
+		void RenderPrepass(const VkCommandBuffer &commandBuffer, const ICamera &camera) override;
+
 		void Render(const VkCommandBuffer &commandBuffer, const Vector4 &clipPlane, const ICamera &camera) override;
+	private:
+		void RenderCasters(const VkCommandBuffer &commandBuffer, const std::vector<ShadowRender *> &renderList, const uint32_t &i, const bool &drawStatic, const bool &drawDynamic);
+
+		void CopyCache(const VkCommandBuffer &commandBuffer, const uint32_t &i, const bool &save);
 	};
 }
@@ -0,0 +1,170 @@
+#include "ShadowCascade.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "../Maths/Maths.hpp"
+
+namespace Flounder
+{
+	const float CACHE_PADDING = 1.25f;
+
+	ShadowCascade::ShadowCascade() :
+		m_lightDirection(new Vector3()),
+		m_centre(new Vector3()),
+		m_radius(0.0f),
+		m_depth(0.0f),
+		m_resolution(0),
+		m_offsetX(0),
+		m_offsetY(0),
+		m_lightViewMatrix(new Matrix4()),
+		m_projectionMatrix(new Matrix4()),
+		m_projectionViewMatrix(new Matrix4()),
+		m_shadowMapSpaceMatrix(new Matrix4()),
+		m_cached(false),
+		m_dirty(true)
+	{
+	}
+
+	ShadowCascade::~ShadowCascade()
+	{
+		delete m_lightDirection;
+		delete m_centre;
+
+		delete m_lightViewMatrix;
+		delete m_projectionMatrix;
+		delete m_projectionViewMatrix;
+		delete m_shadowMapSpaceMatrix;
+	}
+
+	void ShadowCascade::Update(const ICamera &camera, const Vector3 &lightDirection, const float &nearSplit, const float &farSplit, const float &casterOffset,
+		const uint32_t &resolution, const bool &cached, const float &cacheAngle)
+	{
+		// Finds the corners of the frustum slice in world space.
+		Matrix4 inverseView = Matrix4();
+		Matrix4::Invert(*camera.GetViewMatrix(), &inverseView);
+		const float tanX = 1.0f / std::fabs(camera.GetProjectionMatrix()->m_00);
+		const float tanY = 1.0f / std::fabs(camera.GetProjectionMatrix()->m_11);
+
+		Vector3 corners[8];
+		Vector3 centre = Vector3();
+		Vector4 corner = Vector4();
+
+		for (int i = 0; i < 8; i++)
+		{
+			const float distance = i < 4 ? nearSplit : farSplit;
+			const float x = (i & 1) ? distance * tanX : -distance * tanX;
+			const float y = (i & 2) ? distance * tanY : -distance * tanY;
+			Matrix4::Transform(inverseView, Vector4(x, y, -distance, 1.0f), &corner);
+			corners[i] = Vector3(corner.m_x, corner.m_y, corner.m_z);
+			centre += corners[i];
+		}
+
+		centre /= 8.0f;
+
+		// The sphere radius does not change as the camera rotates, rounding it up hides float jitter.
+		float radius = 0.0f;
+
+		for (int i = 0; i < 8; i++)
+		{
+			radius = std::max(radius, Vector3::GetDistance(corners[i], centre));
+		}
+
+		radius = std::ceil(radius * 16.0f) / 16.0f;
+
+		if (!cached)
+		{
+			m_cached = false;
+			m_dirty = true;
+			m_resolution = resolution;
+			UpdateMatrices(centre, radius, lightDirection, casterOffset);
+			return;
+		}
+
+		// Cached cascades are only moved when they no longer cover the slice or the light has turned.
+		const bool lightMoved = Vector3::Dot(lightDirection, *m_lightDirection) < std::cos(Maths::Radians(cacheAngle));
+		const bool sliceEscaped = Vector3::GetDistance(centre, *m_centre) + radius > m_radius;
+
+		if (!m_cached || lightMoved || sliceEscaped || m_resolution != resolution)
+		{
+			m_cached = true;
+			m_dirty = true;
+			m_resolution = resolution;
+			UpdateMatrices(centre, radius * CACHE_PADDING, lightDirection, casterOffset);
+		}
+	}
+
+	bool ShadowCascade::IsInBox(const Vector3 &position, const float &radius) const
+	{
+		Vector4 lightPosition = Vector4();
+		Matrix4::Transform(*m_lightViewMatrix, Vector4(position), &lightPosition);
+
+		return std::fabs(lightPosition.m_x) <= m_radius + radius &&
+			std::fabs(lightPosition.m_y) <= m_radius + radius &&
+			lightPosition.m_z <= radius && lightPosition.m_z >= -m_depth - radius;
+	}
+
+	void ShadowCascade::SetAtlasOffset(const uint32_t &offsetX, const uint32_t &offsetY)
+	{
+		if (m_offsetX != offsetX || m_offsetY != offsetY)
+		{
+			m_offsetX = offsetX;
+			m_offsetY = offsetY;
+			Invalidate();
+		}
+	}
+
+	void ShadowCascade::UpdateMatrices(const Vector3 &centre, const float &radius, const Vector3 &lightDirection, const float &casterOffset)
+	{
+		*m_lightDirection = lightDirection;
+		m_lightDirection->Normalize();
+		m_radius = radius;
+		m_depth = 2.0f * radius + casterOffset;
+
+		// Builds the light rotation, looking down the light direction.
+		Vector3 zAxis = -Vector3(*m_lightDirection);
+		Vector3 up = std::fabs(zAxis.m_y) > 0.99f ? Vector3(0.0f, 0.0f, 1.0f) : Vector3(0.0f, 1.0f, 0.0f);
+		Vector3 xAxis = Vector3();
+		Vector3::Cross(up, zAxis, &xAxis);
+		xAxis.Normalize();
+		Vector3 yAxis = Vector3();
+		Vector3::Cross(zAxis, xAxis, &yAxis);
+
+		// Snaps the centre to whole texels in light space.
+		const float texelSize = (2.0f * radius) / static_cast<float>(m_resolution);
+		const float snappedX = std::floor(Vector3::Dot(centre, xAxis) / texelSize) * texelSize;
+		const float snappedY = std::floor(Vector3::Dot(centre, yAxis) / texelSize) * texelSize;
+		const float depth = Vector3::Dot(centre, zAxis);
+		*m_centre = (xAxis * snappedX) + (yAxis * snappedY) + (zAxis * depth);
+
+		const Vector3 eye = *m_centre + (zAxis * (radius + casterOffset));
+
+		m_lightViewMatrix->SetIdentity();
+		m_lightViewMatrix->m_00 = xAxis.m_x;
+		m_lightViewMatrix->m_10 = xAxis.m_y;
+		m_lightViewMatrix->m_20 = xAxis.m_z;
+		m_lightViewMatrix->m_30 = -Vector3::Dot(xAxis, eye);
+		m_lightViewMatrix->m_01 = yAxis.m_x;
+		m_lightViewMatrix->m_11 = yAxis.m_y;
+		m_lightViewMatrix->m_21 = yAxis.m_z;
+		m_lightViewMatrix->m_31 = -Vector3::Dot(yAxis, eye);
+		m_lightViewMatrix->m_02 = zAxis.m_x;
+		m_lightViewMatrix->m_12 = zAxis.m_y;
+		m_lightViewMatrix->m_22 = zAxis.m_z;
+		m_lightViewMatrix->m_32 = -Vector3::Dot(zAxis, eye);
+
+		// Orthographic projection with Vulkan's [0, 1] depth range.
+		m_projectionMatrix->SetIdentity();
+		m_projectionMatrix->m_00 = 1.0f / radius;
+		m_projectionMatrix->m_11 = 1.0f / radius;
+		m_projectionMatrix->m_22 = -1.0f / m_depth;
+
+		Matrix4::Multiply(*m_projectionMatrix, *m_lightViewMatrix, m_projectionViewMatrix);
+
+		Matrix4 offset = Matrix4();
+		offset.m_00 = 0.5f;
+		offset.m_11 = 0.5f;
+		offset.m_30 = 0.5f;
+		offset.m_31 = 0.5f;
+		Matrix4::Multiply(offset, *m_projectionViewMatrix, m_shadowMapSpaceMatrix);
+	}
+}
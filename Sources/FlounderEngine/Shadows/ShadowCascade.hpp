@@ -0,0 +1,109 @@
+#pragma once
+
+#include "../Scenes/ICamera.hpp"
+#include "../Maths/Matrix4.hpp"
+#include "../Maths/Vector3.hpp"
+
+namespace Flounder
+{
+#define MAX_CASCADES 4
+
+	/// <summary>
+	/// One split of the cameras view frustum that is rendered into a cell of the shadow atlas.
+	/// The cascade is fit around a bounding sphere of its frustum slice, so the projection does not change size as the camera rotates,
+	/// and the centre is snapped to whole shadow map texels so shadow edges do not shimmer as the camera moves.
+	/// </summary>
+	class F_EXPORT ShadowCascade
+	{
+	private:
+		Vector3 *m_lightDirection;
+		Vector3 *m_centre;
+		float m_radius;
+		float m_depth;
+
+		uint32_t m_resolution;
+		uint32_t m_offsetX;
+		uint32_t m_offsetY;
+
+		Matrix4 *m_lightViewMatrix;
+		Matrix4 *m_projectionMatrix;
+		Matrix4 *m_projectionViewMatrix;
+		Matrix4 *m_shadowMapSpaceMatrix;
+
+		bool m_cached;
+		bool m_dirty;
+	public:
+		/// <summary>
+		/// Creates a new shadow cascade.
+		/// </summary>
+		ShadowCascade();
+
+		~ShadowCascade();
+
+		/// <summary>
+		/// Fits the cascade to a slice of the cameras view frustum.
+		/// A cached cascade is padded and only moved when the slice leaves the padded area or the light turns by more than the cache angle.
+		/// </summary>
+		/// <param name="camera"> The camera object to be used when calculating the cascades size. </param>
+		/// <param name="lightDirection"> The direction the light travels in. </param>
+		/// <param name="nearSplit"> The view distance this cascade starts at. </param>
+		/// <param name="farSplit"> The view distance this cascade ends at. </param>
+		/// <param name="casterOffset"> How far behind the slice casters are still captured. </param>
+		/// <param name="resolution"> The size of this cascades cell in the atlas. </param>
+		/// <param name="cached"> If this cascade should keep its contents between frames. </param>
+		/// <param name="cacheAngle"> The light rotation in degrees that forces a cached cascade to be rendered again. </param>
+		void Update(const ICamera &camera, const Vector3 &lightDirection, const float &nearSplit, const float &farSplit, const float &casterOffset,
+			const uint32_t &resolution, const bool &cached, const float &cacheAngle);
+
+		/// <summary>
+		/// Tests if a bounding sphere intersects the cascades light space box, used to cull casters per cascade.
+		/// </summary>
+		/// <param name="position"> The centre of the bounding sphere in world space. </param>
+		/// <param name="radius"> The radius of the bounding sphere. </param>
+		/// <returns> If the sphere intersects the box. </returns>
+		bool IsInBox(const Vector3 &position, const float &radius) const;
+
+		/// <summary>
+		/// Sets where in the shadow atlas this cascade is rendered to.
+		/// </summary>
+		/// <param name="offsetX"> The cells x offset in pixels. </param>
+		/// <param name="offsetY"> The cells y offset in pixels. </param>
+		void SetAtlasOffset(const uint32_t &offsetX, const uint32_t &offsetY);
+
+		uint32_t GetResolution() const { return m_resolution; }
+
+		uint32_t GetOffsetX() const { return m_offsetX; }
+
+		uint32_t GetOffsetY() const { return m_offsetY; }
+
+		Matrix4 *GetProjectionViewMatrix() const { return m_projectionViewMatrix; }
+
+		/// <summary>
+		/// This biased projection-view matrix converts world positions into the cascades [0, 1] shadow map space.
+		/// </summary>
+		/// <returns> The to-shadow-map-space matrix. </returns>
+		Matrix4 *GetToShadowMapSpaceMatrix() const { return m_shadowMapSpaceMatrix; }
+
+		Matrix4 *GetLightSpaceTransform() const { return m_lightViewMatrix; }
+
+		bool IsCached() const { return m_cached; }
+
+		/// <summary>
+		/// Gets if the casters in the cascades atlas cell have to be rendered again this frame, a clean cached cascade only draws its dynamic casters.
+		/// </summary>
+		/// <returns> If the cascade is dirty. </returns>
+		bool IsDirty() const { return m_dirty; }
+
+		/// <summary>
+		/// Marks the cascade as rendered, the static casters of a cached cascade will be kept until it is moved or invalidated.
+		/// </summary>
+		void SetRendered() { m_dirty = !m_cached; }
+
+		/// <summary>
+		/// Forces the cascade to be fit and rendered again on the next update.
+		/// </summary>
+		void Invalidate() { m_radius = 0.0f; }
+	private:
+		void UpdateMatrices(const Vector3 &centre, const float &radius, const Vector3 &lightDirection, const float &casterOffset);
+	};
+}
@@ -1,22 +1,33 @@
 #include "ShadowRender.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include "../Meshes/Mesh.hpp"
 #include "../Worlds/Worlds.hpp"
 #include "UbosShadows.hpp"
 
 namespace Flounder
 {
-	ShadowRender::ShadowRender() :
+	ShadowRender::ShadowRender(const bool &isStatic) :
 		Component(),
 		m_uniformObject(new UniformBuffer(sizeof(UbosShadows::UboObject))),
-		m_descriptorSet(nullptr)
+		m_descriptorSets(std::vector<DescriptorSet *>(MAX_CASCADES)),
+		m_static(isStatic),
+		m_centre(new Vector3()),
+		m_radius(0.0f)
 	{
 	}
 
 	ShadowRender::~ShadowRender()
 	{
 		delete m_uniformObject;
-		delete m_descriptorSet;
+
+		for (auto descriptorSet : m_descriptorSets)
+		{
+			delete descriptorSet;
+		}
+
+		delete m_centre;
 	}
 
 	void ShadowRender::Update()
@@ -25,17 +36,37 @@ namespace Flounder
 		UbosShadows::UboObject uboObject = {};
 		GetGameObject()->GetTransform()->GetWorldMatrix(&uboObject.transform);
 		m_uniformObject->Update(&uboObject);
+
+		// Updates the bounding sphere used for cascade culling.
+		auto mesh = GetGameObject()->GetComponent<Mesh>();
+
+		if (mesh == nullptr || mesh->GetModel() == nullptr)
+		{
+			return;
+		}
+
+		auto aabb = mesh->GetModel()->GetAabb();
+		auto scaling = GetGameObject()->GetTransform()->GetScaling();
+		Vector4 centre = Vector4();
+		Matrix4::Transform(uboObject.transform, Vector4(aabb->GetCentreX(), aabb->GetCentreY(), aabb->GetCentreZ(), 1.0f), &centre);
+		m_centre->Set(centre.m_x, centre.m_y, centre.m_z);
+		m_radius = 0.5f * Vector3(aabb->GetWidth(), aabb->GetHeight(), aabb->GetDepth()).Length() *
+			std::max(std::fabs(scaling->m_x), std::max(std::fabs(scaling->m_y), std::fabs(scaling->m_z)));
 	}
 
 	void ShadowRender::Load(LoadedValue *value)
 	{
+		// Prefabs written before casters could be static have no key, they cast as dynamic casters.
+		auto isStatic = value->GetChild("Static");
+		m_static = isStatic != nullptr && isStatic->Get<bool>();
 	}
 
 	void ShadowRender::Write(LoadedValue *value)
 	{
+		value->GetChild("Static", true)->Set(m_static);
 	}
 
-	void ShadowRender::CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene)
+	void ShadowRender::CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene, const uint32_t &cascade)
 	{
 		// Gets required components.
 		auto mesh = GetGameObject()->GetComponent<Mesh>();
@@ -46,18 +77,18 @@ namespace Flounder
 		}
 
 		// Updates descriptors.
-		if (m_descriptorSet == nullptr)
+		if (m_descriptorSets.at(cascade) == nullptr)
 		{
-			m_descriptorSet = new DescriptorSet(pipeline);
+			m_descriptorSets.at(cascade) = new DescriptorSet(pipeline);
 		}
 
-		m_descriptorSet->Update({
+		m_descriptorSets.at(cascade)->Update({
 			uniformScene,
 			m_uniformObject
 		});
 
 		// Draws the object.
-		m_descriptorSet->BindDescriptor(commandBuffer);
+		m_descriptorSets.at(cascade)->BindDescriptor(commandBuffer);
 		mesh->GetModel()->CmdRender(commandBuffer);
 	}
 }
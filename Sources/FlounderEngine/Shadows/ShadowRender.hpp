@@ -6,6 +6,7 @@
 #include "../Objects/GameObject.hpp"
 #include "../Renderer/Pipelines/Pipeline.hpp"
 #include "../Renderer/Buffers/UniformBuffer.hpp"
+#include "ShadowCascade.hpp"
 
 namespace Flounder
 {
@@ -17,9 +18,17 @@ namespace Flounder
 	{
 	private:
 		UniformBuffer *m_uniformObject;
-		DescriptorSet *m_descriptorSet;
+		std::vector<DescriptorSet *> m_descriptorSets;
+
+		bool m_static;
+		Vector3 *m_centre;
+		float m_radius;
 	public:
-		ShadowRender();
+		/// <summary>
+		/// Creates a new shadow render.
+		/// </summary>
+		/// <param name="isStatic"> If the caster never moves, only static casters are drawn into cached cascades. </param>
+		ShadowRender(const bool &isStatic = false);
 
 		~ShadowRender();
 
@@ -29,10 +38,22 @@ namespace Flounder
 
 		void Write(LoadedValue *value) override;
 
-		void CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene);
+		void CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene, const uint32_t &cascade);
 
 		std::string GetName() const override { return "ShadowRender"; };
 
 		UniformBuffer *GetUniformObject() const { return m_uniformObject; }
+
+		bool IsStatic() const { return m_static; }
+
+		void SetStatic(const bool &isStatic) { m_static = isStatic; }
+
+		/// <summary>
+		/// Gets the world space centre of the casters bounding sphere, updated with the transform.
+		/// </summary>
+		/// <returns> The bounding sphere centre. </returns>
+		Vector3 *GetCentre() const { return m_centre; }
+
+		float GetRadius() const { return m_radius; }
 	};
 }
@@ -1,5 +1,7 @@
 #include "Shadows.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include "../Scenes/Scenes.hpp"
 
 namespace Flounder
@@ -14,22 +16,82 @@ namespace Flounder
 		m_shadowTransition(11.0f),
 		m_shadowBoxOffset(9.0f),
 		m_shadowBoxDistance(70.0f),
-		m_shadowBox(new ShadowBox())
+		m_cascadeCount(3),
+		m_cascadeSplitLambda(0.75f),
+		m_cascadeCacheStart(2),
+		m_cascadeCacheAngle(1.0f),
+		m_cascades(new std::vector<ShadowCascade *>()),
+		m_cascadeSplits()
 	{
+		for (uint32_t i = 0; i < MAX_CASCADES; i++)
+		{
+			m_cascades->push_back(new ShadowCascade());
+			m_cascadeSplits[i] = 0.0f;
+		}
 	}
 
 	Shadows::~Shadows()
 	{
 		delete m_lightDirection;
 
-		delete m_shadowBox;
+		for (auto cascade : *m_cascades)
+		{
+			delete cascade;
+		}
+
+		delete m_cascades;
 	}
 
 	void Shadows::Update()
 	{
-		if (Scenes::Get()->GetCamera() != nullptr)
+		const auto camera = Scenes::Get()->GetCamera();
+
+		if (camera == nullptr)
+		{
+			return;
+		}
+
+		// The atlas is split into a 2x2 grid of cascade cells.
+		const uint32_t resolution = m_shadowSize / 2;
+		const float nearPlane = camera->GetNearPlane();
+		const float farPlane = std::max(m_shadowBoxDistance, nearPlane);
+		float lastSplit = nearPlane;
+
+		for (uint32_t i = 0; i < m_cascadeCount; i++)
+		{
+			// Practical split scheme, blends logarithmic and uniform splits.
+			const float p = static_cast<float>(i + 1) / static_cast<float>(m_cascadeCount);
+			const float logSplit = nearPlane * std::pow(farPlane / nearPlane, p);
+			const float uniformSplit = nearPlane + (farPlane - nearPlane) * p;
+			m_cascadeSplits[i] = m_cascadeSplitLambda * logSplit + (1.0f - m_cascadeSplitLambda) * uniformSplit;
+
+			ShadowCascade *cascade = m_cascades->at(i);
+			cascade->SetAtlasOffset((i % 2) * resolution, (i / 2) * resolution);
+			cascade->Update(*camera, *m_lightDirection, lastSplit, m_cascadeSplits[i], m_shadowBoxOffset, resolution, i >= m_cascadeCacheStart, m_cascadeCacheAngle);
+			lastSplit = m_cascadeSplits[i];
+		}
+	}
+
+	void Shadows::SetShadowSize(const uint32_t &shadowSize)
+	{
+		if (m_shadowSize != shadowSize)
+		{
+			m_shadowSize = shadowSize;
+			InvalidateCache();
+		}
+	}
+
+	void Shadows::SetCascadeCount(const uint32_t &cascadeCount)
+	{
+		m_cascadeCount = std::min(std::max(cascadeCount, 2u), static_cast<uint32_t>(MAX_CASCADES));
+		InvalidateCache();
+	}
+
+	void Shadows::InvalidateCache()
+	{
+		for (auto cascade : *m_cascades)
 		{
-			m_shadowBox->Update(*Scenes::Get()->GetCamera(), *m_lightDirection, m_shadowBoxOffset, m_shadowBoxDistance);
+			cascade->Invalidate();
 		}
 	}
 }
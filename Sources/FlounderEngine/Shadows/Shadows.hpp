@@ -1,8 +1,9 @@
 #pragma once
 
+#include <vector>
 #include "../Engine/Engine.hpp"
 #include "../Maths/Vector3.hpp"
-#include "ShadowBox.hpp"
+#include "ShadowCascade.hpp"
 
 namespace Flounder
 {
@@ -24,7 +25,13 @@ namespace Flounder
 		float m_shadowBoxOffset;
 		float m_shadowBoxDistance;
 
-		ShadowBox *m_shadowBox;
+		uint32_t m_cascadeCount;
+		float m_cascadeSplitLambda;
+		uint32_t m_cascadeCacheStart;
+		float m_cascadeCacheAngle;
+
+		std::vector<ShadowCascade *> *m_cascades;
+		float m_cascadeSplits[MAX_CASCADES];
 	public:
 		/// <summary>
 		/// Gets this engine instance.
@@ -53,7 +60,7 @@ namespace Flounder
 
 		uint32_t GetShadowSize() const { return m_shadowSize; }
 
-		void SetShadowSize(const uint32_t &shadowSize) { m_shadowSize = shadowSize; }
+		void SetShadowSize(const uint32_t &shadowSize);
 
 		int GetShadowPcf() const { return m_shadowPcf; }
 
@@ -79,10 +86,52 @@ namespace Flounder
 
 		void SetShadowBoxDistance(const float &shadowBoxDistance) { m_shadowBoxDistance = shadowBoxDistance; }
 
+		uint32_t GetCascadeCount() const { return m_cascadeCount; }
+
+		/// <summary>
+		/// Sets the number of cascades the shadow distance is split into.
+		/// </summary>
+		/// <param name="cascadeCount"> The cascade count, clamped between 2 and 4. </param>
+		void SetCascadeCount(const uint32_t &cascadeCount);
+
+		float GetCascadeSplitLambda() const { return m_cascadeSplitLambda; }
+
+		/// <summary>
+		/// Sets the blend between uniform (0) and logarithmic (1) cascade splits.
+		/// </summary>
+		/// <param name="cascadeSplitLambda"> The split lambda. </param>
+		void SetCascadeSplitLambda(const float &cascadeSplitLambda) { m_cascadeSplitLambda = cascadeSplitLambda; }
+
+		uint32_t GetCascadeCacheStart() const { return m_cascadeCacheStart; }
+
+		/// <summary>
+		/// Sets the first cascade that is cached, the static casters of a cached cascade are kept and only re-rendered when the light turns or the camera leaves them.
+		/// Dynamic casters are drawn over a copy of the kept static casters every frame.
+		/// </summary>
+		/// <param name="cascadeCacheStart"> The first cached cascade, the cascade count disables caching. </param>
+		void SetCascadeCacheStart(const uint32_t &cascadeCacheStart) { m_cascadeCacheStart = cascadeCacheStart; }
+
+		float GetCascadeCacheAngle() const { return m_cascadeCacheAngle; }
+
+		void SetCascadeCacheAngle(const float &cascadeCacheAngle) { m_cascadeCacheAngle = cascadeCacheAngle; }
+
+		/// <summary>
+		/// Gets a cascade, these can be used to test if casters are inside each cascades box.
+		/// </summary>
+		/// <param name="i"> The cascade index. </param>
+		/// <returns> The shadow cascade. </returns>
+		ShadowCascade *GetCascade(const uint32_t &i) const { return m_cascades->at(i); }
+
+		/// <summary>
+		/// Gets the view distance the cascade ends at.
+		/// </summary>
+		/// <param name="i"> The cascade index. </param>
+		/// <returns> The cascades far split. </returns>
+		float GetCascadeSplit(const uint32_t &i) const { return m_cascadeSplits[i]; }
+
 		/// <summary>
-		/// Get the shadow box, so that it can be used by other class to test if engine.entities are inside the box.
+		/// Forces every cascade to be rendered again, should be called after static casters change.
 		/// </summary>
-		/// <returns> The shadow box. </returns>
-		ShadowBox *GetShadowBox() const { return m_shadowBox; }
+		void InvalidateCache();
 	};
 }
@@ -4,13 +4,15 @@ namespace Flounder
 {
 	Tasks::Tasks() :
 		IModule(),
-		m_tasks(new std::vector<std::function<void()>>())
+		m_tasks(new std::vector<std::function<void()>>()),
+		m_threadPool(new ThreadPool())
 	{
 	}
 
 	Tasks::~Tasks()
 	{
 		delete m_tasks;
+		delete m_threadPool;
 	}
 
 	void Tasks::Update()
@@ -3,6 +3,7 @@
 #include <functional>
 #include <vector>
 #include "../Engine/Engine.hpp"
+#include "ThreadPool.hpp"
 
 namespace Flounder
 {
@@ -14,6 +15,7 @@ namespace Flounder
 	{
 	private:
 		std::vector<std::function<void()>> *m_tasks;
+		ThreadPool *m_threadPool;
 	public:
 		/// <summary>
 		/// Gets this engine instance.
@@ -35,5 +37,11 @@ namespace Flounder
 		/// </summary>
 		/// <param name="task"> The task to add. </param>
 		void AddTask(std::function<void()> task) const;
+
+		/// <summary>
+		/// Gets the worker pool used to run jobs off the main thread.
+		/// </summary>
+		/// <returns> The thread pool. </returns>
+		ThreadPool *GetThreadPool() const { return m_threadPool; }
 	};
 }
@@ -0,0 +1,114 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace Flounder
+{
+	ThreadPool::ThreadPool(const unsigned int &threadCount) :
+		m_workers(std::vector<std::thread>()),
+		m_jobs(std::queue<std::function<void()>>()),
+		m_mutex(),
+		m_condition(),
+		m_stop(false)
+	{
+		unsigned int count = threadCount;
+
+		if (count == 0)
+		{
+			const unsigned int hardware = std::thread::hardware_concurrency();
+			count = hardware > 1 ? hardware - 1 : 1;
+		}
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			m_workers.emplace_back(&ThreadPool::Run, this);
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+
+		m_condition.notify_all();
+
+		for (auto &worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	std::future<void> ThreadPool::Enqueue(const std::function<void()> &job)
+	{
+		auto task = std::make_shared<std::packaged_task<void()>>(job);
+		std::future<void> result = task->get_future();
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobs.emplace([task]()
+			{
+				(*task)();
+			});
+		}
+
+		m_condition.notify_one();
+		return result;
+	}
+
+	void ThreadPool::ParallelFor(const unsigned int &count, const std::function<void(unsigned int, unsigned int)> &job)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		const unsigned int blocks = std::min(count, GetThreadCount() + 1);
+		const unsigned int blockSize = (count + blocks - 1) / blocks;
+		std::vector<std::future<void>> futures = {};
+
+		for (unsigned int start = blockSize; start < count; start += blockSize)
+		{
+			const unsigned int end = std::min(start + blockSize, count);
+			futures.push_back(Enqueue([job, start, end]()
+			{
+				job(start, end);
+			}));
+		}
+
+		job(0, std::min(blockSize, count));
+
+		for (auto &future : futures)
+		{
+			future.get();
+		}
+	}
+
+	void ThreadPool::Run()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this]()
+				{
+					return m_stop || !m_jobs.empty();
+				});
+
+				if (m_stop && m_jobs.empty())
+				{
+					return;
+				}
+
+				job = std::move(m_jobs.front());
+				m_jobs.pop();
+			}
+
+			job();
+		}
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "../Prerequisites.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// A fixed set of worker threads that run queued jobs off the main thread.
+	/// </summary>
+	class F_EXPORT ThreadPool
+	{
+	private:
+		std::vector<std::thread> m_workers;
+		std::queue<std::function<void()>> m_jobs;
+
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		bool m_stop;
+	public:
+		/// <summary>
+		/// Creates a new thread pool.
+		/// </summary>
+		/// <param name="threadCount"> The number of workers, or 0 to use one less than the hardware concurrency. </param>
+		ThreadPool(const unsigned int &threadCount = 0);
+
+		~ThreadPool();
+
+		/// <summary>
+		/// Adds a job to the queue, it will be run by the next free worker.
+		/// </summary>
+		/// <param name="job"> The job to run. </param>
+		/// <returns> A future that becomes ready once the job has finished. </returns>
+		std::future<void> Enqueue(const std::function<void()> &job);
+
+		/// <summary>
+		/// Splits the range [0, count) into one block per worker and waits for every block to finish.
+		/// The calling thread also runs a block, so this is safe to call with an empty pool.
+		/// </summary>
+		/// <param name="count"> The size of the range. </param>
+		/// <param name="job"> The job to run on each block, given the blocks start and end. </param>
+		void ParallelFor(const unsigned int &count, const std::function<void(unsigned int, unsigned int)> &job);
+
+		unsigned int GetThreadCount() const { return static_cast<unsigned int>(m_workers.size()); }
+	private:
+		void Run();
+	};
+}
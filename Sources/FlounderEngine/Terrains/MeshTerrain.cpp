@@ -1,46 +1,11 @@
 #include "MeshTerrain.hpp"
 
-#include "../Maths/Maths.hpp"
-#include "../Maths/Colour.hpp"
-#include "Terrains.hpp"
-
 namespace Flounder
 {
-	const std::array<Colour, 4> BIOME_COLOURS = {
-		Colour("#ffcc00"), Colour("#E17B35"), Colour("#C35D35"), Colour("#683130")
-	};
-	const float SPREAD = 0.76f;
-	const float HALF_SPREAD = SPREAD / 2.0f;
-	const float AMPLITUDE = 20.0f;
-	const float PART = 1.0f / (BIOME_COLOURS.size() - 1);
-
-	MeshTerrain::MeshTerrain(const float &sideLength, const float &squareSize, const int &vertexCount, const float &textureScale, Vector3 *position) :
-		MeshSimple(sideLength, squareSize, vertexCount, textureScale),
-		m_position(position)
-	{
-		MeshSimple::GenerateMesh();
-	}
-
-	Vector3 MeshTerrain::GetPosition(const float &x, const float &z)
-	{
-		Vector3 position = Vector3(x, 0.0f, z);
-		position.m_y = Terrains::Get()->GetHeight(position.m_x + m_position->m_x, position.m_z + m_position->m_z);
-		return position;
-	}
-
-	Vector3 MeshTerrain::GetNormal(const Vector3 &position)
-	{
-		return Terrains::Get()->GetNormal(position.m_x + m_position->m_x, position.m_z + m_position->m_z);
-	}
-
-	Vector3 MeshTerrain::GetColour(const Vector3 &position, const Vector3 &normal)
+	MeshTerrain::MeshTerrain(const uint32_t &gridSize) :
+		Model(TerrainVertex::GetGridVertices(gridSize).data(), sizeof(TerrainVertex), (gridSize + 1) * (gridSize + 1),
+			ColliderAabb(Vector3(0.0f, 0.0f, 0.0f), Vector3(static_cast<float>(gridSize), 0.0f, static_cast<float>(gridSize))), "TerrainGrid"),
+		m_gridSize(gridSize)
 	{
-		float value = (position.m_y + AMPLITUDE) / (AMPLITUDE * 2.0f);
-		value = Maths::Clamp((value - HALF_SPREAD) * (1.0f / SPREAD), 0.0f, 0.9999f);
-		int firstBiome = static_cast<int>(std::floor(value / PART));
-		float blend = (value - (firstBiome * PART)) / PART;
-		Colour colour = Colour();
-		Colour::Interpolate(BIOME_COLOURS.at(firstBiome), BIOME_COLOURS.at(firstBiome + 1), blend, &colour);
-		return colour;
 	}
 }
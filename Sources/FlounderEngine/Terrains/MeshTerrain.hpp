@@ -1,21 +1,32 @@
 #pragma once
 
-#include "Models/Shapes/MeshSimple.hpp"
+#include "../Models/Model.hpp"
+#include "TerrainVertex.hpp"
 
 namespace Flounder
 {
+	/// <summary>
+	/// The grid every terrain node is drawn with, the vertices are grid points from the nodes corner and are placed by the terrain shader.
+	/// The grid has no index buffer of its own, it is drawn with the index buffer shared by the terrain renderer.
+	/// </summary>
 	class F_EXPORT MeshTerrain :
-		public MeshSimple
+		public Model
 	{
 	private:
-		Vector3 *m_position;
+		uint32_t m_gridSize;
 	public:
-		MeshTerrain(const float &sideLength, const float &squareSize, const int &vertexCount, const float &textureScale, Vector3 *position);
+		/// <summary>
+		/// Creates a new terrain grid.
+		/// </summary>
+		/// <param name="gridSize"> The number of cells along each side. </param>
+		MeshTerrain(const uint32_t &gridSize);
 
-		Vector3 GetPosition(const float &x, const float &z) override;
+		uint32_t GetGridSize() const { return m_gridSize; }
 
-		Vector3 GetNormal(const Vector3 &position) override;
-
-		Vector3 GetColour(const Vector3 &position, const Vector3 &normal) override;
+		/// <summary>
+		/// Gets the number of shared grid indices one draw of the grid uses.
+		/// </summary>
+		/// <returns> The index count. </returns>
+		uint32_t GetIndexCount() const { return 6 * m_gridSize * m_gridSize; }
 	};
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 
 #include "../Scenes/Scenes.hpp"
 #include "../Models/Model.hpp"
+#include "TerrainVertex.hpp"
 #include "Terrains.hpp"
 #include "UbosTerrains.hpp"
 
@@ -10,14 +11,19 @@ namespace Flounder
 	RendererTerrains::RendererTerrains(const GraphicsStage &graphicsStage) :
 		IRenderer(),
 		m_uniformScene(new UniformBuffer(sizeof(UbosTerrains::UboScene))),
+		m_gridIndices(nullptr),
 		m_pipeline(new Pipeline(graphicsStage, PipelineCreate({ "Resources/Shaders/Terrains/Terrain.vert", "Resources/Shaders/Terrains/Terrain.frag" },
-			VertexModel::GetBindingDescriptions(), PIPELINE_MRT, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT), { }))
+			TerrainVertex::GetBindingDescriptions(), PIPELINE_MRT, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT, TerrainVertex::GetAttributeDescriptions()), { }))
 	{
+		// Every terrain node is drawn with a grid of the same size, so they all share one index buffer.
+		std::vector<uint16_t> indices = TerrainVertex::GetGridIndices(Terrains::TILE_SIZE);
+		m_gridIndices = new IndexBuffer(VK_INDEX_TYPE_UINT16, sizeof(uint16_t), indices.size(), indices.data());
 	}
 
 	RendererTerrains::~RendererTerrains()
 	{
 		delete m_uniformScene;
+		delete m_gridIndices;
 		delete m_pipeline;
 	}
 
@@ -26,9 +32,11 @@ namespace Flounder
 		UbosTerrains::UboScene uboScene = {};
 		uboScene.projection = *camera.GetProjectionMatrix();
 		uboScene.view = *camera.GetViewMatrix();
+		uboScene.cameraPosition = Vector4(*camera.GetPosition());
 		m_uniformScene->Update(&uboScene);
 
 		m_pipeline->BindPipeline(commandBuffer);
+		vkCmdBindIndexBuffer(commandBuffer, m_gridIndices->GetBuffer(), 0, m_gridIndices->GetIndexType());
 
 		std::vector<TerrainRender *> renderList = std::vector<TerrainRender *>();
 		Scenes::Get()->GetStructure()->QueryComponents<TerrainRender>(&renderList);
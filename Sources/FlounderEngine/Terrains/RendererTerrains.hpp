@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Renderer/IRenderer.hpp"
+#include "../Renderer/Buffers/IndexBuffer.hpp"
 #include "../Renderer/Buffers/UniformBuffer.hpp"
 #include "../Renderer/Pipelines/Pipeline.hpp"
 
@@ -11,6 +12,7 @@ namespace Flounder
 	{
 	private:
 		UniformBuffer *m_uniformScene;
+		IndexBuffer *m_gridIndices;
 		Pipeline *m_pipeline;
 	public:
 		RendererTerrains(const GraphicsStage &graphicsStage);
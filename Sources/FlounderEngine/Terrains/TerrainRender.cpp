@@ -1,41 +1,97 @@
 ﻿#include "TerrainRender.hpp"
 
-#include "../Devices/Display.hpp"
-#include "../Meshes/Mesh.hpp"
-#include "../Worlds/Worlds.hpp"
-#include "../Physics/Rigidbody.hpp"
+#include <algorithm>
+#include <cmath>
 #include "../Scenes/Scenes.hpp"
-#include "UbosTerrains.hpp"
+#include "Terrains.hpp"
 
 namespace Flounder
 {
-	const int TerrainRender::SIDE_LENGTH = 200;
-	const std::vector<float> TerrainRender::SQUARE_SIZES = {
-		2.0f, 8.0f, 25.0f, 50.0f
-	};
-	const std::vector<float> TerrainRender::TEXTURE_SCALES = {
-		10.0f, 5.0f, 2.0f, 1.0f
-	};
+	const int TerrainRender::LOD_LEVELS = 8;
+	const float TerrainRender::LOD_RANGE = 4.0f;
+	const float TerrainRender::MORPH_START = 0.85f;
+	const uint32_t TerrainRender::MAX_NODES = 1024;
+	const uint32_t TerrainRender::MAX_SLOTS = 1024;
+	const uint32_t TerrainRender::SLOT_SIZE = ((Terrains::TILE_ROW * Terrains::TILE_ROW) + 1) & ~1;
 
 	TerrainRender::TerrainRender() :
 		Component(),
-		m_uniformObject(new UniformBuffer(sizeof(UbosTerrains::UboObject))),
-		m_descriptorSet(nullptr)
+		m_descriptorSet(nullptr),
+		m_grid(new MeshTerrain(Terrains::TILE_SIZE)),
+		m_storageNodes(new StorageBuffer(sizeof(UbosTerrains::Node) * MAX_NODES)),
+		m_storageHeights(new StorageBuffer(sizeof(uint16_t) * SLOT_SIZE * MAX_SLOTS)),
+		m_nodes(std::vector<UbosTerrains::Node>()),
+		m_ranges(std::vector<float>()),
+		m_slots(std::unordered_map<uint64_t, uint32_t>()),
+		m_slotKeys(std::vector<uint64_t>()),
+		m_slotFrames(std::vector<uint32_t>()),
+		m_slotHeights(std::vector<uint16_t>(SLOT_SIZE)),
+		m_frame(0)
 	{
+		// Each level reaches twice as far as the one below it, a node is drawn at a level once it is out of range of the level below.
+		for (int level = 0; level < LOD_LEVELS; level++)
+		{
+			m_ranges.push_back(LOD_RANGE * Terrains::TILE_SIZE * Terrains::GetTileSpacing(level));
+		}
 	}
 
 	TerrainRender::~TerrainRender()
 	{
-		delete m_uniformObject;
 		delete m_descriptorSet;
+		delete m_grid;
+		delete m_storageNodes;
+		delete m_storageHeights;
 	}
 
 	void TerrainRender::Update()
 	{
-		// Updates uniforms.
-		UbosTerrains::UboObject uboObject = {};
-		GetGameObject()->GetTransform()->GetWorldMatrix(&uboObject.transform);
-		m_uniformObject->Update(&uboObject);
+		m_nodes.clear();
+		m_frame++;
+
+		auto camera = Scenes::Get()->GetCamera();
+
+		if (camera == nullptr)
+		{
+			return;
+		}
+
+		const Vector3 cameraPosition = *camera->GetPosition();
+		const Frustum &frustum = *camera->GetViewFrustum();
+
+		// Roots are the tiles of the top level that the horizon reaches.
+		const int root = LOD_LEVELS - 1;
+		const float rootSize = Terrains::TILE_SIZE * Terrains::GetTileSpacing(root);
+		const int minX = static_cast<int>(std::floor((cameraPosition.m_x - m_ranges[root]) / rootSize));
+		const int minZ = static_cast<int>(std::floor((cameraPosition.m_z - m_ranges[root]) / rootSize));
+		const int maxX = static_cast<int>(std::floor((cameraPosition.m_x + m_ranges[root]) / rootSize));
+		const int maxZ = static_cast<int>(std::floor((cameraPosition.m_z + m_ranges[root]) / rootSize));
+
+		for (int z = minZ; z <= maxZ; z++)
+		{
+			for (int x = minX; x <= maxX; x++)
+			{
+				// Heights are not known until a tile is streamed in, so roots are kept by their distance across the ground.
+				const Vector3 min = Vector3(x * rootSize, cameraPosition.m_y, z * rootSize);
+				const Vector3 max = Vector3((x + 1) * rootSize, cameraPosition.m_y, (z + 1) * rootSize);
+
+				if (!InRange(min, max, cameraPosition, m_ranges[root]))
+				{
+					continue;
+				}
+
+				const TerrainTile *tile = Terrains::Get()->GetTile(root, x, z, false);
+
+				if (tile != nullptr)
+				{
+					SelectNode(root, x, z, *tile, cameraPosition, frustum);
+				}
+			}
+		}
+
+		if (!m_nodes.empty())
+		{
+			m_storageNodes->Update(m_nodes.data(), 0, sizeof(UbosTerrains::Node) * m_nodes.size());
+		}
 	}
 
 	void TerrainRender::Load(LoadedValue *value)
@@ -48,24 +104,11 @@ namespace Flounder
 
 	void TerrainRender::CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene)
 	{
-		// Gets required components.
-		auto mesh = GetGameObject()->GetComponent<Mesh>();
-
-		if (mesh == nullptr || mesh->GetModel() == nullptr)
+		if (m_nodes.empty())
 		{
 			return;
 		}
 
-		/*auto rigidbody = GetGameObject()->GetComponent<Rigidbody>();
-
-		if (rigidbody != nullptr && rigidbody->GetCollider() != nullptr)
-		{
-			if (!rigidbody->GetCollider()->InFrustum(*Scenes::Get()->GetCamera()->GetViewFrustum()))
-			{
-				return;
-			}
-		}*/
-
 		// Updates descriptors.
 		if (m_descriptorSet == nullptr)
 		{
@@ -74,11 +117,133 @@ namespace Flounder
 
 		m_descriptorSet->Update({
 			uniformScene,
-			m_uniformObject
+			m_storageNodes,
+			m_storageHeights
 		});
 
-		// Draws the object.
+		// Draws every node with one instanced draw of the grid, using the shared grid indices.
 		m_descriptorSet->BindDescriptor(commandBuffer);
-		mesh->GetModel()->CmdRender(commandBuffer);
+		m_grid->CmdBind(commandBuffer);
+		vkCmdDrawIndexed(commandBuffer, m_grid->GetIndexCount(), static_cast<uint32_t>(m_nodes.size()), 0, 0, 0);
+	}
+
+	void TerrainRender::SelectNode(const int &level, const int &x, const int &z, const TerrainTile &tile, const Vector3 &cameraPosition, const Frustum &frustum)
+	{
+		const float size = Terrains::TILE_SIZE * Terrains::GetTileSpacing(level);
+		const Vector3 min = Vector3(x * size, tile.minHeight, z * size);
+		const Vector3 max = Vector3((x + 1) * size, tile.maxHeight, (z + 1) * size);
+
+		if (!frustum.CubeInFrustum(min, max))
+		{
+			return;
+		}
+
+		// Nodes only split once all four children are streamed in, until then the node is drawn whole.
+		if (level > 0 && InRange(min, max, cameraPosition, m_ranges[level - 1]))
+		{
+			const TerrainTile *children[4];
+			bool ready = true;
+
+			for (int i = 0; i < 4; i++)
+			{
+				children[i] = Terrains::Get()->GetTile(level - 1, 2 * x + (i & 1), 2 * z + (i >> 1), false);
+				ready = ready && children[i] != nullptr;
+			}
+
+			if (ready)
+			{
+				for (int i = 0; i < 4; i++)
+				{
+					SelectNode(level - 1, 2 * x + (i & 1), 2 * z + (i >> 1), *children[i], cameraPosition, frustum);
+				}
+
+				return;
+			}
+		}
+
+		AddNode(level, x, z, tile);
+	}
+
+	void TerrainRender::AddNode(const int &level, const int &x, const int &z, const TerrainTile &tile)
+	{
+		if (m_nodes.size() >= MAX_NODES)
+		{
+			return;
+		}
+
+		// Vertices morph over the last part of the range between this level and the one below.
+		const float spacing = Terrains::GetTileSpacing(level);
+		const float size = Terrains::TILE_SIZE * spacing;
+		const float rangeBelow = level > 0 ? m_ranges[level - 1] : 0.0f;
+		const float morphStart = rangeBelow + MORPH_START * (m_ranges[level] - rangeBelow);
+
+		UbosTerrains::Node node = {};
+		node.origin = Vector4(x * size, z * size, spacing, static_cast<float>(GetSlot(level, x, z, tile)));
+		node.morph = Vector4(morphStart, m_ranges[level], 0.0f, 0.0f);
+		m_nodes.push_back(node);
+	}
+
+	uint32_t TerrainRender::GetSlot(const int &level, const int &x, const int &z, const TerrainTile &tile)
+	{
+		const uint64_t key = Terrains::GetKey(level, x, z);
+		auto it = m_slots.find(key);
+
+		if (it != m_slots.end())
+		{
+			m_slotFrames[it->second] = m_frame;
+			return it->second;
+		}
+
+		// Tiles are uploaded to a free slot, or the slot that has gone unused the longest once the pool is full.
+		uint32_t slot = static_cast<uint32_t>(m_slotKeys.size());
+
+		if (slot < MAX_SLOTS)
+		{
+			m_slotKeys.push_back(key);
+			m_slotFrames.push_back(m_frame);
+		}
+		else
+		{
+			slot = 0;
+
+			for (uint32_t i = 1; i < MAX_SLOTS; i++)
+			{
+				if (m_slotFrames[i] < m_slotFrames[slot])
+				{
+					slot = i;
+				}
+			}
+
+			m_slots.erase(m_slotKeys[slot]);
+			m_slotKeys[slot] = key;
+			m_slotFrames[slot] = m_frame;
+		}
+
+		// Slots are padded to an even number of heights so every upload starts on a 32 bit boundary.
+		for (size_t i = 0; i < tile.heights.size(); i++)
+		{
+			m_slotHeights[i] = QuantizeHeight(tile.heights[i]);
+		}
+
+		const VkDeviceSize slotSize = sizeof(uint16_t) * SLOT_SIZE;
+		m_storageHeights->Update(m_slotHeights.data(), slotSize * slot, slotSize);
+		m_slots.emplace(key, slot);
+		return slot;
+	}
+
+	uint16_t TerrainRender::QuantizeHeight(const float &height)
+	{
+		// Maps the terrains height range onto the full 16 bits, Terrain.vert decodes it with the same range.
+		const float value = (height - Terrains::HEIGHT_OFFSET + Terrains::HEIGHT_AMPLITUDE) / (2.0f * Terrains::HEIGHT_AMPLITUDE);
+		return static_cast<uint16_t>(std::lround(65535.0f * std::min(std::max(value, 0.0f), 1.0f)));
+	}
+
+	bool TerrainRender::InRange(const Vector3 &min, const Vector3 &max, const Vector3 &position, const float &range)
+	{
+		// The distance from the position to the closest point in the box.
+		const float dx = std::max(std::max(min.m_x - position.m_x, 0.0f), position.m_x - max.m_x);
+		const float dy = std::max(std::max(min.m_y - position.m_y, 0.0f), position.m_y - max.m_y);
+		const float dz = std::max(std::max(min.m_z - position.m_z, 0.0f), position.m_z - max.m_z);
+		return dx * dx + dy * dy + dz * dz <= range * range;
 	}
 }
@@ -1,23 +1,53 @@
 ﻿#pragma once
 
+#include <unordered_map>
 #include <vector>
 #include "../Objects/Component.hpp"
 #include "../Objects/GameObject.hpp"
+#include "../Physics/Frustum.hpp"
+#include "../Renderer/Buffers/StorageBuffer.hpp"
 #include "../Renderer/Buffers/UniformBuffer.hpp"
 #include "../Renderer/Pipelines/Pipeline.hpp"
+#include "MeshTerrain.hpp"
+#include "UbosTerrains.hpp"
 
 namespace Flounder
 {
+	struct TerrainTile;
+
+	/// <summary>
+	/// A component that draws the terrain out to the horizon with a continuous distance dependent level of detail.
+	/// The terrain is a quadtree of nodes, a node at level n covers a terrain tile of that level and every node is drawn
+	/// with the same grid mesh, instanced once per selected node. Nodes are selected each update from the roots down,
+	/// splitting while they are inside the range of the level below and skipping nodes outside the view frustum.
+	/// Heights are read in the vertex shader from a pool of tiles on the GPU, vertices morph onto the grid of the level
+	/// above as they near the end of their levels range so there are no pops or cracks between levels.
+	/// Pool heights are quantized to 16 bits over the terrains height range, the same for every tile so shared edges match.
+	/// </summary>
 	class F_EXPORT TerrainRender :
 		public Component
 	{
 	private:
-		UniformBuffer *m_uniformObject;
 		DescriptorSet *m_descriptorSet;
+
+		MeshTerrain *m_grid;
+		StorageBuffer *m_storageNodes;
+		StorageBuffer *m_storageHeights;
+		std::vector<UbosTerrains::Node> m_nodes;
+		std::vector<float> m_ranges;
+
+		std::unordered_map<uint64_t, uint32_t> m_slots;
+		std::vector<uint64_t> m_slotKeys;
+		std::vector<uint32_t> m_slotFrames;
+		std::vector<uint16_t> m_slotHeights;
+		uint32_t m_frame;
 	public:
-		static const int SIDE_LENGTH;
-		static const std::vector<float> SQUARE_SIZES;
-		static const std::vector<float> TEXTURE_SCALES;
+		static const int LOD_LEVELS;
+		static const float LOD_RANGE;
+		static const float MORPH_START;
+		static const uint32_t MAX_NODES;
+		static const uint32_t MAX_SLOTS;
+		static const uint32_t SLOT_SIZE;
 
 		TerrainRender();
 
@@ -29,10 +59,30 @@ namespace Flounder
 
 		void Write(LoadedValue *value) override;
 
+		/// <summary>
+		/// Draws the selected nodes, the renderers shared grid index buffer has to be bound first.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record to. </param>
+		/// <param name="pipeline"> The terrain pipeline. </param>
+		/// <param name="uniformScene"> The scene uniform. </param>
 		void CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene);
 
 		std::string GetName() const override { return "TerrainRender"; };
 
-		UniformBuffer *GetUniformObject() const { return m_uniformObject; }
+		/// <summary>
+		/// Gets the number of nodes selected to be drawn in the last update.
+		/// </summary>
+		/// <returns> The selected node count. </returns>
+		uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_nodes.size()); }
+	private:
+		void SelectNode(const int &level, const int &x, const int &z, const TerrainTile &tile, const Vector3 &cameraPosition, const Frustum &frustum);
+
+		void AddNode(const int &level, const int &x, const int &z, const TerrainTile &tile);
+
+		uint32_t GetSlot(const int &level, const int &x, const int &z, const TerrainTile &tile);
+
+		static uint16_t QuantizeHeight(const float &height);
+
+		static bool InRange(const Vector3 &min, const Vector3 &max, const Vector3 &position, const float &range);
 	};
 }
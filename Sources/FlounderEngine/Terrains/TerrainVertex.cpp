@@ -0,0 +1,77 @@
+#include "TerrainVertex.hpp"
+
+namespace Flounder
+{
+	TerrainVertex::TerrainVertex(const uint32_t &x, const uint32_t &z) :
+		m_x(static_cast<uint16_t>(x)),
+		m_z(static_cast<uint16_t>(z))
+	{
+	}
+
+	std::vector<TerrainVertex> TerrainVertex::GetGridVertices(const uint32_t &gridSize)
+	{
+		std::vector<TerrainVertex> vertices = std::vector<TerrainVertex>();
+		vertices.reserve((gridSize + 1) * (gridSize + 1));
+
+		for (uint32_t z = 0; z <= gridSize; z++)
+		{
+			for (uint32_t x = 0; x <= gridSize; x++)
+			{
+				vertices.emplace_back(x, z);
+			}
+		}
+
+		return vertices;
+	}
+
+	std::vector<uint16_t> TerrainVertex::GetGridIndices(const uint32_t &gridSize)
+	{
+		const uint32_t rowSize = gridSize + 1;
+		std::vector<uint16_t> indices = std::vector<uint16_t>();
+		indices.reserve(6 * gridSize * gridSize);
+
+		for (uint32_t z = 0; z < gridSize; z++)
+		{
+			for (uint32_t x = 0; x < gridSize; x++)
+			{
+				const uint16_t topLeft = static_cast<uint16_t>(x + rowSize * z);
+				const uint16_t topRight = static_cast<uint16_t>(topLeft + 1);
+				const uint16_t bottomLeft = static_cast<uint16_t>(topLeft + rowSize);
+				const uint16_t bottomRight = static_cast<uint16_t>(bottomLeft + 1);
+				indices.push_back(topLeft);
+				indices.push_back(bottomLeft);
+				indices.push_back(topRight);
+				indices.push_back(topRight);
+				indices.push_back(bottomLeft);
+				indices.push_back(bottomRight);
+			}
+		}
+
+		return indices;
+	}
+
+	std::vector<VkVertexInputBindingDescription> TerrainVertex::GetBindingDescriptions()
+	{
+		std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
+
+		// The vertex input description.
+		bindingDescriptions[0].binding = 0;
+		bindingDescriptions[0].stride = sizeof(TerrainVertex);
+		bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+		return bindingDescriptions;
+	}
+
+	std::vector<VkVertexInputAttributeDescription> TerrainVertex::GetAttributeDescriptions()
+	{
+		std::vector<VkVertexInputAttributeDescription> attributeDescriptions(1);
+
+		// Grid point attribute.
+		attributeDescriptions[0].binding = 0;
+		attributeDescriptions[0].location = 0;
+		attributeDescriptions[0].format = VK_FORMAT_R16G16_UINT;
+		attributeDescriptions[0].offset = offsetof(TerrainVertex, m_x);
+
+		return attributeDescriptions;
+	}
+}
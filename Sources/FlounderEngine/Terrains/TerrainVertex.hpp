@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include "../Engine/Platform.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// A terrain grid vertex packed into 32 bits, decoded by Terrain.vert.
+	/// The vertex only holds its grid point, 16 bits per axis. Its height, normal and colour are all taken from the nodes
+	/// heights in the shader, so the same vertices are shared by every node. Grids are drawn with the shared grid index
+	/// buffer, which has 16 bit indices so a grid can have at most 255 cells along each side.
+	/// </summary>
+	class F_EXPORT TerrainVertex
+	{
+	public:
+		uint16_t m_x;
+		uint16_t m_z;
+
+		/// <summary>
+		/// Creates a new packed terrain vertex.
+		/// </summary>
+		/// <param name="x"> The x grid point. </param>
+		/// <param name="z"> The z grid point. </param>
+		TerrainVertex(const uint32_t &x, const uint32_t &z);
+
+		/// <summary>
+		/// Creates the vertices for a grid, in rows along x.
+		/// </summary>
+		/// <param name="gridSize"> The number of cells along each side. </param>
+		/// <returns> The grid vertices. </returns>
+		static std::vector<TerrainVertex> GetGridVertices(const uint32_t &gridSize);
+
+		/// <summary>
+		/// Fills an index buffer with the indices for a grid, every grid of the same size is drawn with the same indices.
+		/// Cells are split along the diagonal from (x + 1, z) to (x, z + 1), the shader morphs vertices along it.
+		/// </summary>
+		/// <param name="gridSize"> The number of cells along each side. </param>
+		/// <returns> The grid indices. </returns>
+		static std::vector<uint16_t> GetGridIndices(const uint32_t &gridSize);
+
+		static std::vector<VkVertexInputBindingDescription> GetBindingDescriptions();
+
+		static std::vector<VkVertexInputAttributeDescription> GetAttributeDescriptions();
+	};
+}
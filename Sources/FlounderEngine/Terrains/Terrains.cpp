@@ -1,12 +1,31 @@
 #include "Terrains.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "../Scenes/Scenes.hpp"
+#include "../Tasks/Tasks.hpp"
 #include "../Worlds/Worlds.hpp"
 
 namespace Flounder
 {
+	const int Terrains::TILE_SIZE = 64;
+	const int Terrains::TILE_BORDER = 1;
+	const int Terrains::TILE_ROW = TILE_SIZE + 1 + 2 * TILE_BORDER;
+	const float Terrains::TILE_SPACING = 1.0f;
+	const float Terrains::HEIGHT_OFFSET = 15.0f;
+	const float Terrains::HEIGHT_AMPLITUDE = 60.0f;
+	const int Terrains::PREFETCH_RADIUS = 4;
+
 	Terrains::Terrains() :
 		IModule(),
-		m_noise1(NoiseFast(8420152))
+		m_noise1(NoiseFast(8420152)),
+		m_maxTiles(1024),
+		m_tiles(std::unordered_map<uint64_t, std::shared_ptr<TileEntry>>()),
+		m_tileOrder(std::list<uint64_t>()),
+		m_lastTile(nullptr),
+		m_lastKey(0),
+		m_prefetch(false)
 	{
 		m_noise1.SetNoiseType(NoiseFast::PerlinFractal);
 		m_noise1.SetFrequency(0.003f);
@@ -19,29 +38,53 @@ namespace Flounder
 
 	Terrains::~Terrains()
 	{
+		// Jobs read the noise, so they have to finish before it is destroyed.
+		for (auto &tile : m_tiles)
+		{
+			if (!tile.second->ready)
+			{
+				tile.second->job.wait();
+			}
+		}
 	}
 
 	void Terrains::Update()
 	{
+		// Nothing is generated ahead of time until something has asked for terrain heights.
+		if (!m_prefetch || Scenes::Get()->GetScene() == nullptr || Scenes::Get()->GetCamera() == nullptr)
+		{
+			return;
+		}
+
+		const Vector3 cameraPosition = *Scenes::Get()->GetCamera()->GetPosition();
+		const float radius = PREFETCH_RADIUS * TILE_SIZE * TILE_SPACING;
+		RequestTiles(cameraPosition.m_x - radius, cameraPosition.m_z - radius, cameraPosition.m_x + radius, cameraPosition.m_z + radius);
 	}
 
 	float Terrains::GetHeight(const float &x, const float &z)
 	{
-		float height1 = m_noise1.GetNoise(x, z);
-		height1 = (height1 * 60.0f) + 15.0f;
-	//	float length = std::sqrt((x * x) + (z * z));
-
-	//	if (length >= 700.0f)
-	//	{
-	//		height1 = height1 - (0.2f * (length - 700.0f));
-	//	}
+		const float gridX = x / TILE_SPACING;
+		const float gridZ = z / TILE_SPACING;
+		const int cellX = static_cast<int>(std::floor(gridX));
+		const int cellZ = static_cast<int>(std::floor(gridZ));
+		const int tileX = GetTileIndex(cellX);
+		const int tileZ = GetTileIndex(cellZ);
+		const int localX = cellX - tileX * TILE_SIZE;
+		const int localZ = cellZ - tileZ * TILE_SIZE;
+		const float blendX = gridX - static_cast<float>(cellX);
+		const float blendZ = gridZ - static_cast<float>(cellZ);
 
-		return height1;
+		// Tiles hold one more row and column than they cover, so every cell can be interpolated without a neighbour.
+		const TerrainTile *tile = GetTile(0, tileX, tileZ, true);
+		const float *heights = &tile->heights[(localX + TILE_BORDER) + TILE_ROW * (localZ + TILE_BORDER)];
+		const float height0 = heights[0] + blendX * (heights[1] - heights[0]);
+		const float height1 = heights[TILE_ROW] + blendX * (heights[TILE_ROW + 1] - heights[TILE_ROW]);
+		return height0 + blendZ * (height1 - height0);
 	}
 
 	Vector3 Terrains::GetNormal(const float &x, const float &z)
 	{
-		const float squareSize = 0.1f;
+		const float squareSize = TILE_SPACING;
 		const float heightL = GetHeight(x - squareSize, z);
 		const float heightR = GetHeight(x + squareSize, z);
 		const float heightD = GetHeight(x, z - squareSize);
@@ -57,4 +100,121 @@ namespace Flounder
 	{
 		return Vector3(x, GetHeight(x, z), z);
 	}
+
+	void Terrains::RequestTiles(const float &minX, const float &minZ, const float &maxX, const float &maxZ)
+	{
+		const int minTileX = GetTileIndex(static_cast<int>(std::floor(minX / TILE_SPACING)));
+		const int minTileZ = GetTileIndex(static_cast<int>(std::floor(minZ / TILE_SPACING)));
+		const int maxTileX = GetTileIndex(static_cast<int>(std::floor(maxX / TILE_SPACING)));
+		const int maxTileZ = GetTileIndex(static_cast<int>(std::floor(maxZ / TILE_SPACING)));
+
+		for (int tileZ = minTileZ; tileZ <= maxTileZ; tileZ++)
+		{
+			for (int tileX = minTileX; tileX <= maxTileX; tileX++)
+			{
+				if (m_tiles.find(GetKey(0, tileX, tileZ)) == m_tiles.end())
+				{
+					CreateTile(0, tileX, tileZ);
+				}
+			}
+		}
+	}
+
+	const TerrainTile *Terrains::GetTile(const int &level, const int &tileX, const int &tileZ, const bool &wait)
+	{
+		const uint64_t key = GetKey(level, tileX, tileZ);
+
+		// Neighbouring reads almost always land in the same tile, so it skips the lookup.
+		if (m_lastTile != nullptr && m_lastKey == key)
+		{
+			return &m_lastTile->tile;
+		}
+
+		if (level == 0)
+		{
+			m_prefetch = true;
+		}
+
+		auto it = m_tiles.find(key);
+		std::shared_ptr<TileEntry> entry = it != m_tiles.end() ? it->second : CreateTile(level, tileX, tileZ);
+		m_tileOrder.splice(m_tileOrder.end(), m_tileOrder, entry->order);
+
+		if (!entry->ready)
+		{
+			if (!wait && entry->job.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				return nullptr;
+			}
+
+			entry->job.wait();
+			entry->ready = true;
+		}
+
+		m_lastTile = entry;
+		m_lastKey = key;
+		return &entry->tile;
+	}
+
+	std::shared_ptr<Terrains::TileEntry> Terrains::CreateTile(const int &level, const int &tileX, const int &tileZ)
+	{
+		while (!m_tiles.empty() && m_tiles.size() >= m_maxTiles)
+		{
+			auto evicted = m_tiles.find(m_tileOrder.front());
+
+			if (!evicted->second->ready)
+			{
+				evicted->second->job.wait();
+			}
+
+			if (evicted->second == m_lastTile)
+			{
+				m_lastTile = nullptr;
+			}
+
+			m_tiles.erase(evicted);
+			m_tileOrder.pop_front();
+		}
+
+		const uint64_t key = GetKey(level, tileX, tileZ);
+		std::shared_ptr<TileEntry> entry = std::make_shared<TileEntry>();
+		entry->ready = false;
+		entry->order = m_tileOrder.insert(m_tileOrder.end(), key);
+		entry->job = Tasks::Get()->GetThreadPool()->Enqueue([this, entry, level, tileX, tileZ]()
+		{
+			GenerateTile(&entry->tile, level, tileX, tileZ);
+		});
+		m_tiles.emplace(key, entry);
+		return entry;
+	}
+
+	void Terrains::GenerateTile(TerrainTile *tile, const int &level, const int &tileX, const int &tileZ) const
+	{
+		const float spacing = GetTileSpacing(level);
+		const float startX = (tileX * TILE_SIZE - TILE_BORDER) * spacing;
+		const float startZ = (tileZ * TILE_SIZE - TILE_BORDER) * spacing;
+		tile->heights.resize(TILE_ROW * TILE_ROW);
+		m_noise1.FillNoiseSet(tile->heights.data(), startX, startZ, TILE_ROW, TILE_ROW, spacing);
+		tile->minHeight = std::numeric_limits<float>::max();
+		tile->maxHeight = std::numeric_limits<float>::lowest();
+
+		for (auto &height : tile->heights)
+		{
+			height = (height * HEIGHT_AMPLITUDE) + HEIGHT_OFFSET;
+			tile->minHeight = std::min(tile->minHeight, height);
+			tile->maxHeight = std::max(tile->maxHeight, height);
+		}
+	}
+
+	int Terrains::GetTileIndex(const int &cell)
+	{
+		// Floors towards negative infinity, so cell -1 is in tile -1.
+		return (cell >= 0 ? cell : cell - TILE_SIZE + 1) / TILE_SIZE;
+	}
+
+	uint64_t Terrains::GetKey(const int &level, const int &tileX, const int &tileZ)
+	{
+		// 30 bits per axis and 4 for the level.
+		const uint64_t mask = (static_cast<uint64_t>(1) << 30) - 1;
+		return (static_cast<uint64_t>(tileX) & mask) | ((static_cast<uint64_t>(tileZ) & mask) << 30) | (static_cast<uint64_t>(level) << 60);
+	}
 }
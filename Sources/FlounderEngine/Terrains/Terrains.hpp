@@ -1,5 +1,9 @@
 #pragma once
 
+#include <future>
+#include <list>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include "../Engine/Engine.hpp"
 #include "../Maths/Noise/NoiseFast.hpp"
@@ -7,15 +11,53 @@
 
 namespace Flounder
 {
+	/// <summary>
+	/// A square grid of terrain heights, the grid has a border of samples around it so differences can be taken at its edges.
+	/// </summary>
+	struct TerrainTile
+	{
+		std::vector<float> heights;
+		float minHeight;
+		float maxHeight;
+	};
+
 	/// <summary>
 	/// A module used for managing terrains in 3D worlds.
+	/// Heights are read from a cache of square tiles, each tile holds a grid of heights generated in one batch on a worker
+	/// thread. Heights between grid points are bilinearly interpolated, normals are taken from differences in the grid.
+	/// Tiles have levels, a tile at level n has grid points 2^n times further apart, so distant terrain is cheap to stream.
+	/// Tiles around the camera are generated ahead of time, the least recently used tiles are evicted once the cache is full.
+	/// The cache is not locked, so every query has to be made from the main thread, worker threads only fill the tiles they are given.
 	/// </summary>
 	class F_EXPORT Terrains :
 		public IModule
 	{
 	private:
+		struct TileEntry
+		{
+			TerrainTile tile;
+			std::future<void> job;
+			bool ready;
+			std::list<uint64_t>::iterator order;
+		};
+
 		NoiseFast m_noise1;
+
+		uint32_t m_maxTiles;
+		std::unordered_map<uint64_t, std::shared_ptr<TileEntry>> m_tiles;
+		std::list<uint64_t> m_tileOrder;
+		std::shared_ptr<TileEntry> m_lastTile;
+		uint64_t m_lastKey;
+		bool m_prefetch;
 	public:
+		static const int TILE_SIZE;
+		static const int TILE_BORDER;
+		static const int TILE_ROW;
+		static const float TILE_SPACING;
+		static const float HEIGHT_OFFSET;
+		static const float HEIGHT_AMPLITUDE;
+		static const int PREFETCH_RADIUS;
+
 		/// <summary>
 		/// Gets this engine instance.
 		/// </summary>
@@ -37,10 +79,76 @@ namespace Flounder
 
 		void Update() override;
 
+		/// <summary>
+		/// Gets the height of the terrain, from the tile cache.
+		/// This reads and updates the cache, so it has to be called from the main thread.
+		/// </summary>
+		/// <param name="x"> The world x position. </param>
+		/// <param name="z"> The world z position. </param>
+		/// <returns> The terrain height. </returns>
 		float GetHeight(const float &x, const float &z);
 
+		/// <summary>
+		/// Gets the normal of the terrain, from the tile cache. This has to be called from the main thread.
+		/// </summary>
+		/// <param name="x"> The world x position. </param>
+		/// <param name="z"> The world z position. </param>
+		/// <returns> The terrain normal. </returns>
 		Vector3 GetNormal(const float &x, const float &z);
 
+		/// <summary>
+		/// Gets the point on the terrain, from the tile cache. This has to be called from the main thread.
+		/// </summary>
+		/// <param name="x"> The world x position. </param>
+		/// <param name="z"> The world z position. </param>
+		/// <returns> The terrain position. </returns>
 		Vector3 GetPosition(const float &x, const float &z);
+
+		/// <summary>
+		/// Gets a tile from the cache, tiles that are not cached are queued to be generated on worker threads.
+		/// This has to be called from the main thread, and the tile may be evicted by the next call.
+		/// </summary>
+		/// <param name="level"> The tiles level. </param>
+		/// <param name="tileX"> The tiles x index, in tiles of its level. </param>
+		/// <param name="tileZ"> The tiles z index, in tiles of its level. </param>
+		/// <param name="wait"> If the tile should be waited on when it is still generating. </param>
+		/// <returns> The tile, or nullptr if it is still generating and is not waited on. </returns>
+		const TerrainTile *GetTile(const int &level, const int &tileX, const int &tileZ, const bool &wait);
+
+		/// <summary>
+		/// Queues every tile that covers an area to be generated on worker threads, tiles already cached are skipped.
+		/// This has to be called from the main thread.
+		/// </summary>
+		/// <param name="minX"> The areas minimum world x position. </param>
+		/// <param name="minZ"> The areas minimum world z position. </param>
+		/// <param name="maxX"> The areas maximum world x position. </param>
+		/// <param name="maxZ"> The areas maximum world z position. </param>
+		void RequestTiles(const float &minX, const float &minZ, const float &maxX, const float &maxZ);
+
+		uint32_t GetTileCount() const { return static_cast<uint32_t>(m_tiles.size()); }
+
+		uint32_t GetMaxTiles() const { return m_maxTiles; }
+
+		void SetMaxTiles(const uint32_t &maxTiles) { m_maxTiles = maxTiles; }
+
+		/// <summary>
+		/// Gets the distance between a levels grid points.
+		/// </summary>
+		/// <param name="level"> The level. </param>
+		/// <returns> The grid spacing, in world units. </returns>
+		static float GetTileSpacing(const int &level) { return TILE_SPACING * static_cast<float>(1 << level); }
+
+		/// <summary>
+		/// Gets the tile a grid cell is in, the same for every level.
+		/// </summary>
+		/// <param name="cell"> The cells index along one axis, in grid points of its level. </param>
+		/// <returns> The tiles index along that axis. </returns>
+		static int GetTileIndex(const int &cell);
+
+		static uint64_t GetKey(const int &level, const int &tileX, const int &tileZ);
+	private:
+		std::shared_ptr<TileEntry> CreateTile(const int &level, const int &tileX, const int &tileZ);
+
+		void GenerateTile(TerrainTile *tile, const int &level, const int &tileX, const int &tileZ) const;
 	};
 }
@@ -12,11 +12,13 @@ namespace Flounder
 		{
 			Matrix4 projection;
 			Matrix4 view;
+			Vector4 cameraPosition;
 		};
 
-		struct UboObject
+		struct Node
 		{
-			Matrix4 transform;
+			Vector4 origin; // The nodes corner x and z, its grid spacing, and its slot in the height pool.
+			Vector4 morph; // The distances morphing starts and ends at.
 		};
 	};
 }
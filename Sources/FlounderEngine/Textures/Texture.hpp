@@ -65,12 +65,23 @@ namespace Flounder
 		/// </summary>
 		Texture(const uint32_t &width, const uint32_t &height, const VkFormat &format, const VkImageLayout &imageLayout, const VkImageUsageFlags &usage);
 
+		/// <summary>
+		/// A new texture object from pixels in memory, used for textures generated at load time.
+		/// </summary>
+		/// <param name="width"> The width in pixels. </param>
+		/// <param name="height"> The height in pixels. </param>
+		/// <param name="pixels"> The pixels, tightly packed rows of the format. </param>
+		/// <param name="format"> The pixel format. </param>
+		/// <param name="pixelSize"> The size of one pixel, in bytes. </param>
+		/// <param name="nearest"> If the texture is sampled without filtering. </param>
+		Texture(const uint32_t &width, const uint32_t &height, const void *pixels, const VkFormat &format, const uint32_t &pixelSize, const bool &nearest = false);
+
 		/// <summary>
 		/// Deconstructor for the texture object.
 		/// </summary>
 		~Texture();
 
-		static DescriptorType CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage);
+		static DescriptorType CreateDescriptor(const uint32_t &binding, const VkShaderStageFlags &stage, const uint32_t &count = 1);
 
 		VkWriteDescriptorSet GetWriteDescriptor(const uint32_t &binding, const DescriptorSet &descriptorSet) const override;
 
@@ -106,6 +117,8 @@ namespace Flounder
 
 		VkSampler GetSampler() const { return m_sampler; }
 
+		VkDescriptorImageInfo GetImageInfo() const { return m_imageInfo; }
+
 		static VkDeviceSize LoadSize(const std::string &filepath);
 
 		static stbi_uc *LoadPixels(const std::string &filepath, int *width, int *height, int *components);
@@ -0,0 +1,102 @@
+#include "TextureArray.hpp"
+
+#include <algorithm>
+
+namespace Flounder
+{
+	TextureArray::TextureArray(const uint32_t &size, Texture *fallback) :
+		Descriptor(),
+		m_fallback(fallback),
+		m_imageInfos(std::vector<VkDescriptorImageInfo>(size, fallback->GetImageInfo())),
+		m_slots(std::unordered_map<Texture *, uint32_t>()),
+		m_freeSlots(std::vector<uint32_t>()),
+		m_used(std::vector<bool>(size, false)),
+		m_version(0)
+	{
+		Clear();
+	}
+
+	TextureArray::~TextureArray()
+	{
+	}
+
+	uint32_t TextureArray::Add(Texture *texture)
+	{
+		if (texture == nullptr)
+		{
+			return 0;
+		}
+
+		auto it = m_slots.find(texture);
+
+		if (it != m_slots.end())
+		{
+			m_used.at(it->second) = true;
+			return it->second;
+		}
+
+		if (m_freeSlots.empty())
+		{
+			return 0;
+		}
+
+		const uint32_t slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+		m_slots.emplace(texture, slot);
+		m_imageInfos.at(slot) = texture->GetImageInfo();
+		m_used.at(slot) = true;
+		m_version++;
+		return slot;
+	}
+
+	void TextureArray::Update()
+	{
+		for (auto it = m_slots.begin(); it != m_slots.end();)
+		{
+			// The fallback slot is never freed.
+			if (it->second == 0 || m_used.at(it->second))
+			{
+				++it;
+				continue;
+			}
+
+			m_imageInfos.at(it->second) = m_fallback->GetImageInfo();
+			m_freeSlots.push_back(it->second);
+			it = m_slots.erase(it);
+			m_version++;
+		}
+
+		std::fill(m_used.begin(), m_used.end(), false);
+	}
+
+	void TextureArray::Clear()
+	{
+		m_slots.clear();
+		m_slots.emplace(m_fallback, 0);
+		std::fill(m_imageInfos.begin(), m_imageInfos.end(), m_fallback->GetImageInfo());
+		std::fill(m_used.begin(), m_used.end(), false);
+		m_freeSlots.clear();
+
+		// Free slots are taken from the back, so the lowest slots are filled first.
+		for (uint32_t slot = static_cast<uint32_t>(m_imageInfos.size()) - 1; slot > 0; slot--)
+		{
+			m_freeSlots.push_back(slot);
+		}
+
+		m_version++;
+	}
+
+	VkWriteDescriptorSet TextureArray::GetWriteDescriptor(const uint32_t &binding, const DescriptorSet &descriptorSet) const
+	{
+		VkWriteDescriptorSet descriptorWrite = {};
+		descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrite.dstSet = descriptorSet.GetDescriptorSet();
+		descriptorWrite.dstBinding = binding;
+		descriptorWrite.dstArrayElement = 0;
+		descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorWrite.descriptorCount = static_cast<uint32_t>(m_imageInfos.size());
+		descriptorWrite.pImageInfo = m_imageInfos.data();
+
+		return descriptorWrite;
+	}
+}
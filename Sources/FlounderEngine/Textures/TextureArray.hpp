@@ -0,0 +1,64 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "Texture.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// A fixed size array of sampled textures bound as one descriptor, so draws can pick a texture by index instead of by descriptor set.
+	/// Every slot is always written, empty slots point at the fallback texture.
+	/// Slots of textures that were not added during a frame are freed when the next frame starts, so the array does not fill up and destroyed textures drop out.
+	/// </summary>
+	class F_EXPORT TextureArray :
+		public Descriptor
+	{
+	private:
+		Texture *m_fallback;
+		std::vector<VkDescriptorImageInfo> m_imageInfos;
+		std::unordered_map<Texture *, uint32_t> m_slots;
+		std::vector<uint32_t> m_freeSlots;
+		std::vector<bool> m_used;
+		uint32_t m_version;
+	public:
+		/// <summary>
+		/// Creates a new texture array.
+		/// </summary>
+		/// <param name="size"> The number of slots, this has to match the array size in the shader. </param>
+		/// <param name="fallback"> The texture used in empty slots, this is always slot 0. </param>
+		TextureArray(const uint32_t &size, Texture *fallback);
+
+		/// <summary>
+		/// Deconstructor for the texture array.
+		/// </summary>
+		~TextureArray();
+
+		/// <summary>
+		/// Gets the slot of a texture, adding it to the array if it is new.
+		/// </summary>
+		/// <param name="texture"> The texture to find. </param>
+		/// <returns> The textures slot, or the fallback slot if the texture is null or the array is full. </returns>
+		uint32_t Add(Texture *texture);
+
+		/// <summary>
+		/// Starts a new frame, freeing the slots of textures that were not added since the last update.
+		/// </summary>
+		void Update();
+
+		/// <summary>
+		/// Removes every texture from the array.
+		/// </summary>
+		void Clear();
+
+		VkWriteDescriptorSet GetWriteDescriptor(const uint32_t &binding, const DescriptorSet &descriptorSet) const override;
+
+		uint32_t GetSize() const { return static_cast<uint32_t>(m_imageInfos.size()); }
+
+		/// <summary>
+		/// Gets a counter that changes every time a slot is written, used to know when descriptor sets have to be rewritten.
+		/// </summary>
+		/// <returns> The arrays version. </returns>
+		uint32_t GetVersion() const { return m_version; }
+	};
+}
@@ -1,48 +1,80 @@
 #include "Block.hpp"
 
-#include "Chunk.hpp"
-
 namespace Flounder
 {
-	std::map<std::string, Colour*> Block::s_colours = std::map<std::string, Colour*>
+	std::vector<Block *> Block::s_registry = std::vector<Block *>
 		{
-			{"", new Colour("#FFFFFF", 0.0f)},
-			{"Grass", new Colour("#5E7831")},
-			{"Dirt", new Colour("#784800")},
-			{"Stone", new Colour("#8B8D7A")},
+			new Block("", Colour("#FFFFFF", 0.0f), false),
+			new Block("Grass", Colour("#5E7831")),
+			new Block("Dirt", Colour("#784800")),
+			new Block("Stone", Colour("#8B8D7A")),
+			new Block("Sand", Colour("#C2B280")),
+			new Block("Snow", Colour("#F0F0F0")),
+			new Block("Coal Ore", Colour("#2E2E2E")),
+			new Block("Iron Ore", Colour("#A0785A")),
 		};
+	uint32_t Block::s_version = 0;
 
-	Block::Block(Chunk *parent, const Vector3 &position, const std::string &type) :
-		m_parent(parent),
-		m_position(new Vector3(position)),
-		m_type(type)
+	Block::Block(const std::string &name, const Colour &colour, const bool &solid) :
+		m_name(name),
+		m_colour(new Colour(colour)),
+		m_solid(solid)
 	{
 	}
 
 	Block::~Block()
 	{
-		delete m_position;
+		delete m_colour;
 	}
 
-	void Block::SetChanged()
+	BlockId Block::Register(const std::string &name, const Colour &colour, const bool &solid)
 	{
-		m_parent->Rebuild();
+		for (BlockId i = 0; i < s_registry.size(); i++)
+		{
+			if (s_registry[i]->m_name == name)
+			{
+				*s_registry[i]->m_colour = colour;
+				s_registry[i]->m_solid = solid;
+				s_version++;
+				return i;
+			}
+		}
+
+		// Voxel vertices only have room for this many ids.
+		if (s_registry.size() >= MAX_BLOCKS)
+		{
+			fprintf(stderr, "Could not register block '%s', the registry is full\n", name.c_str());
+			return BLOCK_AIR;
+		}
+
+		s_registry.push_back(new Block(name, colour, solid));
+		s_version++;
+		return static_cast<BlockId>(s_registry.size() - 1);
 	}
 
-	Colour *Block::FindColour(const std::string &key)
+	BlockId Block::Find(const std::string &name)
 	{
-		const auto it = s_colours.find(key);
-
-		if (it == s_colours.end())
+		for (BlockId i = 0; i < s_registry.size(); i++)
 		{
+			if (s_registry[i]->m_name == name)
+			{
+				return i;
+			}
+		}
+
 #if FLOUNDER_VERBOSE
-			printf("Could not find a Block Face colour from key: %s", key.c_str());
+		printf("Could not find a Block type from name: %s\n", name.c_str());
 #endif
-			auto colour = new Colour();
-			s_colours.insert(std::make_pair(key, colour));
-			return colour;
+		return BLOCK_AIR;
+	}
+
+	Block *Block::Get(const BlockId &id)
+	{
+		if (id >= s_registry.size())
+		{
+			return s_registry[BLOCK_AIR];
 		}
 
-		return it->second;
+		return s_registry[id];
 	}
 }
@@ -1,12 +1,15 @@
 #pragma once
 
-#include <map>
+#include <string>
+#include <vector>
 #include "../Maths/Colour.hpp"
-#include "../Maths/Vector3.hpp"
 
 namespace Flounder
 {
-	class Chunk;
+	typedef uint16_t BlockId;
+
+#define BLOCK_AIR 0
+#define MAX_BLOCKS 256
 
 	enum BlockFace
 	{
@@ -18,29 +21,72 @@ namespace Flounder
 		FaceRight = 5
 	};
 
+	/// <summary>
+	/// A type of block, voxels only store the id this type was registered with.
+	/// Types should be registered before chunks are generated, the registry is read from worker threads.
+	/// </summary>
 	class F_EXPORT Block
 	{
 	private:
-		static std::map<std::string, Colour*> s_colours;
-
-		Chunk *m_parent;
-
-		Vector3 *m_position;
-		std::string m_type;
+		static std::vector<Block *> s_registry;
+		static uint32_t s_version;
 
+		std::string m_name;
+		Colour *m_colour;
+		bool m_solid;
 	public:
-		Block(Chunk *parent, const Vector3 &position, const std::string &type);
+		/// <summary>
+		/// Creates a new block type.
+		/// </summary>
+		/// <param name="name"> The unique name of the type. </param>
+		/// <param name="colour"> The colour meshed faces of this type are given. </param>
+		/// <param name="solid"> If this type fills its voxel, hiding its neighbours faces. </param>
+		Block(const std::string &name, const Colour &colour, const bool &solid = true);
 
 		~Block();
 
-		void SetChanged();
+		std::string GetName() const { return m_name; }
+
+		Colour *GetColour() const { return m_colour; }
+
+		bool IsSolid() const { return m_solid; }
+
+		/// <summary>
+		/// Adds a block type to the registry, a type with the same name is replaced. At most MAX_BLOCKS types can be registered.
+		/// </summary>
+		/// <param name="name"> The unique name of the type. </param>
+		/// <param name="colour"> The colour meshed faces of this type are given. </param>
+		/// <param name="solid"> If this type fills its voxel. </param>
+		/// <returns> The types id, or air if the registry is full. </returns>
+		static BlockId Register(const std::string &name, const Colour &colour, const bool &solid = true);
+
+		/// <summary>
+		/// Finds the id of a registered block type.
+		/// </summary>
+		/// <param name="name"> The name of the type. </param>
+		/// <returns> The types id, or air if the type was not found. </returns>
+		static BlockId Find(const std::string &name);
 
-		Vector3 *GetPosition() const { return m_position; }
+		/// <summary>
+		/// Gets a registered block type.
+		/// </summary>
+		/// <param name="id"> The types id. </param>
+		/// <returns> The type, or air if the id is not registered. </returns>
+		static Block *Get(const BlockId &id);
 
-		std::string GetType() const { return m_type; }
+		/// <summary>
+		/// Gets if a voxel with this id fills its space.
+		/// </summary>
+		/// <param name="id"> The types id. </param>
+		/// <returns> If the voxel is filled. </returns>
+		static bool IsFilled(const BlockId &id) { return id != BLOCK_AIR && id < s_registry.size() && s_registry[id]->m_solid; }
 
-		void SetType(const std::string &type) { m_type = type; }
+		static uint32_t GetCount() { return static_cast<uint32_t>(s_registry.size()); }
 
-		static Colour *FindColour(const std::string &key);
+		/// <summary>
+		/// Gets a number that changes every time a type is registered or replaced, so copies of the registry know to refresh.
+		/// </summary>
+		/// <returns> The registry version. </returns>
+		static uint32_t GetVersion() { return s_version; }
 	};
 }
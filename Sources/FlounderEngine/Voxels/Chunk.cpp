@@ -1,7 +1,10 @@
 #include "Chunk.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include "../Scenes/Scenes.hpp"
-#include "../Worlds/Worlds.hpp"
+#include "../Tasks/Tasks.hpp"
+#include "Voxels.hpp"
 
 namespace Flounder
 {
@@ -9,82 +12,204 @@ namespace Flounder
 	const int Chunk::CHUNK_HEIGHT = 16;
 	const float Chunk::VOXEL_SIZE = 1.0f;
 	const Vector3 *Chunk::CHUNK_SIZE = new Vector3(VOXEL_SIZE * CHUNK_WIDTH, VOXEL_SIZE * CHUNK_HEIGHT, VOXEL_SIZE * CHUNK_WIDTH);
+	const int Chunk::MAX_LOD = 3;
 
 	Chunk::Chunk(const ChunkMesh &chunkMesh, const bool &generate) :
 		Component(),
-		m_blocks(new std::vector<std::vector<std::vector<Block*>>>(CHUNK_WIDTH, std::vector<std::vector<Block*>>(CHUNK_WIDTH, std::vector<Block*>(CHUNK_HEIGHT)))),
+		m_blocks(new ChunkStorage(CHUNK_WIDTH * CHUNK_WIDTH * CHUNK_HEIGHT)),
 		m_chunkMesh(chunkMesh),
 		m_generate(generate),
-		m_rebuild(true)
+		m_rebuild(true),
+		m_modified(false),
+		m_version(0),
+		m_lod(0),
+		m_chunkX(0),
+		m_chunkY(0),
+		m_chunkZ(0),
+		m_registered(false),
+		m_mesher(nullptr),
+		m_job(std::future<void>())
 	{
-		for (unsigned int x = 0; x < CHUNK_WIDTH; x++)
-		{
-			for (unsigned int z = 0; z < CHUNK_WIDTH; z++)
-			{
-				for (unsigned int y = 0; y < CHUNK_HEIGHT; y++)
-				{
-					m_blocks->at(x).at(z).at(y) = new Block(this, VOXEL_SIZE * Vector3(x, y, z), "");
-				}
-			}
-		}
 	}
 
 	Chunk::~Chunk()
 	{
-		for (auto x : *m_blocks)
+		// The job writes into the mesher, so it has to finish before either is destroyed.
+		if (m_job.valid())
 		{
-			for (auto z : x)
-			{
-				for (auto y : z)
-				{
-					delete y;
-				}
-			}
+			m_job.wait();
 		}
 
+		if (m_registered)
+		{
+			Save();
+			Voxels::Get()->RemoveChunk(this, m_chunkX, m_chunkY, m_chunkZ);
+		}
+
+		delete m_mesher;
 		delete m_blocks;
 	}
 
 	void Chunk::Update()
 	{
-		if (m_generate)
+		if (!m_registered)
 		{
-			Generate();
-			m_generate = false;
+			const Vector3 position = *GetGameObject()->GetTransform()->GetPosition();
+			m_chunkX = static_cast<int>(std::floor(position.m_x / CHUNK_SIZE->m_x + 0.5f));
+			m_chunkY = static_cast<int>(std::floor(position.m_y / CHUNK_SIZE->m_y + 0.5f));
+			m_chunkZ = static_cast<int>(std::floor(position.m_z / CHUNK_SIZE->m_z + 0.5f));
+			m_registered = true;
+			Voxels::Get()->AddChunk(this, m_chunkX, m_chunkY, m_chunkZ);
 		}
 
-		if (m_rebuild)
+		// A finished mesh waiting for an upload slot no longer has a job.
+		if (m_mesher != nullptr && (!m_job.valid() || m_job.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
 		{
-			GenerateMesh();
-			m_rebuild = false;
+			FinishJob();
+		}
+
+		if (m_mesher == nullptr && (m_generate || m_rebuild))
+		{
+			StartJob();
 		}
 	}
 
 	void Chunk::Load(LoadedValue *value)
 	{
+		m_chunkMesh = static_cast<ChunkMesh>(value->GetChild("Mesh")->Get<int>());
+		m_generate = value->GetChild("Generate")->Get<bool>();
 	}
 
 	void Chunk::Write(LoadedValue *value)
 	{
+		// Voxels are not kept in prefabs, they are saved into the worlds region files.
+		value->GetChild("Mesh", true)->Set(static_cast<int>(m_chunkMesh));
+		value->GetChild("Generate", true)->Set(m_generate);
+	}
+
+	BlockId Chunk::GetBlock(const int &x, const int &y, const int &z) const
+	{
+		if (x >= 0 && x < CHUNK_WIDTH && z >= 0 && z < CHUNK_WIDTH && y >= 0 && y < CHUNK_HEIGHT)
+		{
+			return m_blocks->Get(GetIndex(x, y, z));
+		}
+
+		return BLOCK_AIR;
 	}
 
-	Block *Chunk::GetBlock(const int &x, const int &y, const int &z)
+	void Chunk::SetBlock(const int &x, const int &y, const int &z, const BlockId &id)
 	{
 		if (x >= 0 && x < CHUNK_WIDTH && z >= 0 && z < CHUNK_WIDTH && y >= 0 && y < CHUNK_HEIGHT)
 		{
-			return m_blocks->at(x).at(z).at(y);
+			m_blocks->Set(GetIndex(x, y, z), id);
+			m_modified = true;
+			Rebuild();
+			RebuildNeighbours(x, y, z);
+		}
+	}
+
+	bool Chunk::IsBlockFilled(const int &x, const int &y, const int &z) const
+	{
+		Chunk *neighbour = nullptr;
+
+		if (x < 0)
+		{
+			neighbour = GetNeighbour(FaceLeft);
+		}
+		else if (x >= CHUNK_WIDTH)
+		{
+			neighbour = GetNeighbour(FaceRight);
+		}
+		else if (y < 0)
+		{
+			neighbour = GetNeighbour(FaceDown);
+		}
+		else if (y >= CHUNK_HEIGHT)
+		{
+			neighbour = GetNeighbour(FaceUp);
+		}
+		else if (z < 0)
+		{
+			neighbour = GetNeighbour(FaceFront);
+		}
+		else if (z >= CHUNK_WIDTH)
+		{
+			neighbour = GetNeighbour(FaceBack);
+		}
+		else
+		{
+			return Block::IsFilled(GetBlock(x, y, z));
+		}
+
+		if (neighbour == nullptr)
+		{
+			return false;
+		}
+
+		return Block::IsFilled(neighbour->GetBlock((x + CHUNK_WIDTH) % CHUNK_WIDTH, (y + CHUNK_HEIGHT) % CHUNK_HEIGHT, (z + CHUNK_WIDTH) % CHUNK_WIDTH));
+	}
+
+	Chunk *Chunk::GetNeighbour(const BlockFace &face) const
+	{
+		if (!m_registered)
+		{
+			return nullptr;
+		}
+
+		switch (face)
+		{
+		case FaceFront:
+			return Voxels::Get()->GetChunk(m_chunkX, m_chunkY, m_chunkZ - 1);
+		case FaceBack:
+			return Voxels::Get()->GetChunk(m_chunkX, m_chunkY, m_chunkZ + 1);
+		case FaceUp:
+			return Voxels::Get()->GetChunk(m_chunkX, m_chunkY + 1, m_chunkZ);
+		case FaceDown:
+			return Voxels::Get()->GetChunk(m_chunkX, m_chunkY - 1, m_chunkZ);
+		case FaceLeft:
+			return Voxels::Get()->GetChunk(m_chunkX - 1, m_chunkY, m_chunkZ);
+		case FaceRight:
+			return Voxels::Get()->GetChunk(m_chunkX + 1, m_chunkY, m_chunkZ);
+		default:
+			return nullptr;
 		}
+	}
 
-		return nullptr;
+	void Chunk::Rebuild()
+	{
+		m_rebuild = true;
+		m_version++;
 	}
 
-	bool Chunk::IsBlockFilled(const int &x, const int &y, const int &z)
+	void Chunk::SetLod(const int &lod)
 	{
-		Block *block = GetBlock(x, y, z);
-		return block != nullptr && !block->GetType().empty();
+		const int clamped = std::max(0, std::min(lod, MAX_LOD));
+
+		if (clamped == m_lod)
+		{
+			return;
+		}
+
+		m_lod = clamped;
+		Rebuild();
+
+		for (int face = 0; face < 6; face++)
+		{
+			Chunk *neighbour = GetNeighbour(static_cast<BlockFace>(face));
+
+			if (neighbour != nullptr)
+			{
+				neighbour->Rebuild();
+			}
+		}
 	}
 
-	bool Chunk::IsFaceVisible(const int &x, const int &y, const int &z, const BlockFace &faceType)
+	Vector3 Chunk::GetPosition(const uint32_t &index)
+	{
+		return Vector3(index % CHUNK_WIDTH, index / (CHUNK_WIDTH * CHUNK_WIDTH), (index / CHUNK_WIDTH) % CHUNK_WIDTH);
+	}
+
+	bool Chunk::IsFaceVisible(const int &x, const int &y, const int &z, const BlockFace &faceType) const
 	{
 		switch (faceType)
 		{
@@ -105,376 +230,178 @@ namespace Flounder
 		}
 	}
 
-	void Chunk::Generate()
+	void Chunk::Reset(const int &x, const int &y, const int &z)
 	{
-		auto position = *GetGameObject()->GetTransform()->GetPosition() / VOXEL_SIZE;
-	//	auto noise = Worlds::Get()->GetNoise();
+		Unload();
+
+		m_blocks->Fill(BLOCK_AIR);
+		m_generate = true;
+		m_modified = false;
+		Rebuild();
+
+		m_chunkX = x;
+		m_chunkY = y;
+		m_chunkZ = z;
+		m_registered = true;
+		Voxels::Get()->AddChunk(this, m_chunkX, m_chunkY, m_chunkZ);
+	}
 
-		for (int x = 0; x < CHUNK_WIDTH; x++)
+	void Chunk::Unload()
+	{
+		if (m_registered)
 		{
-			for (int z = 0; z < CHUNK_WIDTH; z++)
+			Save();
+
+			// Neighbours culled their faces against this chunk, they are left facing empty space.
+			for (int face = 0; face < 6; face++)
 			{
-				for (int y = 0; y < CHUNK_HEIGHT; y++)
+				Chunk *neighbour = GetNeighbour(static_cast<BlockFace>(face));
+
+				if (neighbour != nullptr)
 				{
-					m_blocks->at(x).at(z).at(y)->SetType("Stone");
-
-					/*int height = (int) std::floor(CHUNK_HEIGHT * (noise->GetValue(x + position.m_x, y + position.m_y, z + position.m_z) + 0.1f));
-
-					if (y > height)
-					{
-						continue;
-					}
-
-					if (y == height)
-					{
-						m_blocks->at(x).at(z).at(y)->SetType("Grass");
-					}
-					else if (height - y <= 2)
-					{
-						m_blocks->at(x).at(z).at(y)->SetType("Dirt");
-					}
-					else
-					{
-						m_blocks->at(x).at(z).at(y)->SetType("Stone");
-					}*/
+					neighbour->Rebuild();
 				}
 			}
-		}
-	}
 
-	void Chunk::GenerateMesh()
-	{
-#if FLOUNDER_VERBOSE
-		const auto debugStart = Engine::Get()->GetTimeMs();
-#endif
-
-		auto mesh = GetGameObject()->GetComponent<Mesh>();
-
-		if (mesh == nullptr)
-		{
-			return;
+			Voxels::Get()->RemoveChunk(this, m_chunkX, m_chunkY, m_chunkZ);
+			m_registered = false;
 		}
 
-		std::vector<IVertex*> vertices = {};
-		std::vector<uint32_t> indices = {};
+		auto mesh = GetGameObject() == nullptr ? nullptr : GetGameObject()->GetComponent<Mesh>();
 
-		switch (m_chunkMesh)
+		if (mesh != nullptr)
 		{
-		case MeshGreedy:
-			CreateGreedyMesh(&vertices, &indices);
-			break;
-		case MeshSimple:
-			CreateSimpleMesh(&vertices, &indices);
-			break;
+			delete mesh->GetModel();
+			mesh->SetModel(nullptr);
 		}
+	}
 
-		delete mesh->GetModel();
-
-		if (!vertices.empty() || !indices.empty())
+	void Chunk::Save()
+	{
+		// Chunks still generating have nothing worth saving, their voxels are replaced when the job finishes.
+		if (!m_registered || !m_modified || m_generate)
 		{
-			Model *model = new Model(vertices, indices, GetName());
-			mesh->SetModel(model);
+			return;
 		}
 
-#if FLOUNDER_VERBOSE
-		const auto debugEnd = Engine::Get()->GetTimeMs();
-
-		if (debugEnd - debugStart > 22.0f)
-		{
-			printf("Chunk %s built in %fms\n", GetName().c_str(), debugEnd - debugStart);
-		}
-#endif
+		Voxels::Get()->SaveChunk(m_chunkX, m_chunkY, m_chunkZ, *m_blocks);
+		m_modified = false;
 	}
 
-	void Chunk::CreateSimpleMesh(std::vector<IVertex*> *vertices, std::vector<uint32_t> *indices)
+	void Chunk::RebuildNeighbours(const int &x, const int &y, const int &z)
 	{
-		int u, v;
-		BlockFace currentFace;
-
-		std::vector<int> du = std::vector<int>{0, 0, 0};
-		std::vector<int> dv = std::vector<int>{0, 0, 0};
+		// Only voxels on a border can change which of a neighbours faces are hidden.
+		const bool borders[6] = {z == 0, z == CHUNK_WIDTH - 1, y == CHUNK_HEIGHT - 1, y == 0, x == 0, x == CHUNK_WIDTH - 1};
 
-		// We start with the lesser-spotted boolean for-loop (also known as the old flippy floppy).
-		for (bool backFace = true, b = false; b != backFace; backFace = backFace && b, b = !b)
+		for (int face = 0; face < 6; face++)
 		{
-			// We sweep over the 3 dimensions - most of what follows is well described by Mikola Lysenko in his post.
-			for (int d = 0; d < 3; d++)
-			{
-				u = (d + 1) % 3;
-				v = (d + 2) % 3;
+			Chunk *neighbour = borders[face] ? GetNeighbour(static_cast<BlockFace>(face)) : nullptr;
 
-				// Here we're keeping track of the side that we're meshing.
-				if (d == 0)
-				{
-					currentFace = backFace ? FaceLeft : FaceRight;
-				}
-				else if (d == 1)
-				{
-					currentFace = backFace ? FaceDown : FaceUp;
-				}
-				else if (d == 2)
-				{
-					currentFace = backFace ? FaceFront : FaceBack;
-				}
-
-				// We move through all of the blocks in the chunk.
-				for (int x = 0; x < CHUNK_WIDTH; x++)
-				{
-					for (int z = 0; z < CHUNK_WIDTH; z++)
-					{
-						for (int y = 0; y < CHUNK_HEIGHT; y++)
-						{
-							// Here we filter out invisible faces.
-							if (!IsFaceVisible(x, y, z, currentFace))
-							{
-								continue;
-							}
-
-							Block *block = GetBlock(x, y, z);
-
-							if (block == nullptr || block->GetType().empty())
-							{
-								continue;
-							}
-
-							du[0] = 0;
-							du[1] = 0;
-							du[2] = 0;
-							du[u] = 1;
-
-							dv[0] = 0;
-							dv[1] = 0;
-							dv[2] = 0;
-							dv[v] = 1;
-
-							// And here we call the quad function in order to render a merged quad in the scene.
-							Vector3 bottomLeft = Vector3(x, y, z);
-							Vector3 topLeft = Vector3(x + dv[0], y + dv[1], z + dv[2]);
-							Vector3 topRight = Vector3(x + du[0] + dv[0], y + du[1] + dv[1], z + du[2] + dv[2]);
-							Vector3 bottomRight = Vector3(x + du[0], y + du[1], z + du[2]);
-							GenerateQuad(vertices, indices, bottomLeft, topLeft, topRight, bottomRight, 1, 1, block->GetType(), backFace);
-						}
-					}
-				}
+			if (neighbour != nullptr)
+			{
+				neighbour->Rebuild();
 			}
 		}
 	}
 
-	void Chunk::CreateGreedyMesh(std::vector<IVertex*> *vertices, std::vector<uint32_t> *indices)
+	void Chunk::StartJob()
 	{
-		// This method is based off of Robert O'Leary's implementation (https://github.com/roboleary/GreedyMesh)
+		if (GetGameObject()->GetComponent<Mesh>() == nullptr)
+		{
+			return;
+		}
 
-		// These are just working variables for the algorithm - almost all taken
-		// directly from Mikola Lysenko's javascript implementation.
-		int i, j, k, l, w, h, u, v, n;
-		BlockFace currentFace;
+		// The job works on a copy, so the chunk can still be read and edited while it runs.
+		m_mesher = new ChunkMesher(new ChunkStorage(*m_blocks), m_chunkMesh, m_version, m_lod);
+		m_rebuild = false;
 
-		std::vector<int> x = std::vector<int>{0, 0, 0};
-		std::vector<int> q = std::vector<int>{0, 0, 0};
-		std::vector<int> du = std::vector<int>{0, 0, 0};
-		std::vector<int> dv = std::vector<int>{0, 0, 0};
+		for (int face = 0; face < 6; face++)
+		{
+			Chunk *neighbour = GetNeighbour(static_cast<BlockFace>(face));
 
-		// We create a mask - this will contain the groups of matching voxel faces
-		// as we proceed through the chunk in 6 directions - once for each face.
-		std::vector<std::string> mask = std::vector<std::string>(CHUNK_WIDTH * CHUNK_HEIGHT);
+			// Cells do not line up between levels, so faces along a level change are kept as a skirt that hides the cracks.
+			if (neighbour != nullptr && neighbour->IsGenerated() && neighbour->m_lod == m_lod)
+			{
+				m_mesher->SetBorder(static_cast<BlockFace>(face), *neighbour->m_blocks);
+			}
+		}
 
-		// These are just working variables to hold two faces during comparison.
-		std::string voxelFace, voxelFace1;
+		ChunkMesher *mesher = m_mesher;
+		const bool generate = m_generate;
+		const std::string name = GetGameObject()->GetName();
+		Voxels *voxels = Voxels::Get();
+		const int x = m_chunkX;
+		const int y = m_chunkY;
+		const int z = m_chunkZ;
 
-		// We start with the lesser-spotted boolean for-loop (also known as the old flippy floppy).
-		// The variable backFace will be TRUE on the first iteration and FALSE on the second - this allows
-		// us to track which direction the indices should run during creation of the quad.
-		// This loop runs twice, and the inner loop 3 times - totally 6 iterations - one for each voxel face.
-		for (bool backFace = true, b = false; b != backFace; backFace = backFace && b, b = !b)
+		m_job = Tasks::Get()->GetThreadPool()->Enqueue([mesher, generate, name, voxels, x, y, z]()
 		{
-			// We sweep over the 3 dimensions - most of what follows is well described by Mikola Lysenko in his post.
-			for (int d = 0; d < 3; d++)
-			{
-				u = (d + 1) % 3;
-				v = (d + 2) % 3;
+#if FLOUNDER_VERBOSE
+			const auto debugStart = Engine::Get()->GetTimeMs();
+#endif
 
-				x[0] = 0;
-				x[1] = 0;
-				x[2] = 0;
+			// Saved chunks are read back instead of being generated again.
+			if (generate && !voxels->ReadChunk(x, y, z, mesher->GetBlocks()))
+			{
+				voxels->GetGenerator()->Generate(mesher->GetBlocks(), x, y, z);
+			}
 
-				q[0] = 0;
-				q[1] = 0;
-				q[2] = 0;
-				q[d] = 1;
+			mesher->Build();
 
-				// Here we're keeping track of the side that we're meshing.
-				if (d == 0)
-				{
-					currentFace = backFace ? FaceLeft : FaceRight;
-				}
-				else if (d == 1)
-				{
-					currentFace = backFace ? FaceDown : FaceUp;
-				}
-				else if (d == 2)
-				{
-					currentFace = backFace ? FaceFront : FaceBack;
-				}
+#if FLOUNDER_VERBOSE
+			const auto debugEnd = Engine::Get()->GetTimeMs();
 
-				// We move through the dimension from front to back.
-				for (x[d] = -1; x[d] < CHUNK_WIDTH;)
-				{
-					// We compute the mask.
-					n = 0;
-
-					for (x[v] = 0; x[v] < CHUNK_HEIGHT; x[v]++)
-					{
-						for (x[u] = 0; x[u] < CHUNK_WIDTH; x[u]++)
-						{
-							// Here we retrieve two voxel faces for comparison.
-							voxelFace = GetVoxelFace(x[0], x[1], x[2], currentFace);
-							voxelFace1 = GetVoxelFace(x[0] + q[0], x[1] + q[1], x[2] + q[2], currentFace);
-
-							// We choose the face to add to the mask depending on whether we're moving through on a backface or not.
-							mask[n++] = ((!voxelFace.empty() && !voxelFace1.empty() && voxelFace == voxelFace1))
-								? ""
-								: backFace ? voxelFace1 : voxelFace;
-						}
-					}
-
-					x[d]++;
-
-					// Now we generate the mesh for the mask.
-					n = 0;
-
-					for (j = 0; j < CHUNK_HEIGHT; j++)
-					{
-						for (i = 0; i < CHUNK_WIDTH;)
-						{
-							if (!mask[n].empty())
-							{
-								// We compute the width.
-								for (w = 1; i + w < CHUNK_WIDTH && !mask[n + w].empty() && mask[n + w] == mask[n]; w++)
-								{
-								}
-
-								// Then we compute height.
-								bool done = false;
-
-								for (h = 1; j + h < CHUNK_HEIGHT; h++)
-								{
-									for (k = 0; k < w; k++)
-									{
-										if (mask[n + k + h * CHUNK_WIDTH].empty() || mask[n + k + h * CHUNK_WIDTH] != mask[n])
-										{
-											done = true;
-											break;
-										}
-									}
-
-									if (done)
-									{
-										break;
-									}
-								}
-
-								// Here we check if the BlockFace is transparent, we don't mesh any culled faces.
-								//	if (!mask[n].transparent)
-								{
-									// Add quad.
-									x[u] = i;
-									x[v] = j;
-
-									du[0] = 0;
-									du[1] = 0;
-									du[2] = 0;
-									du[u] = w;
-
-									dv[0] = 0;
-									dv[1] = 0;
-									dv[2] = 0;
-									dv[v] = h;
-
-									// And here we call the quad function in order to render a merged quad in the scene.
-									Vector3 bottomLeft = Vector3(x[0], x[1], x[2]);
-									Vector3 topLeft = Vector3(x[0] + dv[0], x[1] + dv[1], x[2] + dv[2]);
-									Vector3 bottomRight = Vector3(x[0] + du[0], x[1] + du[1], x[2] + du[2]);
-									Vector3 topRight = Vector3(x[0] + du[0] + dv[0], x[1] + du[1] + dv[1], x[2] + du[2] + dv[2]);
-									GenerateQuad(vertices, indices, bottomLeft, topLeft, topRight, bottomRight, w, h, mask[n], backFace);
-								}
-
-								// We zero out the mask.
-								for (l = 0; l < h; ++l)
-								{
-									for(k = 0; k < w; ++k)
-									{
-										mask[n + k + l * CHUNK_WIDTH] = "";
-									}
-								}
-
-								// And then finally increment the counters and continue.
-								i += w;
-								n += w;
-							}
-							else
-							{
-								i++;
-								n++;
-							}
-						}
-					}
-				}
+			if (debugEnd - debugStart > 22.0f)
+			{
+				printf("Chunk %s built in %fms\n", name.c_str(), debugEnd - debugStart);
 			}
-		}
+#endif
+		});
 	}
 
-	std::string Chunk::GetVoxelFace(const int &x, const int &y, const int &z, const BlockFace &faceType)
+	void Chunk::FinishJob()
 	{
-		if (!IsFaceVisible(x, y, z, faceType))
+		if (m_job.valid())
 		{
-			return "";
+			m_job.get();
 		}
 
-		Block *block = GetBlock(x, y, z);
-		return block != nullptr ? block->GetType() : "";
-	}
-
-	void Chunk::GenerateQuad(std::vector<IVertex*> *vertices, std::vector<uint32_t> *indices,
-							 const Vector3 &bottomLeft, const Vector3 &topLeft, const Vector3 &topRight, const Vector3 &bottomRight,
-							 const int &width, const int &height,
-							 const std::string &blockType, const bool &backFace)
-	{
-		// Gets where to start indices from.
-		unsigned int indexStart = vertices->size();
-
-		Colour colour = *Block::FindColour(blockType);
+		if (m_generate)
+		{
+			// Generated voxels replace the chunk, edits made while generating are lost.
+			// Rebuilds asked for while the job ran are kept, a neighbour that finished generating first needs this chunk to mesh against it.
+			*m_blocks = *m_mesher->GetBlocks();
+			m_generate = false;
+			m_rebuild = m_rebuild || m_mesher->GetLod() != m_lod;
+			m_modified = false;
 
-		// Calculates the quads normal direction.
-		Vector3 normal = Vector3();
-		Vector3::Cross(topRight - bottomRight, topLeft - bottomRight, &normal);
+			// Neighbours meshed before this chunk existed still have walls facing it.
+			RebuildNeighbours(0, 0, 0);
+			RebuildNeighbours(CHUNK_WIDTH - 1, CHUNK_HEIGHT - 1, CHUNK_WIDTH - 1);
+		}
 
-		// Flips normal x and z when x is present, I have no clue why.
-		if (normal.m_x != 0.0f)
+		// The chunk changed after the snapshot was taken, a newer job will replace this mesh.
+		if (m_mesher->GetVersion() != m_version || m_mesher->GetLod() != m_lod)
 		{
-			float tempX = normal.m_x;
+			delete m_mesher;
+			m_mesher = nullptr;
+			return;
+		}
 
-			normal.m_x = normal.m_z;
-			normal.m_z = tempX;
+		if (!Voxels::Get()->RequestUpload())
+		{
+			return;
 		}
 
-		normal.Normalize();
+		auto mesh = GetGameObject()->GetComponent<Mesh>();
 
-		if (backFace)
+		if (mesh != nullptr)
 		{
-			normal.Negate();
+			delete mesh->GetModel();
+			mesh->SetModel(m_mesher->CreateModel(GetGameObject()->GetName()));
 		}
 
-		// Pushes vertices and indices from quad.
-		vertices->push_back(new VertexModel(VOXEL_SIZE * bottomLeft, Vector2(), normal, colour));
-		vertices->push_back(new VertexModel(VOXEL_SIZE * topLeft, Vector2(), normal, colour));
-		vertices->push_back(new VertexModel(VOXEL_SIZE * bottomRight, Vector2(), normal, colour));
-		vertices->push_back(new VertexModel(VOXEL_SIZE * topRight, Vector2(), normal, colour));
-
-		indices->push_back(indexStart + 2);
-		indices->push_back(indexStart + (backFace ? 0 : 3));
-		indices->push_back(indexStart + 1);
-		indices->push_back(indexStart + 1);
-		indices->push_back(indexStart + (backFace ? 3 : 0));
-		indices->push_back(indexStart + 2);
+		delete m_mesher;
+		m_mesher = nullptr;
 	}
 }
@@ -1,30 +1,42 @@
 #pragma once
 
+#include <future>
 #include "../Objects/Component.hpp"
 #include "../Meshes/Mesh.hpp"
 #include "Block.hpp"
+#include "ChunkMesher.hpp"
+#include "ChunkStorage.hpp"
 
 namespace Flounder
 {
-	enum ChunkMesh
-	{
-		MeshGreedy = 0,
-		MeshSimple = 1
-	};
-
+	/// <summary>
+	/// A component that holds a block of voxels, it is generated and meshed by jobs on the worker threads.
+	/// </summary>
 	class F_EXPORT Chunk :
 		public Component
 	{
 	private:
-		std::vector<std::vector<std::vector<Block*>>> *m_blocks;
+		ChunkStorage *m_blocks;
 		ChunkMesh m_chunkMesh;
 		bool m_generate;
 		bool m_rebuild;
+		bool m_modified;
+		uint32_t m_version;
+		int m_lod;
+
+		int m_chunkX;
+		int m_chunkY;
+		int m_chunkZ;
+		bool m_registered;
+
+		ChunkMesher *m_mesher;
+		std::future<void> m_job;
 	public:
 		static const int CHUNK_WIDTH;
 		static const int CHUNK_HEIGHT;
 		static const float VOXEL_SIZE;
 		static const Vector3 *CHUNK_SIZE;
+		static const int MAX_LOD;
 
 		Chunk(const ChunkMesh &chunkMesh = MeshGreedy, const bool &generate = false);
 
@@ -38,28 +50,116 @@ namespace Flounder
 
 		std::string GetName() const override { return "Chunk"; };
 
-		Block *GetBlock(const int &x, const int &y, const int &z);
-
-		bool IsBlockFilled(const int &x, const int &y, const int &z);
-
-		bool IsFaceVisible(const int &x, const int &y, const int &z, const BlockFace &faceType);
-
-		void Rebuild() { m_rebuild = true; }
+		/// <summary>
+		/// Gets the block id of a voxel in this chunk.
+		/// </summary>
+		/// <param name="x"> The voxels x position in the chunk. </param>
+		/// <param name="y"> The voxels y position in the chunk. </param>
+		/// <param name="z"> The voxels z position in the chunk. </param>
+		/// <returns> The block id, air if the position is outside of the chunk. </returns>
+		BlockId GetBlock(const int &x, const int &y, const int &z) const;
+
+		/// <summary>
+		/// Sets the block id of a voxel in this chunk and marks the chunk to be rebuilt.
+		/// </summary>
+		/// <param name="x"> The voxels x position in the chunk. </param>
+		/// <param name="y"> The voxels y position in the chunk. </param>
+		/// <param name="z"> The voxels z position in the chunk. </param>
+		/// <param name="id"> The block id. </param>
+		void SetBlock(const int &x, const int &y, const int &z, const BlockId &id);
+
+		/// <summary>
+		/// Gets if a voxel is filled, positions one voxel outside of the chunk are looked up in the neighbouring chunk.
+		/// </summary>
+		/// <param name="x"> The voxels x position in the chunk. </param>
+		/// <param name="y"> The voxels y position in the chunk. </param>
+		/// <param name="z"> The voxels z position in the chunk. </param>
+		/// <returns> If the voxel is filled. </returns>
+		bool IsBlockFilled(const int &x, const int &y, const int &z) const;
+
+		bool IsFaceVisible(const int &x, const int &y, const int &z, const BlockFace &faceType) const;
+
+		ChunkStorage *GetStorage() const { return m_blocks; }
+
+		/// <summary>
+		/// Gets the loaded chunk that touches a side of this chunk.
+		/// </summary>
+		/// <param name="face"> The side of this chunk. </param>
+		/// <returns> The neighbour, or nullptr if it is not loaded. </returns>
+		Chunk *GetNeighbour(const BlockFace &face) const;
+
+		/// <summary>
+		/// Moves a pooled or new chunk to a chunk coordinate, clearing its voxels and mesh and queuing it to be generated.
+		/// </summary>
+		/// <param name="x"> The chunks x coordinate, in chunks. </param>
+		/// <param name="y"> The chunks y coordinate, in chunks. </param>
+		/// <param name="z"> The chunks z coordinate, in chunks. </param>
+		void Reset(const int &x, const int &y, const int &z);
+
+		/// <summary>
+		/// Removes the chunk from the chunk map and frees its mesh, so it can be kept in a pool.
+		/// Edited chunks are saved to their region file first.
+		/// </summary>
+		void Unload();
+
+		/// <summary>
+		/// Queues the chunk to be written to its region file if it was edited since it was loaded.
+		/// </summary>
+		void Save();
+
+		bool IsGenerated() const { return !m_generate; }
+
+		bool IsModified() const { return m_modified; }
+
+		/// <summary>
+		/// Gets if a job is building or still holding a mesh for this chunk, busy chunks can not be reset or unloaded.
+		/// </summary>
+		/// <returns> If the chunk is busy. </returns>
+		bool IsBusy() const { return m_mesher != nullptr; }
+
+		int GetChunkX() const { return m_chunkX; }
+
+		int GetChunkY() const { return m_chunkY; }
+
+		int GetChunkZ() const { return m_chunkZ; }
+
+		/// <summary>
+		/// Marks the chunk to be meshed again, any mesh still being built is discarded once it finishes.
+		/// </summary>
+		void Rebuild();
+
+		uint32_t GetVersion() const { return m_version; }
+
+		int GetLod() const { return m_lod; }
+
+		/// <summary>
+		/// Sets the level of detail the chunk is meshed at, each level doubles the size of the cells it is meshed from.
+		/// Neighbours are rebuilt too, faces are not culled across chunks meshed at different levels so the seam is closed.
+		/// </summary>
+		/// <param name="lod"> The level of detail, from 0 to MAX_LOD. </param>
+		void SetLod(const int &lod);
+
+		/// <summary>
+		/// Gets the index of a voxel in the flat storage, voxels are laid out in x, then z, then y order.
+		/// </summary>
+		/// <param name="x"> The voxels x position in the chunk. </param>
+		/// <param name="y"> The voxels y position in the chunk. </param>
+		/// <param name="z"> The voxels z position in the chunk. </param>
+		/// <returns> The voxels index. </returns>
+		static uint32_t GetIndex(const int &x, const int &y, const int &z) { return x + CHUNK_WIDTH * (z + CHUNK_WIDTH * y); }
+
+		/// <summary>
+		/// Gets the position of a voxel in the chunk from its index in the flat storage.
+		/// </summary>
+		/// <param name="index"> The voxels index. </param>
+		/// <returns> The voxels position, in voxels. </returns>
+		static Vector3 GetPosition(const uint32_t &index);
 
 	private:
-		void Generate();
-
-		void GenerateMesh();
-
-		void CreateSimpleMesh(std::vector<IVertex*> *vertices, std::vector<uint32_t> *indices);
-
-		void CreateGreedyMesh(std::vector<IVertex*> *vertices, std::vector<uint32_t> *indices);
+		void RebuildNeighbours(const int &x, const int &y, const int &z);
 
-		std::string GetVoxelFace(const int &x, const int &y, const int &z, const BlockFace &faceType);
+		void StartJob();
 
-		void GenerateQuad(std::vector<IVertex*> *vertices, std::vector<uint32_t> *indices,
-						  const Vector3 &bottomLeft, const Vector3 &topLeft, const Vector3 &topRight, const Vector3 &bottomRight,
-						  const int &width, const int &height,
-						  const std::string &blockType, const bool &backFace);
+		void FinishJob();
 	};
 }
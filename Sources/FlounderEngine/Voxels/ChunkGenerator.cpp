@@ -0,0 +1,288 @@
+#include "ChunkGenerator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include "Chunk.hpp"
+
+namespace Flounder
+{
+	const int CAVE_STEP = 4;
+
+	ChunkGenerator::ChunkGenerator(const int &seed) :
+		m_seed(seed),
+		m_caveThreshold(0.4f),
+		m_biomes(std::vector<Biome>()),
+		m_ores(std::vector<OreLayer>()),
+		m_noises(std::unordered_map<std::thread::id, GeneratorNoise *>()),
+		m_noiseMutex(),
+		m_generated(0),
+		m_generateTime(0),
+		m_chunksPerSecond(0.0f),
+		m_averageTime(0.0f)
+	{
+		const BlockId grass = Block::Find("Grass");
+		const BlockId dirt = Block::Find("Dirt");
+		const BlockId stone = Block::Find("Stone");
+		const BlockId sand = Block::Find("Sand");
+		const BlockId snow = Block::Find("Snow");
+
+		AddBiome({"Plains", grass, dirt, 3, 8.0f, 12.0f, 0.0f, 0.2f});
+		AddBiome({"Desert", sand, sand, 4, 4.0f, 6.0f, 0.7f, -0.6f});
+		AddBiome({"Mountains", stone, stone, 1, 24.0f, 40.0f, -0.3f, -0.2f});
+		AddBiome({"Tundra", snow, dirt, 2, 12.0f, 16.0f, -0.8f, 0.4f});
+
+		AddOre({Block::Find("Coal Ore"), -64, 48, 0.012f});
+		AddOre({Block::Find("Iron Ore"), -128, 16, 0.006f});
+	}
+
+	ChunkGenerator::~ChunkGenerator()
+	{
+		for (auto &noise : m_noises)
+		{
+			delete noise.second->height;
+			delete noise.second->temperature;
+			delete noise.second->moisture;
+			delete noise.second->caves;
+			delete noise.second->ores;
+			delete noise.second;
+		}
+	}
+
+	void ChunkGenerator::Generate(ChunkStorage *blocks, const int &x, const int &y, const int &z)
+	{
+		const auto timeStart = std::chrono::high_resolution_clock::now();
+		const GeneratorNoise &noise = *GetNoise();
+
+		const int width = Chunk::CHUNK_WIDTH;
+		const int height = Chunk::CHUNK_HEIGHT;
+		const int originX = x * width;
+		const int originY = y * height;
+		const int originZ = z * width;
+
+		// Heightmap pass, the 2D noise is filled for the whole chunk at once then every column finds its biome and surface height.
+		std::vector<float> temperatures = std::vector<float>(width * width);
+		std::vector<float> moistures = std::vector<float>(width * width);
+		std::vector<float> values = std::vector<float>(width * width);
+		noise.temperature->FillNoiseSet(temperatures.data(), static_cast<float>(originX), static_cast<float>(originZ), width, width);
+		noise.moisture->FillNoiseSet(moistures.data(), static_cast<float>(originX), static_cast<float>(originZ), width, width);
+		noise.height->FillNoiseSet(values.data(), static_cast<float>(originX), static_cast<float>(originZ), width, width);
+
+		std::vector<int> heights = std::vector<int>(width * width);
+		std::vector<uint32_t> biomes = std::vector<uint32_t>(width * width);
+		int maxHeight = std::numeric_limits<int>::min();
+
+		for (int column = 0; column < width * width; column++)
+		{
+			const float surface = GetHeight(temperatures[column], moistures[column], values[column], &biomes[column]);
+			heights[column] = static_cast<int>(std::floor(surface));
+			maxHeight = std::max(maxHeight, heights[column]);
+		}
+
+		// Chunks above the terrain are air, so the 3D passes are skipped.
+		if (originY > maxHeight || m_biomes.empty())
+		{
+			blocks->Fill(BLOCK_AIR);
+			blocks->Compact();
+			m_generated++;
+			m_generateTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - timeStart).count();
+			return;
+		}
+
+		// Density pass, caves change slowly so they are sampled on a coarse lattice and interpolated per voxel.
+		const int latticeWidth = width / CAVE_STEP + 1;
+		const int latticeHeight = height / CAVE_STEP + 1;
+		std::vector<float> lattice = std::vector<float>(latticeWidth * latticeWidth * latticeHeight);
+		noise.caves->FillNoiseSet(lattice.data(), static_cast<float>(originX), static_cast<float>(originY), static_cast<float>(originZ),
+			latticeWidth, latticeHeight, latticeWidth, static_cast<float>(CAVE_STEP));
+
+		auto getDensity = [&lattice, latticeWidth, latticeHeight](const int &i, const int &j, const int &k)
+		{
+			const int li = i / CAVE_STEP;
+			const int lj = j / CAVE_STEP;
+			const int lk = k / CAVE_STEP;
+			const float fi = static_cast<float>(i % CAVE_STEP) / static_cast<float>(CAVE_STEP);
+			const float fj = static_cast<float>(j % CAVE_STEP) / static_cast<float>(CAVE_STEP);
+			const float fk = static_cast<float>(k % CAVE_STEP) / static_cast<float>(CAVE_STEP);
+
+			auto sample = [&lattice, latticeWidth, latticeHeight](const int &a, const int &b, const int &c)
+			{
+				return lattice[a + latticeWidth * (b + latticeHeight * c)];
+			};
+
+			const float x00 = sample(li, lj, lk) + fi * (sample(li + 1, lj, lk) - sample(li, lj, lk));
+			const float x10 = sample(li, lj + 1, lk) + fi * (sample(li + 1, lj + 1, lk) - sample(li, lj + 1, lk));
+			const float x01 = sample(li, lj, lk + 1) + fi * (sample(li + 1, lj, lk + 1) - sample(li, lj, lk + 1));
+			const float x11 = sample(li, lj + 1, lk + 1) + fi * (sample(li + 1, lj + 1, lk + 1) - sample(li, lj + 1, lk + 1));
+			const float y0 = x00 + fj * (x10 - x00);
+			const float y1 = x01 + fj * (x11 - x01);
+			return y0 + fk * (y1 - y0);
+		};
+
+		// Fill pass, biome layers down from the surface with caves carved out of them.
+		const BlockId stone = Block::Find("Stone");
+		std::vector<BlockId> voxels = std::vector<BlockId>(blocks->GetSize());
+		uint32_t filled = 0;
+
+		for (int j = 0; j < height; j++)
+		{
+			for (int k = 0; k < width; k++)
+			{
+				for (int i = 0; i < width; i++)
+				{
+					const int column = i + width * k;
+					const int depth = heights[column] - (originY + j);
+
+					if (depth < 0 || getDensity(i, j, k) > m_caveThreshold)
+					{
+						continue;
+					}
+
+					const Biome &biome = m_biomes[biomes[column]];
+					BlockId id = stone;
+
+					if (depth == 0)
+					{
+						id = biome.surface;
+					}
+					else if (depth <= biome.fillerDepth)
+					{
+						id = biome.filler;
+					}
+
+					voxels[i + width * (k + width * j)] = id;
+					filled++;
+				}
+			}
+		}
+
+		// Ore pass, white noise is hashed from the voxel so ores are the same however chunks are loaded.
+		for (uint32_t o = 0; o < m_ores.size(); o++)
+		{
+			const OreLayer &ore = m_ores[o];
+
+			if (originY + height <= ore.minHeight || originY > ore.maxHeight)
+			{
+				continue;
+			}
+
+			for (uint32_t index = 0; index < voxels.size(); index++)
+			{
+				if (voxels[index] != stone)
+				{
+					continue;
+				}
+
+				const Vector3 position = Chunk::GetPosition(index);
+				const int worldY = originY + static_cast<int>(position.m_y);
+
+				if (worldY < ore.minHeight || worldY > ore.maxHeight)
+				{
+					continue;
+				}
+
+				const float value = noise.ores->GetWhiteNoiseInt(originX + static_cast<int>(position.m_x) + 7919 * static_cast<int>(o), worldY,
+					originZ + static_cast<int>(position.m_z));
+
+				if (0.5f * (value + 1.0f) < ore.chance)
+				{
+					voxels[index] = ore.block;
+				}
+			}
+		}
+
+		// Fills with whichever of air or stone is most common, then only the voxels that differ are set.
+		const BlockId fill = 2 * filled > voxels.size() ? stone : BLOCK_AIR;
+		blocks->Fill(fill);
+
+		for (uint32_t index = 0; index < voxels.size(); index++)
+		{
+			if (voxels[index] != fill)
+			{
+				blocks->Set(index, voxels[index]);
+			}
+		}
+
+		blocks->Compact();
+
+		m_generated++;
+		m_generateTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - timeStart).count();
+	}
+
+	uint32_t ChunkGenerator::SampleThroughput(const float &interval)
+	{
+		const uint32_t generated = m_generated.exchange(0);
+		const uint64_t generateTime = m_generateTime.exchange(0);
+
+		m_chunksPerSecond = interval > 0.0f ? static_cast<float>(generated) / interval : 0.0f;
+		m_averageTime = generated != 0 ? static_cast<float>(generateTime) / (1000.0f * static_cast<float>(generated)) : 0.0f;
+		return generated;
+	}
+
+	ChunkGenerator::GeneratorNoise *ChunkGenerator::GetNoise()
+	{
+		std::unique_lock<std::mutex> lock(m_noiseMutex);
+		auto it = m_noises.find(std::this_thread::get_id());
+
+		if (it != m_noises.end())
+		{
+			return it->second;
+		}
+
+		// Worker threads live as long as the pool, so this only happens once per thread.
+		GeneratorNoise *noise = new GeneratorNoise();
+
+		noise->height = new NoiseFast(m_seed);
+		noise->height->SetNoiseType(NoiseFast::SimplexFractal);
+		noise->height->SetFrequency(0.008f);
+		noise->height->SetFractalOctaves(4);
+
+		noise->temperature = new NoiseFast(m_seed + 1);
+		noise->temperature->SetNoiseType(NoiseFast::Simplex);
+		noise->temperature->SetFrequency(0.0015f);
+
+		noise->moisture = new NoiseFast(m_seed + 2);
+		noise->moisture->SetNoiseType(NoiseFast::Simplex);
+		noise->moisture->SetFrequency(0.0015f);
+
+		noise->caves = new NoiseFast(m_seed + 3);
+		noise->caves->SetNoiseType(NoiseFast::SimplexFractal);
+		noise->caves->SetFrequency(0.03f);
+		noise->caves->SetFractalOctaves(2);
+
+		noise->ores = new NoiseFast(m_seed + 4);
+		noise->ores->SetNoiseType(NoiseFast::WhiteNoise);
+
+		m_noises.emplace(std::this_thread::get_id(), noise);
+		return noise;
+	}
+
+	float ChunkGenerator::GetHeight(const float &temperature, const float &moisture, const float &value, uint32_t *biome) const
+	{
+		// Every biome is weighted by how close its climate is, so heights blend across borders without seams.
+		float totalWeight = 0.0f;
+		float totalHeight = 0.0f;
+		float maxWeight = 0.0f;
+		*biome = 0;
+
+		for (uint32_t i = 0; i < m_biomes.size(); i++)
+		{
+			const float dt = temperature - m_biomes[i].temperature;
+			const float dm = moisture - m_biomes[i].moisture;
+			const float distance = dt * dt + dm * dm;
+			const float weight = 1.0f / (distance * distance + 0.0001f);
+
+			totalWeight += weight;
+			totalHeight += weight * (m_biomes[i].height + m_biomes[i].amplitude * value);
+
+			if (weight > maxWeight)
+			{
+				maxWeight = weight;
+				*biome = i;
+			}
+		}
+
+		return totalWeight != 0.0f ? totalHeight / totalWeight : 0.0f;
+	}
+}
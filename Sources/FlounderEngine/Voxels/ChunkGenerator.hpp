@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../Maths/Noise/NoiseFast.hpp"
+#include "ChunkStorage.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// A climate the terrain can have, columns take the surface of the nearest biome and a blend of every biomes height.
+	/// </summary>
+	struct Biome
+	{
+		std::string name;
+		BlockId surface;
+		BlockId filler;
+		int fillerDepth;
+		float height;
+		float amplitude;
+		float temperature;
+		float moisture;
+	};
+
+	/// <summary>
+	/// An ore scattered through stone between two heights, the chance is per stone voxel.
+	/// </summary>
+	struct OreLayer
+	{
+		BlockId block;
+		int minHeight;
+		int maxHeight;
+		float chance;
+	};
+
+	/// <summary>
+	/// Generates the voxels of chunks from noise, it is safe to call from any number of worker threads.
+	/// Each thread gets its own noise, a chunk is generated as passes over the whole chunk: a 2D pass that finds every
+	/// columns biome and height, a 3D pass that samples cave density on a coarse lattice and interpolates it, then the
+	/// fill and ore passes. Biomes and ores should be added before chunks are generated.
+	/// </summary>
+	class F_EXPORT ChunkGenerator
+	{
+	private:
+		struct GeneratorNoise
+		{
+			NoiseFast *height;
+			NoiseFast *temperature;
+			NoiseFast *moisture;
+			NoiseFast *caves;
+			NoiseFast *ores;
+		};
+
+		int m_seed;
+		float m_caveThreshold;
+
+		std::vector<Biome> m_biomes;
+		std::vector<OreLayer> m_ores;
+
+		std::unordered_map<std::thread::id, GeneratorNoise *> m_noises;
+		std::mutex m_noiseMutex;
+
+		std::atomic<uint32_t> m_generated;
+		std::atomic<uint64_t> m_generateTime;
+		float m_chunksPerSecond;
+		float m_averageTime;
+	public:
+		/// <summary>
+		/// Creates a new chunk generator with the default biomes and ores.
+		/// </summary>
+		/// <param name="seed"> The seed all noise is made from. </param>
+		ChunkGenerator(const int &seed = 954627);
+
+		~ChunkGenerator();
+
+		/// <summary>
+		/// Generates the voxels of a chunk.
+		/// </summary>
+		/// <param name="blocks"> The storage to generate into. </param>
+		/// <param name="x"> The chunks x coordinate, in chunks. </param>
+		/// <param name="y"> The chunks y coordinate, in chunks. </param>
+		/// <param name="z"> The chunks z coordinate, in chunks. </param>
+		void Generate(ChunkStorage *blocks, const int &x, const int &y, const int &z);
+
+		/// <summary>
+		/// Takes the chunks generated since the last sample and works out the throughput.
+		/// </summary>
+		/// <param name="interval"> The time since the last sample, in seconds. </param>
+		/// <returns> The number of chunks generated since the last sample. </returns>
+		uint32_t SampleThroughput(const float &interval);
+
+		/// <summary>
+		/// Gets the number of chunks generated per second, over the last sampled interval.
+		/// </summary>
+		/// <returns> The generation throughput. </returns>
+		float GetChunksPerSecond() const { return m_chunksPerSecond; }
+
+		/// <summary>
+		/// Gets the time a worker took to generate a chunk on average, over the last sampled interval.
+		/// </summary>
+		/// <returns> The time per chunk, in milliseconds. </returns>
+		float GetAverageTime() const { return m_averageTime; }
+
+		int GetSeed() const { return m_seed; }
+
+		void AddBiome(const Biome &biome) { m_biomes.push_back(biome); }
+
+		std::vector<Biome> GetBiomes() const { return m_biomes; }
+
+		void AddOre(const OreLayer &ore) { m_ores.push_back(ore); }
+
+		std::vector<OreLayer> GetOres() const { return m_ores; }
+
+		float GetCaveThreshold() const { return m_caveThreshold; }
+
+		void SetCaveThreshold(const float &caveThreshold) { m_caveThreshold = caveThreshold; }
+	private:
+		GeneratorNoise *GetNoise();
+
+		float GetHeight(const float &temperature, const float &moisture, const float &value, uint32_t *biome) const;
+	};
+}
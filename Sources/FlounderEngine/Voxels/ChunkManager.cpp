@@ -0,0 +1,250 @@
+#include "ChunkManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "../Meshes/Mesh.hpp"
+#include "../Scenes/Scenes.hpp"
+#include "VoxelRender.hpp"
+#include "Voxels.hpp"
+
+namespace Flounder
+{
+	ChunkManager::ChunkManager(const int &radius, const uint32_t &loadsPerFrame, const float &lodDistance) :
+		Component(),
+		m_radius(radius),
+		m_loadsPerFrame(loadsPerFrame),
+		m_lodDistance(lodDistance),
+		m_loaded(std::vector<GameObject *>()),
+		m_pool(std::vector<GameObject *>()),
+		m_candidates(std::vector<ChunkCandidate>()),
+		m_centreX(0),
+		m_centreY(0),
+		m_centreZ(0),
+		m_scan(true),
+		m_unload(false)
+	{
+	}
+
+	ChunkManager::~ChunkManager()
+	{
+		// Loaded chunks belong to the scene structure, pooled chunks are only owned here.
+		for (auto object : m_pool)
+		{
+			delete object;
+		}
+	}
+
+	void ChunkManager::Update()
+	{
+		auto camera = Scenes::Get()->GetCamera();
+
+		if (camera == nullptr)
+		{
+			return;
+		}
+
+		const Vector3 position = *camera->GetPosition();
+		const int centreX = static_cast<int>(std::floor(position.m_x / Chunk::CHUNK_SIZE->m_x));
+		const int centreY = static_cast<int>(std::floor(position.m_y / Chunk::CHUNK_SIZE->m_y));
+		const int centreZ = static_cast<int>(std::floor(position.m_z / Chunk::CHUNK_SIZE->m_z));
+
+		if (centreX != m_centreX || centreY != m_centreY || centreZ != m_centreZ)
+		{
+			m_centreX = centreX;
+			m_centreY = centreY;
+			m_centreZ = centreZ;
+			m_scan = true;
+			m_unload = true;
+			UpdateLods();
+		}
+
+		if (m_unload)
+		{
+			m_unload = UnloadFar();
+		}
+
+		if (!m_scan)
+		{
+			return;
+		}
+
+		// The camera looks down its views negative z axis.
+		const Matrix4 &view = *camera->GetViewMatrix();
+		const Vector3 forward = Vector3(-view.m_02, -view.m_12, -view.m_22);
+		ScanCandidates(forward);
+
+		const uint32_t loads = std::min(m_loadsPerFrame, static_cast<uint32_t>(m_candidates.size()));
+
+		for (uint32_t i = 0; i < loads; i++)
+		{
+			const ChunkCandidate &candidate = m_candidates.at(i);
+			LoadChunk(candidate.x, candidate.y, candidate.z);
+		}
+
+		// Once nothing is missing the radius is not scanned again until the camera changes chunk.
+		m_scan = m_candidates.size() > loads;
+	}
+
+	void ChunkManager::Load(LoadedValue *value)
+	{
+	}
+
+	void ChunkManager::Write(LoadedValue *value)
+	{
+	}
+
+	void ChunkManager::SetRadius(const int &radius)
+	{
+		m_radius = radius;
+		m_scan = true;
+		m_unload = true;
+	}
+
+	void ChunkManager::SetLodDistance(const float &lodDistance)
+	{
+		m_lodDistance = lodDistance;
+		UpdateLods();
+	}
+
+	bool ChunkManager::UnloadFar()
+	{
+		// Chunks are kept one chunk past the radius, so moving along a border does not thrash them.
+		const int unloadRadius = m_radius + 1;
+		bool busy = false;
+
+		for (auto it = m_loaded.begin(); it != m_loaded.end();)
+		{
+			Chunk *chunk = (*it)->GetComponent<Chunk>();
+			const int dx = chunk->GetChunkX() - m_centreX;
+			const int dy = chunk->GetChunkY() - m_centreY;
+			const int dz = chunk->GetChunkZ() - m_centreZ;
+
+			if (dx * dx + dy * dy + dz * dz <= unloadRadius * unloadRadius)
+			{
+				++it;
+				continue;
+			}
+
+			// Busy chunks are left until their job finishes and retried on the next update.
+			if (chunk->IsBusy())
+			{
+				busy = true;
+				++it;
+				continue;
+			}
+
+			chunk->Unload();
+			(*it)->StructureRemove();
+			m_pool.push_back(*it);
+			it = m_loaded.erase(it);
+		}
+
+		return busy;
+	}
+
+	void ChunkManager::UpdateLods()
+	{
+		for (auto object : m_loaded)
+		{
+			Chunk *chunk = object->GetComponent<Chunk>();
+			chunk->SetLod(GetLod(chunk->GetChunkX(), chunk->GetChunkY(), chunk->GetChunkZ(), chunk->GetLod()));
+		}
+	}
+
+	int ChunkManager::GetLod(const int &x, const int &y, const int &z, const int &current) const
+	{
+		const int dx = x - m_centreX;
+		const int dy = y - m_centreY;
+		const int dz = z - m_centreZ;
+		const float distance = std::sqrt(static_cast<float>(dx * dx + dy * dy + dz * dz));
+
+		int lod = 0;
+		float threshold = m_lodDistance;
+
+		while (lod < Chunk::MAX_LOD && distance >= threshold)
+		{
+			lod++;
+			threshold *= 2.0f;
+		}
+
+		// Chunks only gain detail once they are a chunk inside the threshold, so moving along a threshold does not keep remeshing them.
+		if (lod < current && distance >= m_lodDistance * static_cast<float>(1 << (current - 1)) - 1.0f)
+		{
+			return current;
+		}
+
+		return lod;
+	}
+
+	void ChunkManager::ScanCandidates(const Vector3 &forward)
+	{
+		m_candidates.clear();
+
+		for (int x = -m_radius; x <= m_radius; x++)
+		{
+			for (int y = -m_radius; y <= m_radius; y++)
+			{
+				for (int z = -m_radius; z <= m_radius; z++)
+				{
+					const int distanceSquared = x * x + y * y + z * z;
+
+					if (distanceSquared > m_radius * m_radius ||
+						Voxels::Get()->GetChunk(m_centreX + x, m_centreY + y, m_centreZ + z) != nullptr)
+					{
+						continue;
+					}
+
+					// Chunks in front of the camera are treated as up to half as far away, chunks behind as half again as far.
+					const float distance = std::sqrt(static_cast<float>(distanceSquared));
+					float facing = 0.0f;
+
+					if (distance > 0.0f)
+					{
+						facing = (forward.m_x * x + forward.m_y * y + forward.m_z * z) / distance;
+					}
+
+					ChunkCandidate candidate = {};
+					candidate.x = m_centreX + x;
+					candidate.y = m_centreY + y;
+					candidate.z = m_centreZ + z;
+					candidate.priority = distance * (1.0f - 0.5f * facing);
+					m_candidates.push_back(candidate);
+				}
+			}
+		}
+
+		std::sort(m_candidates.begin(), m_candidates.end(), [](const ChunkCandidate &a, const ChunkCandidate &b)
+		{
+			return a.priority < b.priority;
+		});
+	}
+
+	void ChunkManager::LoadChunk(const int &x, const int &y, const int &z)
+	{
+		const Vector3 position = *Chunk::CHUNK_SIZE * Vector3(x, y, z);
+		GameObject *object;
+
+		if (!m_pool.empty())
+		{
+			object = m_pool.back();
+			m_pool.pop_back();
+			object->SetTransform(Transform(position));
+			object->StructureSwitch(Scenes::Get()->GetStructure());
+		}
+		else
+		{
+			object = new GameObject(Transform(position));
+			object->AddComponent(new Chunk(MeshGreedy, false));
+			object->AddComponent(new Mesh());
+			object->AddComponent(new VoxelRender());
+		}
+
+		object->SetName("Chunk," + std::to_string(x) + "," + std::to_string(y) + "," + std::to_string(z));
+
+		// The level is set before the chunk is registered, so it does not rebuild the neighbours of its last position.
+		Chunk *chunk = object->GetComponent<Chunk>();
+		chunk->SetLod(GetLod(x, y, z, 0));
+		chunk->Reset(x, y, z);
+		m_loaded.push_back(object);
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include "../Objects/Component.hpp"
+#include "../Objects/GameObject.hpp"
+#include "Chunk.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// A component that streams an unbounded voxel world around the camera.
+	/// Missing chunks inside the load radius are created nearest first, favouring chunks in front of the camera, with a per update budget.
+	/// Chunks past the radius are unloaded into a pool and reused, so their storage, uniforms and descriptors are not reallocated.
+	/// Chunks are meshed at a coarser level of detail each time their distance doubles past the lod distance.
+	/// </summary>
+	class F_EXPORT ChunkManager :
+		public Component
+	{
+	private:
+		struct ChunkCandidate
+		{
+			int x;
+			int y;
+			int z;
+			float priority;
+		};
+
+		int m_radius;
+		uint32_t m_loadsPerFrame;
+		float m_lodDistance;
+
+		std::vector<GameObject *> m_loaded;
+		std::vector<GameObject *> m_pool;
+		std::vector<ChunkCandidate> m_candidates;
+
+		int m_centreX;
+		int m_centreY;
+		int m_centreZ;
+		bool m_scan;
+		bool m_unload;
+	public:
+		/// <summary>
+		/// Creates a new chunk manager.
+		/// </summary>
+		/// <param name="radius"> The radius around the camera that is kept loaded, in chunks. </param>
+		/// <param name="loadsPerFrame"> How many chunks can be queued for generation each update. </param>
+		/// <param name="lodDistance"> The distance full detail chunks are kept within, in chunks. </param>
+		ChunkManager(const int &radius = 6, const uint32_t &loadsPerFrame = 4, const float &lodDistance = 2.0f);
+
+		~ChunkManager();
+
+		void Update() override;
+
+		void Load(LoadedValue *value) override;
+
+		void Write(LoadedValue *value) override;
+
+		std::string GetName() const override { return "ChunkManager"; };
+
+		int GetRadius() const { return m_radius; }
+
+		void SetRadius(const int &radius);
+
+		uint32_t GetLoadsPerFrame() const { return m_loadsPerFrame; }
+
+		void SetLoadsPerFrame(const uint32_t &loadsPerFrame) { m_loadsPerFrame = loadsPerFrame; }
+
+		float GetLodDistance() const { return m_lodDistance; }
+
+		void SetLodDistance(const float &lodDistance);
+
+		uint32_t GetLoadedCount() const { return static_cast<uint32_t>(m_loaded.size()); }
+
+		uint32_t GetPooledCount() const { return static_cast<uint32_t>(m_pool.size()); }
+	private:
+		bool UnloadFar();
+
+		void UpdateLods();
+
+		int GetLod(const int &x, const int &y, const int &z, const int &current) const;
+
+		void ScanCandidates(const Vector3 &forward);
+
+		void LoadChunk(const int &x, const int &y, const int &z);
+	};
+}
@@ -0,0 +1,617 @@
+#include "ChunkMesher.hpp"
+
+#include <algorithm>
+#include "Chunk.hpp"
+
+namespace Flounder
+{
+	ChunkMesher::ChunkMesher(ChunkStorage *blocks, const ChunkMesh &chunkMesh, const uint32_t &version, const int &lod) :
+		m_blocks(blocks),
+		m_chunkMesh(chunkMesh),
+		m_version(version),
+		m_lod(lod),
+		m_scale(1 << lod),
+		m_width(Chunk::CHUNK_WIDTH >> lod),
+		m_height(Chunk::CHUNK_HEIGHT >> lod),
+		m_cells(std::vector<BlockId>()),
+		m_borders(),
+		m_vertices(std::vector<VoxelVertex>()),
+		m_minExtents(Vector3()),
+		m_maxExtents(Vector3())
+	{
+	}
+
+	ChunkMesher::~ChunkMesher()
+	{
+		delete m_blocks;
+	}
+
+	void ChunkMesher::SetBorder(const BlockFace &face, const ChunkStorage &neighbour)
+	{
+		// The neighbours layer of cells that touches this chunk, given in the neighbours own cell space.
+		int fixed;
+
+		switch (face)
+		{
+		case FaceLeft:
+		case FaceFront:
+			fixed = m_width - 1;
+			break;
+		case FaceDown:
+			fixed = m_height - 1;
+			break;
+		default:
+			fixed = 0;
+			break;
+		}
+
+		std::vector<BlockId> &border = m_borders[face];
+		border.resize(m_width * m_height);
+
+		for (int a = 0; a < m_width; a++)
+		{
+			for (int b = 0; b < m_width; b++)
+			{
+				switch (face)
+				{
+				case FaceLeft:
+				case FaceRight:
+					if (b < m_height)
+					{
+						border[GetBorderIndex(face, fixed, b, a)] = GetCell(neighbour, fixed, b, a, m_scale);
+					}
+					break;
+				case FaceUp:
+				case FaceDown:
+					border[GetBorderIndex(face, a, fixed, b)] = GetCell(neighbour, a, fixed, b, m_scale);
+					break;
+				case FaceFront:
+				case FaceBack:
+					if (b < m_height)
+					{
+						border[GetBorderIndex(face, a, b, fixed)] = GetCell(neighbour, a, b, fixed, m_scale);
+					}
+					break;
+				}
+			}
+		}
+	}
+
+	void ChunkMesher::Build()
+	{
+		// Coarser levels of detail are meshed from cells of several voxels, each standing in for the voxels it covers.
+		m_cells.resize(m_width * m_width * m_height);
+
+		for (int y = 0; y < m_height; y++)
+		{
+			for (int z = 0; z < m_width; z++)
+			{
+				for (int x = 0; x < m_width; x++)
+				{
+					m_cells[x + m_width * (z + m_width * y)] = GetCell(*m_blocks, x, y, z, m_scale);
+				}
+			}
+		}
+
+		switch (m_chunkMesh)
+		{
+		case MeshGreedy:
+			CreateGreedyMesh();
+			break;
+		case MeshSimple:
+			CreateSimpleMesh();
+			break;
+		}
+	}
+
+	Model *ChunkMesher::CreateModel(const std::string &name)
+	{
+		if (m_vertices.empty())
+		{
+			return nullptr;
+		}
+
+		const ColliderAabb aabb = ColliderAabb(Chunk::VOXEL_SIZE * m_minExtents, Chunk::VOXEL_SIZE * m_maxExtents);
+		Model *model = new Model(m_vertices.data(), sizeof(VoxelVertex), m_vertices.size(), aabb, name);
+		m_vertices.clear();
+		return model;
+	}
+
+	BlockId ChunkMesher::GetCell(const ChunkStorage &blocks, const int &x, const int &y, const int &z, const int &scale)
+	{
+		if (scale == 1)
+		{
+			return blocks.Get(Chunk::GetIndex(x, y, z));
+		}
+
+		// A cell is filled when at least half of its voxels are, it takes the most common block among them.
+		BlockId ids[8];
+		int counts[8];
+		int types = 0;
+		int filled = 0;
+
+		for (int j = y * scale; j < (y + 1) * scale; j++)
+		{
+			for (int k = z * scale; k < (z + 1) * scale; k++)
+			{
+				for (int i = x * scale; i < (x + 1) * scale; i++)
+				{
+					const BlockId id = blocks.Get(Chunk::GetIndex(i, j, k));
+
+					if (!Block::IsFilled(id))
+					{
+						continue;
+					}
+
+					filled++;
+					int type = 0;
+
+					while (type < types && ids[type] != id)
+					{
+						type++;
+					}
+
+					if (type == types)
+					{
+						// Past eight kinds of block the rarer ones are not counted.
+						if (types == 8)
+						{
+							continue;
+						}
+
+						ids[types] = id;
+						counts[types] = 0;
+						types++;
+					}
+
+					counts[type]++;
+				}
+			}
+		}
+
+		if (2 * filled < scale * scale * scale)
+		{
+			return BLOCK_AIR;
+		}
+
+		int common = 0;
+
+		for (int type = 1; type < types; type++)
+		{
+			if (counts[type] > counts[common])
+			{
+				common = type;
+			}
+		}
+
+		return ids[common];
+	}
+
+	BlockId ChunkMesher::GetBlock(const int &x, const int &y, const int &z) const
+	{
+		if (x >= 0 && x < m_width && z >= 0 && z < m_width && y >= 0 && y < m_height)
+		{
+			return m_cells[x + m_width * (z + m_width * y)];
+		}
+
+		return BLOCK_AIR;
+	}
+
+	bool ChunkMesher::IsBlockFilled(const int &x, const int &y, const int &z) const
+	{
+		if (x >= 0 && x < m_width && z >= 0 && z < m_width && y >= 0 && y < m_height)
+		{
+			return Block::IsFilled(m_cells[x + m_width * (z + m_width * y)]);
+		}
+
+		// Only the neighbours sharing a face are known, cells past an edge or corner of the chunk are treated as empty.
+		const int outside = (x < 0 || x >= m_width) + (y < 0 || y >= m_height) + (z < 0 || z >= m_width);
+
+		if (outside > 1)
+		{
+			return false;
+		}
+
+		BlockFace face;
+
+		if (x < 0)
+		{
+			face = FaceLeft;
+		}
+		else if (x >= m_width)
+		{
+			face = FaceRight;
+		}
+		else if (y < 0)
+		{
+			face = FaceDown;
+		}
+		else if (y >= m_height)
+		{
+			face = FaceUp;
+		}
+		else if (z < 0)
+		{
+			face = FaceFront;
+		}
+		else
+		{
+			face = FaceBack;
+		}
+
+		const std::vector<BlockId> &border = m_borders[face];
+
+		if (border.empty())
+		{
+			return false;
+		}
+
+		return Block::IsFilled(border[GetBorderIndex(face, x, y, z)]);
+	}
+
+	uint32_t ChunkMesher::GetBorderIndex(const BlockFace &face, const int &x, const int &y, const int &z) const
+	{
+		switch (face)
+		{
+		case FaceLeft:
+		case FaceRight:
+			return z + m_width * y;
+		case FaceUp:
+		case FaceDown:
+			return x + m_width * z;
+		default:
+			return x + m_width * y;
+		}
+	}
+
+	bool ChunkMesher::IsFaceVisible(const int &x, const int &y, const int &z, const BlockFace &faceType) const
+	{
+		switch (faceType)
+		{
+		case FaceFront:
+			return !IsBlockFilled(x, y, z - 1);
+		case FaceBack:
+			return !IsBlockFilled(x, y, z + 1);
+		case FaceUp:
+			return !IsBlockFilled(x, y + 1, z);
+		case FaceDown:
+			return !IsBlockFilled(x, y - 1, z);
+		case FaceLeft:
+			return !IsBlockFilled(x - 1, y, z);
+		case FaceRight:
+			return !IsBlockFilled(x + 1, y, z);
+		default:
+			return false;
+		}
+	}
+
+	void ChunkMesher::CreateSimpleMesh()
+	{
+		int u, v;
+		BlockFace currentFace;
+
+		std::vector<int> du = std::vector<int>{0, 0, 0};
+		std::vector<int> dv = std::vector<int>{0, 0, 0};
+
+		// We start with the lesser-spotted boolean for-loop (also known as the old flippy floppy).
+		for (bool backFace = true, b = false; b != backFace; backFace = backFace && b, b = !b)
+		{
+			// We sweep over the 3 dimensions - most of what follows is well described by Mikola Lysenko in his post.
+			for (int d = 0; d < 3; d++)
+			{
+				u = (d + 1) % 3;
+				v = (d + 2) % 3;
+
+				// Here we're keeping track of the side that we're meshing.
+				if (d == 0)
+				{
+					currentFace = backFace ? FaceLeft : FaceRight;
+				}
+				else if (d == 1)
+				{
+					currentFace = backFace ? FaceDown : FaceUp;
+				}
+				else if (d == 2)
+				{
+					currentFace = backFace ? FaceFront : FaceBack;
+				}
+
+				// We move through all of the blocks in the chunk.
+				for (int x = 0; x < m_width; x++)
+				{
+					for (int z = 0; z < m_width; z++)
+					{
+						for (int y = 0; y < m_height; y++)
+						{
+							// Here we filter out invisible faces.
+							if (!IsFaceVisible(x, y, z, currentFace))
+							{
+								continue;
+							}
+
+							BlockId block = GetBlock(x, y, z);
+
+							if (!Block::IsFilled(block))
+							{
+								continue;
+							}
+
+							const uint32_t ambientOcclusion = GetAmbientOcclusion(x, y, z, currentFace);
+
+							du[0] = 0;
+							du[1] = 0;
+							du[2] = 0;
+							du[u] = 1;
+
+							dv[0] = 0;
+							dv[1] = 0;
+							dv[2] = 0;
+							dv[v] = 1;
+
+							// And here we call the quad function in order to render a merged quad in the scene.
+							Vector3 bottomLeft = Vector3(x, y, z);
+							Vector3 topLeft = Vector3(x + dv[0], y + dv[1], z + dv[2]);
+							Vector3 topRight = Vector3(x + du[0] + dv[0], y + du[1] + dv[1], z + du[2] + dv[2]);
+							Vector3 bottomRight = Vector3(x + du[0], y + du[1], z + du[2]);
+							GenerateQuad(bottomLeft, topLeft, topRight, bottomRight, 1, 1, block, currentFace, ambientOcclusion, backFace);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void ChunkMesher::CreateGreedyMesh()
+	{
+		// This method is based off of Robert O'Leary's implementation (https://github.com/roboleary/GreedyMesh)
+
+		// These are just working variables for the algorithm - almost all taken
+		// directly from Mikola Lysenko's javascript implementation.
+		int i, j, k, l, w, h, u, v, n;
+		BlockFace currentFace;
+
+		std::vector<int> x = std::vector<int>{0, 0, 0};
+		std::vector<int> q = std::vector<int>{0, 0, 0};
+		std::vector<int> du = std::vector<int>{0, 0, 0};
+		std::vector<int> dv = std::vector<int>{0, 0, 0};
+
+		// We create a mask - this will contain the groups of matching voxel faces
+		// as we proceed through the chunk in 6 directions - once for each face.
+		// Faces are only merged when both their block and their corners ambient occlusion match.
+		std::vector<uint32_t> mask = std::vector<uint32_t>(m_width * m_height);
+
+		// These are just working variables to hold two faces during comparison.
+		uint32_t voxelFace, voxelFace1;
+
+		// We start with the lesser-spotted boolean for-loop (also known as the old flippy floppy).
+		// The variable backFace will be TRUE on the first iteration and FALSE on the second - this allows
+		// us to track which direction the indices should run during creation of the quad.
+		// This loop runs twice, and the inner loop 3 times - totally 6 iterations - one for each voxel face.
+		for (bool backFace = true, b = false; b != backFace; backFace = backFace && b, b = !b)
+		{
+			// We sweep over the 3 dimensions - most of what follows is well described by Mikola Lysenko in his post.
+			for (int d = 0; d < 3; d++)
+			{
+				u = (d + 1) % 3;
+				v = (d + 2) % 3;
+
+				x[0] = 0;
+				x[1] = 0;
+				x[2] = 0;
+
+				q[0] = 0;
+				q[1] = 0;
+				q[2] = 0;
+				q[d] = 1;
+
+				// Here we're keeping track of the side that we're meshing.
+				if (d == 0)
+				{
+					currentFace = backFace ? FaceLeft : FaceRight;
+				}
+				else if (d == 1)
+				{
+					currentFace = backFace ? FaceDown : FaceUp;
+				}
+				else if (d == 2)
+				{
+					currentFace = backFace ? FaceFront : FaceBack;
+				}
+
+				// We move through the dimension from front to back.
+				for (x[d] = -1; x[d] < m_width;)
+				{
+					// We compute the mask.
+					n = 0;
+
+					for (x[v] = 0; x[v] < m_height; x[v]++)
+					{
+						for (x[u] = 0; x[u] < m_width; x[u]++)
+						{
+							// Here we retrieve two voxel faces for comparison.
+							voxelFace = GetVoxelFace(x[0], x[1], x[2], currentFace);
+							voxelFace1 = GetVoxelFace(x[0] + q[0], x[1] + q[1], x[2] + q[2], currentFace);
+
+							// We choose the face to add to the mask depending on whether we're moving through on a backface or not.
+							mask[n++] = ((voxelFace != BLOCK_AIR && voxelFace1 != BLOCK_AIR && voxelFace == voxelFace1))
+								? BLOCK_AIR
+								: backFace ? voxelFace1 : voxelFace;
+						}
+					}
+
+					x[d]++;
+
+					// Now we generate the mesh for the mask.
+					n = 0;
+
+					for (j = 0; j < m_height; j++)
+					{
+						for (i = 0; i < m_width;)
+						{
+							if (mask[n] != BLOCK_AIR)
+							{
+								// We compute the width.
+								for (w = 1; i + w < m_width && mask[n + w] == mask[n]; w++)
+								{
+								}
+
+								// Then we compute height.
+								bool done = false;
+
+								for (h = 1; j + h < m_height; h++)
+								{
+									for (k = 0; k < w; k++)
+									{
+										if (mask[n + k + h * m_width] != mask[n])
+										{
+											done = true;
+											break;
+										}
+									}
+
+									if (done)
+									{
+										break;
+									}
+								}
+
+								// Here we check if the BlockFace is transparent, we don't mesh any culled faces.
+								//	if (!mask[n].transparent)
+								{
+									// Add quad.
+									x[u] = i;
+									x[v] = j;
+
+									du[0] = 0;
+									du[1] = 0;
+									du[2] = 0;
+									du[u] = w;
+
+									dv[0] = 0;
+									dv[1] = 0;
+									dv[2] = 0;
+									dv[v] = h;
+
+									// And here we call the quad function in order to render a merged quad in the scene.
+									Vector3 bottomLeft = Vector3(x[0], x[1], x[2]);
+									Vector3 topLeft = Vector3(x[0] + dv[0], x[1] + dv[1], x[2] + dv[2]);
+									Vector3 bottomRight = Vector3(x[0] + du[0], x[1] + du[1], x[2] + du[2]);
+									Vector3 topRight = Vector3(x[0] + du[0] + dv[0], x[1] + du[1] + dv[1], x[2] + du[2] + dv[2]);
+									GenerateQuad(bottomLeft, topLeft, topRight, bottomRight, w, h, static_cast<BlockId>(mask[n] & 0xFFFF), currentFace, mask[n] >> 16, backFace);
+								}
+
+								// We zero out the mask.
+								for (l = 0; l < h; ++l)
+								{
+									for(k = 0; k < w; ++k)
+									{
+										mask[n + k + l * m_width] = BLOCK_AIR;
+									}
+								}
+
+								// And then finally increment the counters and continue.
+								i += w;
+								n += w;
+							}
+							else
+							{
+								i++;
+								n++;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	uint32_t ChunkMesher::GetVoxelFace(const int &x, const int &y, const int &z, const BlockFace &faceType) const
+	{
+		if (!IsFaceVisible(x, y, z, faceType))
+		{
+			return BLOCK_AIR;
+		}
+
+		BlockId block = GetBlock(x, y, z);
+
+		if (!Block::IsFilled(block))
+		{
+			return BLOCK_AIR;
+		}
+
+		return static_cast<uint32_t>(block) | (GetAmbientOcclusion(x, y, z, faceType) << 16);
+	}
+
+	uint32_t ChunkMesher::GetAmbientOcclusion(const int &x, const int &y, const int &z, const BlockFace &faceType) const
+	{
+		// The face looks into the layer of cells next to it, the axes along the layer match the ones quads are built on.
+		const int d = (faceType == FaceLeft || faceType == FaceRight) ? 0 : (faceType == FaceUp || faceType == FaceDown) ? 1 : 2;
+		const int u = (d + 1) % 3;
+		const int v = (d + 2) % 3;
+
+		int layer[3] = {x, y, z};
+		layer[d] += (faceType == FaceRight || faceType == FaceUp || faceType == FaceBack) ? 1 : -1;
+
+		// Corners are bottom left, top left, bottom right then top right, 2 bits each.
+		uint32_t result = 0;
+
+		for (int corner = 0; corner < 4; corner++)
+		{
+			const int du = (corner & 2) ? 1 : -1;
+			const int dv = (corner & 1) ? 1 : -1;
+
+			int side0[3] = {layer[0], layer[1], layer[2]};
+			side0[u] += du;
+			int side1[3] = {layer[0], layer[1], layer[2]};
+			side1[v] += dv;
+			int diagonal[3] = {layer[0], layer[1], layer[2]};
+			diagonal[u] += du;
+			diagonal[v] += dv;
+
+			const bool filled0 = IsBlockFilled(side0[0], side0[1], side0[2]);
+			const bool filled1 = IsBlockFilled(side1[0], side1[1], side1[2]);
+			const bool filledDiagonal = IsBlockFilled(diagonal[0], diagonal[1], diagonal[2]);
+
+			// Two filled sides close the corner off, whatever is in the diagonal.
+			const uint32_t occlusion = (filled0 && filled1) ? 0 : 3 - (filled0 + filled1 + filledDiagonal);
+			result |= occlusion << (2 * corner);
+		}
+
+		return result;
+	}
+
+	void ChunkMesher::GenerateQuad(const Vector3 &bottomLeft, const Vector3 &topLeft, const Vector3 &topRight, const Vector3 &bottomRight,
+							 const int &width, const int &height,
+							 const BlockId &blockType, const BlockFace &faceType, const uint32_t &ambientOcclusion, const bool &backFace)
+	{
+		// The shared index buffer can not address any more vertices.
+		if (m_vertices.size() >= 4 * VOXEL_MAX_QUADS)
+		{
+			return;
+		}
+
+		// Back faces swap their first and last corners, so the shared quad indices wind them the other way.
+		const Vector3 *corners[4] = {&bottomLeft, &topLeft, &bottomRight, &topRight};
+
+		for (int i = 0; i < 4; i++)
+		{
+			const int corner = (backFace && (i == 0 || i == 3)) ? 3 - i : i;
+
+			// Corners are in cells, they are scaled back into voxels.
+			const Vector3 position = static_cast<float>(m_scale) * *corners[corner];
+			m_vertices.emplace_back(static_cast<uint32_t>(position.m_x), static_cast<uint32_t>(position.m_y), static_cast<uint32_t>(position.m_z),
+				faceType, (ambientOcclusion >> (2 * corner)) & 3, blockType);
+
+			if (m_vertices.size() == 1)
+			{
+				m_minExtents = position;
+				m_maxExtents = position;
+			}
+			else
+			{
+				m_minExtents = Vector3(std::min(m_minExtents.m_x, position.m_x), std::min(m_minExtents.m_y, position.m_y), std::min(m_minExtents.m_z, position.m_z));
+				m_maxExtents = Vector3(std::max(m_maxExtents.m_x, position.m_x), std::max(m_maxExtents.m_y, position.m_y), std::max(m_maxExtents.m_z, position.m_z));
+			}
+		}
+	}
+}
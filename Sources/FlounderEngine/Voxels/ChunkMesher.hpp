@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+#include "../Models/Model.hpp"
+#include "ChunkStorage.hpp"
+#include "VoxelVertex.hpp"
+
+namespace Flounder
+{
+	enum ChunkMesh
+	{
+		MeshGreedy = 0,
+		MeshSimple = 1
+	};
+
+	/// <summary>
+	/// Builds the mesh of a chunk from a snapshot of its voxels, so it can run on a worker while the chunk keeps changing.
+	/// The vertices are built off the main thread, only the model creation has to happen on the main thread.
+	/// Distant chunks are meshed at a level of detail, where each level doubles the size of the cells being meshed.
+	/// </summary>
+	class F_EXPORT ChunkMesher
+	{
+	private:
+		ChunkStorage *m_blocks;
+		ChunkMesh m_chunkMesh;
+		uint32_t m_version;
+		int m_lod;
+		int m_scale;
+		int m_width;
+		int m_height;
+		std::vector<BlockId> m_cells;
+		std::vector<BlockId> m_borders[6];
+
+		std::vector<VoxelVertex> m_vertices;
+		Vector3 m_minExtents;
+		Vector3 m_maxExtents;
+	public:
+		/// <summary>
+		/// Creates a new chunk mesher.
+		/// </summary>
+		/// <param name="blocks"> The snapshot of the chunks voxels, the mesher takes ownership of it. </param>
+		/// <param name="chunkMesh"> The meshing method to use. </param>
+		/// <param name="version"> The chunks version when the snapshot was taken. </param>
+		/// <param name="lod"> The level of detail, the chunk is meshed in cells of 2 to the power of lod voxels on each axis. </param>
+		ChunkMesher(ChunkStorage *blocks, const ChunkMesh &chunkMesh, const uint32_t &version, const int &lod = 0);
+
+		~ChunkMesher();
+
+		/// <summary>
+		/// Copies the layer of a neighbouring chunk that touches this chunk, so faces against filled neighbour voxels are culled.
+		/// Sides without a border are treated as empty, so the faces along them are kept.
+		/// </summary>
+		/// <param name="face"> The side of this chunk the neighbour is on. </param>
+		/// <param name="neighbour"> The neighbours voxels. </param>
+		void SetBorder(const BlockFace &face, const ChunkStorage &neighbour);
+
+		/// <summary>
+		/// Builds the vertices and indices, this is safe to call from a worker thread.
+		/// </summary>
+		void Build();
+
+		/// <summary>
+		/// Uploads the built mesh into a new model, this has to be called from the main thread.
+		/// The model only has packed voxel vertices, it is drawn with the voxel renderers shared quad indices.
+		/// </summary>
+		/// <param name="name"> The models name. </param>
+		/// <returns> The new model, or nullptr if the chunk has no visible faces. </returns>
+		Model *CreateModel(const std::string &name);
+
+		ChunkStorage *GetBlocks() const { return m_blocks; }
+
+		uint32_t GetVersion() const { return m_version; }
+
+		int GetLod() const { return m_lod; }
+
+		/// <summary>
+		/// Gets the block a cell of voxels is meshed as at a level of detail.
+		/// </summary>
+		/// <param name="blocks"> The chunks voxels. </param>
+		/// <param name="x"> The cells x position, in cells. </param>
+		/// <param name="y"> The cells y position, in cells. </param>
+		/// <param name="z"> The cells z position, in cells. </param>
+		/// <param name="scale"> The cells size, in voxels. </param>
+		/// <returns> The most common block in the cell, or air if less than half of the cell is filled. </returns>
+		static BlockId GetCell(const ChunkStorage &blocks, const int &x, const int &y, const int &z, const int &scale);
+	private:
+		BlockId GetBlock(const int &x, const int &y, const int &z) const;
+
+		bool IsBlockFilled(const int &x, const int &y, const int &z) const;
+
+		uint32_t GetBorderIndex(const BlockFace &face, const int &x, const int &y, const int &z) const;
+
+		bool IsFaceVisible(const int &x, const int &y, const int &z, const BlockFace &faceType) const;
+
+		void CreateSimpleMesh();
+
+		void CreateGreedyMesh();
+
+		uint32_t GetVoxelFace(const int &x, const int &y, const int &z, const BlockFace &faceType) const;
+
+		uint32_t GetAmbientOcclusion(const int &x, const int &y, const int &z, const BlockFace &faceType) const;
+
+		void GenerateQuad(const Vector3 &bottomLeft, const Vector3 &topLeft, const Vector3 &topRight, const Vector3 &bottomRight,
+						  const int &width, const int &height,
+						  const BlockId &blockType, const BlockFace &faceType, const uint32_t &ambientOcclusion, const bool &backFace);
+	};
+}
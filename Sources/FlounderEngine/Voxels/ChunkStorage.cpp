@@ -0,0 +1,159 @@
+#include "ChunkStorage.hpp"
+
+namespace Flounder
+{
+	ChunkStorage::ChunkStorage(const uint32_t &size) :
+		m_size(size),
+		m_bits(0),
+		m_palette(std::vector<BlockId>{BLOCK_AIR}),
+		m_data(std::vector<uint64_t>())
+	{
+	}
+
+	ChunkStorage::~ChunkStorage()
+	{
+	}
+
+	BlockId ChunkStorage::Get(const uint32_t &index) const
+	{
+		return m_palette[GetPaletteIndex(index)];
+	}
+
+	void ChunkStorage::Set(const uint32_t &index, const BlockId &id)
+	{
+		uint32_t paletteIndex = 0;
+
+		while (paletteIndex < m_palette.size() && m_palette[paletteIndex] != id)
+		{
+			paletteIndex++;
+		}
+
+		if (paletteIndex == m_palette.size())
+		{
+			m_palette.push_back(id);
+			const uint32_t bits = GetBitsFor(static_cast<uint32_t>(m_palette.size()));
+
+			if (bits != m_bits)
+			{
+				std::vector<uint32_t> remap = std::vector<uint32_t>(m_palette.size());
+
+				for (uint32_t i = 0; i < remap.size(); i++)
+				{
+					remap[i] = i;
+				}
+
+				Repack(bits, remap);
+			}
+		}
+
+		SetPaletteIndex(index, paletteIndex);
+	}
+
+	void ChunkStorage::Fill(const BlockId &id)
+	{
+		m_bits = 0;
+		m_palette.clear();
+		m_palette.push_back(id);
+		m_data.clear();
+	}
+
+	void ChunkStorage::Compact()
+	{
+		std::vector<uint32_t> counts = std::vector<uint32_t>(m_palette.size());
+
+		for (uint32_t i = 0; i < m_size; i++)
+		{
+			counts[GetPaletteIndex(i)]++;
+		}
+
+		std::vector<BlockId> palette = std::vector<BlockId>();
+		std::vector<uint32_t> remap = std::vector<uint32_t>(m_palette.size());
+
+		for (uint32_t i = 0; i < m_palette.size(); i++)
+		{
+			if (counts[i] != 0)
+			{
+				remap[i] = static_cast<uint32_t>(palette.size());
+				palette.push_back(m_palette[i]);
+			}
+		}
+
+		if (palette.size() == m_palette.size())
+		{
+			return;
+		}
+
+		Repack(GetBitsFor(static_cast<uint32_t>(palette.size())), remap);
+		m_palette = palette;
+	}
+
+	uint32_t ChunkStorage::GetMemorySize() const
+	{
+		return static_cast<uint32_t>(m_palette.size() * sizeof(BlockId) + m_data.size() * sizeof(uint64_t));
+	}
+
+	uint32_t ChunkStorage::GetPaletteIndex(const uint32_t &index) const
+	{
+		if (m_bits == 0)
+		{
+			return 0;
+		}
+
+		// Bit counts are powers of two, so an index never straddles two words.
+		const uint32_t perWord = 64 / m_bits;
+		const uint32_t shift = (index % perWord) * m_bits;
+		return static_cast<uint32_t>((m_data[index / perWord] >> shift) & ((static_cast<uint64_t>(1) << m_bits) - 1));
+	}
+
+	void ChunkStorage::SetPaletteIndex(const uint32_t &index, const uint32_t &paletteIndex)
+	{
+		if (m_bits == 0)
+		{
+			return;
+		}
+
+		const uint32_t perWord = 64 / m_bits;
+		const uint32_t shift = (index % perWord) * m_bits;
+		const uint64_t mask = ((static_cast<uint64_t>(1) << m_bits) - 1) << shift;
+		uint64_t &word = m_data[index / perWord];
+		word = (word & ~mask) | ((static_cast<uint64_t>(paletteIndex) << shift) & mask);
+	}
+
+	void ChunkStorage::Repack(const uint32_t &bits, const std::vector<uint32_t> &remap)
+	{
+		std::vector<uint32_t> indices = std::vector<uint32_t>(m_size);
+
+		for (uint32_t i = 0; i < m_size; i++)
+		{
+			indices[i] = remap[GetPaletteIndex(i)];
+		}
+
+		m_bits = bits;
+		m_data.clear();
+
+		if (m_bits == 0)
+		{
+			return;
+		}
+
+		const uint32_t perWord = 64 / m_bits;
+		m_data.resize((m_size + perWord - 1) / perWord);
+
+		for (uint32_t i = 0; i < m_size; i++)
+		{
+			SetPaletteIndex(i, indices[i]);
+		}
+	}
+
+	uint32_t ChunkStorage::GetBitsFor(const uint32_t &paletteSize)
+	{
+		uint32_t bits = 0;
+
+		while ((static_cast<uint32_t>(1) << bits) < paletteSize)
+		{
+			bits = bits == 0 ? 1 : bits * 2;
+		}
+
+		return bits;
+	}
+}
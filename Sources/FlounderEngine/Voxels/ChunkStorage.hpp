@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include "../Engine/Platform.hpp"
+#include "Block.hpp"
+
+namespace Flounder
+{
+	/// <summary>
+	/// A flat array of voxels stored as indices into a small palette of block ids.
+	/// Indices are bit packed with 0, 1, 2, 4, 8 or 16 bits per voxel, so a chunk with a handful of types costs a few kilobytes.
+	/// </summary>
+	class F_EXPORT ChunkStorage
+	{
+	private:
+		uint32_t m_size;
+		uint32_t m_bits;
+		std::vector<BlockId> m_palette;
+		std::vector<uint64_t> m_data;
+	public:
+		/// <summary>
+		/// Creates a new storage filled with air.
+		/// </summary>
+		/// <param name="size"> The number of voxels stored. </param>
+		ChunkStorage(const uint32_t &size);
+
+		~ChunkStorage();
+
+		/// <summary>
+		/// Gets the block id of a voxel.
+		/// </summary>
+		/// <param name="index"> The voxels index. </param>
+		/// <returns> The block id. </returns>
+		BlockId Get(const uint32_t &index) const;
+
+		/// <summary>
+		/// Sets the block id of a voxel, widening the packed indices if the palette outgrows them.
+		/// </summary>
+		/// <param name="index"> The voxels index. </param>
+		/// <param name="id"> The block id. </param>
+		void Set(const uint32_t &index, const BlockId &id);
+
+		/// <summary>
+		/// Sets every voxel to one block id.
+		/// </summary>
+		/// <param name="id"> The block id. </param>
+		void Fill(const BlockId &id);
+
+		/// <summary>
+		/// Removes palette entries no voxel uses anymore and packs the indices as tight as possible.
+		/// </summary>
+		void Compact();
+
+		uint32_t GetSize() const { return m_size; }
+
+		uint32_t GetBits() const { return m_bits; }
+
+		const std::vector<BlockId> &GetPalette() const { return m_palette; }
+
+		const std::vector<uint64_t> &GetData() const { return m_data; }
+
+		/// <summary>
+		/// Gets the number of bytes used by the palette and packed indices.
+		/// </summary>
+		/// <returns> The memory size. </returns>
+		uint32_t GetMemorySize() const;
+	private:
+		uint32_t GetPaletteIndex(const uint32_t &index) const;
+
+		void SetPaletteIndex(const uint32_t &index, const uint32_t &paletteIndex);
+
+		void Repack(const uint32_t &bits, const std::vector<uint32_t> &remap);
+
+		static uint32_t GetBitsFor(const uint32_t &paletteSize);
+	};
+}
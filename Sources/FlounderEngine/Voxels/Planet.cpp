@@ -1,42 +1,132 @@
 #include "Planet.hpp"
 
-#include "../Maths/Maths.hpp"
+#include <algorithm>
+#include <cmath>
+#include "../Meshes/Mesh.hpp"
+#include "../Scenes/Scenes.hpp"
+#include "../Tasks/Tasks.hpp"
+#include "Chunk.hpp"
 #include "VoxelRender.hpp"
 
 namespace Flounder
 {
-	Planet::Planet(const int &sideLength) :
-		m_chunks(new std::vector<Chunk *>(sideLength * sideLength)),
-		m_sideLength(sideLength),
-		m_generate(true)
+	const float MERGE_DISTANCE = 1.25f;
+
+	Planet::Planet(const int &sideLength, const float &amplitude, const float &splitDistance, const uint32_t &maxJobs) :
+		Component(),
+		m_sideLength(1),
+		m_maxDepth(0),
+		m_amplitude(amplitude),
+		m_splitDistance(splitDistance),
+		m_maxJobs(maxJobs),
+		m_noise(new NoiseFast(954627)),
+		m_roots(),
+		m_candidates(std::vector<NodeCandidate>()),
+		m_destroyed(std::vector<GameObject *>()),
+		m_jobs(0)
 	{
+		// Every split halves a patch, so sides a power of 2 chunks across end in patches of exactly one chunk.
+		while (m_sideLength < sideLength)
+		{
+			m_sideLength *= 2;
+			m_maxDepth++;
+		}
+
+		m_noise->SetNoiseType(NoiseFast::SimplexFractal);
+		m_noise->SetFrequency(0.01f);
+		m_noise->SetFractalOctaves(5);
 	}
 
 	Planet::~Planet()
 	{
-		for (auto chunk : *m_chunks)
+		// Shown patches belong to the scene structure, only removed patches are owned here.
+		for (auto &root : m_roots)
+		{
+			if (root != nullptr)
+			{
+				DeleteNode(root, false);
+			}
+		}
+
+		for (auto object : m_destroyed)
 		{
-			delete chunk;
+			delete object;
 		}
 
-		delete m_chunks;
+		delete m_noise;
 	}
 
 	void Planet::Update()
 	{
-		if (m_generate)
+		// Removed patches may still have been in this updates copy of the structure, so they are deleted an update later.
+		for (auto object : m_destroyed)
+		{
+			delete object;
+		}
+
+		m_destroyed.clear();
+
+		auto camera = Scenes::Get()->GetCamera();
+
+		if (camera == nullptr)
 		{
-			Generate();
-			m_generate = false;
+			return;
+		}
+
+		if (m_roots[0] == nullptr)
+		{
+			for (int side = 0; side < 6; side++)
+			{
+				m_roots[side] = CreateNode(static_cast<PlanetSide>(side), 0, 0, 0, nullptr);
+			}
+		}
+
+		const Vector3 cameraPosition = (*camera->GetPosition() - *GetGameObject()->GetTransform()->GetPosition()) / Chunk::VOXEL_SIZE;
+		m_candidates.clear();
+
+		for (auto &root : m_roots)
+		{
+			UpdateNode(root, cameraPosition);
+		}
+
+		// Patches nearest the camera are generated first.
+		std::sort(m_candidates.begin(), m_candidates.end(), [](const NodeCandidate &a, const NodeCandidate &b)
+		{
+			return a.priority < b.priority;
+		});
+
+		for (auto &candidate : m_candidates)
+		{
+			if (m_jobs >= m_maxJobs)
+			{
+				break;
+			}
+
+			StartJob(candidate.node);
 		}
 	}
 
 	void Planet::Load(LoadedValue *value)
 	{
+		m_amplitude = value->GetChild("Amplitude")->Get<float>();
+		m_splitDistance = value->GetChild("Split Distance")->Get<float>();
 	}
 
 	void Planet::Write(LoadedValue *value)
 	{
+		value->GetChild("Amplitude", true)->Set(m_amplitude);
+		value->GetChild("Split Distance", true)->Set(m_splitDistance);
+	}
+
+	float Planet::GetRadius() const
+	{
+		return GetHalfSize() * Chunk::VOXEL_SIZE;
+	}
+
+	float Planet::GetHeight(const Vector3 &direction) const
+	{
+		const float halfSize = GetHalfSize();
+		return m_amplitude * m_noise->GetNoise(direction.m_x * halfSize, direction.m_y * halfSize, direction.m_z * halfSize);
 	}
 
 	Vector3 Planet::GetSideDirection(const PlanetSide &side)
@@ -60,35 +150,427 @@ namespace Flounder
 		}
 	}
 
-	PlanetSide Planet::GetSide(const Vector3 &position, const int &sideLength)
+	Vector3 Planet::GetSideRotation(const PlanetSide &side)
 	{
-		return SideLeft;
+		switch (side)
+		{
+		case SideFront:
+			return Vector3(90.0f, 0.0f, 0.0f);
+		case SideBack:
+			return Vector3(-90.0f, 0.0f, 0.0f);
+		case SideUp:
+			return Vector3(0.0f, 0.0f, 0.0f);
+		case SideDown:
+			return Vector3(180.0f, 0.0f, 0.0f);
+		case SideLeft:
+			return Vector3(0.0f, 0.0f, 90.0f);
+		case SideRight:
+			return Vector3(0.0f, 0.0f, -90.0f);
+		default:
+			return Vector3();
+		}
 	}
 
-	void Planet::Generate()
+	PlanetSide Planet::GetSide(const Vector3 &direction)
 	{
-		// Chunks.
-		new GameObject("PlanetCentre", Transform(Vector3(), Vector3(), 1.0f));
+		const float x = std::fabs(direction.m_x);
+		const float y = std::fabs(direction.m_y);
+		const float z = std::fabs(direction.m_z);
 
-		for (int j = 0; j < m_sideLength; j++)
+		if (x >= y && x >= z)
 		{
-			for (int k = 0; k < m_sideLength; k++)
+			return direction.m_x > 0.0f ? SideRight : SideLeft;
+		}
+
+		if (y >= z)
+		{
+			return direction.m_y > 0.0f ? SideUp : SideDown;
+		}
+
+		return direction.m_z > 0.0f ? SideFront : SideBack;
+	}
+
+	void Planet::GetSideAxes(const PlanetSide &side, Vector3 *u, Vector3 *normal, Vector3 *v)
+	{
+		// Taken from the same rotation the patches are drawn with, so the axes always agree with the shader.
+		Matrix4 rotation = Matrix4();
+		Matrix4::TransformationMatrix(Vector3(), GetSideRotation(side), Vector3(1.0f, 1.0f, 1.0f), &rotation);
+
+		Vector4 axis = Vector4();
+		Matrix4::Transform(rotation, Vector4(1.0f, 0.0f, 0.0f, 0.0f), &axis);
+		u->Set(std::round(axis.m_x), std::round(axis.m_y), std::round(axis.m_z));
+		Matrix4::Transform(rotation, Vector4(0.0f, 1.0f, 0.0f, 0.0f), &axis);
+		normal->Set(std::round(axis.m_x), std::round(axis.m_y), std::round(axis.m_z));
+		Matrix4::Transform(rotation, Vector4(0.0f, 0.0f, 1.0f, 0.0f), &axis);
+		v->Set(std::round(axis.m_x), std::round(axis.m_y), std::round(axis.m_z));
+	}
+
+	Planet::PlanetNode *Planet::CreateNode(const PlanetSide &side, const int &depth, const int &x, const int &y, PlanetNode *parent)
+	{
+		PlanetNode *node = new PlanetNode();
+		node->side = side;
+		node->depth = depth;
+		node->x = x;
+		node->y = y;
+		node->parent = parent;
+		node->built = false;
+		node->shown = false;
+
+		for (auto &child : node->children)
+		{
+			child = nullptr;
+		}
+
+		// The centre of the patch on the terrain, used to measure the cameras distance.
+		const float halfSize = GetHalfSize();
+		const float size = static_cast<float>(Chunk::CHUNK_WIDTH * GetScale(depth));
+		Vector3 u = Vector3();
+		Vector3 normal = Vector3();
+		Vector3 v = Vector3();
+		GetSideAxes(side, &u, &normal, &v);
+
+		Vector3 direction = normal * halfSize + u * (size * (x + 0.5f) - halfSize) + v * (size * (y + 0.5f) - halfSize);
+		direction.Normalize();
+		node->centre = direction * (halfSize + GetHeight(direction));
+		return node;
+	}
+
+	void Planet::DeleteNode(PlanetNode *node, const bool &removeObjects)
+	{
+		for (auto &child : node->children)
+		{
+			if (child != nullptr)
+			{
+				DeleteNode(child, removeObjects);
+			}
+		}
+
+		// The job writes into the node, so it has to finish before the node is destroyed.
+		if (node->job.valid())
+		{
+			node->job.wait();
+			m_jobs--;
+		}
+
+		for (auto mesher : node->meshers)
+		{
+			delete mesher;
+		}
+
+		if (removeObjects)
+		{
+			Hide(node);
+		}
+
+		delete node;
+	}
+
+	void Planet::UpdateNode(PlanetNode *node, const Vector3 &cameraPosition)
+	{
+		if (node->job.valid() && node->job.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+		{
+			node->job.get();
+			node->built = true;
+			m_jobs--;
+		}
+
+		const float distance = (cameraPosition - node->centre).Length();
+		const float size = static_cast<float>(Chunk::CHUNK_WIDTH * GetScale(node->depth));
+
+		if (node->children[0] != nullptr)
+		{
+			// Merges a little further out than it split, so a camera on the boundary does not rebuild patches every update.
+			if (distance > m_splitDistance * size * MERGE_DISTANCE)
 			{
-				for (int l = 0; l < m_sideLength; l++)
+				if (node->shown)
+				{
+					DeleteChildren(node);
+					return;
+				}
+
+				if (node->built)
 				{
-					Vector3 position = *Chunk::CHUNK_SIZE * Vector3(j, 0, k);
-				//	PlanetSide side = GetSide(position, m_sideLength);
+					Show(node);
+					DeleteChildren(node);
+					return;
+				}
 
-					GameObject *chunk = new GameObject(Transform(*Chunk::CHUNK_SIZE * Vector3(j, l, k)));
-					chunk->SetName("Chunk" + GetName() + "," + std::to_string(j) + "," + std::to_string(l) + "," + std::to_string(k));
-					chunk->AddComponent(new Chunk(MeshGreedy, true));
-					chunk->AddComponent(new Mesh());
-					chunk->AddComponent(new VoxelRender());
-					//	chunk->AddComponent(new ShadowRender());
+				if (!node->job.valid())
+				{
+					m_candidates.push_back({node, distance});
+				}
+			}
+
+			for (auto &child : node->children)
+			{
+				UpdateNode(child, cameraPosition);
+			}
 
-					m_chunks->at(j * k) = chunk->GetComponent<Chunk>();
+			// The patch is kept until all of its children can replace it at once.
+			if (node->shown && IsReady(node->children[0]) && IsReady(node->children[1]) && IsReady(node->children[2]) && IsReady(node->children[3]))
+			{
+				for (auto &child : node->children)
+				{
+					Reveal(child);
 				}
+
+				Hide(node);
 			}
+
+			return;
 		}
+
+		if (!node->shown)
+		{
+			if (node->built && (node->parent == nullptr || !node->parent->shown))
+			{
+				Show(node);
+			}
+			else if (!node->built && !node->job.valid())
+			{
+				m_candidates.push_back({node, distance});
+			}
+		}
+
+		if (node->shown && node->depth < m_maxDepth && distance < m_splitDistance * size)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				node->children[i] = CreateNode(node->side, node->depth + 1, 2 * node->x + (i % 2), 2 * node->y + (i / 2), node);
+			}
+		}
+	}
+
+	bool Planet::IsReady(PlanetNode *node) const
+	{
+		if (node->shown || node->built)
+		{
+			return true;
+		}
+
+		if (node->children[0] == nullptr)
+		{
+			return false;
+		}
+
+		for (auto &child : node->children)
+		{
+			if (!IsReady(child))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void Planet::Reveal(PlanetNode *node)
+	{
+		if (node->shown)
+		{
+			return;
+		}
+
+		if (node->built)
+		{
+			Show(node);
+			return;
+		}
+
+		for (auto &child : node->children)
+		{
+			Reveal(child);
+		}
+	}
+
+	void Planet::Show(PlanetNode *node)
+	{
+		const float halfSize = GetHalfSize();
+		const int scale = GetScale(node->depth);
+		const float size = static_cast<float>(Chunk::CHUNK_WIDTH * scale);
+		const Vector3 centre = *GetGameObject()->GetTransform()->GetPosition();
+		Vector3 u = Vector3();
+		Vector3 normal = Vector3();
+		Vector3 v = Vector3();
+		GetSideAxes(node->side, &u, &normal, &v);
+
+		for (uint32_t i = 0; i < node->meshers.size(); i++)
+		{
+			const std::string name = "Planet" + std::to_string(node->side) + "," + std::to_string(node->depth) + "," +
+				std::to_string(node->x) + "," + std::to_string(node->y) + "," + std::to_string(i);
+			Model *model = node->meshers[i]->CreateModel(name);
+			delete node->meshers[i];
+
+			if (model == nullptr)
+			{
+				continue;
+			}
+
+			// The patch is placed flat on its side of the cube, the shader bends it onto the sphere.
+			const Vector3 corner = normal * (halfSize + static_cast<float>(node->layers[i] * scale)) +
+				u * (size * node->x - halfSize) + v * (size * node->y - halfSize);
+
+			GameObject *object = new GameObject(Transform(centre + corner * Chunk::VOXEL_SIZE, GetSideRotation(node->side), static_cast<float>(scale)));
+			object->SetName(name);
+			object->AddComponent(new Mesh(model));
+			object->AddComponent(new VoxelRender());
+			object->GetComponent<VoxelRender>()->SetPlanet(centre, GetRadius());
+			node->objects.push_back(object);
+		}
+
+		node->meshers.clear();
+		node->layers.clear();
+		node->built = false;
+		node->shown = true;
+	}
+
+	void Planet::Hide(PlanetNode *node)
+	{
+		for (auto object : node->objects)
+		{
+			auto mesh = object->GetComponent<Mesh>();
+
+			if (mesh != nullptr)
+			{
+				delete mesh->GetModel();
+				mesh->SetModel(nullptr);
+			}
+
+			object->StructureRemove();
+			m_destroyed.push_back(object);
+		}
+
+		node->objects.clear();
+		node->shown = false;
+	}
+
+	void Planet::DeleteChildren(PlanetNode *node)
+	{
+		for (auto &child : node->children)
+		{
+			DeleteNode(child, true);
+			child = nullptr;
+		}
+	}
+
+	void Planet::StartJob(PlanetNode *node)
+	{
+		m_jobs++;
+		node->job = Tasks::Get()->GetThreadPool()->Enqueue([this, node]()
+		{
+			Build(node);
+		});
+	}
+
+	void Planet::Build(PlanetNode *node) const
+	{
+		const int width = Chunk::CHUNK_WIDTH;
+		const int height = Chunk::CHUNK_HEIGHT;
+		const float halfSize = GetHalfSize();
+		const int scale = GetScale(node->depth);
+		const float size = static_cast<float>(width * scale);
+		Vector3 u = Vector3();
+		Vector3 normal = Vector3();
+		Vector3 v = Vector3();
+		GetSideAxes(node->side, &u, &normal, &v);
+
+		// Heights are found once per column of cells, through the middle of each cell, the noise is filled for every column at once.
+		std::vector<float> samplesX = std::vector<float>(width * width);
+		std::vector<float> samplesY = std::vector<float>(width * width);
+		std::vector<float> samplesZ = std::vector<float>(width * width);
+
+		for (int k = 0; k < width; k++)
+		{
+			for (int i = 0; i < width; i++)
+			{
+				Vector3 direction = normal * halfSize + u * (size * node->x - halfSize + (i + 0.5f) * scale) + v * (size * node->y - halfSize + (k + 0.5f) * scale);
+				direction.Normalize();
+
+				samplesX[i + width * k] = direction.m_x * halfSize;
+				samplesY[i + width * k] = direction.m_y * halfSize;
+				samplesZ[i + width * k] = direction.m_z * halfSize;
+			}
+		}
+
+		std::vector<float> heights = std::vector<float>(width * width);
+		m_noise->FillNoiseSet(heights.data(), samplesX.data(), samplesY.data(), samplesZ.data(), width * width);
+		float minHeight = m_amplitude;
+		float maxHeight = -m_amplitude;
+
+		for (auto &columnHeight : heights)
+		{
+			columnHeight *= m_amplitude;
+			minHeight = std::min(minHeight, columnHeight);
+			maxHeight = std::max(maxHeight, columnHeight);
+		}
+
+		// The patch is a shell of chunks stacked from a little under its lowest column to its highest.
+		const int bottom = static_cast<int>(std::floor(minHeight / scale)) - 2;
+		const int top = static_cast<int>(std::floor(maxHeight / scale));
+		const int layers = (top - bottom) / height + 1;
+
+		const BlockId grass = Block::Find("Grass");
+		const BlockId dirt = Block::Find("Dirt");
+		const BlockId stone = Block::Find("Stone");
+		const BlockId sand = Block::Find("Sand");
+		const BlockId snow = Block::Find("Snow");
+
+		for (int layer = 0; layer < layers; layer++)
+		{
+			const int base = bottom + layer * height;
+			ChunkStorage *blocks = new ChunkStorage(width * width * height);
+
+			for (int j = 0; j < height; j++)
+			{
+				for (int k = 0; k < width; k++)
+				{
+					for (int i = 0; i < width; i++)
+					{
+						const float columnHeight = heights[i + width * k];
+						const float depth = columnHeight - (base + j + 0.5f) * scale;
+
+						if (depth < 0.0f)
+						{
+							continue;
+						}
+
+						const bool beach = columnHeight < -0.4f * m_amplitude;
+						BlockId id = stone;
+
+						if (depth < scale)
+						{
+							id = beach ? sand : columnHeight > 0.6f * m_amplitude ? snow : grass;
+						}
+						else if (depth < scale + 3.0f)
+						{
+							id = beach ? sand : dirt;
+						}
+
+						blocks->Set(Chunk::GetIndex(i, j, k), id);
+					}
+				}
+			}
+
+			blocks->Compact();
+			node->meshers.push_back(new ChunkMesher(blocks, MeshGreedy, 0));
+			node->layers.push_back(base);
+		}
+
+		// Faces between the stacked chunks of a patch are hidden, only the sides of the patch keep their walls.
+		for (uint32_t i = 0; i + 1 < node->meshers.size(); i++)
+		{
+			node->meshers[i]->SetBorder(FaceUp, *node->meshers[i + 1]->GetBlocks());
+			node->meshers[i + 1]->SetBorder(FaceDown, *node->meshers[i]->GetBlocks());
+		}
+
+		for (auto mesher : node->meshers)
+		{
+			mesher->Build();
+		}
+	}
+
+	float Planet::GetHalfSize() const
+	{
+		return 0.5f * static_cast<float>(m_sideLength * Chunk::CHUNK_WIDTH);
 	}
 }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <future>
+#include <vector>
+#include "../Maths/Noise/NoiseFast.hpp"
 #include "../Objects/Component.hpp"
-#include "Chunk.hpp"
+#include "../Objects/GameObject.hpp"
+#include "ChunkMesher.hpp"
 
 namespace Flounder
 {
@@ -15,15 +19,62 @@ namespace Flounder
 		SideRight = 5
 	};
 
+	/// <summary>
+	/// A component that builds a voxel planet as a cube projected onto a sphere.
+	/// Each side of the cube is a quadtree of patches, a patch is meshed as chunks of cells where a cell at depth d covers
+	/// sideLength / 2^d voxels on each axis, so the whole planet is never meshed at full detail. Patches split when the
+	/// camera comes closer than the split distance times their size and merge again a little further out. Patches are
+	/// generated and meshed on worker threads nearest first, a patch is only swapped for its children once all four are
+	/// built so the surface never has holes. Patches are bent onto the sphere by the voxel vertex shader.
+	/// </summary>
 	class F_EXPORT Planet :
 		public Component
 	{
 	private:
-		std::vector<Chunk *> *m_chunks;
+		struct PlanetNode
+		{
+			PlanetSide side;
+			int depth;
+			int x;
+			int y;
+			PlanetNode *parent;
+			PlanetNode *children[4];
+			Vector3 centre;
+
+			std::vector<ChunkMesher *> meshers;
+			std::vector<int> layers;
+			std::vector<GameObject *> objects;
+			std::future<void> job;
+			bool built;
+			bool shown;
+		};
+
+		struct NodeCandidate
+		{
+			PlanetNode *node;
+			float priority;
+		};
+
 		int m_sideLength;
-		bool m_generate;
+		int m_maxDepth;
+		float m_amplitude;
+		float m_splitDistance;
+		uint32_t m_maxJobs;
+
+		NoiseFast *m_noise;
+		PlanetNode *m_roots[6];
+		std::vector<NodeCandidate> m_candidates;
+		std::vector<GameObject *> m_destroyed;
+		uint32_t m_jobs;
 	public:
-		Planet(const int &sideLength = 4);
+		/// <summary>
+		/// Creates a new planet.
+		/// </summary>
+		/// <param name="sideLength"> The number of chunks across a side of the cube at full detail, rounded up to a power of 2. </param>
+		/// <param name="amplitude"> How far the terrain rises and falls from the sphere, in voxels. </param>
+		/// <param name="splitDistance"> How many patch sizes away from the camera a patch splits. </param>
+		/// <param name="maxJobs"> How many patches can be generating on worker threads at once. </param>
+		Planet(const int &sideLength = 32, const float &amplitude = 24.0f, const float &splitDistance = 1.5f, const uint32_t &maxJobs = 8);
 
 		~Planet();
 
@@ -35,10 +86,78 @@ namespace Flounder
 
 		std::string GetName() const override { return "Planet"; };
 
+		/// <summary>
+		/// Gets the planets radius, the distance from its centre to the middle of a side of the cube.
+		/// </summary>
+		/// <returns> The radius, in world units. </returns>
+		float GetRadius() const;
+
+		/// <summary>
+		/// Gets the height of the terrain above the sphere, this is safe to call from worker threads.
+		/// </summary>
+		/// <param name="direction"> The normalized direction from the planets centre. </param>
+		/// <returns> The terrain height, in voxels. </returns>
+		float GetHeight(const Vector3 &direction) const;
+
+		int GetSideLength() const { return m_sideLength; }
+
+		float GetAmplitude() const { return m_amplitude; }
+
+		float GetSplitDistance() const { return m_splitDistance; }
+
+		void SetSplitDistance(const float &splitDistance) { m_splitDistance = splitDistance; }
+
+		uint32_t GetMaxJobs() const { return m_maxJobs; }
+
+		void SetMaxJobs(const uint32_t &maxJobs) { m_maxJobs = maxJobs; }
+
 		static Vector3 GetSideDirection(const PlanetSide &side);
 
-		static PlanetSide GetSide(const Vector3 &position, const int &sideLength);
+		/// <summary>
+		/// Gets the rotation that turns a chunks up axis to face out of a side of the cube.
+		/// </summary>
+		/// <param name="side"> The side. </param>
+		/// <returns> The rotation, in degrees. </returns>
+		static Vector3 GetSideRotation(const PlanetSide &side);
+
+		/// <summary>
+		/// Gets the side of the cube a direction from the planets centre passes through.
+		/// </summary>
+		/// <param name="direction"> The direction, it does not need to be normalized. </param>
+		/// <returns> The side. </returns>
+		static PlanetSide GetSide(const Vector3 &direction);
+
+		/// <summary>
+		/// Gets the axes of a side of the cube, a chunk on the side has its x axis along u, y along the normal and z along v.
+		/// </summary>
+		/// <param name="side"> The side. </param>
+		/// <param name="u"> The sides first tangent. </param>
+		/// <param name="normal"> The sides outward normal. </param>
+		/// <param name="v"> The sides second tangent. </param>
+		static void GetSideAxes(const PlanetSide &side, Vector3 *u, Vector3 *normal, Vector3 *v);
 	private:
-		void Generate();
+		PlanetNode *CreateNode(const PlanetSide &side, const int &depth, const int &x, const int &y, PlanetNode *parent);
+
+		void DeleteNode(PlanetNode *node, const bool &removeObjects);
+
+		void UpdateNode(PlanetNode *node, const Vector3 &cameraPosition);
+
+		bool IsReady(PlanetNode *node) const;
+
+		void Reveal(PlanetNode *node);
+
+		void Show(PlanetNode *node);
+
+		void Hide(PlanetNode *node);
+
+		void DeleteChildren(PlanetNode *node);
+
+		void StartJob(PlanetNode *node);
+
+		void Build(PlanetNode *node) const;
+
+		float GetHalfSize() const;
+
+		int GetScale(const int &depth) const { return m_sideLength >> depth; }
 	};
 }
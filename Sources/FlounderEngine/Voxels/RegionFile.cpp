@@ -0,0 +1,373 @@
+#include "RegionFile.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include "../Helpers/FileSystem.hpp"
+
+#ifdef FLOUNDER_PLATFORM_WINDOWS
+#include <Windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace Flounder
+{
+	const char REGION_MAGIC[4] = {'F', 'V', 'R', 'G'};
+	const uint32_t REGION_VERSION = 1;
+	const uint32_t REGION_SECTOR = 256;
+
+	RegionFile::RegionFile(const std::string &filename) :
+		m_filename(filename),
+		m_file(nullptr),
+		m_header(nullptr),
+		m_mapping(nullptr),
+		m_mapped(false),
+		m_mutex()
+	{
+		m_file = fopen(m_filename.c_str(), "rb+");
+
+		if (m_file == nullptr)
+		{
+			FileSystem::CreateFolder(m_filename.substr(0, m_filename.find_last_of("\\/")));
+			m_file = fopen(m_filename.c_str(), "wb+");
+
+			if (m_file == nullptr)
+			{
+				fprintf(stderr, "Could not create region file: '%s'\n", m_filename.c_str());
+				return;
+			}
+
+			// Written once up front, so the header can be mapped at its full size.
+			RegionHeader *header = new RegionHeader();
+			memcpy(header->magic, REGION_MAGIC, sizeof(REGION_MAGIC));
+			header->version = REGION_VERSION;
+			fwrite(header, sizeof(RegionHeader), 1, m_file);
+			fflush(m_file);
+			delete header;
+		}
+
+		MapHeader();
+
+		if (m_header != nullptr && (memcmp(m_header->magic, REGION_MAGIC, sizeof(REGION_MAGIC)) != 0 || m_header->version != REGION_VERSION))
+		{
+			fprintf(stderr, "Region file is not a supported region: '%s'\n", m_filename.c_str());
+			UnmapHeader();
+		}
+	}
+
+	RegionFile::~RegionFile()
+	{
+		UnmapHeader();
+
+		if (m_file != nullptr)
+		{
+			fclose(m_file);
+		}
+	}
+
+	bool RegionFile::Read(const uint32_t &index, ChunkStorage *blocks)
+	{
+		std::vector<char> data = std::vector<char>();
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			if (!IsOpen() || index >= REGION_CHUNKS || m_header->entries[index].size == 0)
+			{
+				return false;
+			}
+
+			const RegionEntry entry = m_header->entries[index];
+			data.resize(entry.size);
+			fseek(m_file, entry.offset, SEEK_SET);
+
+			if (fread(data.data(), 1, entry.size, m_file) != entry.size)
+			{
+				fprintf(stderr, "Could not read chunk %i from region: '%s'\n", index, m_filename.c_str());
+				return false;
+			}
+		}
+
+		return Decode(data.data(), static_cast<uint32_t>(data.size()), blocks);
+	}
+
+	void RegionFile::Write(const uint32_t &index, const ChunkStorage &blocks)
+	{
+		std::vector<char> data = std::vector<char>();
+		Encode(blocks, &data);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		if (!IsOpen() || index >= REGION_CHUNKS)
+		{
+			return;
+		}
+
+		RegionEntry &entry = m_header->entries[index];
+		const uint32_t size = static_cast<uint32_t>(data.size());
+
+		if (size > entry.capacity)
+		{
+			// Moves the chunk to the end of the file, padded so it can grow a little in place next time.
+			fseek(m_file, 0, SEEK_END);
+			entry.offset = static_cast<uint32_t>(ftell(m_file));
+			entry.capacity = ((size + REGION_SECTOR - 1) / REGION_SECTOR) * REGION_SECTOR;
+			data.resize(entry.capacity);
+		}
+
+		fseek(m_file, entry.offset, SEEK_SET);
+		fwrite(data.data(), 1, data.size(), m_file);
+		fflush(m_file);
+
+		// The entry is only updated once the payload is on disk.
+		entry.size = size;
+		WriteEntry(index);
+	}
+
+	bool RegionFile::Contains(const uint32_t &index)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return IsOpen() && index < REGION_CHUNKS && m_header->entries[index].size != 0;
+	}
+
+	uint32_t RegionFile::GetIndex(const int &x, const int &y, const int &z)
+	{
+		const int localX = x - GetRegion(x) * REGION_SIZE;
+		const int localY = y - GetRegion(y) * REGION_SIZE;
+		const int localZ = z - GetRegion(z) * REGION_SIZE;
+		return static_cast<uint32_t>(localX + REGION_SIZE * (localZ + REGION_SIZE * localY));
+	}
+
+	int RegionFile::GetRegion(const int &chunk)
+	{
+		return static_cast<int>(std::floor(static_cast<float>(chunk) / static_cast<float>(REGION_SIZE)));
+	}
+
+	void RegionFile::Encode(const ChunkStorage &blocks, std::vector<char> *data)
+	{
+		auto append = [data](const void *value, const size_t &size)
+		{
+			const char *bytes = static_cast<const char *>(value);
+			data->insert(data->end(), bytes, bytes + size);
+		};
+
+		// Block ids depend on registration order, so the palette is saved by name.
+		const std::vector<BlockId> &palette = blocks.GetPalette();
+		const uint16_t paletteSize = static_cast<uint16_t>(palette.size());
+		append(&paletteSize, sizeof(uint16_t));
+
+		for (auto id : palette)
+		{
+			const std::string name = Block::Get(id)->GetName();
+			const uint8_t length = static_cast<uint8_t>(std::min(name.size(), static_cast<size_t>(255)));
+			append(&length, sizeof(uint8_t));
+			append(name.data(), length);
+		}
+
+		// Runs of palette indices, terrain is mostly horizontal layers so the y major voxel order makes long runs.
+		std::vector<uint16_t> runs = std::vector<uint16_t>();
+		uint16_t runIndex = 0;
+		uint16_t runLength = 0;
+
+		for (uint32_t i = 0; i < blocks.GetSize(); i++)
+		{
+			const BlockId id = blocks.Get(i);
+			uint16_t index = 0;
+
+			while (palette[index] != id)
+			{
+				index++;
+			}
+
+			if (runLength != 0 && (index != runIndex || runLength == UINT16_MAX))
+			{
+				runs.push_back(runLength);
+				runs.push_back(runIndex);
+				runLength = 0;
+			}
+
+			runIndex = index;
+			runLength++;
+		}
+
+		if (runLength != 0)
+		{
+			runs.push_back(runLength);
+			runs.push_back(runIndex);
+		}
+
+		const uint32_t runCount = static_cast<uint32_t>(runs.size() / 2);
+		append(&runCount, sizeof(uint32_t));
+		append(runs.data(), runs.size() * sizeof(uint16_t));
+	}
+
+	bool RegionFile::Decode(const char *data, const uint32_t &size, ChunkStorage *blocks)
+	{
+		uint32_t offset = 0;
+
+		auto read = [data, size, &offset](void *value, const size_t &length)
+		{
+			if (offset + length > size)
+			{
+				return false;
+			}
+
+			memcpy(value, data + offset, length);
+			offset += static_cast<uint32_t>(length);
+			return true;
+		};
+
+		uint16_t paletteSize = 0;
+
+		if (!read(&paletteSize, sizeof(uint16_t)) || paletteSize == 0)
+		{
+			return false;
+		}
+
+		std::vector<BlockId> palette = std::vector<BlockId>(paletteSize);
+
+		for (uint16_t i = 0; i < paletteSize; i++)
+		{
+			uint8_t length = 0;
+			char name[256];
+
+			if (!read(&length, sizeof(uint8_t)) || !read(name, length))
+			{
+				return false;
+			}
+
+			palette[i] = Block::Find(std::string(name, length));
+		}
+
+		uint32_t runCount = 0;
+
+		if (!read(&runCount, sizeof(uint32_t)) || runCount == 0 || runCount > blocks->GetSize())
+		{
+			return false;
+		}
+
+		std::vector<uint16_t> runs = std::vector<uint16_t>(runCount * 2);
+
+		if (!read(runs.data(), runs.size() * sizeof(uint16_t)))
+		{
+			return false;
+		}
+
+		if (runs[1] >= paletteSize || runs[0] > blocks->GetSize())
+		{
+			return false;
+		}
+
+		// Fills with the first run, then only the voxels that differ from it are set.
+		const BlockId fill = palette[runs[1]];
+		blocks->Fill(fill);
+		uint32_t voxel = runs[0];
+
+		for (uint32_t i = 1; i < runCount; i++)
+		{
+			const uint16_t length = runs[2 * i];
+			const uint16_t index = runs[2 * i + 1];
+
+			if (index >= paletteSize || voxel + length > blocks->GetSize())
+			{
+				return false;
+			}
+
+			if (palette[index] != fill)
+			{
+				for (uint32_t j = voxel; j < voxel + length; j++)
+				{
+					blocks->Set(j, palette[index]);
+				}
+			}
+
+			voxel += length;
+		}
+
+		blocks->Compact();
+		return voxel == blocks->GetSize();
+	}
+
+	void RegionFile::MapHeader()
+	{
+#ifdef FLOUNDER_PLATFORM_WINDOWS
+		HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file)));
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, 0, sizeof(RegionHeader), nullptr);
+
+		if (mapping != nullptr)
+		{
+			void *view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(RegionHeader));
+
+			if (view != nullptr)
+			{
+				m_header = static_cast<RegionHeader *>(view);
+				m_mapping = mapping;
+				m_mapped = true;
+				return;
+			}
+
+			CloseHandle(mapping);
+		}
+#else
+		void *view = mmap(nullptr, sizeof(RegionHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fileno(m_file), 0);
+
+		if (view != MAP_FAILED)
+		{
+			m_header = static_cast<RegionHeader *>(view);
+			m_mapped = true;
+			return;
+		}
+#endif
+
+		// Falls back to a copy of the header, entries are then written back one at a time.
+		m_header = new RegionHeader();
+		fseek(m_file, 0, SEEK_SET);
+
+		if (fread(m_header, sizeof(RegionHeader), 1, m_file) != 1)
+		{
+			delete m_header;
+			m_header = nullptr;
+		}
+	}
+
+	void RegionFile::UnmapHeader()
+	{
+		if (m_header == nullptr)
+		{
+			return;
+		}
+
+		if (m_mapped)
+		{
+#ifdef FLOUNDER_PLATFORM_WINDOWS
+			UnmapViewOfFile(m_header);
+			CloseHandle(static_cast<HANDLE>(m_mapping));
+#else
+			munmap(m_header, sizeof(RegionHeader));
+#endif
+		}
+		else
+		{
+			delete m_header;
+		}
+
+		m_header = nullptr;
+		m_mapping = nullptr;
+		m_mapped = false;
+	}
+
+	void RegionFile::WriteEntry(const uint32_t &index)
+	{
+		if (m_mapped)
+		{
+			return;
+		}
+
+		fseek(m_file, offsetof(RegionHeader, entries) + index * sizeof(RegionEntry), SEEK_SET);
+		fwrite(&m_header->entries[index], sizeof(RegionEntry), 1, m_file);
+		fflush(m_file);
+	}
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../Engine/Platform.hpp"
+#include "ChunkStorage.hpp"
+
+namespace Flounder
+{
+#define REGION_SIZE 16
+#define REGION_CHUNKS (REGION_SIZE * REGION_SIZE * REGION_SIZE)
+
+	/// <summary>
+	/// Where a chunks payload is stored in a region file, a zero size means the chunk was never saved.
+	/// </summary>
+	struct RegionEntry
+	{
+		uint32_t offset;
+		uint32_t size;
+		uint32_t capacity;
+		uint32_t padding;
+	};
+
+	/// <summary>
+	/// The table at the start of every region file.
+	/// </summary>
+	struct RegionHeader
+	{
+		char magic[4];
+		uint32_t version;
+		RegionEntry entries[REGION_CHUNKS];
+	};
+
+	/// <summary>
+	/// A file holding a cube of REGION_SIZE chunks on each axis.
+	/// The header is memory mapped, so finding a chunk does not touch the disk, and each chunk is stored as its palette by
+	/// block name followed by run length encoded palette indices. A payload is rewritten in place while it fits its slot,
+	/// otherwise it is moved to the end of the file. Every method is safe to call from worker threads.
+	/// </summary>
+	class F_EXPORT RegionFile
+	{
+	private:
+		std::string m_filename;
+		FILE *m_file;
+
+		RegionHeader *m_header;
+		void *m_mapping;
+		bool m_mapped;
+
+		std::mutex m_mutex;
+	public:
+		/// <summary>
+		/// Opens a region file, creating it if it does not exist.
+		/// </summary>
+		/// <param name="filename"> The region files path. </param>
+		RegionFile(const std::string &filename);
+
+		~RegionFile();
+
+		/// <summary>
+		/// Reads a chunk from the region.
+		/// </summary>
+		/// <param name="index"> The chunks index in the region. </param>
+		/// <param name="blocks"> The storage to read the voxels into. </param>
+		/// <returns> If the chunk was saved in this region. </returns>
+		bool Read(const uint32_t &index, ChunkStorage *blocks);
+
+		/// <summary>
+		/// Writes a chunk into the region.
+		/// </summary>
+		/// <param name="index"> The chunks index in the region. </param>
+		/// <param name="blocks"> The voxels to write. </param>
+		void Write(const uint32_t &index, const ChunkStorage &blocks);
+
+		/// <summary>
+		/// Gets if a chunk has been saved in this region.
+		/// </summary>
+		/// <param name="index"> The chunks index in the region. </param>
+		/// <returns> If the chunk is saved. </returns>
+		bool Contains(const uint32_t &index);
+
+		bool IsOpen() const { return m_file != nullptr && m_header != nullptr; }
+
+		std::string GetFilename() const { return m_filename; }
+
+		/// <summary>
+		/// Gets the index of a chunk inside of its region.
+		/// </summary>
+		/// <param name="x"> The chunks x coordinate, in chunks. </param>
+		/// <param name="y"> The chunks y coordinate, in chunks. </param>
+		/// <param name="z"> The chunks z coordinate, in chunks. </param>
+		/// <returns> The chunks index. </returns>
+		static uint32_t GetIndex(const int &x, const int &y, const int &z);
+
+		/// <summary>
+		/// Gets the region coordinate a chunk coordinate belongs to.
+		/// </summary>
+		/// <param name="chunk"> The chunk coordinate on one axis. </param>
+		/// <returns> The region coordinate on that axis. </returns>
+		static int GetRegion(const int &chunk);
+
+		/// <summary>
+		/// Encodes a chunk into its region payload.
+		/// </summary>
+		/// <param name="blocks"> The voxels to encode. </param>
+		/// <param name="data"> The payload to write into. </param>
+		static void Encode(const ChunkStorage &blocks, std::vector<char> *data);
+
+		/// <summary>
+		/// Decodes a region payload into a chunk.
+		/// </summary>
+		/// <param name="data"> The payload. </param>
+		/// <param name="size"> The payloads size in bytes. </param>
+		/// <param name="blocks"> The storage to read the voxels into. </param>
+		/// <returns> If the payload was valid. </returns>
+		static bool Decode(const char *data, const uint32_t &size, ChunkStorage *blocks);
+	private:
+		void MapHeader();
+
+		void UnmapHeader();
+
+		void WriteEntry(const uint32_t &index);
+	};
+}
@@ -6,20 +6,29 @@
 #include "../Scenes/Scenes.hpp"
 #include "UbosVoxels.hpp"
 #include "VoxelRender.hpp"
+#include "VoxelVertex.hpp"
 
 namespace Flounder
 {
 	RendererVoxels::RendererVoxels(const GraphicsStage &graphicsStage) :
 		IRenderer(),
 		m_uniformScene(new UniformBuffer(sizeof(UbosVoxels::UboScene))),
+		m_uniformBlocks(new UniformBuffer(sizeof(UbosVoxels::UboBlocks))),
+		m_blocksVersion(UINT32_MAX),
+		m_quadIndices(nullptr),
 		m_pipeline(new Pipeline(graphicsStage, PipelineCreate({"Resources/Shaders/Voxels/Voxel.vert", "Resources/Shaders/Voxels/Voxel.frag"},
-			VertexModel::GetBindingDescriptions(), PIPELINE_MRT, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT), { }))
+			VoxelVertex::GetBindingDescriptions(), PIPELINE_MRT, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT, VoxelVertex::GetAttributeDescriptions()), { }))
 	{
+		// Every chunk is made of quads with the same corner order, so they all share one index buffer.
+		std::vector<uint16_t> indices = VoxelVertex::GetQuadIndices(VOXEL_MAX_QUADS);
+		m_quadIndices = new IndexBuffer(VK_INDEX_TYPE_UINT16, sizeof(uint16_t), indices.size(), indices.data());
 	}
 
 	RendererVoxels::~RendererVoxels()
 	{
 		delete m_uniformScene;
+		delete m_uniformBlocks;
+		delete m_quadIndices;
 		delete m_pipeline;
 	}
 
@@ -30,14 +39,29 @@ namespace Flounder
 		uboScene.view = *camera.GetViewMatrix();
 		m_uniformScene->Update(&uboScene);
 
+		// Block colours are looked up by the shader, they are only uploaded when a block type changes.
+		if (m_blocksVersion != Block::GetVersion())
+		{
+			UbosVoxels::UboBlocks uboBlocks = {};
+
+			for (uint32_t i = 0; i < Block::GetCount(); i++)
+			{
+				uboBlocks.colours[i] = *Block::Get(static_cast<BlockId>(i))->GetColour();
+			}
+
+			m_uniformBlocks->Update(&uboBlocks);
+			m_blocksVersion = Block::GetVersion();
+		}
+
 		m_pipeline->BindPipeline(commandBuffer);
+		vkCmdBindIndexBuffer(commandBuffer, m_quadIndices->GetBuffer(), 0, m_quadIndices->GetIndexType());
 
 		std::vector<VoxelRender *> renderList = std::vector<VoxelRender *>();
 		Scenes::Get()->GetStructure()->QueryComponents<VoxelRender>(&renderList);
 
 		for (auto entityRender : renderList)
 		{
-			entityRender->CmdRender(commandBuffer, *m_pipeline, m_uniformScene);
+			entityRender->CmdRender(commandBuffer, *m_pipeline, m_uniformScene, m_uniformBlocks);
 		}
 	}
 }
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "../Renderer/IRenderer.hpp"
+#include "../Renderer/Buffers/IndexBuffer.hpp"
 #include "../Renderer/Buffers/UniformBuffer.hpp"
 #include "../Renderer/Pipelines/Pipeline.hpp"
 
@@ -11,6 +12,9 @@ namespace Flounder
 	{
 	private:
 		UniformBuffer *m_uniformScene;
+		UniformBuffer *m_uniformBlocks;
+		uint32_t m_blocksVersion;
+		IndexBuffer *m_quadIndices;
 		Pipeline *m_pipeline;
 	public:
 		RendererVoxels(const GraphicsStage &graphicsStage);
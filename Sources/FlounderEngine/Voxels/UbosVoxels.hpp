@@ -4,6 +4,7 @@
 #include "../Maths/Matrix4.hpp"
 #include "../Maths/Vector2.hpp"
 #include "../Maths/Vector4.hpp"
+#include "Block.hpp"
 
 namespace Flounder
 {
@@ -19,6 +20,12 @@ namespace Flounder
 		struct UboObject
 		{
 			Matrix4 transform;
+			Vector4 planet;
+		};
+
+		struct UboBlocks
+		{
+			Colour colours[MAX_BLOCKS];
 		};
 	};
 }
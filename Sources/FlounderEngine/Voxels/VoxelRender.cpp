@@ -6,6 +6,7 @@
 #include "../Materials/Material.hpp"
 #include "../Physics/Rigidbody.hpp"
 #include "../Scenes/Scenes.hpp"
+#include "Chunk.hpp"
 #include "UbosVoxels.hpp"
 
 namespace Flounder
@@ -13,7 +14,8 @@ namespace Flounder
 	VoxelRender::VoxelRender() :
 		Component(),
 		m_uniformObject(new UniformBuffer(sizeof(UbosVoxels::UboObject))),
-		m_descriptorSet(nullptr)
+		m_descriptorSet(nullptr),
+		m_planet(new Vector4())
 	{
 	}
 
@@ -21,13 +23,17 @@ namespace Flounder
 	{
 		delete m_uniformObject;
 		delete m_descriptorSet;
+		delete m_planet;
 	}
 
 	void VoxelRender::Update()
 	{
 		// Updates uniforms.
+		// Vertices are packed in voxels, the transform scales them to the voxel size.
 		UbosVoxels::UboObject uboObject = {};
 		GetGameObject()->GetTransform()->GetWorldMatrix(&uboObject.transform);
+		Matrix4::Scale(uboObject.transform, Vector3(Chunk::VOXEL_SIZE, Chunk::VOXEL_SIZE, Chunk::VOXEL_SIZE), &uboObject.transform);
+		uboObject.planet = *m_planet;
 		m_uniformObject->Update(&uboObject);
 	}
 
@@ -39,7 +45,7 @@ namespace Flounder
 	{
 	}
 
-	void VoxelRender::CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene)
+	void VoxelRender::CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene, UniformBuffer *uniformBlocks)
 	{
 		// Gets required components.
 		auto mesh = GetGameObject()->GetComponent<Mesh>();
@@ -67,11 +73,13 @@ namespace Flounder
 
 		m_descriptorSet->Update({
 			uniformScene,
-			m_uniformObject
+			m_uniformObject,
+			uniformBlocks
 		});
 
-		// Draws the object.
+		// Draws the object, every 4 vertices are a quad drawn with 6 of the shared indices.
 		m_descriptorSet->BindDescriptor(commandBuffer);
-		mesh->GetModel()->CmdRender(commandBuffer);
+		mesh->GetModel()->CmdBind(commandBuffer);
+		vkCmdDrawIndexed(commandBuffer, 6 * (mesh->GetModel()->GetVertexBuffer()->GetVertexCount() / 4), 1, 0, 0, 0);
 	}
 }
@@ -3,6 +3,7 @@
 #include <vector>
 #include "../Engine/Platform.hpp"
 #include "../Objects/Component.hpp"
+#include "../Maths/Vector4.hpp"
 #include "../Objects/GameObject.hpp"
 #include "../Renderer/Pipelines/Pipeline.hpp"
 #include "../Renderer/Buffers/UniformBuffer.hpp"
@@ -18,6 +19,7 @@ namespace Flounder
 	private:
 		UniformBuffer *m_uniformObject;
 		DescriptorSet *m_descriptorSet;
+		Vector4 *m_planet;
 	public:
 		VoxelRender();
 
@@ -29,10 +31,24 @@ namespace Flounder
 
 		void Write(LoadedValue *value) override;
 
-		void CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene);
+		/// <summary>
+		/// Draws the chunks packed vertices, the shared quad index buffer must already be bound.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="pipeline"> The voxel pipeline. </param>
+		/// <param name="uniformScene"> The scene uniforms. </param>
+		/// <param name="uniformBlocks"> The block colour uniforms. </param>
+		void CmdRender(const VkCommandBuffer &commandBuffer, const Pipeline &pipeline, UniformBuffer *uniformScene, UniformBuffer *uniformBlocks);
 
 		std::string GetName() const override { return "VoxelRender"; };
 
 		UniformBuffer *GetUniformObject() const { return m_uniformObject; }
+
+		/// <summary>
+		/// Bends the chunk onto a cube-sphere planet, the chunks up axis has to face out of a side of the cube.
+		/// </summary>
+		/// <param name="centre"> The planets centre. </param>
+		/// <param name="radius"> The planets radius, zero draws the chunk flat. </param>
+		void SetPlanet(const Vector3 &centre, const float &radius) { m_planet->Set(centre.m_x, centre.m_y, centre.m_z, radius); }
 	};
 }
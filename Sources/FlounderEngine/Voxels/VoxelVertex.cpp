@@ -0,0 +1,53 @@
+#include "VoxelVertex.hpp"
+
+namespace Flounder
+{
+	VoxelVertex::VoxelVertex(const uint32_t &x, const uint32_t &y, const uint32_t &z, const BlockFace &face, const uint32_t &ambientOcclusion, const BlockId &block) :
+		m_data((x & 31) | ((y & 31) << 5) | ((z & 31) << 10) | ((static_cast<uint32_t>(face) & 7) << 15) | ((ambientOcclusion & 3) << 18) | ((static_cast<uint32_t>(block) & 255) << 20))
+	{
+	}
+
+	std::vector<uint16_t> VoxelVertex::GetQuadIndices(const uint32_t &quads)
+	{
+		std::vector<uint16_t> indices = std::vector<uint16_t>();
+		indices.reserve(6 * quads);
+
+		for (uint32_t i = 0; i < quads; i++)
+		{
+			const uint16_t start = static_cast<uint16_t>(4 * i);
+			indices.push_back(start + 2);
+			indices.push_back(start + 3);
+			indices.push_back(start + 1);
+			indices.push_back(start + 1);
+			indices.push_back(start + 0);
+			indices.push_back(start + 2);
+		}
+
+		return indices;
+	}
+
+	std::vector<VkVertexInputBindingDescription> VoxelVertex::GetBindingDescriptions()
+	{
+		std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
+
+		// The vertex input description.
+		bindingDescriptions[0].binding = 0;
+		bindingDescriptions[0].stride = sizeof(VoxelVertex);
+		bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+		return bindingDescriptions;
+	}
+
+	std::vector<VkVertexInputAttributeDescription> VoxelVertex::GetAttributeDescriptions()
+	{
+		std::vector<VkVertexInputAttributeDescription> attributeDescriptions(1);
+
+		// Packed data attribute.
+		attributeDescriptions[0].binding = 0;
+		attributeDescriptions[0].location = 0;
+		attributeDescriptions[0].format = VK_FORMAT_R32_UINT;
+		attributeDescriptions[0].offset = offsetof(VoxelVertex, m_data);
+
+		return attributeDescriptions;
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include "../Engine/Platform.hpp"
+#include "Block.hpp"
+
+namespace Flounder
+{
+#define VOXEL_MAX_QUADS 16384
+
+	/// <summary>
+	/// A voxel vertex packed into 32 bits, decoded by Voxel.vert.
+	/// Bits 0 to 14 hold the position in the chunk, 5 bits per axis in voxels, bits 15 to 17 the face, bits 18 and 19 the
+	/// ambient occlusion and bits 20 to 27 the block id. Vertices are always written as quads of 4, in the order drawn by
+	/// the shared quad index buffer, which has 16 bit indices so a chunk can have at most VOXEL_MAX_QUADS quads.
+	/// </summary>
+	class F_EXPORT VoxelVertex
+	{
+	public:
+		uint32_t m_data;
+
+		/// <summary>
+		/// Creates a new packed voxel vertex.
+		/// </summary>
+		/// <param name="x"> The x position in the chunk, in voxels. </param>
+		/// <param name="y"> The y position in the chunk, in voxels. </param>
+		/// <param name="z"> The z position in the chunk, in voxels. </param>
+		/// <param name="face"> The face the vertex belongs to, the shader looks up its normal. </param>
+		/// <param name="ambientOcclusion"> How open the corner is, from 0 (fully occluded) to 3. </param>
+		/// <param name="block"> The block id, the shader looks up its colour. </param>
+		VoxelVertex(const uint32_t &x, const uint32_t &y, const uint32_t &z, const BlockFace &face, const uint32_t &ambientOcclusion, const BlockId &block);
+
+		/// <summary>
+		/// Fills an index buffer with the indices for a number of quads, every chunk is drawn with the same indices.
+		/// </summary>
+		/// <param name="quads"> The number of quads. </param>
+		/// <returns> The quad indices. </returns>
+		static std::vector<uint16_t> GetQuadIndices(const uint32_t &quads);
+
+		static std::vector<VkVertexInputBindingDescription> GetBindingDescriptions();
+
+		static std::vector<VkVertexInputAttributeDescription> GetAttributeDescriptions();
+	};
+}
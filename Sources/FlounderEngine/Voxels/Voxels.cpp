@@ -0,0 +1,445 @@
+#include "Voxels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "../Helpers/FileSystem.hpp"
+#include "../Tasks/Tasks.hpp"
+#include "Chunk.hpp"
+
+namespace Flounder
+{
+	Voxels::Voxels() :
+		IModule(),
+		m_uploadsPerFrame(4),
+		m_uploads(0),
+		m_chunks(std::unordered_map<uint64_t, Chunk *>()),
+		m_generator(new ChunkGenerator()),
+		m_timerThroughput(new Timer(1.0f)),
+		m_worldFolder(""),
+		m_regions(std::unordered_map<uint64_t, std::shared_ptr<RegionFile>>()),
+		m_regionOrder(std::vector<uint64_t>()),
+		m_regionWrites(std::unordered_map<uint64_t, uint32_t>()),
+		m_pendingWrites(std::unordered_map<uint64_t, std::shared_ptr<ChunkStorage>>()),
+		m_writes(std::vector<std::future<void>>()),
+		m_regionMutex(),
+		m_writeMutex()
+	{
+		SetWorldFolder("Saves/World");
+	}
+
+	Voxels::~Voxels()
+	{
+		// Chunks are saved as they are destroyed, every write has to land before the regions are closed.
+		for (auto &write : m_writes)
+		{
+			write.wait();
+		}
+
+		delete m_generator;
+		delete m_timerThroughput;
+	}
+
+	void Voxels::Update()
+	{
+		m_uploads = 0;
+
+		for (auto it = m_writes.begin(); it != m_writes.end();)
+		{
+			if (it->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			{
+				it = m_writes.erase(it);
+				continue;
+			}
+
+			++it;
+		}
+
+		if (m_timerThroughput->IsPassedTime())
+		{
+			m_timerThroughput->ResetStartTime();
+			m_generator->SampleThroughput(m_timerThroughput->GetInterval());
+
+#if FLOUNDER_VERBOSE
+			if (m_generator->GetChunksPerSecond() != 0.0f)
+			{
+				printf("Voxels generated %f chunks/s, %fms per chunk\n", m_generator->GetChunksPerSecond(), m_generator->GetAverageTime());
+			}
+#endif
+		}
+	}
+
+	bool Voxels::RequestUpload()
+	{
+		if (m_uploads >= m_uploadsPerFrame)
+		{
+			return false;
+		}
+
+		m_uploads++;
+		return true;
+	}
+
+	void Voxels::AddChunk(Chunk *chunk, const int &x, const int &y, const int &z)
+	{
+		m_chunks[GetKey(x, y, z)] = chunk;
+	}
+
+	void Voxels::RemoveChunk(Chunk *chunk, const int &x, const int &y, const int &z)
+	{
+		auto it = m_chunks.find(GetKey(x, y, z));
+
+		if (it != m_chunks.end() && it->second == chunk)
+		{
+			m_chunks.erase(it);
+		}
+	}
+
+	Chunk *Voxels::GetChunk(const int &x, const int &y, const int &z) const
+	{
+		auto it = m_chunks.find(GetKey(x, y, z));
+		return it != m_chunks.end() ? it->second : nullptr;
+	}
+
+	bool Voxels::ReadChunk(const int &x, const int &y, const int &z, ChunkStorage *blocks)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_writeMutex);
+			auto it = m_pendingWrites.find(GetKey(x, y, z));
+
+			if (it != m_pendingWrites.end())
+			{
+				*blocks = *it->second;
+				return true;
+			}
+		}
+
+		// Chunks in regions that were never written are not saved, reading them does not create the region file.
+		std::shared_ptr<RegionFile> region = GetRegion(x, y, z, false);
+		return region != nullptr && region->Read(RegionFile::GetIndex(x, y, z), blocks);
+	}
+
+	void Voxels::SaveChunk(const int &x, const int &y, const int &z, const ChunkStorage &blocks)
+	{
+		const uint64_t key = GetKey(x, y, z);
+		const uint64_t regionKey = GetRegionKey(x, y, z);
+		std::shared_ptr<ChunkStorage> copy = std::make_shared<ChunkStorage>(blocks);
+
+		{
+			// Pins the region until the write lands, so it is not closed and opened a second time while the write is queued.
+			std::unique_lock<std::mutex> lock(m_regionMutex);
+			m_regionWrites[regionKey]++;
+		}
+
+		{
+			// Reads see the newest copy until it is written, even if an older write of the chunk is still queued.
+			std::unique_lock<std::mutex> lock(m_writeMutex);
+			m_pendingWrites[key] = copy;
+		}
+
+		m_writes.push_back(Tasks::Get()->GetThreadPool()->Enqueue([this, x, y, z, key, regionKey, copy]()
+		{
+			std::shared_ptr<RegionFile> region = GetRegion(x, y, z, true);
+			region->Write(RegionFile::GetIndex(x, y, z), *copy);
+
+			{
+				std::unique_lock<std::mutex> lock(m_writeMutex);
+				auto it = m_pendingWrites.find(key);
+
+				if (it != m_pendingWrites.end() && it->second == copy)
+				{
+					m_pendingWrites.erase(it);
+				}
+			}
+
+			std::unique_lock<std::mutex> lock(m_regionMutex);
+			auto it = m_regionWrites.find(regionKey);
+
+			if (it != m_regionWrites.end() && --it->second == 0)
+			{
+				m_regionWrites.erase(it);
+			}
+		}));
+	}
+
+	BlockId Voxels::GetBlock(const int &x, const int &y, const int &z) const
+	{
+		ChunkCache cache = {};
+		return GetBlock(x, y, z, &cache);
+	}
+
+	bool Voxels::Raycast(const Vector3 &origin, const Vector3 &direction, const float &maxDistance, VoxelHit *hit) const
+	{
+		const float length = direction.Length();
+
+		if (length == 0.0f)
+		{
+			return false;
+		}
+
+		// The walk is done in voxel units, so every voxel is one unit wide.
+		const float start[3] = {origin.m_x / Chunk::VOXEL_SIZE, origin.m_y / Chunk::VOXEL_SIZE, origin.m_z / Chunk::VOXEL_SIZE};
+		const float ray[3] = {direction.m_x / length, direction.m_y / length, direction.m_z / length};
+		const float maxT = maxDistance / Chunk::VOXEL_SIZE;
+
+		// The faces a ray enters a voxel through when stepping in the positive and negative direction of each axis.
+		const BlockFace entered[3][2] = {{FaceLeft, FaceRight}, {FaceDown, FaceUp}, {FaceFront, FaceBack}};
+
+		int voxel[3];
+		int step[3];
+		float tMax[3];
+		float tDelta[3];
+		int axis = 0;
+
+		for (int i = 0; i < 3; i++)
+		{
+			voxel[i] = static_cast<int>(std::floor(start[i]));
+
+			if (ray[i] > 0.0f)
+			{
+				step[i] = 1;
+				tDelta[i] = 1.0f / ray[i];
+				tMax[i] = (static_cast<float>(voxel[i]) + 1.0f - start[i]) * tDelta[i];
+			}
+			else if (ray[i] < 0.0f)
+			{
+				step[i] = -1;
+				tDelta[i] = -1.0f / ray[i];
+				tMax[i] = (start[i] - static_cast<float>(voxel[i])) * tDelta[i];
+			}
+			else
+			{
+				step[i] = 0;
+				tDelta[i] = std::numeric_limits<float>::infinity();
+				tMax[i] = std::numeric_limits<float>::infinity();
+			}
+
+			// A ray starting inside a filled voxel reports the face of its main axis.
+			if (std::fabs(ray[i]) > std::fabs(ray[axis]))
+			{
+				axis = i;
+			}
+		}
+
+		ChunkCache cache = {};
+		float t = 0.0f;
+
+		while (t <= maxT)
+		{
+			const BlockId block = GetBlock(voxel[0], voxel[1], voxel[2], &cache);
+
+			if (Block::IsFilled(block))
+			{
+				hit->x = voxel[0];
+				hit->y = voxel[1];
+				hit->z = voxel[2];
+				hit->face = entered[axis][step[axis] > 0 ? 0 : 1];
+				hit->block = block;
+				hit->distance = t * Chunk::VOXEL_SIZE;
+				return true;
+			}
+
+			// Steps into whichever neighbour the ray reaches first.
+			axis = (tMax[0] < tMax[1]) ? (tMax[0] < tMax[2] ? 0 : 2) : (tMax[1] < tMax[2] ? 1 : 2);
+			voxel[axis] += step[axis];
+			t = tMax[axis];
+			tMax[axis] += tDelta[axis];
+		}
+
+		return false;
+	}
+
+	Vector3 *Voxels::ResolveCollision(const ColliderAabb &aabb, const Vector3 &positionDelta, Vector3 *destination) const
+	{
+		if (destination == nullptr)
+		{
+			destination = new Vector3();
+		}
+
+		// Small enough to ignore float error, so boxes resting against a voxel are not counted as overlapping it.
+		const float epsilon = 0.0001f;
+		const float size = Chunk::VOXEL_SIZE;
+
+		float minimum[3] = {aabb.GetMinExtents()->m_x / size, aabb.GetMinExtents()->m_y / size, aabb.GetMinExtents()->m_z / size};
+		float maximum[3] = {aabb.GetMaxExtents()->m_x / size, aabb.GetMaxExtents()->m_y / size, aabb.GetMaxExtents()->m_z / size};
+		float delta[3] = {positionDelta.m_x / size, positionDelta.m_y / size, positionDelta.m_z / size};
+		const int order[3] = {1, 0, 2};
+
+		ChunkCache cache = {};
+
+		for (auto axis : order)
+		{
+			if (delta[axis] == 0.0f)
+			{
+				continue;
+			}
+
+			// The voxels the box covers on the other two axes.
+			int lower[3];
+			int upper[3];
+
+			for (int i = 0; i < 3; i++)
+			{
+				lower[i] = static_cast<int>(std::floor(minimum[i] + epsilon));
+				upper[i] = static_cast<int>(std::ceil(maximum[i] - epsilon)) - 1;
+			}
+
+			// Walks the layers of voxels in front of the box, nearest first, until one has a filled voxel.
+			if (delta[axis] > 0.0f)
+			{
+				const int first = static_cast<int>(std::ceil(maximum[axis] - epsilon));
+				const int last = static_cast<int>(std::ceil(maximum[axis] + delta[axis])) - 1;
+
+				for (int layer = first; layer <= last; layer++)
+				{
+					if (IsSlabFilled(axis, layer, lower, upper, &cache))
+					{
+						delta[axis] = std::max(static_cast<float>(layer) - maximum[axis], 0.0f);
+						break;
+					}
+				}
+			}
+			else
+			{
+				const int first = static_cast<int>(std::floor(minimum[axis] + epsilon)) - 1;
+				const int last = static_cast<int>(std::floor(minimum[axis] + delta[axis]));
+
+				for (int layer = first; layer >= last; layer--)
+				{
+					if (IsSlabFilled(axis, layer, lower, upper, &cache))
+					{
+						delta[axis] = std::min(static_cast<float>(layer + 1) - minimum[axis], 0.0f);
+						break;
+					}
+				}
+			}
+
+			minimum[axis] += delta[axis];
+			maximum[axis] += delta[axis];
+		}
+
+		return destination->Set(delta[0] * size, delta[1] * size, delta[2] * size);
+	}
+
+	void Voxels::SetGenerator(ChunkGenerator *generator)
+	{
+		delete m_generator;
+		m_generator = generator;
+	}
+
+	void Voxels::SetWorldFolder(const std::string &worldFolder)
+	{
+		m_worldFolder = worldFolder;
+
+		// Creates each folder in the path, the file system only creates the last one.
+		for (size_t i = m_worldFolder.find_first_of("\\/"); i != std::string::npos; i = m_worldFolder.find_first_of("\\/", i + 1))
+		{
+			FileSystem::CreateFolder(m_worldFolder.substr(0, i));
+		}
+
+		FileSystem::CreateFolder(m_worldFolder);
+	}
+
+	std::shared_ptr<RegionFile> Voxels::GetRegion(const int &x, const int &y, const int &z, const bool &create)
+	{
+		const int regionX = RegionFile::GetRegion(x);
+		const int regionY = RegionFile::GetRegion(y);
+		const int regionZ = RegionFile::GetRegion(z);
+		const uint64_t key = GetKey(regionX, regionY, regionZ);
+
+		std::unique_lock<std::mutex> lock(m_regionMutex);
+		auto it = m_regions.find(key);
+
+		if (it != m_regions.end())
+		{
+			return it->second;
+		}
+
+		const std::string filename = m_worldFolder + "/r." + std::to_string(regionX) + "." + std::to_string(regionY) + "." + std::to_string(regionZ) + ".fvr";
+
+		if (!create && !FileSystem::FileExists(filename))
+		{
+			return nullptr;
+		}
+
+		// Closes the oldest region nothing is using, regions with queued writes or open readers stay open so a path is never opened twice.
+		// When every region is in use the limit is passed until one is released.
+		if (m_regions.size() >= MAX_OPEN_REGIONS)
+		{
+			for (auto order = m_regionOrder.begin(); order != m_regionOrder.end(); ++order)
+			{
+				auto region = m_regions.find(*order);
+
+				if (m_regionWrites.find(*order) == m_regionWrites.end() && region->second.use_count() == 1)
+				{
+					m_regions.erase(region);
+					m_regionOrder.erase(order);
+					break;
+				}
+			}
+		}
+
+		std::shared_ptr<RegionFile> region = std::make_shared<RegionFile>(filename);
+		m_regions.emplace(key, region);
+		m_regionOrder.push_back(key);
+		return region;
+	}
+
+	BlockId Voxels::GetBlock(const int &x, const int &y, const int &z, ChunkCache *cache) const
+	{
+		// Floors towards negative infinity, so voxel -1 is in chunk -1.
+		const int chunkX = (x >= 0 ? x : x - Chunk::CHUNK_WIDTH + 1) / Chunk::CHUNK_WIDTH;
+		const int chunkY = (y >= 0 ? y : y - Chunk::CHUNK_HEIGHT + 1) / Chunk::CHUNK_HEIGHT;
+		const int chunkZ = (z >= 0 ? z : z - Chunk::CHUNK_WIDTH + 1) / Chunk::CHUNK_WIDTH;
+
+		// Neighbouring queries are usually in the same chunk, so the map is only searched when the chunk changes.
+		if (!cache->valid || cache->x != chunkX || cache->y != chunkY || cache->z != chunkZ)
+		{
+			cache->chunk = GetChunk(chunkX, chunkY, chunkZ);
+			cache->x = chunkX;
+			cache->y = chunkY;
+			cache->z = chunkZ;
+			cache->valid = true;
+		}
+
+		if (cache->chunk == nullptr)
+		{
+			return BLOCK_AIR;
+		}
+
+		return cache->chunk->GetBlock(x - chunkX * Chunk::CHUNK_WIDTH, y - chunkY * Chunk::CHUNK_HEIGHT, z - chunkZ * Chunk::CHUNK_WIDTH);
+	}
+
+	bool Voxels::IsSlabFilled(const int &axis, const int &layer, const int *lower, const int *upper, ChunkCache *cache) const
+	{
+		int voxel[3];
+		voxel[axis] = layer;
+		const int u = (axis + 1) % 3;
+		const int v = (axis + 2) % 3;
+
+		for (voxel[u] = lower[u]; voxel[u] <= upper[u]; voxel[u]++)
+		{
+			for (voxel[v] = lower[v]; voxel[v] <= upper[v]; voxel[v]++)
+			{
+				if (Block::IsFilled(GetBlock(voxel[0], voxel[1], voxel[2], cache)))
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	uint64_t Voxels::GetKey(const int &x, const int &y, const int &z)
+	{
+		// 21 bits per axis, enough for a million chunks in each direction.
+		const uint64_t mask = (static_cast<uint64_t>(1) << 21) - 1;
+		return (static_cast<uint64_t>(x) & mask) | ((static_cast<uint64_t>(y) & mask) << 21) | ((static_cast<uint64_t>(z) & mask) << 42);
+	}
+
+	uint64_t Voxels::GetRegionKey(const int &x, const int &y, const int &z)
+	{
+		return GetKey(RegionFile::GetRegion(x), RegionFile::GetRegion(y), RegionFile::GetRegion(z));
+	}
+}
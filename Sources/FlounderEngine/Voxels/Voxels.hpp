@@ -0,0 +1,213 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "../Engine/Engine.hpp"
+#include "../Maths/Timer.hpp"
+#include "../Physics/ColliderAabb.hpp"
+#include "../Physics/Ray.hpp"
+#include "ChunkGenerator.hpp"
+#include "RegionFile.hpp"
+
+namespace Flounder
+{
+	class Chunk;
+
+#define MAX_OPEN_REGIONS 32
+
+	/// <summary>
+	/// The voxel a raycast hit, in world voxel coordinates.
+	/// </summary>
+	struct VoxelHit
+	{
+		int x;
+		int y;
+		int z;
+		BlockFace face;
+		BlockId block;
+		float distance;
+	};
+
+	/// <summary>
+	/// A module used for managing voxel worlds.
+	/// </summary>
+	class F_EXPORT Voxels :
+		public IModule
+	{
+	private:
+		struct ChunkCache
+		{
+			Chunk *chunk;
+			int x;
+			int y;
+			int z;
+			bool valid;
+		};
+
+		uint32_t m_uploadsPerFrame;
+		uint32_t m_uploads;
+
+		std::unordered_map<uint64_t, Chunk *> m_chunks;
+
+		ChunkGenerator *m_generator;
+		Timer *m_timerThroughput;
+
+		std::string m_worldFolder;
+		std::unordered_map<uint64_t, std::shared_ptr<RegionFile>> m_regions;
+		std::vector<uint64_t> m_regionOrder;
+		std::unordered_map<uint64_t, uint32_t> m_regionWrites;
+		std::unordered_map<uint64_t, std::shared_ptr<ChunkStorage>> m_pendingWrites;
+		std::vector<std::future<void>> m_writes;
+		std::mutex m_regionMutex;
+		std::mutex m_writeMutex;
+	public:
+		/// <summary>
+		/// Gets this engine instance.
+		/// </summary>
+		/// <returns> The current module instance. </returns>
+		static Voxels *Get()
+		{
+			return reinterpret_cast<Voxels *>(Engine::Get()->GetModule("voxels"));
+		}
+
+		/// <summary>
+		/// Creates a new voxels module.
+		/// </summary>
+		Voxels();
+
+		/// <summary>
+		/// Deconstructor for the voxels module.
+		/// </summary>
+		~Voxels();
+
+		void Update() override;
+
+		/// <summary>
+		/// Takes one chunk mesh upload from this updates budget.
+		/// </summary>
+		/// <returns> If the upload can happen this update, otherwise it should be retried on the next one. </returns>
+		bool RequestUpload();
+
+		/// <summary>
+		/// Adds a chunk to the chunk map, so its neighbours can find it.
+		/// </summary>
+		/// <param name="chunk"> The chunk to add. </param>
+		/// <param name="x"> The chunks x coordinate, in chunks. </param>
+		/// <param name="y"> The chunks y coordinate, in chunks. </param>
+		/// <param name="z"> The chunks z coordinate, in chunks. </param>
+		void AddChunk(Chunk *chunk, const int &x, const int &y, const int &z);
+
+		/// <summary>
+		/// Removes a chunk from the chunk map.
+		/// </summary>
+		/// <param name="chunk"> The chunk to remove. </param>
+		/// <param name="x"> The chunks x coordinate, in chunks. </param>
+		/// <param name="y"> The chunks y coordinate, in chunks. </param>
+		/// <param name="z"> The chunks z coordinate, in chunks. </param>
+		void RemoveChunk(Chunk *chunk, const int &x, const int &y, const int &z);
+
+		/// <summary>
+		/// Finds a chunk in the chunk map.
+		/// </summary>
+		/// <param name="x"> The chunks x coordinate, in chunks. </param>
+		/// <param name="y"> The chunks y coordinate, in chunks. </param>
+		/// <param name="z"> The chunks z coordinate, in chunks. </param>
+		/// <returns> The chunk, or nullptr if none is loaded there. </returns>
+		Chunk *GetChunk(const int &x, const int &y, const int &z) const;
+
+		/// <summary>
+		/// Reads a saved chunk from its region file, chunks still waiting to be written are read from memory.
+		/// This is safe to call from worker threads.
+		/// </summary>
+		/// <param name="x"> The chunks x coordinate, in chunks. </param>
+		/// <param name="y"> The chunks y coordinate, in chunks. </param>
+		/// <param name="z"> The chunks z coordinate, in chunks. </param>
+		/// <param name="blocks"> The storage to read the voxels into. </param>
+		/// <returns> If the chunk has been saved. </returns>
+		bool ReadChunk(const int &x, const int &y, const int &z, ChunkStorage *blocks);
+
+		/// <summary>
+		/// Queues a copy of a chunk to be written into its region file on a worker thread.
+		/// </summary>
+		/// <param name="x"> The chunks x coordinate, in chunks. </param>
+		/// <param name="y"> The chunks y coordinate, in chunks. </param>
+		/// <param name="z"> The chunks z coordinate, in chunks. </param>
+		/// <param name="blocks"> The voxels to save. </param>
+		void SaveChunk(const int &x, const int &y, const int &z, const ChunkStorage &blocks);
+
+		ChunkGenerator *GetGenerator() const { return m_generator; }
+
+		/// <summary>
+		/// Sets the generator new chunks are made with, this should be done before any chunk is generated.
+		/// </summary>
+		/// <param name="generator"> The new generator, the module takes ownership of it. </param>
+		void SetGenerator(ChunkGenerator *generator);
+
+		std::string GetWorldFolder() const { return m_worldFolder; }
+
+		/// <summary>
+		/// Sets the folder region files are kept in, regions already opened stay open.
+		/// </summary>
+		/// <param name="worldFolder"> The world folder. </param>
+		void SetWorldFolder(const std::string &worldFolder);
+
+		/// <summary>
+		/// Gets the block at a voxel in the world, voxels in chunks that are not loaded are air.
+		/// </summary>
+		/// <param name="x"> The voxels x coordinate, in voxels. </param>
+		/// <param name="y"> The voxels y coordinate, in voxels. </param>
+		/// <param name="z"> The voxels z coordinate, in voxels. </param>
+		/// <returns> The block id. </returns>
+		BlockId GetBlock(const int &x, const int &y, const int &z) const;
+
+		/// <summary>
+		/// Walks a ray through the voxel grid one voxel at a time (Amanatides and Woo) and finds the first filled voxel.
+		/// Chunks are only looked up when the ray crosses into a new one, and nothing is allocated, so it can be run many
+		/// times a frame. Queries read the chunk map, so they have to be made from the main thread.
+		/// </summary>
+		/// <param name="origin"> The rays origin, in world space. </param>
+		/// <param name="direction"> The rays direction, it does not need to be normalized. </param>
+		/// <param name="maxDistance"> How far to walk the ray, in world units. </param>
+		/// <param name="hit"> The hit to fill in, it is left untouched if nothing is hit. </param>
+		/// <returns> If a filled voxel was hit. </returns>
+		bool Raycast(const Vector3 &origin, const Vector3 &direction, const float &maxDistance, VoxelHit *hit) const;
+
+		/// <summary>
+		/// Walks a ray through the voxel grid and finds the first filled voxel.
+		/// </summary>
+		/// <param name="ray"> The ray, such as a mouse picking ray. </param>
+		/// <param name="maxDistance"> How far to walk the ray, in world units. </param>
+		/// <param name="hit"> The hit to fill in, it is left untouched if nothing is hit. </param>
+		/// <returns> If a filled voxel was hit. </returns>
+		bool Raycast(const Ray &ray, const float &maxDistance, VoxelHit *hit) const { return Raycast(*ray.m_origin, *ray.m_currentRay, maxDistance, hit); }
+
+		/// <summary>
+		/// Sweeps a box through the voxel grid and shortens its movement so it stops against filled voxels.
+		/// The box is moved along y, then x, then z, so it slides along walls and floors. An axis of the result that is
+		/// shorter than the movement asked for has collided, such as a character landing on the ground.
+		/// </summary>
+		/// <param name="aabb"> The box, in world space, it should not already be inside of filled voxels. </param>
+		/// <param name="positionDelta"> The movement of the box. </param>
+		/// <param name="destination"> The movement that can be made. </param>
+		/// <returns> The destination. </returns>
+		Vector3 *ResolveCollision(const ColliderAabb &aabb, const Vector3 &positionDelta, Vector3 *destination) const;
+
+		uint32_t GetChunkCount() const { return static_cast<uint32_t>(m_chunks.size()); }
+
+		uint32_t GetUploadsPerFrame() const { return m_uploadsPerFrame; }
+
+		void SetUploadsPerFrame(const uint32_t &uploadsPerFrame) { m_uploadsPerFrame = uploadsPerFrame; }
+	private:
+		std::shared_ptr<RegionFile> GetRegion(const int &x, const int &y, const int &z, const bool &create);
+
+		BlockId GetBlock(const int &x, const int &y, const int &z, ChunkCache *cache) const;
+
+		bool IsSlabFilled(const int &axis, const int &layer, const int *lower, const int *upper, ChunkCache *cache) const;
+
+		static uint64_t GetKey(const int &x, const int &y, const int &z);
+
+		static uint64_t GetRegionKey(const int &x, const int &y, const int &z);
+	};
+}